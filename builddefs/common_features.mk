@@ -576,6 +576,21 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     ifeq ($(strip $(RGB_MATRIX_CUSTOM_USER)), yes)
         OPT_DEFS += -DRGB_MATRIX_CUSTOM_USER
     endif
+
+    ifeq ($(strip $(RGB_MATRIX_GOVERNOR_ENABLE)), yes)
+        OPT_DEFS += -DRGB_MATRIX_GOVERNOR_ENABLE
+        SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_governor.c
+    endif
+
+    ifeq ($(strip $(RGB_MATRIX_COMPOSITOR_ENABLE)), yes)
+        OPT_DEFS += -DRGB_MATRIX_COMPOSITOR_ENABLE
+        SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_compositor.c
+    endif
+
+    ifeq ($(strip $(RGB_MATRIX_COLOR16_ENABLE)), yes)
+        OPT_DEFS += -DRGB_MATRIX_COLOR16_ENABLE
+        SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_color16.c
+    endif
 endif
 
 VARIABLE_TRACE ?= no
@@ -689,6 +704,11 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Include files used by all split keyboards
     QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_util.c
 
+    ifeq ($(strip $(SPLIT_DELTA_ENABLE)), yes)
+        OPT_DEFS += -DSPLIT_DELTA_ENABLE
+        QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_delta.c
+    endif
+
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
@@ -115,6 +115,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #define OLED_ALL_BLOCKS_MASK (((((OLED_BLOCK_TYPE)1 << (OLED_BLOCK_COUNT - 1)) - 1) << 1) | 1)
+STATIC_ASSERT(OLED_BLOCK_COUNT <= sizeof(OLED_BLOCK_TYPE) * 8, "OLED_BLOCK_COUNT must fit in the bits of OLED_BLOCK_TYPE");
+
+// Rotated runs are built up here, whole blocks or a full 8px column of smaller ones. Data sent asynchronously may still
+// be on the bus while the next run is rotated, so two buffers are alternated between.
+#define OLED_ROTATION_BUFFER_SIZE (OLED_BLOCK_SIZE < OLED_DISPLAY_HEIGHT ? OLED_DISPLAY_HEIGHT : OLED_BLOCK_SIZE)
+#if defined(OLED_TRANSPORT_SPI) && defined(OLED_ASYNC_FLUSH)
+#    define OLED_ROTATION_BUFFER_COUNT 2
+#else
+#    define OLED_ROTATION_BUFFER_COUNT 1
+#endif
 
 #define OLED_IC_HAS_HORIZONTAL_MODE (OLED_IC == OLED_IC_SSD1306)
 #define OLED_IC_COM_PINS_ARE_COLUMNS (OLED_IC == OLED_IC_SH1107)
@@ -188,6 +198,12 @@ uint16_t oled_update_timeout;
 #endif
 
 // Transmit/Write Funcs.
+void oled_send_wait(void) {
+#if defined(OLED_TRANSPORT_SPI) && defined(OLED_ASYNC_FLUSH)
+    spi_stop_wait();
+#endif
+}
+
 __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
 #if defined(OLED_TRANSPORT_SPI)
     if (!spi_start(OLED_CS_PIN, false, OLED_SPI_MODE, OLED_SPI_DIVISOR)) {
@@ -255,6 +271,25 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
 #endif
 }
 
+__attribute__((weak)) bool oled_send_data_async(const uint8_t *data, uint16_t size) {
+#if defined(OLED_TRANSPORT_SPI) && defined(OLED_ASYNC_FLUSH)
+    if (!spi_start(OLED_CS_PIN, false, OLED_SPI_MODE, OLED_SPI_DIVISOR)) {
+        return false;
+    }
+    // Data Mode
+    gpio_write_pin_high(OLED_DC_PIN);
+    // Start sending the data, leaving the OLED selected until it has gone or another device starts on the bus
+    if (spi_transmit_async(data, size) != SPI_STATUS_SUCCESS) {
+        spi_stop();
+        return false;
+    }
+    spi_stop_async();
+    return true;
+#else
+    return oled_send_data(data, size);
+#endif
+}
+
 __attribute__((weak)) void oled_driver_init(void) {
 #if defined(OLED_TRANSPORT_SPI)
     spi_init();
@@ -384,13 +419,38 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+// Returns how many dirty blocks, starting from update_start, can be sent as a single window, up to limit
+static uint8_t calc_run(uint8_t update_start, uint16_t limit) {
+    uint8_t count = 1;
+    while (count < limit && update_start + count < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << (update_start + count)))) {
+        uint16_t length = OLED_BLOCK_SIZE * (count + 1);
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            // Windows either cover whole pages, or part of a single one. Page Addressing Mode can only do the latter.
+            uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
+            if ((!OLED_IC_HAS_HORIZONTAL_MODE || OLED_BLOCK_SIZE % OLED_DISPLAY_WIDTH != 0) && start_column + length > OLED_DISPLAY_WIDTH) {
+                break;
+            }
+        } else {
+            // Rotated windows either cover whole 8px columns, or part of a single one, and must fit the rotation buffer
+            uint8_t start_row = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT;
+            if (length > OLED_ROTATION_BUFFER_SIZE || (OLED_BLOCK_SIZE < OLED_DISPLAY_HEIGHT && start_row + length > OLED_DISPLAY_HEIGHT)) {
+                break;
+            }
+        }
+        ++count;
+    }
+    return count;
+}
+
+static void calc_bounds(uint8_t update_start, uint8_t count, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
+    uint16_t length       = OLED_BLOCK_SIZE * count;
+    uint8_t  start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
+    uint8_t  start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
 #if !OLED_IC_HAS_HORIZONTAL_MODE
     // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
     // Column value must be split into high and low nybble and sent as two commands.
+    (void)length;
     cmd_array[0] = PAM_PAGE_ADDR | start_page;
     cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
     cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
@@ -398,52 +458,87 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     // Commands for use in Horizontal Addressing mode.
     cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
     cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    cmd_array[2] = (length + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
+    cmd_array[5] = (length + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
 #endif
 }
 
-static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
+static void calc_bounds_90(uint8_t update_start, uint8_t count, uint8_t *cmd_array) {
     // Block numbering starts from the bottom left corner, going up and then to
     // the right.  The controller needs the page and column numbers for the top
-    // left and bottom right corners of that block.
-
-    // Total number of pages across the screen height.
-    const uint8_t height_in_pages = OLED_DISPLAY_HEIGHT / 8;
-
-    // Difference of starting page numbers for adjacent blocks; may be 0 if
-    // blocks are large enough to occupy one or more whole 8px columns.
-    const uint8_t page_inc_per_block = OLED_BLOCK_SIZE % OLED_DISPLAY_HEIGHT / 8;
-
-    // Top page number for a block which is at the bottom edge of the screen.
-    const uint8_t bottom_block_top_page = (height_in_pages - page_inc_per_block) % height_in_pages;
+    // left and bottom right corners of the run of blocks, which either lies
+    // within one 8px column or covers whole ones.
+    uint16_t length       = OLED_BLOCK_SIZE * count;
+    uint8_t  start_column = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
+    uint8_t  start_page;
+    uint8_t  end_page;
+    uint8_t  end_column;
+    if (length < OLED_DISPLAY_HEIGHT) {
+        // Pixels from the bottom of the screen to the start of the run
+        uint8_t start_row = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT;
+        start_page        = (OLED_DISPLAY_HEIGHT - start_row - length) / 8;
+        end_page          = start_page + length / 8 - 1;
+        end_column        = start_column + 7;
+    } else {
+        start_page = 0;
+        end_page   = OLED_DISPLAY_HEIGHT / 8 - 1;
+        end_column = start_column + length / OLED_DISPLAY_HEIGHT * 8 - 1;
+    }
 
 #if !OLED_IC_HAS_HORIZONTAL_MODE
     // Only the Page Addressing Mode is supported
-    uint8_t start_page   = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
-    cmd_array[0]         = PAM_PAGE_ADDR | start_page;
-    cmd_array[1]         = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
-    cmd_array[2]         = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
+    (void)end_page;
+    (void)end_column;
+    cmd_array[0] = PAM_PAGE_ADDR | start_page;
+    cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
+    cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
 #else
-    cmd_array[1] = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8 + OLED_COLUMN_OFFSET;
-    cmd_array[4] = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8 - 1 + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) % OLED_DISPLAY_HEIGHT / 8 + cmd_array[4];
+    cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
+    cmd_array[2] = end_column + OLED_COLUMN_OFFSET;
+    cmd_array[4] = start_page;
+    cmd_array[5] = end_page;
 #endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
+// Rotates an 8x8 tile, so that bit i of dest[7 - j] is bit j of src[i]. Works on the tile as two 32 bit words,
+// swapping bits, then pairs, then nibbles between the rows, rather than moving one bit at a time.
+static void rotate_90(const uint8_t *src, uint8_t *dest) {
+    uint32_t x = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3];
+    uint32_t y = ((uint32_t)src[4] << 24) | ((uint32_t)src[5] << 16) | ((uint32_t)src[6] << 8) | src[7];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    dest[0] = y;
+    dest[1] = y >> 8;
+    dest[2] = y >> 16;
+    dest[3] = y >> 24;
+    dest[4] = x;
+    dest[5] = x >> 8;
+    dest[6] = x >> 16;
+    dest[7] = x >> 24;
 }
 
-static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+// Rotates a run of blocks into the order the OLED writes its memory: a page at a time from the top, each as wide as
+// the run. Our memory runs from the bottom left in this mode, up each 8px column and then to the right.
+static void rotate_run(const uint8_t *src, uint16_t length, uint8_t *dest) {
+    const uint8_t num_columns = length < OLED_DISPLAY_HEIGHT ? 1 : length / OLED_DISPLAY_HEIGHT;
+    const uint8_t num_pages   = length < OLED_DISPLAY_HEIGHT ? length / 8 : OLED_DISPLAY_HEIGHT / 8;
+    for (uint8_t column = 0; column < num_columns; ++column) {
+        for (uint8_t tile = 0; tile < num_pages; ++tile) {
+            rotate_90(&src[OLED_DISPLAY_HEIGHT * column + 8 * tile], &dest[(num_pages - 1 - tile) * num_columns * 8 + 8 * column]);
         }
     }
 }
@@ -458,24 +553,40 @@ void oled_render_dirty(bool all) {
     // Turn on display if it is off
     oled_on();
 
+    static uint8_t temp_buffer[OLED_ROTATION_BUFFER_COUNT][OLED_ROTATION_BUFFER_SIZE];
+    static uint8_t temp_index = 0;
+
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
+        // Adjacent dirty blocks are sent together, each still counting towards the limit
+        uint16_t limit = OLED_UPDATE_PROCESS_LIMIT - num_processed;
+        if (all) {
+            limit = OLED_BLOCK_COUNT;
+        }
+        uint8_t  count  = calc_run(update_start, limit);
+        uint16_t length = OLED_BLOCK_SIZE * count;
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
 #else
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
+        const uint8_t *data = &oled_buffer[OLED_BLOCK_SIZE * update_start];
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+            calc_bounds(update_start, count, &display_start[1]); // Offset from I2C_CMD byte at the start
         } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+            calc_bounds_90(update_start, count, &display_start[1]); // Offset from I2C_CMD byte at the start
+            // Rotate before sending the position, which waits for any data still on the bus
+            temp_index = (temp_index + 1) % OLED_ROTATION_BUFFER_COUNT;
+            rotate_run(data, length, temp_buffer[temp_index]);
+            data = temp_buffer[temp_index];
         }
 
         // Send column & page position
@@ -484,33 +595,22 @@ void oled_render_dirty(bool all) {
             return;
         }
 
+#if OLED_IC_HAS_HORIZONTAL_MODE
+        if (!oled_send_data_async(data, length)) {
+            print("oled_render data failed\n");
+            return;
+        }
+#else
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_data_async(data, length)) {
                 print("oled_render data failed\n");
                 return;
             }
         } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
-
-#if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
-            }
-#else
             // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+            const uint8_t columns_in_run = length < OLED_DISPLAY_HEIGHT ? 8 : length / OLED_DISPLAY_HEIGHT * 8;
+            const uint8_t num_pages      = length / columns_in_run;
             for (uint8_t i = 0; i < num_pages; ++i) {
                 // Send column & page position for all pages except the first one
                 if (i > 0) {
@@ -521,16 +621,19 @@ void oled_render_dirty(bool all) {
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_send_data_async(&data[columns_in_run * i], columns_in_run)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
             }
-#endif
         }
+#endif
 
-        // Clear dirty flag of just rendered block
-        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        // Clear dirty flags of just rendered blocks
+        for (uint8_t i = 0; i < count; ++i) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start++);
+        }
+        num_processed += count;
     }
 }
 
@@ -931,6 +1034,9 @@ void oled_task(void) {
         return;
     }
 
+    // Complete anything rendered last time, which has had the rest of the main loop to go out
+    oled_send_wait();
+
 #if OLED_UPDATE_INTERVAL > 0
     if (timer_elapsed(oled_update_timeout) >= OLED_UPDATE_INTERVAL) {
         oled_update_timeout = timer_read();
@@ -50,26 +50,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_ALT
 #    endif
 
-// For 90 degree rotation, we map our internal matrix to oled matrix using fixed arrays
-// The OLED writes to it's memory horizontally, starting top left, but our memory starts bottom left in this mode
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8, 16, 24, 32, 40, 48, 56 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 56, 48, 40, 32, 24, 16, 8, 0 }
-#    endif
-// If OLED_BLOCK_TYPE is uint32_t, these tables would look like:
-// #define OLED_SOURCE_MAP { 32, 40, 48, 56 }
-// #define OLED_TARGET_MAP { 24, 16, 8, 0 }
-// If OLED_BLOCK_TYPE is uint16_t, these tables would look like:
-// #define OLED_SOURCE_MAP { 0, 8, 16, 24, 32, 40, 48, 56 }
-// #define OLED_TARGET_MAP { 56, 48, 40, 32, 24, 16, 8, 0 }
-// If OLED_BLOCK_TYPE is uint8_t, these tables would look like:
-// #define OLED_SOURCE_MAP { 0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120 }
-// #define OLED_TARGET_MAP { 56, 120, 48, 112, 40, 104, 32, 96, 24, 88, 16, 80, 8, 72, 0, 64 }
-
 #elif defined(OLED_DISPLAY_64X32)
 #    ifndef OLED_DISPLAY_WIDTH
 #        define OLED_DISPLAY_WIDTH 64
@@ -96,15 +76,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_ALT
 #    endif
 
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8, 16, 24 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 24, 16, 8, 0 }
-#    endif
-
 #elif defined(OLED_DISPLAY_64X48)
 #    ifndef OLED_DISPLAY_WIDTH
 #        define OLED_DISPLAY_WIDTH 64
@@ -131,15 +102,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_ALT
 #    endif
 
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 8, 0 }
-#    endif
-
 #elif defined(OLED_DISPLAY_64X128)
 #    ifndef OLED_DISPLAY_WIDTH
 #        define OLED_DISPLAY_WIDTH 64
@@ -169,15 +131,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_ALT
 #    endif
 
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8, 16, 24, 32, 40, 48, 56 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 56, 48, 40, 32, 24, 16, 8, 0 }
-#    endif
-
 #elif defined(OLED_DISPLAY_128X128)
 // Quad height 128x128
 #    ifndef OLED_DISPLAY_WIDTH
@@ -205,16 +158,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_ALT
 #    endif
 
-// For 90 degree rotation, we map our internal matrix to oled matrix using fixed arrays
-// The OLED writes to it's memory horizontally, starting top left, but our memory starts bottom left in this mode
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8, 16, 24, 32, 40, 48, 56 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 56, 48, 40, 32, 24, 16, 8, 0 }
-#    endif
 #else // defined(OLED_DISPLAY_128X64)
 // Default 128x32
 #    ifndef OLED_DISPLAY_WIDTH
@@ -239,19 +182,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define OLED_COM_PINS COM_PINS_SEQ
 #    endif
 
-// For 90 degree rotation, we map our internal matrix to oled matrix using fixed arrays
-// The OLED writes to it's memory horizontally, starting top left, but our memory starts bottom left in this mode
-#    ifndef OLED_SOURCE_MAP
-#        define OLED_SOURCE_MAP \
-            { 0, 8, 16, 24 }
-#    endif
-#    ifndef OLED_TARGET_MAP
-#        define OLED_TARGET_MAP \
-            { 24, 16, 8, 0 }
-#    endif
-// If OLED_BLOCK_TYPE is uint8_t, these tables would look like:
-// #define OLED_SOURCE_MAP { 0, 8, 16, 24, 32, 40, 48, 56 }
-// #define OLED_TARGET_MAP { 48, 32, 16, 0, 56, 40, 24, 8 }
 #endif // defined(OLED_DISPLAY_CUSTOM)
 
 #if !defined(OLED_IC)
@@ -344,6 +274,12 @@ bool oled_send_cmd_P(const uint8_t *data, uint16_t size);
 bool oled_send_data(const uint8_t *data, uint16_t size);
 void oled_driver_init(void);
 
+// Starts sending data to the screen, returning before it has been sent where the transport allows. Used for
+// rendering, the data must be left unmodified until oled_send_wait() has returned. Over SPI with OLED_ASYNC_FLUSH, the
+// OLED stays selected until then, or until another SPI device starts on the bus, which waits for the data first.
+bool oled_send_data_async(const uint8_t *data, uint16_t size);
+void oled_send_wait(void);
+
 // Called at the start of oled_init, weak function overridable by the user
 // rotation - the value passed into oled_init
 // Return new oled_rotation_t if you want to override default rotation
@@ -21,6 +21,22 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_TILE_SIZE
+/**
+ * @def This controls the width and height of the tiles used to track which parts of a surface have been drawn to,
+ *      in pixels. Must be a power of two. Surfaces with more tiles than fit in SURFACE_DIRTY_TILE_BITMAP_SIZE use
+ *      larger tiles.
+ */
+#    define SURFACE_DIRTY_TILE_SIZE 16
+#endif
+
+#ifndef SURFACE_DIRTY_TILE_BITMAP_SIZE
+/**
+ * @def This controls the number of bytes each surface uses to track its dirty tiles, one bit per tile.
+ */
+#    define SURFACE_DIRTY_TILE_BITMAP_SIZE 64
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -1,9 +1,14 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "compiler_support.h"
 #include "color.h"
 #include "qp_draw.h"
 #include "qp_surface_internal.h"
+#include "qp_comms.h"
+
+STATIC_ASSERT((SURFACE_DIRTY_TILE_SIZE > 0) && ((SURFACE_DIRTY_TILE_SIZE & (SURFACE_DIRTY_TILE_SIZE - 1)) == 0), "SURFACE_DIRTY_TILE_SIZE must be a power of two");
+STATIC_ASSERT(SURFACE_DIRTY_TILE_BITMAP_SIZE > 0, "SURFACE_DIRTY_TILE_BITMAP_SIZE must be greater than zero");
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver storage
@@ -29,7 +34,19 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+static inline void qp_surface_set_dirty_tile(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    uint16_t tile = (y >> dirty->tile_shift) * dirty->tiles_across + (x >> dirty->tile_shift);
+    dirty->tiles[tile / 8] |= 1 << (tile % 8);
+}
+
+static inline bool qp_surface_is_dirty_tile(const surface_dirty_data_t *dirty, const uint8_t *tiles, uint16_t tx, uint16_t ty) {
+    uint16_t tile = ty * dirty->tiles_across + tx;
+    return tiles[tile / 8] & (1 << (tile % 8));
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    qp_surface_set_dirty_tile(dirty, x, y);
+
     // Maintain dirty region
     if (dirty->l > x) {
         dirty->l        = x;
@@ -49,6 +66,95 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
     }
 }
 
+void qp_surface_update_dirty_span(surface_dirty_data_t *dirty, uint16_t l, uint16_t r, uint16_t y) {
+    qp_surface_update_dirty(dirty, l, y);
+    qp_surface_update_dirty(dirty, r, y);
+
+    // Mark any tiles the span crosses in between
+    for (uint16_t x = ((l >> dirty->tile_shift) + 1) << dirty->tile_shift; x < r; x += (1 << dirty->tile_shift)) {
+        qp_surface_set_dirty_tile(dirty, x, y);
+    }
+}
+
+static bool qp_surface_transfer_rect(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b, surface_stream_rect_func stream_rect) {
+    // Set the target drawing area
+    if (!target_driver->driver_vtable->viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b)) {
+        qp_dprintf("qp_surface_transfer_rect: fail (could not set target viewport)\n");
+        return false;
+    }
+    if (!stream_rect(surface_driver, target_driver, l, t, r, b)) {
+        qp_dprintf("qp_surface_transfer_rect: fail (could not stream pixdata to target)\n");
+        return false;
+    }
+    return true;
+}
+
+bool qp_surface_transfer_dirty_rects(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface, surface_stream_rect_func stream_rect) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+    surface_dirty_data_t *    dirty          = &surface_handle->dirty;
+
+    // Keep the target's comms open for the whole transfer, so that each chunk can be sent while the next is copied
+    if (!qp_comms_start((painter_device_t)target_driver)) {
+        qp_dprintf("qp_surface_transfer_dirty_rects: fail (could not start target comms)\n");
+        return false;
+    }
+
+    if (entire_surface) {
+        bool ok = qp_surface_transfer_rect(surface_driver, target_driver, x, y, 0, 0, surface_driver->panel_width - 1, surface_driver->panel_height - 1, stream_rect);
+        qp_comms_stop((painter_device_t)target_driver);
+        return ok;
+    }
+
+    // Work from a copy, so that the dirty tiles are kept should the transfer fail
+    uint8_t tiles[SURFACE_DIRTY_TILE_BITMAP_SIZE];
+    memcpy(tiles, dirty->tiles, sizeof(tiles));
+
+    bool ok = true;
+    for (uint16_t ty = 0; ok && ty < dirty->tiles_down; ++ty) {
+        for (uint16_t tx = 0; ok && tx < dirty->tiles_across; ++tx) {
+            if (!qp_surface_is_dirty_tile(dirty, tiles, tx, ty)) {
+                continue;
+            }
+
+            // Grow right across adjacent dirty tiles, then down for as long as the whole run below is dirty too
+            uint16_t tr = tx;
+            while (tr + 1 < dirty->tiles_across && qp_surface_is_dirty_tile(dirty, tiles, tr + 1, ty)) {
+                tr++;
+            }
+            uint16_t tb = ty;
+            while (tb + 1 < dirty->tiles_down) {
+                uint16_t i = tx;
+                while (i <= tr && qp_surface_is_dirty_tile(dirty, tiles, i, tb + 1)) {
+                    i++;
+                }
+                if (i <= tr) {
+                    break;
+                }
+                tb++;
+            }
+
+            // Consume the tiles covered
+            for (uint16_t j = ty; j <= tb; ++j) {
+                for (uint16_t i = tx; i <= tr; ++i) {
+                    uint16_t tile = j * dirty->tiles_across + i;
+                    tiles[tile / 8] &= ~(1 << (tile % 8));
+                }
+            }
+
+            // Tiles on the edge of the dirty region are only partly drawn to, so stay within it
+            uint16_t l = QP_MAX((uint16_t)(tx << dirty->tile_shift), dirty->l);
+            uint16_t t = QP_MAX((uint16_t)(ty << dirty->tile_shift), dirty->t);
+            uint16_t r = QP_MIN((uint16_t)(((tr + 1) << dirty->tile_shift) - 1), dirty->r);
+            uint16_t b = QP_MIN((uint16_t)(((tb + 1) << dirty->tile_shift) - 1), dirty->b);
+            ok         = qp_surface_transfer_rect(surface_driver, target_driver, x, y, l, t, r, b, stream_rect);
+            tx         = tr;
+        }
+    }
+
+    qp_comms_stop((painter_device_t)target_driver);
+    return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
@@ -63,6 +169,18 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
 
+    // Use larger tiles until there's a bit for each of them
+    surface->dirty.tile_shift = __builtin_ctz(SURFACE_DIRTY_TILE_SIZE);
+    while (true) {
+        surface->dirty.tiles_across = ((surface->base.panel_width - 1) >> surface->dirty.tile_shift) + 1;
+        surface->dirty.tiles_down   = ((surface->base.panel_height - 1) >> surface->dirty.tile_shift) + 1;
+        if ((uint32_t)surface->dirty.tiles_across * surface->dirty.tiles_down <= SURFACE_DIRTY_TILE_BITMAP_SIZE * 8) {
+            break;
+        }
+        surface->dirty.tile_shift++;
+    }
+    memset(surface->dirty.tiles, 0xFF, sizeof(surface->dirty.tiles));
+
     return true;
 }
 
@@ -83,6 +201,7 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    memset(surface->dirty.tiles, 0, sizeof(surface->dirty.tiles));
     return true;
 }
 
@@ -22,8 +22,17 @@ typedef struct surface_dirty_data_t {
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // One bit per tile drawn to, so that separate areas can be transferred without everything in between
+    uint8_t  tile_shift;
+    uint16_t tiles_across;
+    uint16_t tiles_down;
+    uint8_t  tiles[SURFACE_DIRTY_TILE_BITMAP_SIZE];
 } surface_dirty_data_t;
 
+// Streams the surface's pixels within the given rectangle to the target, whose viewport has already been set
+typedef bool (*surface_stream_rect_func)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
+
 typedef struct surface_viewport_data_t {
     // Manually manage the viewport for streaming pixel data to the display
     uint16_t viewport_l;
@@ -89,6 +98,8 @@ bool qp_surface_flush(painter_device_t device);
 bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
+void qp_surface_update_dirty_span(surface_dirty_data_t *dirty, uint16_t l, uint16_t r, uint16_t y);
+bool qp_surface_transfer_dirty_rects(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface, surface_stream_rect_func stream_rect);
 
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
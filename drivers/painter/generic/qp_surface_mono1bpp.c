@@ -84,8 +84,73 @@ static bool qp_surface_append_pixels_mono1bpp(painter_device_t device, uint8_t *
     return true;
 }
 
+// Fill a run of pixels with the same palette index, a byte at a time where possible
+static bool qp_surface_append_pixel_run_mono1bpp(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    bool     mono        = palette[palette_index].mono;
+    uint32_t pixel_num   = pixel_offset;
+    uint32_t end         = pixel_offset + pixel_count;
+    uint32_t whole_start = (pixel_offset + 7) / 8;
+    uint32_t whole_end   = end / 8;
+
+    // Leading and trailing pixels which only partly cover a byte are handled individually
+    for (; pixel_num < end && (pixel_num % 8) != 0; ++pixel_num) {
+        if (mono) {
+            target_buffer[pixel_num / 8] |= (1 << (pixel_num % 8));
+        } else {
+            target_buffer[pixel_num / 8] &= ~(1 << (pixel_num % 8));
+        }
+    }
+    if (whole_end > whole_start) {
+        memset(&target_buffer[whole_start], mono ? 0xFF : 0x00, whole_end - whole_start);
+        pixel_num = whole_end * 8;
+    }
+    for (; pixel_num < end; ++pixel_num) {
+        if (mono) {
+            target_buffer[pixel_num / 8] |= (1 << (pixel_num % 8));
+        } else {
+            target_buffer[pixel_num / 8] &= ~(1 << (pixel_num % 8));
+        }
+    }
+    return true;
+}
+
+static bool mono1bpp_stream_rect(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+
+    // Housekeeping of the amount of pixels to transfer
+    uint32_t total_pixel_count = 8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE;
+    uint32_t pixel_counter     = 0;
+    bool     ok                = true;
+
+    // Repack the pixels within the rect into the global pixdata area, sending it whenever it fills up
+    for (uint16_t y = t; ok && y <= b; ++y) {
+        for (uint16_t x = l; ok && x <= r; ++x) {
+            uint32_t pixel_num = y * surface_handle->base.panel_width + x;
+            uint8_t *target    = &qp_internal_global_pixdata_buffer[pixel_counter / 8];
+            if (pixel_counter % 8 == 0) {
+                *target = 0;
+            }
+            if (surface_handle->u8buffer[pixel_num / 8] & (1 << (pixel_num % 8))) {
+                *target |= 1 << (pixel_counter % 8);
+            }
+
+            // If we've accumulated enough data, send it
+            if (++pixel_counter == total_pixel_count) {
+                ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter) && qp_internal_pixdata_sent(true);
+                pixel_counter = 0;
+            }
+        }
+    }
+
+    // If there's any leftover data, send it
+    if (ok && pixel_counter > 0) {
+        ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter) && qp_internal_pixdata_sent(true);
+    }
+    return ok;
+}
+
 static bool mono1bpp_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
-    return false; // Not yet supported.
+    return qp_surface_transfer_dirty_rects(surface_driver, target_driver, x, y, entire_surface, mono1bpp_stream_rect);
 }
 
 static bool qp_surface_append_pixdata_mono1bpp(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
@@ -95,15 +160,16 @@ static bool qp_surface_append_pixdata_mono1bpp(painter_device_t device, uint8_t
 const surface_painter_driver_vtable_t mono1bpp_surface_driver_vtable = {
     .base =
         {
-            .init            = qp_surface_init,
-            .power           = qp_surface_power,
-            .clear           = qp_surface_clear,
-            .flush           = qp_surface_flush,
-            .pixdata         = qp_surface_pixdata_mono1bpp,
-            .viewport        = qp_surface_viewport,
-            .palette_convert = qp_surface_palette_convert_mono1bpp,
-            .append_pixels   = qp_surface_append_pixels_mono1bpp,
-            .append_pixdata  = qp_surface_append_pixdata_mono1bpp,
+            .init             = qp_surface_init,
+            .power            = qp_surface_power,
+            .clear            = qp_surface_clear,
+            .flush            = qp_surface_flush,
+            .pixdata          = qp_surface_pixdata_mono1bpp,
+            .viewport         = qp_surface_viewport,
+            .palette_convert  = qp_surface_palette_convert_mono1bpp,
+            .append_pixels    = qp_surface_append_pixels_mono1bpp,
+            .append_pixdata   = qp_surface_append_pixdata_mono1bpp,
+            .append_pixel_run = qp_surface_append_pixel_run_mono1bpp,
         },
     .target_pixdata_transfer = mono1bpp_target_pixdata_transfer,
 };
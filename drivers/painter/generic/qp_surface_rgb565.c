@@ -35,9 +35,46 @@ static inline void append_pixel_rgb565(surface_painter_device_t *surface, uint16
     qp_surface_increment_pixdata_location(&surface->viewport);
 }
 
+// Copies the pixels up to the end of the current viewport row, updating the dirty region once for the whole span
+static inline uint32_t append_row_span_rgb565(surface_painter_device_t *surface, const uint16_t *data, uint32_t native_pixel_count) {
+    uint16_t w     = surface->base.panel_width;
+    uint16_t x     = surface->viewport.pixdata_x;
+    uint16_t y     = surface->viewport.pixdata_y;
+    uint32_t count = QP_MIN(native_pixel_count, (uint32_t)(surface->viewport.viewport_r - x + 1));
+
+    // Leave anything off-screen to the per-pixel path
+    if (y >= surface->base.panel_height || x + count > w) {
+        append_pixel_rgb565(surface, data[0]);
+        return 1;
+    }
+
+    uint16_t *row   = &surface->u16buffer[y * w + x];
+    int32_t   first = -1;
+    int32_t   last  = -1;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (row[i] != data[i]) {
+            row[i] = data[i];
+            if (first < 0) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+    if (first >= 0) {
+        qp_surface_update_dirty_span(&surface->dirty, x + first, x + last, y);
+    }
+
+    // Move to the start of the next row, wrapping back to the top
+    surface->viewport.pixdata_x = x + count - 1;
+    qp_surface_increment_pixdata_location(&surface->viewport);
+    return count;
+}
+
 static inline void stream_pixdata_rgb565(surface_painter_device_t *surface, const uint16_t *data, uint32_t native_pixel_count) {
-    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
-        append_pixel_rgb565(surface, data[pixel_counter]);
+    while (native_pixel_count > 0) {
+        uint32_t count = append_row_span_rgb565(surface, data, native_pixel_count);
+        data += count;
+        native_pixel_count -= count;
     }
 }
 
@@ -68,55 +105,50 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
-static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
-    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
-
-    uint16_t l = entire_surface ? 0 : surface_handle->dirty.l;
-    uint16_t t = entire_surface ? 0 : surface_handle->dirty.t;
-    uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
-    uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
-
-    // Set the target drawing area
-    bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
-    if (!ok) {
-        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not set target viewport)\n");
-        return false;
+// Fill a run of pixels with the same palette index
+static bool qp_surface_append_pixel_run_rgb565(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    uint16_t *buf    = (uint16_t *)target_buffer;
+    uint16_t  rgb565 = palette[palette_index].rgb565;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = rgb565;
     }
+    return true;
+}
 
-    // Housekeeping of the amount of pixels to transfer
-    uint32_t  total_pixel_count = (8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / surface_driver->native_bits_per_pixel;
-    uint32_t  pixel_counter     = 0;
-    uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
+static bool rgb565_stream_rect(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
-    // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = t; y <= b; ++y) {
-        for (uint16_t x = l; x <= r; ++x) {
-            // Update the target buffer
-            target_buffer[pixel_counter++] = surface_handle->u16buffer[y * surface_handle->base.panel_width + x];
+    // Housekeeping of the amount of pixels to transfer
+    uint32_t total_pixel_count = (8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / surface_driver->native_bits_per_pixel;
+    uint32_t pixel_counter     = 0;
+    bool     ok                = true;
+
+    // Fill the global pixdata area a row span at a time, sending it whenever it fills up
+    for (uint16_t y = t; ok && y <= b; ++y) {
+        const uint16_t *row = &surface_handle->u16buffer[y * surface_handle->base.panel_width];
+        for (uint16_t x = l; ok && x <= r;) {
+            uint16_t count = QP_MIN((uint32_t)(r - x + 1), total_pixel_count - pixel_counter);
+            memcpy(&((uint16_t *)qp_internal_global_pixdata_buffer)[pixel_counter], &row[x], count * sizeof(uint16_t));
+            pixel_counter += count;
+            x += count;
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-                if (!ok) {
-                    qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-                    return false;
-                }
-                // Reset the counter
+                ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter) && qp_internal_pixdata_sent(true);
                 pixel_counter = 0;
             }
         }
     }
 
     // If there's any leftover data, send it
-    if (pixel_counter > 0) {
-        ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-        if (!ok) {
-            qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-            return false;
-        }
+    if (ok && pixel_counter > 0) {
+        ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter) && qp_internal_pixdata_sent(true);
     }
+    return ok;
+}
 
-    return true;
+static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+    return qp_surface_transfer_dirty_rects(surface_driver, target_driver, x, y, entire_surface, rgb565_stream_rect);
 }
 
 static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
@@ -127,15 +159,16 @@ static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *t
 const surface_painter_driver_vtable_t rgb565_surface_driver_vtable = {
     .base =
         {
-            .init            = qp_surface_init,
-            .power           = qp_surface_power,
-            .clear           = qp_surface_clear,
-            .flush           = qp_surface_flush,
-            .pixdata         = qp_surface_pixdata_rgb565,
-            .viewport        = qp_surface_viewport,
-            .palette_convert = qp_surface_palette_convert_rgb565_swapped,
-            .append_pixels   = qp_surface_append_pixels_rgb565,
-            .append_pixdata  = qp_surface_append_pixdata_rgb565,
+            .init             = qp_surface_init,
+            .power            = qp_surface_power,
+            .clear            = qp_surface_clear,
+            .flush            = qp_surface_flush,
+            .pixdata          = qp_surface_pixdata_rgb565,
+            .viewport         = qp_surface_viewport,
+            .palette_convert  = qp_surface_palette_convert_rgb565_swapped,
+            .append_pixels    = qp_surface_append_pixels_rgb565,
+            .append_pixdata   = qp_surface_append_pixdata_rgb565,
+            .append_pixel_run = qp_surface_append_pixel_run_rgb565,
         },
     .target_pixdata_transfer = rgb565_target_pixdata_transfer,
 };
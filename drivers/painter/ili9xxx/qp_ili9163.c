@@ -61,15 +61,16 @@ __attribute__((weak)) bool qp_ili9163_init(painter_device_t device, painter_rota
 const tft_panel_dc_reset_painter_driver_vtable_t ili9163_driver_vtable = {
     .base =
         {
-            .init            = qp_ili9163_init,
-            .power           = qp_tft_panel_power,
-            .clear           = qp_tft_panel_clear,
-            .flush           = qp_tft_panel_flush,
-            .pixdata         = qp_tft_panel_pixdata,
-            .viewport        = qp_tft_panel_viewport,
-            .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
-            .append_pixels   = qp_tft_panel_append_pixels_rgb565,
-            .append_pixdata  = qp_tft_panel_append_pixdata,
+            .init             = qp_ili9163_init,
+            .power            = qp_tft_panel_power,
+            .clear            = qp_tft_panel_clear,
+            .flush            = qp_tft_panel_flush,
+            .pixdata          = qp_tft_panel_pixdata,
+            .viewport         = qp_tft_panel_viewport,
+            .palette_convert  = qp_tft_panel_palette_convert_rgb565_swapped,
+            .append_pixels    = qp_tft_panel_append_pixels_rgb565,
+            .append_pixdata   = qp_tft_panel_append_pixdata,
+            .append_pixel_run = qp_tft_panel_append_pixel_run_rgb565,
         },
     .num_window_bytes   = 2,
     .swap_window_coords = false,
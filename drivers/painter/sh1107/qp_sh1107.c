@@ -113,15 +113,16 @@ bool qp_sh1107_flush(painter_device_t device) {
 const oled_panel_painter_driver_vtable_t sh1107_driver_vtable = {
     .base =
         {
-            .init            = qp_sh1107_init,
-            .power           = qp_oled_panel_power,
-            .clear           = qp_oled_panel_clear,
-            .flush           = qp_sh1107_flush,
-            .pixdata         = qp_oled_panel_passthru_pixdata,
-            .viewport        = qp_oled_panel_passthru_viewport,
-            .palette_convert = qp_oled_panel_passthru_palette_convert,
-            .append_pixels   = qp_oled_panel_passthru_append_pixels,
-            .append_pixdata  = qp_oled_panel_passthru_append_pixdata,
+            .init             = qp_sh1107_init,
+            .power            = qp_oled_panel_power,
+            .clear            = qp_oled_panel_clear,
+            .flush            = qp_sh1107_flush,
+            .pixdata          = qp_oled_panel_passthru_pixdata,
+            .viewport         = qp_oled_panel_passthru_viewport,
+            .palette_convert  = qp_oled_panel_passthru_palette_convert,
+            .append_pixels    = qp_oled_panel_passthru_append_pixels,
+            .append_pixdata   = qp_oled_panel_passthru_append_pixdata,
+            .append_pixel_run = qp_oled_panel_passthru_append_pixel_run,
         },
     .opcodes =
         {
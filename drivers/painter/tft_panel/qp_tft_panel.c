@@ -78,10 +78,10 @@ bool qp_tft_panel_viewport(painter_device_t device, uint16_t left, uint16_t top,
     return true;
 }
 
-// Stream pixel data to the current write position in GRAM
+// Stream pixel data to the current write position in GRAM, which may still be in flight on return
 bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
     painter_driver_t *driver = (painter_driver_t *)device;
-    qp_comms_send(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
+    qp_comms_send_pixdata(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
     return true;
 }
 
@@ -131,3 +131,25 @@ bool qp_tft_panel_append_pixdata(painter_device_t device, uint8_t *target_buffer
     target_buffer[pixdata_offset] = pixdata_byte;
     return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Fill the target location with a run of the same palette index
+
+bool qp_tft_panel_append_pixel_run_rgb565(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    uint16_t *buf    = (uint16_t *)target_buffer;
+    uint16_t  rgb565 = palette[palette_index].rgb565;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = rgb565;
+    }
+    return true;
+}
+
+bool qp_tft_panel_append_pixel_run_rgb888(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    qp_pixel_t pixel = palette[palette_index];
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        target_buffer[(pixel_offset + i) * 3 + 0] = pixel.rgb888.r;
+        target_buffer[(pixel_offset + i) * 3 + 1] = pixel.rgb888.g;
+        target_buffer[(pixel_offset + i) * 3 + 2] = pixel.rgb888.b;
+    }
+    return true;
+}
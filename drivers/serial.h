@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+// target sends a frame to the initiator between transactions, full-duplex only
+bool soft_serial_target_push(const uint8_t *data, uint8_t size);
+// initiator collects the most recent frame pushed by the target, returns its size or 0 if none arrived
+uint8_t soft_serial_initiator_receive_push(uint8_t *data, uint8_t size);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -93,6 +93,25 @@ spi_status_t spi_read(void);
  */
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
+/**
+ * \brief Start sending multiple bytes to the selected SPI device, returning before the transfer has completed where the platform supports it.
+ *
+ * Any transfer already in progress is waited for first. The data must not be modified until `spi_transmit_wait()` has returned, or another SPI function has been called, as these wait for the transfer to complete.
+ *
+ * \param data A pointer to the data to write from.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ *
+ * \return `SPI_STATUS_TIMEOUT` if the timeout period elapses, `SPI_STATUS_ERROR` if some other error occurs, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+/**
+ * \brief Wait for a transfer started by `spi_transmit_async()` to complete.
+ *
+ * \return `SPI_STATUS_TIMEOUT` if the timeout period elapses, `SPI_STATUS_ERROR` if some other error occurs, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_wait(void);
+
 /**
  * \brief Receive multiple bytes from the selected SPI device.
  *
@@ -109,6 +128,18 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length);
  */
 void spi_stop(void);
 
+/**
+ * \brief End the current SPI transaction once a transfer started by `spi_transmit_async()` has completed, without waiting for it.
+ *
+ * The device stays selected until the transfer has gone. The stop is completed by the next call to `spi_start()`, whichever device it is for, or by `spi_stop_wait()`.
+ */
+void spi_stop_async(void);
+
+/**
+ * \brief Complete a stop begun by `spi_stop_async()`, waiting for its transfer. Does nothing if there isn't one.
+ */
+void spi_stop_wait(void);
+
 #ifdef __cplusplus
 }
 #endif
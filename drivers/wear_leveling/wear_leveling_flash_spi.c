@@ -42,6 +42,19 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    STATIC_ASSERT((WEAR_LEVELING_ERASE_STEP_SIZE) % (EXTERNAL_FLASH_SECTOR_SIZE) == 0, "Erase step size must be a multiple of EXTERNAL_FLASH_SECTOR_SIZE");
+
+    for (uint32_t offset = 0; offset < length; offset += (EXTERNAL_FLASH_SECTOR_SIZE)) {
+        if (flash_erase_sector((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address + offset) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -454,3 +454,85 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+def compress_bytes_qmk_lz(bytearray):
+    """Compresses bytes with QMK LZ -- runs of literals, and back-references to the previous 512 bytes of output.
+    """
+    window_size = 512
+    min_match = 3
+    max_match = 321
+    max_candidates = 64
+
+    data = list(bytearray)
+    output = []
+    literals = []
+    chains = {}  # positions of each 3-byte prefix seen so far, oldest first
+
+    def add_position(p):
+        if p + min_match <= len(data):
+            chains.setdefault(tuple(data[p:p + min_match]), []).append(p)
+
+    def append_literals():
+        while len(literals) > 0:
+            chunk = literals[:128]
+            output.append(len(chunk) - 1)
+            output.extend(chunk)
+            del literals[:128]
+
+    n = 0
+    while n < len(data):
+        # Find the longest match within the window, preferring the nearest
+        best_length = 0
+        best_distance = 0
+        if n + min_match <= len(data):
+            limit = min(max_match, len(data) - n)
+            for p in reversed(chains.get(tuple(data[n:n + min_match]), [])[-max_candidates:]):
+                if n - p > window_size:
+                    break
+                length = 0
+                while length < limit and data[p + length] == data[n + length]:
+                    length += 1
+                if length > best_length:
+                    best_length = length
+                    best_distance = n - p
+                    if length == limit:
+                        break
+
+        if best_length < min_match:
+            literals.append(data[n])
+            add_position(n)
+            n += 1
+            continue
+
+        append_literals()
+        far = best_distance > 256
+        output.append(0x80 | (0x40 if far else 0) | min(best_length - min_match, 0x3F))
+        output.append(best_distance - (257 if far else 1))
+        if best_length - min_match >= 0x3F:
+            output.append(best_length - min_match - 0x3F)
+        for p in range(n, n + best_length):
+            add_position(p)
+        n += best_length
+
+    append_literals()
+    return output
+
+
+def compress_bytes(bytearray, *, use_rle, use_lz):
+    """Compresses bytes with whichever of the enabled schemes is smallest, returning the scheme (see qp.h,
+    painter_compression_t) and the compressed bytes.
+    """
+    compression = 0x00
+    output = bytearray
+    if use_rle:
+        rle_data = compress_bytes_qmk_rle(bytearray)
+        if len(rle_data) < len(output):
+            compression = 0x01
+            output = rle_data
+    if use_lz:
+        lz_data = compress_bytes_qmk_lz(bytearray)
+        if len(lz_data) < len(output):
+            compression = 0x02
+            output = lz_data
+    return (compression, output)
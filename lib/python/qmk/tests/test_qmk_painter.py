@@ -0,0 +1,91 @@
+import random
+
+from qmk.painter import compress_bytes, compress_bytes_qmk_lz
+
+# Also checked against the firmware's encoder and decoder, in tests/painter/test_painter_codec.cpp
+LZ_VECTOR_INPUT = list(range(20)) + [0xAA] * 400 + list(range(20)) + [1, 2, 3, 4] * 5
+LZ_VECTOR_OUTPUT = [
+    0x14, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0xAA,  # 21 literals
+    0xBF, 0x00, 0xFF,  # 321 repeats of the previous byte
+    0xBF, 0x00, 0x0C,  # 78 more
+    0xD1, 0xA3,  # 20 bytes from 420 back
+    0x81, 0x12,  # 4 bytes from 19 back
+    0x8D, 0x03,  # 16 bytes from 4 back, overlapping what it writes
+]
+
+
+def decompress_bytes_qmk_lz(data):
+    """Decodes QMK LZ as described in docs/quantum_painter_lz.md.
+    """
+    output = []
+    n = 0
+    while n < len(data):
+        marker = data[n]
+        n += 1
+        if marker < 128:
+            output.extend(data[n:n + marker + 1])
+            n += marker + 1
+            continue
+
+        distance = data[n] + (257 if marker & 0x40 else 1)
+        length = (marker & 0x3F) + 3
+        n += 1
+        if marker & 0x3F == 0x3F:
+            length += data[n]
+            n += 1
+        assert distance <= 512 and distance <= len(output)
+        for _ in range(length):
+            output.append(output[-distance])
+    return output
+
+
+def _assert_round_trip(data):
+    compressed = compress_bytes_qmk_lz(data)
+    assert all(0 <= b <= 255 for b in compressed)
+    assert decompress_bytes_qmk_lz(compressed) == list(data)
+    return compressed
+
+
+def test_lz_vector():
+    assert compress_bytes_qmk_lz(LZ_VECTOR_INPUT) == LZ_VECTOR_OUTPUT
+    assert decompress_bytes_qmk_lz(LZ_VECTOR_OUTPUT) == LZ_VECTOR_INPUT
+
+
+def test_lz_round_trip_empty():
+    assert _assert_round_trip([]) == []
+
+
+def test_lz_round_trip_literals():
+    rng = random.Random(1)
+    data = [rng.randrange(256) for _ in range(1000)]
+    # Longer than a single literal run
+    assert len(_assert_round_trip(data)) > len(data)
+
+
+def test_lz_round_trip_runs():
+    data = [0x00] * 5000 + [0xFF] * 3 + [0x00] * 2
+    assert len(_assert_round_trip(data)) < 100
+
+
+def test_lz_round_trip_patterns():
+    rng = random.Random(2)
+    # A dithered pattern, rows which repeat the one above with changes, and matches right at the edge of the window
+    data = [0x55, 0xAA] * 300
+    row = [rng.randrange(4) for _ in range(40)]
+    for _ in range(30):
+        row[rng.randrange(len(row))] = rng.randrange(4)
+        data.extend(row)
+    block = [rng.randrange(256) for _ in range(100)]
+    data.extend(block + [rng.randrange(256) for _ in range(412)] + block)
+    data.extend(block + [rng.randrange(256) for _ in range(413)] + block)
+    compressed = _assert_round_trip(data)
+    assert len(compressed) < len(data) // 2
+
+
+def test_compress_bytes_picks_smallest():
+    data = list(range(16)) * 64
+    assert compress_bytes(data, use_rle=False, use_lz=False) == (0x00, data)
+    assert compress_bytes(data, use_rle=True, use_lz=False)[0] == 0x00
+    compression, output = compress_bytes(data, use_rle=True, use_lz=True)
+    assert compression == 0x02
+    assert decompress_bytes_qmk_lz(output) == data
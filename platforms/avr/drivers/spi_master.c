@@ -171,6 +171,15 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+// No DMA, so the transfer has completed by the time this returns
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    return spi_transmit(data, length);
+}
+
+spi_status_t spi_transmit_wait(void) {
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spi_status_t status;
 
@@ -198,3 +207,10 @@ void spi_stop(void) {
         current_slave_2x     = false;
     }
 }
+
+// Transfers have always completed, so there's nothing to wait for
+void spi_stop_async(void) {
+    spi_stop();
+}
+
+void spi_stop_wait(void) {}
@@ -37,3 +37,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #if (TIMER_RAW_TOP > 255)
 #    error "Timer0 can't count 1ms at this clock freq. Use larger prescaler."
 #endif
+
+// Milliseconds counted by the timer 0 compare interrupt, for code combining it with TIMER_RAW
+extern volatile uint32_t timer_count;
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <ch.h>
+#include <string.h>
 
+#include "compiler_support.h"
 #include "serial.h"
 #include "serial_protocol.h"
 #include "synchronization_util.h"
@@ -10,6 +12,26 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+#if defined(SPLIT_EVENT_PUSH_ENABLE)
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SPLIT_EVENT_PUSH_ENABLE requires SERIAL_USART_FULL_DUPLEX, the slave has to be able to send at any time."
+#    endif
+
+#    if !defined(SERIAL_PUSH_BUFFER_SIZE)
+#        define SERIAL_PUSH_BUFFER_SIZE 64
+#    endif
+
+/* Starts a pushed frame. Handshakes are transaction IDs XORed with NUM_TOTAL_TRANSACTIONS, so they never match it. */
+#    define SERIAL_PUSH_MARKER 0xFF
+STATIC_ASSERT(NUM_TOTAL_TRANSACTIONS <= 0x80, "Too many transactions to tell pushed frames from handshakes");
+
+static uint8_t push_buffer[SERIAL_PUSH_BUFFER_SIZE];
+static uint8_t push_size = 0;
+
+static inline bool receive_push(void);
+static inline void receive_pending_pushes(void);
+#endif
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -100,6 +122,11 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SPLIT_EVENT_PUSH_ENABLE)
+    /* Keep any frames the slave pushed since the last transaction. */
+    receive_pending_pushes();
+#endif
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
@@ -133,7 +160,22 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+        serial_dprintf("SPLIT: receiving handshake failed\n");
+        return false;
+    }
+
+#if defined(SPLIT_EVENT_PUSH_ENABLE)
+    /* The slave may have been pushing a frame when the transaction started, which it finishes before responding. */
+    while (transaction_id_shake == SERIAL_PUSH_MARKER) {
+        if (unlikely(!receive_push() || !serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+            serial_dprintf("SPLIT: receiving handshake failed\n");
+            return false;
+        }
+    }
+#endif
+
+    if (unlikely(transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
@@ -156,3 +198,69 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+
+#if defined(SPLIT_EVENT_PUSH_ENABLE)
+
+/**
+ * @brief Push a frame from the slave half to the master half, outside of any transaction.
+ *
+ * @return bool Indicates success of sending the frame.
+ */
+bool soft_serial_target_push(const uint8_t* data, uint8_t size) {
+    uint8_t header[2] = {SERIAL_PUSH_MARKER, size};
+
+    /* Holding the lock keeps the slave thread from responding to a transaction in the middle of the frame. */
+    split_shared_memory_lock_autounlock();
+
+    return serial_transport_send(header, sizeof(header)) && serial_transport_send(data, size);
+}
+
+/**
+ * @brief Collect the most recent frame pushed by the slave half.
+ *
+ * @return uint8_t Size of the frame, or 0 if none arrived since the last call.
+ */
+uint8_t soft_serial_initiator_receive_push(uint8_t* data, uint8_t size) {
+    receive_pending_pushes();
+
+    uint8_t received = push_size;
+    push_size        = 0;
+    if (received > size) {
+        return 0;
+    }
+    memcpy(data, push_buffer, received);
+    return received;
+}
+
+/**
+ * @brief Receive the rest of a pushed frame, after its marker.
+ */
+static inline bool receive_push(void) {
+    uint8_t size = 0;
+    push_size    = 0;
+    if (unlikely(!serial_transport_receive(&size, sizeof(size)) || size > sizeof(push_buffer))) {
+        serial_dprintf("SPLIT: receiving pushed frame failed\n");
+        return false;
+    }
+    if (unlikely(!serial_transport_receive(push_buffer, size))) {
+        serial_dprintf("SPLIT: receiving pushed frame failed\n");
+        return false;
+    }
+    /* Pushed frames carry state rather than events, so only the most recent one is kept. */
+    push_size = size;
+    return true;
+}
+
+/**
+ * @brief Receive every frame pushed by the slave which is waiting in the queue, discarding anything else.
+ */
+static inline void receive_pending_pushes(void) {
+    uint8_t marker;
+    while (serial_transport_receive_available(&marker)) {
+        if (marker == SERIAL_PUSH_MARKER && unlikely(!receive_push())) {
+            break;
+        }
+    }
+}
+
+#endif
@@ -40,6 +40,14 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Non-blocking receive of a single byte, if one has already arrived.
+ *
+ * @return true Receive success.
+ * @return false Nothing has arrived.
+ */
+bool __attribute__((nonnull)) serial_transport_receive_available(uint8_t* destination);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
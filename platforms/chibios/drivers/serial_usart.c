@@ -165,6 +165,11 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline bool serial_transport_receive_available(uint8_t* destination) {
+    bool success = chnReadTimeout(serial_driver, destination, 1, TIME_IMMEDIATE) == 1;
+    return success;
+}
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
@@ -60,6 +60,8 @@
 #endif
 
 static bool spiStarted = false;
+// Set by spi_stop_async(), while the last transfer finishes with its device still selected
+static bool spiStopPending = false;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t current_slave_pin     = NO_PIN;
 static bool  current_cs_active_low = true;
@@ -125,6 +127,9 @@ __attribute__((weak)) void spi_init(void) {
 }
 
 bool spi_start_extended(spi_start_config_t *start_config) {
+    // Release a device left selected by spi_stop_async(), so the next one doesn't have to know about it
+    spi_stop_wait();
+
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
     spiAcquireBus(&SPI_DRIVER);
 #endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
@@ -438,6 +443,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 
 spi_status_t spi_write(uint8_t data) {
     uint8_t rxData;
+    spi_transmit_wait();
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
     return rxData;
@@ -445,23 +451,51 @@ spi_status_t spi_write(uint8_t data) {
 
 spi_status_t spi_read(void) {
     uint8_t data = 0;
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, 1, &data);
 
     return data;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+#if (SPI_USE_WAIT == TRUE)
+    // Sleep until the end of transfer interrupt wakes this thread, as spiSend() does. The state is checked under the
+    // lock, so the interrupt can't complete the transfer between the check and suspending.
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        _spi_wait_s(&SPI_DRIVER);
+    }
+    osalSysUnlock();
+#else
+    // The driver leaves the active state from its interrupt, once the DMA transfer has completed
+    while (*(volatile spistate_t *)&SPI_DRIVER.state == SPI_ACTIVE) {
+    }
+#endif
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
+    spiStopPending = false;
     if (spiStarted) {
+        spi_transmit_wait();
         spi_unselect();
         spiStop(&SPI_DRIVER);
         spiStarted = false;
@@ -471,3 +505,20 @@ void spi_stop(void) {
     spiReleaseBus(&SPI_DRIVER);
 #endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
 }
+
+void spi_stop_async(void) {
+#if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
+    // The bus has to be released by the thread which acquired it, which the next spi_start() may not be
+    spi_stop();
+#else
+    if (spiStarted) {
+        spiStopPending = true;
+    }
+#endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
+}
+
+void spi_stop_wait(void) {
+    if (spiStopPending) {
+        spi_stop();
+    }
+}
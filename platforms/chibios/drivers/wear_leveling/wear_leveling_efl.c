@@ -101,6 +101,26 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    // Consolidation erases one bank while the other is live, so a sector has to start exactly where the second bank
+    // does, and none may cross into it
+    bool bank_aligned = false;
+    for (flash_sector_t i = 0; sector_count != UINT16_MAX && i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t       size   = flashGetSectorSize(flash, first_sector + i);
+        if (offset == (WEAR_LEVELING_BANK_SIZE)) {
+            bank_aligned = true;
+        } else if (offset < (WEAR_LEVELING_BANK_SIZE) && offset + size > (WEAR_LEVELING_BANK_SIZE)) {
+            bank_aligned = false;
+            break;
+        }
+    }
+    if (!bank_aligned) {
+        bs_dprintf("Banks do not fall on sector boundaries\n");
+        return false;
+    }
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
     return true;
 }
 
@@ -134,6 +154,39 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    // Sector sizes vary on some MCUs, so erase the sectors lying within the range, which has to be made up of whole
+    // sectors -- erasing one which reaches outside of it could wipe the live bank
+    bool          ret     = true;
+    uint32_t      covered = 0;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t       size   = flashGetSectorSize(flash, first_sector + i);
+        if (offset + size <= address || offset >= address + length) {
+            continue;
+        }
+        if (offset < address || offset + size > address + length) {
+            bs_dprintf("Sector %d crosses the erase range\n", (int)(first_sector + i));
+            return false;
+        }
+        covered += size;
+
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+    return ret && covered == length;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -45,6 +45,16 @@
 #    endif
 #endif
 
+// Double-banked consolidation erases a sector per step where the sector size is fixed (from some family's
+// stm32_registry.h), otherwise a whole bank -- which has to be made up of whole sectors either way
+#ifndef BACKING_STORE_ERASE_SIZE
+#    if defined(STM32_FLASH_SECTOR_SIZE)
+#        define BACKING_STORE_ERASE_SIZE (STM32_FLASH_SECTOR_SIZE)
+#    else
+#        define BACKING_STORE_ERASE_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
+#endif
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
@@ -37,6 +37,20 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    STATIC_ASSERT((WEAR_LEVELING_ERASE_STEP_SIZE) % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == 0, "Erase step size must be a multiple of the flash page size");
+
+    bool ret = true;
+    for (uint32_t offset = 0; offset < length; offset += (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE)) {
+        if (FLASH_ErasePage(WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS + address + offset) != FLASH_COMPLETE) {
+            ret = false;
+        }
+    }
+    return ret;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
@@ -70,8 +70,11 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #    define TOTAL_EEPROM_BYTE_COUNT 4096
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef LEGACY_FLASH_OPS_MOCKED
-// Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+// Normal tests, suites exercising larger NVM layouts may set their own size
+#        ifndef TEST_EEPROM_SIZE
+#            define TEST_EEPROM_SIZE 32
+#        endif
+#        define TOTAL_EEPROM_BYTE_COUNT (TEST_EEPROM_SIZE)
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_legacy_emulated_flash_tests.h"
@@ -0,0 +1,48 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gpio.h"
+
+static bool levels[256];
+static bool outputs[256];
+
+__attribute__((weak)) void gpio_mock_pin_changed(pin_t pin, bool level) {}
+
+void(gpio_set_pin_input)(pin_t pin) {
+    outputs[pin] = false;
+    levels[pin]  = false;
+}
+
+void(gpio_set_pin_input_high)(pin_t pin) {
+    outputs[pin] = false;
+    levels[pin]  = true;
+}
+
+void(gpio_set_pin_input_low)(pin_t pin) {
+    outputs[pin] = false;
+    levels[pin]  = false;
+}
+
+void(gpio_set_pin_output_push_pull)(pin_t pin) {
+    outputs[pin] = true;
+}
+
+void(gpio_set_pin_output_open_drain)(pin_t pin) {
+    outputs[pin] = true;
+}
+
+void(gpio_write_pin)(pin_t pin, bool level) {
+    bool changed = levels[pin] != level;
+    levels[pin]  = level;
+    if (outputs[pin] && changed) {
+        gpio_mock_pin_changed(pin, level);
+    }
+}
+
+bool(gpio_read_pin)(pin_t pin) {
+    return levels[pin];
+}
+
+void(gpio_toggle_pin)(pin_t pin) {
+    (gpio_write_pin)(pin, !levels[pin]);
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "i2c_master.h"
+#include "i2c_mock.h"
+
+static i2c_mock_config_t   config;
+static i2c_mock_receiver_t receiver;
+static i2c_mock_stats_t    stats;
+static uint8_t             register_write[UINT16_MAX + 2];
+
+static void i2c_mock_transaction(uint32_t length) {
+    stats.transactions++;
+    stats.bytes += length;
+    if (config.clock_hz) {
+        // Start and stop conditions, the address byte and each data byte, with acknowledge bits
+        stats.busy_ns += (uint64_t)(2 + (length + 1) * 9) * 1000000000 / config.clock_hz;
+    }
+}
+
+static i2c_status_t i2c_mock_write(uint8_t address, const uint8_t *data, uint16_t length) {
+    i2c_mock_transaction(length);
+    if (receiver) {
+        receiver(address, data, length);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+static i2c_status_t i2c_mock_read(uint8_t *data, uint16_t length) {
+    i2c_mock_transaction(length);
+    memset(data, 0, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+void i2c_mock_configure(const i2c_mock_config_t *new_config, i2c_mock_receiver_t new_receiver) {
+    config   = *new_config;
+    receiver = new_receiver;
+}
+
+const i2c_mock_stats_t *i2c_mock_get_stats(void) {
+    return &stats;
+}
+
+void i2c_mock_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return i2c_mock_write(address, data, length);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return i2c_mock_read(data, length);
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    register_write[0] = regaddr;
+    memcpy(&register_write[1], data, length);
+    return i2c_mock_write(devaddr, register_write, length + 1);
+}
+
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    register_write[0] = regaddr >> 8;
+    register_write[1] = regaddr & 0xFF;
+    memcpy(&register_write[2], data, length);
+    return i2c_mock_write(devaddr, register_write, length + 2);
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_mock_transaction(1);
+    return i2c_mock_read(data, length);
+}
+
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_mock_transaction(2);
+    return i2c_mock_read(data, length);
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    i2c_mock_transaction(0);
+    return I2C_STATUS_SUCCESS;
+}
@@ -0,0 +1,34 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2c_master.h"
+
+/**
+ * Host-side I2C master which hands each write transaction to a receiver, such as a model of a display controller.
+ *
+ * Transactions complete immediately. The time they would have taken on the bus is modelled from the configured clock,
+ * counting nine bits per byte including the address, plus the start and stop conditions. Reads return zeros and every
+ * address acknowledges.
+ */
+
+typedef struct i2c_mock_config_t {
+    uint32_t clock_hz; // 0 for an instantaneous bus
+} i2c_mock_config_t;
+
+typedef struct i2c_mock_stats_t {
+    uint32_t transactions; // Writes and reads, each from start to stop condition
+    uint32_t bytes;        // Bytes written or read, not counting the address
+    uint64_t busy_ns;      // Modelled time the bus spent busy
+} i2c_mock_stats_t;
+
+// Receives the bytes following the address of a write, including the register address for register writes
+typedef void (*i2c_mock_receiver_t)(uint8_t address, const uint8_t *data, uint16_t length);
+
+void                    i2c_mock_configure(const i2c_mock_config_t *config, i2c_mock_receiver_t receiver);
+const i2c_mock_stats_t *i2c_mock_get_stats(void);
+void                    i2c_mock_reset_stats(void);
@@ -0,0 +1,227 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "color.h"
+#include "qp_comms.h"
+#include "qp_draw.h"
+#include "qp_test_display.h"
+
+static test_display_painter_device_t test_display_drivers[QP_TEST_DISPLAY_NUM_DEVICES];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers
+
+static inline bool test_display_is_rotated(painter_driver_t *driver) {
+    return driver->rotation == QP_ROTATION_90 || driver->rotation == QP_ROTATION_270;
+}
+
+uint16_t qp_test_display_width(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return test_display_is_rotated(driver) ? driver->panel_height : driver->panel_width;
+}
+
+uint16_t qp_test_display_height(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return test_display_is_rotated(driver) ? driver->panel_width : driver->panel_height;
+}
+
+static void test_display_write_pixel(test_display_painter_device_t *display, const uint8_t *rgb888) {
+    uint16_t w = qp_test_display_width(display);
+    uint16_t h = qp_test_display_height(display);
+    uint16_t x = display->pixdata_x;
+    uint16_t y = display->pixdata_y;
+
+    if (x < w && y < h) {
+        memcpy(&display->framebuffer[((uint32_t)y * w + x) * 3], rgb888, 3);
+    } else {
+        display->stats.clipped++;
+    }
+
+    // Move along the window as a panel's address counter would, wrapping back to the top
+    if (++display->pixdata_x > display->viewport.right) {
+        display->pixdata_x = display->viewport.left;
+        if (++display->pixdata_y > display->viewport.bottom) {
+            display->pixdata_y = display->viewport.top;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Comms vtable, nothing is sent anywhere
+
+static bool test_display_comms_init(painter_device_t device) {
+    return true;
+}
+
+static bool test_display_comms_start(painter_device_t device) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    display->stats.sessions++;
+    return true;
+}
+
+static bool test_display_comms_stop(painter_device_t device) {
+    return true;
+}
+
+static uint32_t test_display_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    display->stats.bytes += byte_count;
+    return byte_count;
+}
+
+static const painter_comms_vtable_t test_display_comms_vtable = {
+    .comms_init  = test_display_comms_init,
+    .comms_start = test_display_comms_start,
+    .comms_stop  = test_display_comms_stop,
+    .comms_send  = test_display_comms_send,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+static bool qp_test_display_init(painter_device_t device, painter_rotation_t rotation) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    memset(display->framebuffer, 0, QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(display->base.panel_width, display->base.panel_height));
+    display->power_on = true;
+    qp_test_display_reset_stats(device);
+    return true;
+}
+
+static bool qp_test_display_power(painter_device_t device, bool power_on) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    display->power_on                      = power_on;
+    return true;
+}
+
+static bool qp_test_display_clear(painter_device_t device) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    memset(display->framebuffer, 0, QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(display->base.panel_width, display->base.panel_height));
+    return true;
+}
+
+static bool qp_test_display_flush(painter_device_t device) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    display->stats.flushes++;
+    return true;
+}
+
+static bool qp_test_display_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    qp_test_display_viewport_t     rect    = {.left = left, .top = top, .right = right, .bottom = bottom};
+
+    if (display->stats.viewports < QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE) {
+        display->viewport_log[display->stats.viewports] = rect;
+    }
+    display->stats.viewports++;
+    display->stats.bytes += QP_TEST_DISPLAY_VIEWPORT_BYTES;
+
+    display->viewport  = rect;
+    display->pixdata_x = left;
+    display->pixdata_y = top;
+    return true;
+}
+
+static bool qp_test_display_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    const uint8_t *                rgb888  = (const uint8_t *)pixel_data;
+
+    display->stats.pixdata++;
+    display->stats.pixels += native_pixel_count;
+    for (uint32_t i = 0; i < native_pixel_count; ++i) {
+        test_display_write_pixel(display, &rgb888[i * 3]);
+    }
+    return qp_comms_send(device, pixel_data, native_pixel_count * 3) == native_pixel_count * 3;
+}
+
+static bool qp_test_display_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    display->stats.converted += palette_size;
+    for (int16_t i = 0; i < palette_size; ++i) {
+        rgb_t rgb           = hsv_to_rgb_nocie((hsv_t){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        palette[i].rgb888.r = rgb.r;
+        palette[i].rgb888.g = rgb.g;
+        palette[i].rgb888.b = rgb.b;
+    }
+    return true;
+}
+
+static bool qp_test_display_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        target_buffer[(pixel_offset + i) * 3 + 0] = palette[palette_indices[i]].rgb888.r;
+        target_buffer[(pixel_offset + i) * 3 + 1] = palette[palette_indices[i]].rgb888.g;
+        target_buffer[(pixel_offset + i) * 3 + 2] = palette[palette_indices[i]].rgb888.b;
+    }
+    return true;
+}
+
+static bool qp_test_display_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+static bool qp_test_display_append_pixel_run(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    qp_pixel_t pixel = palette[palette_index];
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        target_buffer[(pixel_offset + i) * 3 + 0] = pixel.rgb888.r;
+        target_buffer[(pixel_offset + i) * 3 + 1] = pixel.rgb888.g;
+        target_buffer[(pixel_offset + i) * 3 + 2] = pixel.rgb888.b;
+    }
+    return true;
+}
+
+static const painter_driver_vtable_t test_display_driver_vtable = {
+    .init             = qp_test_display_init,
+    .power            = qp_test_display_power,
+    .clear            = qp_test_display_clear,
+    .flush            = qp_test_display_flush,
+    .pixdata          = qp_test_display_pixdata,
+    .viewport         = qp_test_display_viewport,
+    .palette_convert  = qp_test_display_palette_convert,
+    .append_pixels    = qp_test_display_append_pixels,
+    .append_pixdata   = qp_test_display_append_pixdata,
+    .append_pixel_run = qp_test_display_append_pixel_run,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory and stats
+
+painter_device_t qp_test_display_make_device(uint16_t panel_width, uint16_t panel_height, uint8_t *framebuffer) {
+    for (uint32_t i = 0; i < QP_TEST_DISPLAY_NUM_DEVICES; ++i) {
+        test_display_painter_device_t *driver = &test_display_drivers[i];
+        if (!driver->base.driver_vtable) {
+            driver->base.driver_vtable         = &test_display_driver_vtable;
+            driver->base.comms_vtable          = &test_display_comms_vtable;
+            driver->base.native_bits_per_pixel = 24; // RGB888
+            driver->base.panel_width           = panel_width;
+            driver->base.panel_height          = panel_height;
+            driver->base.rotation              = QP_ROTATION_0;
+            driver->base.offset_x              = 0;
+            driver->base.offset_y              = 0;
+            driver->framebuffer                = framebuffer;
+            return (painter_device_t)driver;
+        }
+    }
+    return NULL;
+}
+
+void qp_test_display_release_device(painter_device_t device) {
+    memset((test_display_painter_device_t *)device, 0, sizeof(test_display_painter_device_t));
+}
+
+const qp_test_display_stats_t *qp_test_display_get_stats(painter_device_t device) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    return &display->stats;
+}
+
+void qp_test_display_reset_stats(painter_device_t device) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    memset(&display->stats, 0, sizeof(display->stats));
+}
+
+const qp_test_display_viewport_t *qp_test_display_get_viewports(painter_device_t device, uint32_t *count) {
+    test_display_painter_device_t *display = (test_display_painter_device_t *)device;
+    *count                                 = QP_MIN(display->stats.viewports, QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE);
+    return display->viewport_log;
+}
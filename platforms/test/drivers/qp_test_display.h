@@ -0,0 +1,87 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qp_internal.h"
+
+/**
+ * Host-side Quantum Painter device, drawing into an RGB888 framebuffer in memory instead of onto a panel.
+ *
+ * The framebuffer is laid out as the display is seen, after rotation, three bytes per pixel in R, G, B order. Alongside
+ * the pixels it counts what a real panel would have been sent: the viewports set, and the bytes that would have gone
+ * over SPI to an ILI9xxx-style controller at 24bpp, window commands included. Those counts are deterministic, unlike
+ * timings on the host, so they can be asserted on to catch drawing routines which start sending more than they used to.
+ */
+
+#ifndef QP_TEST_DISPLAY_NUM_DEVICES
+#    define QP_TEST_DISPLAY_NUM_DEVICES 2
+#endif // QP_TEST_DISPLAY_NUM_DEVICES
+
+#ifndef QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE
+#    define QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE 64
+#endif // QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE
+
+#define QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(w, h) ((uint32_t)(w) * (uint32_t)(h) * 3)
+
+// Bytes sent to set a window on an ILI9xxx: column and row address commands with 16-bit bounds, then memory write
+#define QP_TEST_DISPLAY_VIEWPORT_BYTES 11
+
+typedef struct qp_test_display_viewport_t {
+    uint16_t left;
+    uint16_t top;
+    uint16_t right;
+    uint16_t bottom;
+} qp_test_display_viewport_t;
+
+typedef struct qp_test_display_stats_t {
+    uint32_t viewports; // Viewports set
+    uint32_t pixdata;   // Calls streaming pixel data
+    uint32_t pixels;    // Pixels streamed
+    uint32_t clipped;   // Pixels streamed which fell outside the display
+    uint32_t bytes;     // Bytes a panel would have been sent for the above
+    uint32_t flushes;   // Calls to qp_flush
+    uint32_t sessions;  // Comms sessions started
+    uint32_t converted; // Palette entries converted to the native pixel format
+} qp_test_display_stats_t;
+
+typedef struct test_display_painter_device_t {
+    painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+
+    uint8_t *framebuffer;
+    bool     power_on;
+
+    // Current window, and the write location within it
+    qp_test_display_viewport_t viewport;
+    uint16_t                   pixdata_x;
+    uint16_t                   pixdata_y;
+
+    qp_test_display_stats_t    stats;
+    qp_test_display_viewport_t viewport_log[QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE]; // the first viewports set since the stats were reset
+} test_display_painter_device_t;
+
+/**
+ * Factory method for a test display.
+ *
+ * @param panel_width[in] the width of the display, before rotation
+ * @param panel_height[in] the height of the display, before rotation
+ * @param framebuffer[in] pointer to a preallocated buffer of size `QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(panel_width, panel_height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_test_display_make_device(uint16_t panel_width, uint16_t panel_height, uint8_t *framebuffer);
+
+// Frees up the device slot, so that the tests can make displays of different sizes
+void qp_test_display_release_device(painter_device_t device);
+
+// Width and height of the framebuffer as laid out, which are swapped from the panel's when rotated by 90 or 270 degrees
+uint16_t qp_test_display_width(painter_device_t device);
+uint16_t qp_test_display_height(painter_device_t device);
+
+const qp_test_display_stats_t *qp_test_display_get_stats(painter_device_t device);
+void                           qp_test_display_reset_stats(painter_device_t device);
+
+// Returns the viewports logged since the stats were last reset, at most QP_TEST_DISPLAY_VIEWPORT_LOG_SIZE of them
+const qp_test_display_viewport_t *qp_test_display_get_viewports(painter_device_t device, uint32_t *count);
@@ -0,0 +1,197 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_loopback.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+
+static split_shared_memory_t   other_half;
+static serial_loopback_link_t  link;
+static serial_loopback_stats_t stats;
+static uint32_t                random_state = 1;
+static uint32_t                pending_us;
+
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+static uint8_t  pushed[UINT8_MAX];
+static uint8_t  pushed_size;
+static uint64_t pushed_arrival_us;
+#endif
+
+static uint32_t serial_loopback_random(void) {
+    // xorshift32, so that runs are repeatable for a given seed
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static bool serial_loopback_chance(uint32_t ppm) {
+    return ppm > 0 && serial_loopback_random() % 1000000 < ppm;
+}
+
+// Flips bits in the buffer at the configured error rate, returns true if any were
+static bool serial_loopback_corrupt(uint8_t *data, uint8_t length) {
+    bool corrupted = false;
+    if (link.bit_error_ppm == 0) return false;
+    for (uint16_t bit = 0; bit < length * 8; ++bit) {
+        if (serial_loopback_chance(link.bit_error_ppm)) {
+            if (data) {
+                data[bit / 8] ^= 1 << (bit % 8);
+            }
+            corrupted = true;
+        }
+    }
+    return corrupted;
+}
+
+static uint32_t serial_loopback_bytes_us(uint32_t bytes) {
+    return link.baud ? (uint32_t)((uint64_t)bytes * 10 * 1000000 / link.baud) : 0;
+}
+
+// Swaps the running half's shared memory with the other half's copy
+static void serial_loopback_swap(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &other_half, sizeof(split_shared_memory_t));
+    memcpy(&other_half, &temp, sizeof(split_shared_memory_t));
+}
+
+void serial_loopback_reset(void) {
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&other_half, 0, sizeof(other_half));
+    memset(&link, 0, sizeof(link));
+    random_state = 1;
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+    pushed_size = 0;
+#endif
+    serial_loopback_reset_stats();
+}
+
+const serial_loopback_stats_t *serial_loopback_get_stats(void) {
+    return &stats;
+}
+
+void serial_loopback_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+    pending_us = 0;
+}
+
+void serial_loopback_set_link(const serial_loopback_link_t *new_link, uint32_t seed) {
+    link         = *new_link;
+    random_state = seed ? seed : 1;
+}
+
+void serial_loopback_advance_us(uint32_t us) {
+    stats.elapsed_us += us;
+    pending_us += us;
+    if (pending_us >= 1000) {
+        advance_time(pending_us / 1000);
+        pending_us %= 1000;
+    }
+}
+
+void serial_loopback_run_target(void (*fn)(void)) {
+    serial_loopback_swap();
+    fn();
+    serial_loopback_swap();
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    if (index < 0 || index >= NUM_TOTAL_TRANSACTIONS) return false;
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    uint8_t                   buffer[UINT8_MAX];
+    bool                      corrupted = false;
+
+    stats.transactions++;
+
+    // The transaction ID and its acknowledgement, which both drivers check
+    stats.bytes += 2;
+    serial_loopback_advance_us(serial_loopback_bytes_us(2) + link.turnaround_us);
+    // A dropped transaction loses either the request or the response, the initiator waits it out either way
+    bool dropped      = serial_loopback_chance(link.drop_ppm);
+    bool request_lost = dropped && (serial_loopback_random() & 1);
+    if (request_lost || serial_loopback_corrupt(NULL, 2)) {
+        stats.failures++;
+        serial_loopback_advance_us(link.timeout_us);
+        return false;
+    }
+
+    memcpy(buffer, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    corrupted |= serial_loopback_corrupt(buffer, trans->initiator2target_buffer_size);
+    stats.bytes += trans->initiator2target_buffer_size;
+    serial_loopback_advance_us(serial_loopback_bytes_us(trans->initiator2target_buffer_size) + link.turnaround_us);
+    if (corrupted && link.checksummed) {
+        stats.failures++;
+        serial_loopback_advance_us(link.timeout_us);
+        return false;
+    }
+
+    serial_loopback_swap();
+    memcpy(split_trans_initiator2target_buffer(trans), buffer, trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    memcpy(buffer, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    serial_loopback_swap();
+
+    // The target has acted upon the request, but the response never arrives
+    if (dropped) {
+        stats.failures++;
+        serial_loopback_advance_us(link.timeout_us);
+        return false;
+    }
+
+    corrupted |= serial_loopback_corrupt(buffer, trans->target2initiator_buffer_size);
+    stats.bytes += trans->target2initiator_buffer_size;
+    serial_loopback_advance_us(serial_loopback_bytes_us(trans->target2initiator_buffer_size));
+    if (corrupted && link.checksummed) {
+        stats.failures++;
+        return false;
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), buffer, trans->target2initiator_buffer_size);
+
+    if (corrupted) {
+        stats.corruptions++;
+    }
+    return true;
+}
+
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+
+bool soft_serial_target_push(const uint8_t *data, uint8_t size) {
+    // The marker and size, then the data, on the target's own line so that the initiator isn't held up by it
+    stats.pushes++;
+    stats.bytes += 2 + size;
+    // A lost push goes unnoticed by the target
+    if (serial_loopback_chance(link.drop_ppm) || serial_loopback_corrupt(NULL, 2)) {
+        return true;
+    }
+
+    memcpy(pushed, data, size);
+    if (serial_loopback_corrupt(pushed, size)) {
+        stats.corruptions++;
+    }
+    pushed_size       = size;
+    pushed_arrival_us = stats.elapsed_us + serial_loopback_bytes_us(2 + size);
+    return true;
+}
+
+uint8_t soft_serial_initiator_receive_push(uint8_t *data, uint8_t size) {
+    if (pushed_size == 0 || stats.elapsed_us < pushed_arrival_us) return 0;
+
+    uint8_t received = pushed_size;
+    pushed_size      = 0;
+    if (received > size) return 0;
+    memcpy(data, pushed, received);
+    return received;
+}
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transport.h"
+
+/**
+ * Host-side serial transport which connects both halves of a split keyboard within the one process.
+ *
+ * Each half has its own copy of the split shared memory; `split_shmem` always refers to the half which is currently
+ * running, which is the master unless inside serial_loopback_run_target(). Transactions copy the initiator to target
+ * buffer across, run the slave callback against the target's copy, and copy the target to initiator buffer back.
+ *
+ * The link between the halves is simulated: each transaction takes time according to the configured baud rate and
+ * turnaround latency, which advances the keyboard timer, and may be dropped or have bits corrupted.
+ *
+ * With SPLIT_EVENT_PUSH_ENABLE, frames pushed by the target arrive at the initiator once they'd have been sent, as
+ * on a full-duplex link, and are subject to the same errors.
+ */
+
+typedef struct serial_loopback_link_t {
+    uint32_t baud;          // Bits per second, with 10 bits per byte; 0 for an instantaneous link
+    uint32_t turnaround_us; // Added each time the link changes direction, twice per transaction
+    uint32_t timeout_us;    // Time the initiator waits for a dropped transaction
+    uint32_t bit_error_ppm; // Chance of each bit being flipped, in parts per million
+    uint32_t drop_ppm;      // Chance of each transaction being dropped, in parts per million
+    bool     checksummed;   // Corrupted data fails the transaction, as with the bitbang drivers, rather than arriving
+} serial_loopback_link_t;
+
+typedef struct serial_loopback_stats_t {
+    uint32_t transactions; // Number of round trips, including failed ones
+    uint32_t failures;     // Round trips which returned failure to the initiator
+    uint32_t corruptions;  // Round trips or pushes which delivered corrupted data
+    uint32_t pushes;       // Frames pushed by the target, including lost ones
+    uint32_t bytes;        // Bytes sent in both directions, including the transaction ID and its acknowledgement
+    uint64_t elapsed_us;   // Simulated time, both for the link and serial_loopback_advance_us()
+} serial_loopback_stats_t;
+
+void                           serial_loopback_reset(void);
+const serial_loopback_stats_t *serial_loopback_get_stats(void);
+void                           serial_loopback_reset_stats(void);
+
+// Configures the simulated link, and seeds its error injection
+void serial_loopback_set_link(const serial_loopback_link_t *link, uint32_t seed);
+
+// Advances the simulated time, e.g. for the rest of a scan, together with the keyboard timer
+void serial_loopback_advance_us(uint32_t us);
+
+// Runs the supplied function as the target half, e.g. to call transactions_slave()
+void serial_loopback_run_target(void (*fn)(void));
@@ -0,0 +1,224 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include <time.h>
+
+#include "spi_master.h"
+#include "spi_mock.h"
+
+void advance_time(uint32_t ms);
+
+static spi_mock_config_t   config;
+static spi_mock_receiver_t receiver;
+static spi_mock_stats_t    stats;
+static uint64_t            host_ns;
+static uint64_t            pending_ns;
+static bool                started;
+static bool                stop_pending;
+
+// The transfer on the bus, and a copy of its data as it was started
+static const uint8_t *transfer_data;
+static uint16_t       transfer_length;
+static uint64_t       transfer_end_ns;
+static bool           transfer_dc;
+static uint8_t        transfer_copy[UINT16_MAX];
+
+static uint64_t spi_mock_host_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static uint64_t spi_mock_bytes_ns(uint32_t length) {
+    return config.clock_hz ? (uint64_t)length * 8 * 1000000000 / config.clock_hz : 0;
+}
+
+static void spi_mock_advance_ns(uint64_t ns) {
+    stats.elapsed_ns += ns;
+    pending_ns += ns;
+    if (pending_ns >= 1000000) {
+        advance_time(pending_ns / 1000000);
+        pending_ns %= 1000000;
+    }
+}
+
+static void spi_mock_deliver(const uint8_t *data, uint16_t length, bool dc) {
+    for (uint16_t i = 0; receiver && i < length; ++i) {
+        receiver(data[i], dc);
+    }
+}
+
+static void spi_mock_complete(void) {
+    if (!transfer_data) return;
+    if (memcmp(transfer_data, transfer_copy, transfer_length) != 0) {
+        stats.corruptions++;
+    }
+    spi_mock_deliver(transfer_data, transfer_length, transfer_dc);
+    transfer_data = NULL;
+}
+
+// Brings modelled time up to date with the host on entry to the mock, completing the transfer if it's had time to
+static void spi_mock_enter(void) {
+    uint64_t now = spi_mock_host_ns();
+    if (host_ns && config.cpu_scale) {
+        stats.cpu_ns += (now - host_ns) * config.cpu_scale;
+        spi_mock_advance_ns((now - host_ns) * config.cpu_scale);
+    }
+    if (transfer_data && stats.elapsed_ns >= transfer_end_ns) {
+        spi_mock_complete();
+    }
+}
+
+// Time spent in the mock, including the receiver, isn't the caller's
+static void spi_mock_leave(void) {
+    host_ns = spi_mock_host_ns();
+}
+
+static void spi_mock_wait(void) {
+    if (!transfer_data) return;
+    stats.waits++;
+    spi_mock_advance_ns(transfer_end_ns - stats.elapsed_ns);
+    spi_mock_complete();
+}
+
+static void spi_mock_send(const uint8_t *data, uint16_t length, bool blocking) {
+    spi_mock_wait();
+    uint64_t ns = spi_mock_bytes_ns(length);
+    stats.transfers++;
+    stats.bytes += length;
+    stats.busy_ns += ns;
+
+    bool dc = config.dc_pin != NO_PIN && gpio_read_pin(config.dc_pin);
+    if (blocking) {
+        spi_mock_advance_ns(ns);
+        spi_mock_deliver(data, length, dc);
+        return;
+    }
+    memcpy(transfer_copy, data, length);
+    transfer_data   = data;
+    transfer_length = length;
+    transfer_end_ns = stats.elapsed_ns + ns;
+    transfer_dc     = dc;
+}
+
+void gpio_mock_pin_changed(pin_t pin, bool level) {
+    spi_mock_enter();
+    if (transfer_data) {
+        stats.pin_changes++;
+    }
+    spi_mock_leave();
+}
+
+void spi_mock_configure(const spi_mock_config_t *new_config, spi_mock_receiver_t new_receiver) {
+    spi_mock_enter();
+    spi_mock_wait();
+    config   = *new_config;
+    receiver = new_receiver;
+    spi_mock_leave();
+}
+
+const spi_mock_stats_t *spi_mock_get_stats(void) {
+    spi_mock_enter();
+    spi_mock_leave();
+    return &stats;
+}
+
+void spi_mock_reset_stats(void) {
+    spi_mock_enter();
+    spi_mock_wait();
+    memset(&stats, 0, sizeof(stats));
+    spi_mock_leave();
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    spi_start_config_t start_config = {0};
+    start_config.slave_pin          = slavePin;
+    start_config.lsb_first          = lsbFirst;
+    start_config.mode               = mode;
+    start_config.divisor            = divisor;
+    start_config.cs_active_low      = true;
+    return spi_start_extended(&start_config);
+}
+
+bool spi_start_extended(spi_start_config_t *start_config) {
+    spi_stop_wait();
+    // As on hardware, the bus can't be started again until whoever has it stops
+    if (started) {
+        return false;
+    }
+    started = true;
+    spi_mock_enter();
+    spi_mock_wait();
+    if (start_config->slave_pin != NO_PIN) {
+        gpio_set_pin_output(start_config->slave_pin);
+        gpio_write_pin(start_config->slave_pin, !start_config->cs_active_low);
+    }
+    spi_mock_leave();
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    spi_mock_enter();
+    spi_mock_send(&data, 1, true);
+    spi_mock_leave();
+    return 0;
+}
+
+spi_status_t spi_read(void) {
+    spi_mock_enter();
+    spi_mock_wait();
+    spi_mock_advance_ns(spi_mock_bytes_ns(1));
+    spi_mock_leave();
+    return 0;
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_mock_enter();
+    spi_mock_send(data, length, true);
+    spi_mock_leave();
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_mock_enter();
+    spi_mock_send(data, length, !config.dma);
+    spi_mock_leave();
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+    spi_mock_enter();
+    spi_mock_wait();
+    spi_mock_leave();
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_mock_enter();
+    spi_mock_wait();
+    spi_mock_advance_ns(spi_mock_bytes_ns(length));
+    memset(data, 0, length);
+    spi_mock_leave();
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    spi_mock_enter();
+    spi_mock_wait();
+    spi_mock_leave();
+    started      = false;
+    stop_pending = false;
+}
+
+void spi_stop_async(void) {
+    stop_pending = started;
+}
+
+void spi_stop_wait(void) {
+    if (stop_pending) {
+        spi_stop();
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "spi_master.h"
+
+/**
+ * Host-side SPI master which hands the bytes sent to a receiver, such as a model of a display controller.
+ *
+ * Time is modelled rather than measured: each transfer occupies the bus for as long as it would at the configured
+ * clock, and time spent outside SPI calls is taken from the host clock, scaled up to approximate a slower MCU. The
+ * keyboard timer advances along with it.
+ *
+ * With DMA enabled, spi_transmit_async() returns as soon as the transfer starts, as on ChibiOS. Its data is handed to
+ * the receiver once the transfer would have completed, as it is then, so that a caller modifying a buffer still on
+ * the bus sees the corruption on the display it would on hardware.
+ */
+
+typedef struct spi_mock_config_t {
+    uint32_t clock_hz;  // 0 for an instantaneous bus
+    uint32_t cpu_scale; // How many times slower than the host the modelled MCU is, 0 to ignore time outside SPI calls
+    bool     dma;       // spi_transmit_async() returns before the transfer completes, otherwise it blocks as on AVR
+    pin_t    dc_pin;    // Passed to the receiver with each byte, for displays with a D/C pin
+} spi_mock_config_t;
+
+typedef struct spi_mock_stats_t {
+    uint32_t transfers;   // Calls which sent data, including single bytes
+    uint32_t bytes;       // Bytes sent
+    uint32_t waits;       // Times a caller had to wait for a transfer still on the bus
+    uint32_t corruptions; // Transfers whose data changed before they completed
+    uint32_t pin_changes; // Output pins which changed level while a transfer was on the bus, such as D/C or CS
+    uint64_t elapsed_ns;  // Modelled time, both on the bus and outside SPI calls
+    uint64_t busy_ns;     // Modelled time the bus spent sending
+    uint64_t cpu_ns;      // Modelled time spent outside SPI calls
+} spi_mock_stats_t;
+
+typedef void (*spi_mock_receiver_t)(uint8_t byte, bool dc);
+
+// Sets up the modelled bus, waiting for anything still in flight first
+void                    spi_mock_configure(const spi_mock_config_t *config, spi_mock_receiver_t receiver);
+const spi_mock_stats_t *spi_mock_get_stats(void);
+void                    spi_mock_reset_stats(void);
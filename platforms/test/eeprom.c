@@ -15,57 +15,90 @@
  */
 
 #include "eeprom.h"
+#include "eeprom_test_harness.h"
+#include <string.h>
+#include <time.h>
 
 static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
 
+static test_eeprom_stats_t stats;
+static uint32_t            transaction_latency_ns = 0;
+
+void test_eeprom_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+const test_eeprom_stats_t *test_eeprom_get_stats(void) {
+    return &stats;
+}
+
+void test_eeprom_set_transaction_latency_ns(uint32_t ns) {
+    transaction_latency_ns = ns;
+}
+
+static void wait_transaction(void) {
+    if (transaction_latency_ns == 0) {
+        return;
+    }
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ull + now.tv_nsec - start.tv_nsec < transaction_latency_ns);
+}
+
+static void read_transaction(void *buf, const void *addr, size_t len) {
+    wait_transaction();
+    stats.read_transactions++;
+    stats.bytes_read += len;
+    memcpy(buf, &buffer[(uintptr_t)addr], len);
+}
+
+static void write_transaction(const void *buf, void *addr, size_t len) {
+    wait_transaction();
+    stats.write_transactions++;
+    stats.bytes_written += len;
+    memcpy(&buffer[(uintptr_t)addr], buf, len);
+}
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
-    uintptr_t offset = (uintptr_t)addr;
-    return buffer[offset];
+    uint8_t value;
+    read_transaction(&value, addr, 1);
+    return value;
 }
 
 void eeprom_write_byte(uint8_t *addr, uint8_t value) {
-    uintptr_t offset = (uintptr_t)addr;
-    buffer[offset]   = value;
+    write_transaction(&value, addr, 1);
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr) {
-    const uint8_t *p = (const uint8_t *)addr;
-    return eeprom_read_byte(p) | (eeprom_read_byte(p + 1) << 8);
+    uint8_t p[2];
+    read_transaction(p, addr, sizeof(p));
+    return p[0] | (p[1] << 8);
 }
 
 uint32_t eeprom_read_dword(const uint32_t *addr) {
-    const uint8_t *p = (const uint8_t *)addr;
-    return eeprom_read_byte(p) | (eeprom_read_byte(p + 1) << 8) | (eeprom_read_byte(p + 2) << 16) | (eeprom_read_byte(p + 3) << 24);
+    uint8_t p[4];
+    read_transaction(p, addr, sizeof(p));
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    const uint8_t *p    = (const uint8_t *)addr;
-    uint8_t *      dest = (uint8_t *)buf;
-    while (len--) {
-        *dest++ = eeprom_read_byte(p++);
-    }
+    read_transaction(buf, addr, len);
 }
 
 void eeprom_write_word(uint16_t *addr, uint16_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    uint8_t p[2] = {value, value >> 8};
+    write_transaction(p, addr, sizeof(p));
 }
 
 void eeprom_write_dword(uint32_t *addr, uint32_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    uint8_t p[4] = {value, value >> 8, value >> 16, value >> 24};
+    write_transaction(p, addr, sizeof(p));
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t *      p   = (uint8_t *)addr;
-    const uint8_t *src = (const uint8_t *)buf;
-    while (len--) {
-        eeprom_write_byte(p++, *src++);
-    }
+    write_transaction(buf, addr, len);
 }
 
 void eeprom_update_byte(uint8_t *addr, uint8_t value) {
@@ -73,23 +106,13 @@ void eeprom_update_byte(uint8_t *addr, uint8_t value) {
 }
 
 void eeprom_update_word(uint16_t *addr, uint16_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    eeprom_write_word(addr, value);
 }
 
 void eeprom_update_dword(uint32_t *addr, uint32_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    eeprom_write_dword(addr, value);
 }
 
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t *      p   = (uint8_t *)addr;
-    const uint8_t *src = (const uint8_t *)buf;
-    while (len--) {
-        eeprom_write_byte(p++, *src++);
-    }
+    eeprom_write_block(buf, addr, len);
 }
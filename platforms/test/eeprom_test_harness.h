@@ -0,0 +1,31 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Access statistics for the test harness EEPROM. Every call into the eeprom_* API counts as one bus transaction, the
+    same way an I2C or SPI EEPROM driver would issue one transfer per call.
+*/
+typedef struct test_eeprom_stats_t {
+    uint32_t read_transactions;
+    uint32_t write_transactions;
+    uint32_t bytes_read;
+    uint32_t bytes_written;
+} test_eeprom_stats_t;
+
+void                       test_eeprom_reset_stats(void);
+const test_eeprom_stats_t *test_eeprom_get_stats(void);
+
+// Busy-waits for the given time on every transaction, to model slow external EEPROM in benchmarks. 0 disables it.
+void test_eeprom_set_transaction_latency_ns(uint32_t ns);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pin_defs.h"
+
+typedef uint8_t pin_t;
+
+/* Operation of GPIO by pin, implemented by drivers/gpio_mock.c for tests which drive peripherals. The names are
+ * parenthesised so that tests may still replace them with macros of their own. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void(gpio_set_pin_input)(pin_t pin);
+void(gpio_set_pin_input_high)(pin_t pin);
+void(gpio_set_pin_input_low)(pin_t pin);
+void(gpio_set_pin_output_push_pull)(pin_t pin);
+void(gpio_set_pin_output_open_drain)(pin_t pin);
+#define gpio_set_pin_output(pin) gpio_set_pin_output_push_pull(pin)
+
+void(gpio_write_pin)(pin_t pin, bool level);
+#define gpio_write_pin_high(pin) gpio_write_pin(pin, true)
+#define gpio_write_pin_low(pin) gpio_write_pin(pin, false)
+
+bool(gpio_read_pin)(pin_t pin);
+
+void(gpio_toggle_pin)(pin_t pin);
+
+// Called whenever an output changes level, so that peripheral mocks can check when it happens
+void gpio_mock_pin_changed(pin_t pin, bool level);
+
+#ifdef __cplusplus
+}
+#endif
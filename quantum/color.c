@@ -108,3 +108,66 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+rgb16_t hsv_to_rgb16(uint8_t hue, uint8_t sat, uint16_t val) {
+    rgb16_t  rgb;
+    uint8_t  region, remainder;
+    uint16_t v, p, q, t;
+
+#ifdef USE_CIE1931_CURVE
+    uint8_t  index = val >> 8;
+    uint16_t lower = pgm_read_byte(&CIE1931_CURVE[index]) * 257;
+    uint16_t upper = index == 255 ? lower : pgm_read_byte(&CIE1931_CURVE[index + 1]) * 257;
+    v              = lower + (((uint32_t)(upper - lower) * (val & 0xFF)) >> 8);
+#else
+    v = val;
+#endif
+
+    if (sat == 0) {
+        rgb.r = rgb.g = rgb.b = v;
+        return rgb;
+    }
+
+    region    = hue * 6 / 255;
+    remainder = (hue * 2 - region * 85) * 3;
+
+    p = ((uint32_t)v * (255 - sat)) >> 8;
+    q = ((uint32_t)v * (255 - ((sat * remainder) >> 8))) >> 8;
+    t = ((uint32_t)v * (255 - ((sat * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb.r = v;
+            rgb.g = t;
+            rgb.b = p;
+            break;
+        case 1:
+            rgb.r = q;
+            rgb.g = v;
+            rgb.b = p;
+            break;
+        case 2:
+            rgb.r = p;
+            rgb.g = v;
+            rgb.b = t;
+            break;
+        case 3:
+            rgb.r = p;
+            rgb.g = q;
+            rgb.b = v;
+            break;
+        case 4:
+            rgb.r = t;
+            rgb.g = p;
+            rgb.b = v;
+            break;
+        default:
+            rgb.r = v;
+            rgb.g = p;
+            rgb.b = q;
+            break;
+    }
+
+    return rgb;
+}
@@ -93,5 +93,16 @@ typedef struct PACKED hsv_t {
 // DEPRECATED
 typedef hsv_t HSV;
 
+typedef struct rgb16_t {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} rgb16_t;
+
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+/**
+ * Like hsv_to_rgb(), but with a 16-bit value and 16 bits per output channel, so that dim colours and slow fades keep
+ * their resolution. The CIE curve, when enabled, is interpolated between table entries.
+ */
+rgb16_t hsv_to_rgb16(uint8_t hue, uint8_t sat, uint16_t val);
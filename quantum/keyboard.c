@@ -110,6 +110,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+#    include "nvm_commit_queue.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -450,6 +453,9 @@ void quantum_init(void) {
     layer_state_set_kb((layer_state_t)layer_state);
 }
 
+// Until keyboard_init() completes, and while keyboard_task() runs
+static bool keyboard_task_busy = true;
+
 /** \brief keyboard_init
  *
  * FIXME: needs doc
@@ -547,6 +553,7 @@ void keyboard_init(void) {
 #endif
 
     keyboard_post_init_quantum(); /* Always keep this last */
+    keyboard_task_busy = false;
 }
 
 /** \brief key_event_task
@@ -701,8 +708,14 @@ void quantum_task(void) {
 #endif
 }
 
+/** \brief Whether keyboard_task() can't be run right now, for code which runs it from within long operations. */
+bool is_keyboard_task_busy(void) {
+    return keyboard_task_busy;
+}
+
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+    keyboard_task_busy = true;
     __attribute__((unused)) bool activity_has_occurred = false;
     if (matrix_task()) {
         last_matrix_activity_trigger();
@@ -796,4 +809,14 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+    nvm_commit_queue_task();
+#endif
+
+#ifdef EEPROM_DRIVER
+    eeprom_driver_task();
+#endif
+
+    keyboard_task_busy = false;
 }
@@ -109,6 +109,8 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+/* whether keyboard_task() can't be run right now, as keyboard_init() hasn't finished or it's already running */
+bool is_keyboard_task_busy(void);
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
@@ -0,0 +1,148 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "compiler_support.h"
+#include "eeprom.h"
+#include "timer.h"
+#include "nvm_commit_queue.h"
+
+STATIC_ASSERT(NVM_COMMIT_QUEUE_PAGE_SIZE >= 1 && NVM_COMMIT_QUEUE_PAGE_SIZE <= 32, "NVM_COMMIT_QUEUE_PAGE_SIZE must be between 1 and 32");
+STATIC_ASSERT(NVM_COMMIT_QUEUE_SLOTS >= 1 && NVM_COMMIT_QUEUE_SLOTS <= 255, "NVM_COMMIT_QUEUE_SLOTS must be between 1 and 255");
+
+typedef struct nvm_commit_slot_t {
+    uint32_t  dirty; // one bit per byte of the page that has a pending update
+    uintptr_t page;  // address of the start of the page
+    uint8_t   data[NVM_COMMIT_QUEUE_PAGE_SIZE];
+} nvm_commit_slot_t;
+
+static nvm_commit_slot_t slots[NVM_COMMIT_QUEUE_SLOTS];
+// Slots in the order they were first dirtied, only the first pending_count entries are in use
+static uint8_t  slot_order[NVM_COMMIT_QUEUE_SLOTS];
+static bool     slot_order_ready = false;
+static uint8_t  pending_count    = 0;
+static bool     draining         = false;
+static uint32_t first_update     = 0;
+static uint32_t last_update      = 0;
+
+static nvm_commit_slot_t *find_slot(uintptr_t page) {
+    for (uint8_t i = 0; i < pending_count; i++) {
+        if (slots[slot_order[i]].page == page) {
+            return &slots[slot_order[i]];
+        }
+    }
+    return NULL;
+}
+
+// Writes out each contiguous run of dirty bytes in the oldest pending page as a single block.
+static void write_oldest_slot(void) {
+    nvm_commit_slot_t *slot = &slots[slot_order[0]];
+    uint8_t            i    = 0;
+    while (i < NVM_COMMIT_QUEUE_PAGE_SIZE) {
+        if (!(slot->dirty & (1ul << i))) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        while (i < NVM_COMMIT_QUEUE_PAGE_SIZE && (slot->dirty & (1ul << i))) {
+            i++;
+        }
+        eeprom_update_block(&slot->data[start], (void *)(slot->page + start), i - start);
+    }
+    slot->dirty = 0;
+
+    uint8_t freed = slot_order[0];
+    pending_count--;
+    memmove(&slot_order[0], &slot_order[1], pending_count);
+    slot_order[pending_count] = freed;
+}
+
+static nvm_commit_slot_t *acquire_slot(uintptr_t page) {
+    nvm_commit_slot_t *slot = find_slot(page);
+    if (slot) {
+        return slot;
+    }
+    if (!slot_order_ready) {
+        nvm_commit_queue_discard();
+    }
+    if (pending_count == NVM_COMMIT_QUEUE_SLOTS) {
+        write_oldest_slot();
+    }
+    if (pending_count == 0) {
+        first_update = timer_read32();
+    }
+    slot        = &slots[slot_order[pending_count++]];
+    slot->page  = page;
+    slot->dirty = 0;
+    return slot;
+}
+
+void nvm_commit_queue_read(void *data, uintptr_t address, size_t size) {
+    eeprom_read_block(data, (const void *)address, size);
+
+    uint8_t *target = data;
+    for (uint8_t i = 0; i < pending_count; i++) {
+        const nvm_commit_slot_t *slot = &slots[slot_order[i]];
+        if (slot->page + NVM_COMMIT_QUEUE_PAGE_SIZE <= address || slot->page >= address + size) {
+            continue;
+        }
+        for (uint8_t offset = 0; offset < NVM_COMMIT_QUEUE_PAGE_SIZE; offset++) {
+            uintptr_t byte = slot->page + offset;
+            if ((slot->dirty & (1ul << offset)) && byte >= address && byte < address + size) {
+                target[byte - address] = slot->data[offset];
+            }
+        }
+    }
+}
+
+void nvm_commit_queue_update(const void *data, uintptr_t address, size_t size) {
+    const uint8_t *source = data;
+    while (size > 0) {
+        uintptr_t          page   = address - (address % NVM_COMMIT_QUEUE_PAGE_SIZE);
+        uint8_t            offset = address - page;
+        size_t             count  = NVM_COMMIT_QUEUE_PAGE_SIZE - offset < size ? NVM_COMMIT_QUEUE_PAGE_SIZE - offset : size;
+        nvm_commit_slot_t *slot   = acquire_slot(page);
+        memcpy(&slot->data[offset], source, count);
+        for (uint8_t i = 0; i < count; i++) {
+            slot->dirty |= 1ul << (offset + i);
+        }
+        address += count;
+        source += count;
+        size -= count;
+    }
+    last_update = timer_read32();
+}
+
+void nvm_commit_queue_task(void) {
+    if (pending_count == 0) {
+        draining = false;
+        return;
+    }
+    if (!draining && (timer_elapsed32(last_update) >= NVM_COMMIT_QUEUE_IDLE_MS || timer_elapsed32(first_update) >= NVM_COMMIT_QUEUE_MAX_DELAY_MS)) {
+        draining = true;
+    }
+    if (draining) {
+        // One page per call, the rest follow on the next calls
+        write_oldest_slot();
+    }
+}
+
+void nvm_commit_queue_flush(void) {
+    while (pending_count > 0) {
+        write_oldest_slot();
+    }
+}
+
+void nvm_commit_queue_discard(void) {
+    for (uint8_t i = 0; i < NVM_COMMIT_QUEUE_SLOTS; i++) {
+        slots[i].dirty = 0;
+        slot_order[i]  = i;
+    }
+    pending_count    = 0;
+    slot_order_ready = true;
+    draining         = false;
+}
+
+bool nvm_commit_queue_pending(void) {
+    return pending_count > 0;
+}
@@ -8,6 +8,7 @@
 #include "nvm_dynamic_keymap.h"
 #include "nvm_eeprom_eeconfig_internal.h"
 #include "nvm_eeprom_via_internal.h"
+#include "nvm_eeprom_commit_queue_internal.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -68,14 +69,169 @@ STATIC_ASSERT((int64_t)(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (int64_t)(DYNAMIC_KEYM
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+// The keymap, encoder map and macros are stored back to back, so a cache covers them as a single region.
+#define DYNAMIC_KEYMAP_NVM_START (DYNAMIC_KEYMAP_EEPROM_ADDR)
+#define DYNAMIC_KEYMAP_NVM_END (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE)
+#define DYNAMIC_KEYMAP_NVM_SIZE (DYNAMIC_KEYMAP_NVM_END - DYNAMIC_KEYMAP_NVM_START)
+
+STATIC_ASSERT(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR >= DYNAMIC_KEYMAP_EEPROM_ADDR, "Dynamic macros must be stored after the dynamic keymap");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Optional RAM caching of the dynamic keymap region. Every keycode lookup otherwise costs two EEPROM reads, which on
+// I2C/SPI EEPROM or wear-leveled flash is orders of magnitude slower than a RAM access.
+//
+//  - DYNAMIC_KEYMAP_RAM_MIRROR keeps a copy of the whole region in RAM, loaded with a single block read on first use.
+//  - DYNAMIC_KEYMAP_CACHE_PAGES keeps that many pages of DYNAMIC_KEYMAP_CACHE_PAGE_SIZE bytes, evicting the least
+//    recently used page on a miss, for boards that cannot spare RAM for the whole region.
+//
+// Writes update the cached copy and are written through to EEPROM, or to the commit queue when it is enabled.
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) && defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+#    error DYNAMIC_KEYMAP_RAM_MIRROR and DYNAMIC_KEYMAP_CACHE_PAGES are mutually exclusive
+#endif
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+
+static uint8_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_NVM_SIZE];
+static bool    dynamic_keymap_mirror_loaded = false;
+
+static inline uint8_t *dynamic_keymap_cache_lookup(uintptr_t address) {
+    if (!dynamic_keymap_mirror_loaded) {
+        nvm_eeprom_read_block(dynamic_keymap_mirror, (const void *)(uintptr_t)DYNAMIC_KEYMAP_NVM_START, sizeof(dynamic_keymap_mirror));
+        dynamic_keymap_mirror_loaded = true;
+    }
+    return &dynamic_keymap_mirror[address - DYNAMIC_KEYMAP_NVM_START];
+}
+
+static inline uint8_t *dynamic_keymap_cache_find(uintptr_t address) {
+    return dynamic_keymap_mirror_loaded ? &dynamic_keymap_mirror[address - DYNAMIC_KEYMAP_NVM_START] : NULL;
+}
+
+static void dynamic_keymap_cache_invalidate(void) {
+    dynamic_keymap_mirror_loaded = false;
+}
+
+#elif defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+
+#    ifndef DYNAMIC_KEYMAP_CACHE_PAGE_SIZE
+#        define DYNAMIC_KEYMAP_CACHE_PAGE_SIZE 32
+#    endif
+
+#    define DYNAMIC_KEYMAP_CACHE_PAGE_COUNT ((DYNAMIC_KEYMAP_NVM_SIZE + DYNAMIC_KEYMAP_CACHE_PAGE_SIZE - 1) / DYNAMIC_KEYMAP_CACHE_PAGE_SIZE)
+
+STATIC_ASSERT(DYNAMIC_KEYMAP_CACHE_PAGES >= 1 && DYNAMIC_KEYMAP_CACHE_PAGES <= 255, "DYNAMIC_KEYMAP_CACHE_PAGES must be between 1 and 255");
+STATIC_ASSERT(DYNAMIC_KEYMAP_CACHE_PAGE_COUNT < 65535, "DYNAMIC_KEYMAP_CACHE_PAGE_SIZE is too small for the dynamic keymap region");
+
+// The region is capped at 64KB by the DYNAMIC_KEYMAP_EEPROM_MAX_ADDR assert above, so 16-bit page tags always fit.
+// Offsets are held as uint32_t only to match the rest of the NVM offset code.
+#    define DYNAMIC_KEYMAP_CACHE_EMPTY 0xFFFF
+
+static uint8_t  dynamic_keymap_cache_data[DYNAMIC_KEYMAP_CACHE_PAGES][DYNAMIC_KEYMAP_CACHE_PAGE_SIZE];
+static uint16_t dynamic_keymap_cache_tag[DYNAMIC_KEYMAP_CACHE_PAGES];
+static uint8_t  dynamic_keymap_cache_lru[DYNAMIC_KEYMAP_CACHE_PAGES]; // slots from most to least recently used
+static bool     dynamic_keymap_cache_ready = false;
+
+static void dynamic_keymap_cache_invalidate(void) {
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_CACHE_PAGES; i++) {
+        dynamic_keymap_cache_tag[i] = DYNAMIC_KEYMAP_CACHE_EMPTY;
+        dynamic_keymap_cache_lru[i] = i;
+    }
+    dynamic_keymap_cache_ready = true;
+}
+
+// Returns the position of the page in the LRU order, or DYNAMIC_KEYMAP_CACHE_PAGES if it is not cached.
+static uint8_t dynamic_keymap_cache_position(uint32_t page) {
+    if (!dynamic_keymap_cache_ready) {
+        dynamic_keymap_cache_invalidate();
+    }
+    uint8_t position = 0;
+    while (position < DYNAMIC_KEYMAP_CACHE_PAGES && dynamic_keymap_cache_tag[dynamic_keymap_cache_lru[position]] != page) {
+        position++;
+    }
+    return position;
+}
+
+static inline uint8_t *dynamic_keymap_cache_find(uintptr_t address) {
+    uint32_t offset   = address - DYNAMIC_KEYMAP_NVM_START;
+    uint8_t  position = dynamic_keymap_cache_position(offset / DYNAMIC_KEYMAP_CACHE_PAGE_SIZE);
+    if (position == DYNAMIC_KEYMAP_CACHE_PAGES) {
+        return NULL;
+    }
+    return &dynamic_keymap_cache_data[dynamic_keymap_cache_lru[position]][offset % DYNAMIC_KEYMAP_CACHE_PAGE_SIZE];
+}
+
+static uint8_t *dynamic_keymap_cache_lookup(uintptr_t address) {
+    uint32_t offset   = address - DYNAMIC_KEYMAP_NVM_START;
+    uint32_t page     = offset / DYNAMIC_KEYMAP_CACHE_PAGE_SIZE;
+    uint8_t  position = dynamic_keymap_cache_position(page);
+    if (position == DYNAMIC_KEYMAP_CACHE_PAGES) {
+        // Miss, refill the least recently used slot
+        uint32_t start = page * DYNAMIC_KEYMAP_CACHE_PAGE_SIZE;
+        uint32_t size  = DYNAMIC_KEYMAP_NVM_SIZE - start < DYNAMIC_KEYMAP_CACHE_PAGE_SIZE ? DYNAMIC_KEYMAP_NVM_SIZE - start : DYNAMIC_KEYMAP_CACHE_PAGE_SIZE;
+        position       = DYNAMIC_KEYMAP_CACHE_PAGES - 1;
+        nvm_eeprom_read_block(dynamic_keymap_cache_data[dynamic_keymap_cache_lru[position]], (const void *)(uintptr_t)(DYNAMIC_KEYMAP_NVM_START + start), size);
+        dynamic_keymap_cache_tag[dynamic_keymap_cache_lru[position]] = page;
+    }
+    // Move to the front of the LRU order
+    uint8_t slot = dynamic_keymap_cache_lru[position];
+    for (; position > 0; position--) {
+        dynamic_keymap_cache_lru[position] = dynamic_keymap_cache_lru[position - 1];
+    }
+    dynamic_keymap_cache_lru[0] = slot;
+    return &dynamic_keymap_cache_data[slot][offset % DYNAMIC_KEYMAP_CACHE_PAGE_SIZE];
+}
+
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
+static inline uint8_t dynamic_keymap_nvm_read_byte(const void *address) {
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    return *dynamic_keymap_cache_lookup((uintptr_t)address);
+#else
+    return nvm_eeprom_read_byte(address);
+#endif
+}
+
+static inline void dynamic_keymap_nvm_update_byte(void *address, uint8_t value) {
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    uint8_t *cached = dynamic_keymap_cache_find((uintptr_t)address);
+    if (cached) {
+        if (*cached == value) {
+            // Already stored, skip the EEPROM compare entirely
+            return;
+        }
+        *cached = value;
+    }
+#endif
+    nvm_eeprom_update_byte(address, value);
+}
+
+static void dynamic_keymap_nvm_update_block(const void *data, void *address, size_t size) {
+    nvm_eeprom_update_block(data, address, size);
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    const uint8_t *source = data;
+    for (size_t i = 0; i < size; i++) {
+        uint8_t *cached = dynamic_keymap_cache_find((uintptr_t)address + i);
+        if (cached) {
+            *cached = source[i];
+        }
+    }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void nvm_dynamic_keymap_erase(void) {
-    // No-op, nvm_eeconfig_erase() will have already erased EEPROM if necessary.
+    // nvm_eeconfig_erase() will have already erased EEPROM if necessary, which leaves any cached copy stale.
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    dynamic_keymap_cache_invalidate();
+#endif
 }
 
 void nvm_dynamic_keymap_macro_erase(void) {
-    // No-op, nvm_eeconfig_erase() will have already erased EEPROM if necessary.
+    // nvm_eeconfig_erase() will have already erased EEPROM if necessary, which leaves any cached copy stale.
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    dynamic_keymap_cache_invalidate();
+#endif
 }
 
 static inline void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
@@ -86,8 +242,8 @@ uint16_t nvm_dynamic_keymap_read_keycode(uint8_t layer, uint8_t row, uint8_t col
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_nvm_read_byte(address) << 8;
+    keycode |= dynamic_keymap_nvm_read_byte(address + 1);
     return keycode;
 }
 
@@ -95,8 +251,8 @@ void nvm_dynamic_keymap_update_keycode(uint8_t layer, uint8_t row, uint8_t colum
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_nvm_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_nvm_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -108,8 +264,8 @@ uint16_t nvm_dynamic_keymap_read_encoder(uint8_t layer, uint8_t encoder_id, bool
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_nvm_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_nvm_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -117,8 +273,8 @@ void nvm_dynamic_keymap_update_encoder(uint8_t layer, uint8_t encoder_id, bool c
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_nvm_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_nvm_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -128,7 +284,7 @@ void nvm_dynamic_keymap_read_buffer(uint32_t offset, uint32_t size, uint8_t *dat
     uint8_t *target                     = data;
     for (uint32_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_nvm_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -143,7 +299,7 @@ void nvm_dynamic_keymap_update_buffer(uint32_t offset, uint32_t size, uint8_t *d
     uint8_t *source                     = data;
     for (uint32_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_nvm_update_byte(target, *source);
         }
         source++;
         target++;
@@ -159,7 +315,7 @@ void nvm_dynamic_keymap_macro_read_buffer(uint32_t offset, uint32_t size, uint8_
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_nvm_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -173,7 +329,7 @@ void nvm_dynamic_keymap_macro_update_buffer(uint32_t offset, uint32_t size, uint
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_nvm_update_byte(target, *source);
         }
         source++;
         target++;
@@ -187,7 +343,7 @@ void nvm_dynamic_keymap_macro_reset(void) {
     uint8_t dummy[16] = {0};
     for (int i = 0; i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; i += sizeof(dummy)) {
         int this_loop = remaining < sizeof(dummy) ? remaining : sizeof(dummy);
-        eeprom_update_block(dummy, start, this_loop);
+        dynamic_keymap_nvm_update_block(dummy, start, this_loop);
         start += this_loop;
         remaining -= this_loop;
     }
@@ -0,0 +1,67 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "eeprom.h"
+
+// EEPROM accessors used by the eeprom NVM provider, routed through the commit queue when it is enabled.
+
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+#    include "nvm_commit_queue.h"
+
+// Multi-byte values are stored little-endian, matching the eeprom_*_word/dword implementations.
+
+static inline void nvm_eeprom_read_block(void *buf, const void *addr, size_t len) {
+    nvm_commit_queue_read(buf, (uintptr_t)addr, len);
+}
+
+static inline uint8_t nvm_eeprom_read_byte(const uint8_t *addr) {
+    uint8_t value;
+    nvm_commit_queue_read(&value, (uintptr_t)addr, sizeof(value));
+    return value;
+}
+
+static inline uint16_t nvm_eeprom_read_word(const uint16_t *addr) {
+    uint8_t p[2];
+    nvm_commit_queue_read(p, (uintptr_t)addr, sizeof(p));
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t nvm_eeprom_read_dword(const uint32_t *addr) {
+    uint8_t p[4];
+    nvm_commit_queue_read(p, (uintptr_t)addr, sizeof(p));
+    return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void nvm_eeprom_update_block(const void *buf, void *addr, size_t len) {
+    nvm_commit_queue_update(buf, (uintptr_t)addr, len);
+}
+
+static inline void nvm_eeprom_update_byte(uint8_t *addr, uint8_t value) {
+    nvm_commit_queue_update(&value, (uintptr_t)addr, sizeof(value));
+}
+
+static inline void nvm_eeprom_update_word(uint16_t *addr, uint16_t value) {
+    uint8_t p[2] = {value, value >> 8};
+    nvm_commit_queue_update(p, (uintptr_t)addr, sizeof(p));
+}
+
+static inline void nvm_eeprom_update_dword(uint32_t *addr, uint32_t value) {
+    uint8_t p[4] = {value, value >> 8, value >> 16, value >> 24};
+    nvm_commit_queue_update(p, (uintptr_t)addr, sizeof(p));
+}
+
+#else // NVM_COMMIT_QUEUE_ENABLE
+
+#    define nvm_eeprom_read_block eeprom_read_block
+#    define nvm_eeprom_read_byte eeprom_read_byte
+#    define nvm_eeprom_read_word eeprom_read_word
+#    define nvm_eeprom_read_dword eeprom_read_dword
+#    define nvm_eeprom_update_block eeprom_update_block
+#    define nvm_eeprom_update_byte eeprom_update_byte
+#    define nvm_eeprom_update_word eeprom_update_word
+#    define nvm_eeprom_update_dword eeprom_update_dword
+
+#endif // NVM_COMMIT_QUEUE_ENABLE
@@ -0,0 +1,51 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+    The commit queue sits between the NVM data repositories and the physical store. Updates are held in RAM and
+    coalesced per page, then written out once writes have been idle for NVM_COMMIT_QUEUE_IDLE_MS, or at the latest
+    NVM_COMMIT_QUEUE_MAX_DELAY_MS after the oldest pending update. Reads always see the queued data.
+
+    nvm_commit_queue_task() writes at most one page per call so a large batch does not stall the scan loop. Suspend and
+    shutdown flush the queue, and anything else that needs data to be on the physical store (for example before
+    jumping to the bootloader) can call nvm_commit_queue_flush().
+*/
+
+// Number of pages that can be pending at once, the oldest page is written out early when they are all in use.
+#ifndef NVM_COMMIT_QUEUE_SLOTS
+#    define NVM_COMMIT_QUEUE_SLOTS 8
+#endif
+
+// Size of each page in bytes, writes are batched within page boundaries. At most 32.
+#ifndef NVM_COMMIT_QUEUE_PAGE_SIZE
+#    if defined(EXTERNAL_EEPROM_PAGE_SIZE) && EXTERNAL_EEPROM_PAGE_SIZE <= 32
+#        define NVM_COMMIT_QUEUE_PAGE_SIZE EXTERNAL_EEPROM_PAGE_SIZE
+#    else
+#        define NVM_COMMIT_QUEUE_PAGE_SIZE 16
+#    endif
+#endif
+
+// Time without further updates after which pending pages are written out.
+#ifndef NVM_COMMIT_QUEUE_IDLE_MS
+#    define NVM_COMMIT_QUEUE_IDLE_MS 500
+#endif
+
+// Upper bound on how long an update may stay pending while updates keep arriving.
+#ifndef NVM_COMMIT_QUEUE_MAX_DELAY_MS
+#    define NVM_COMMIT_QUEUE_MAX_DELAY_MS 5000
+#endif
+
+void nvm_commit_queue_task(void);
+// Flush barrier, returns once every pending update has been written to the physical store.
+void nvm_commit_queue_flush(void);
+// Drops all pending updates, used when the physical store is erased underneath the queue.
+void nvm_commit_queue_discard(void);
+bool nvm_commit_queue_pending(void);
+
+void nvm_commit_queue_read(void *data, uintptr_t address, size_t size);
+void nvm_commit_queue_update(const void *data, uintptr_t address, size_t size);
@@ -28,4 +28,12 @@ else
 
     QUANTUM_SRC += nvm_eeconfig.c
 
+    ifeq ($(strip $(NVM_COMMIT_QUEUE_ENABLE)), yes)
+        ifneq ($(NVM_DRIVER),eeprom)
+            $(call CATASTROPHIC_ERROR,Invalid NVM_DRIVER,NVM_COMMIT_QUEUE_ENABLE requires NVM_DRIVER=eeprom)
+        endif
+        OPT_DEFS += -DNVM_COMMIT_QUEUE_ENABLE
+        QUANTUM_SRC += nvm_commit_queue.c
+    endif
+
 endif
@@ -81,6 +81,11 @@ typedef struct QP_PACKED qff_unicode_glyph_table_v1_t {
     qff_unicode_glyph_v1_t glyph[0]; // Extent of '0' signifies that this struct is immediately followed by the glyph data
 } qff_unicode_glyph_table_v1_t;
 
+/////////////////////////////////////////
+// Font data descriptor
+
+#define QFF_FONT_DATA_DESCRIPTOR_TYPEID 0x04
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QFF API
 
@@ -56,6 +56,48 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_FONT_GLYPH_INDEX
+/**
+ * @def This controls whether an index of each font's glyphs is built in RAM when the font is loaded, so that drawing
+ *      text doesn't have to look up each glyph in the font data -- a linear search for unicode glyphs. Requires 8
+ *      bytes of RAM per glyph. Defaults to "off", and falls back to the font data if the RAM could not be allocated.
+ */
+#    define QUANTUM_PAINTER_FONT_GLYPH_INDEX FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the number of bytes of RAM used to cache glyphs which have already been decoded into the native
+ *      pixel format of the display they were drawn to, so that text redrawn often, such as status labels, can be sent
+ *      straight to the display. The least recently used glyphs are evicted to make room. If set to 0, there's no cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held by the glyph cache, if enabled.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif
+
+#ifndef QUANTUM_PAINTER_FONT_ATLASES
+/**
+ * @def This controls the maximum number of font atlases -- every glyph of a font pre-rendered into a display's native
+ *      pixel format with a pair of colors, using \ref qp_font_atlas_render -- held at once. If set to 0, there are no
+ *      font atlases.
+ */
+#    define QUANTUM_PAINTER_FONT_ATLASES 0
+#endif
+
+#ifndef QUANTUM_PAINTER_FONT_ATLAS_SIZE
+/**
+ * @def This controls the number of bytes of RAM font atlases may use between them, if enabled. The least recently used
+ *      atlases are evicted to make room for new ones.
+ */
+#    define QUANTUM_PAINTER_FONT_ATLAS_SIZE 16384
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -64,6 +106,24 @@
 #    define QUANTUM_PAINTER_CONCURRENT_ANIMATIONS 4
 #endif // QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 
+#ifndef QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+/**
+ * @def This controls whether an index of each animated image's frames is built in RAM when it's first animated, so that
+ *      each frame can be drawn without seeking past the frames before it or rereading its descriptors. Requires 28
+ *      bytes of RAM per frame. Defaults to "off", and falls back to the image data if the RAM could not be allocated.
+ */
+#    define QUANTUM_PAINTER_ANIMATION_FRAME_INDEX FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE
+/**
+ * @def This controls the number of image palettes of up to 16 colors kept after being converted to the native pixel
+ *      format of the display they were drawn to, so that frames sharing a palette skip reading and converting it. The
+ *      least recently used palettes are evicted to make room. If set to 0, there's no cache.
+ */
+#    define QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE 0
+#endif
+
 #ifndef QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE
 /**
  * @def This controls the maximum size of the pixel data buffer used for single blocks of transmission. Larger buffers
@@ -72,6 +132,31 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether the pixel data buffer is doubled, so that one half can be filled while the other is still
+ *      being sent to the display. Drivers using SPI then hand pixel data to the SPI driver's DMA, and carry on decoding
+ *      while it's transferred. Doubles the RAM used by the pixel data buffer.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_YIELD_INTERVAL
+/**
+ * @def This controls how often (in milliseconds) long-running draws let the keyboard task run, between blocks of pixel
+ *      data, so that large images don't delay matrix scanning. If set to 0, draws run to completion without yielding.
+ */
+#    define QUANTUM_PAINTER_YIELD_INTERVAL 0
+#endif
+
+#ifndef QUANTUM_PAINTER_DECODE_SPAN_SIZE
+/**
+ * @def This controls how many palette indices are decoded from images and fonts before being handed to the display
+ *      driver in one go. Larger spans mean fewer driver calls per pixel, at the cost of stack space. Minimum of 8.
+ */
+#    define QUANTUM_PAINTER_DECODE_SPAN_SIZE 32
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -88,6 +173,14 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_SUPPORTS_LZ
+/**
+ * @def This controls whether images and fonts compressed with QMK LZ can be drawn. Requires 512 bytes of RAM for the
+ *      decoder's window of previously decoded data.
+ */
+#    define QUANTUM_PAINTER_SUPPORTS_LZ FALSE
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -129,6 +222,22 @@ typedef struct painter_font_desc_t {
  */
 typedef const painter_font_desc_t *painter_font_handle_t;
 
+/**
+ * @typedef A string of text rendered into the native pixel format of a display, see \ref qp_text_sprite_render.
+ */
+typedef struct painter_text_sprite_t {
+    uint16_t width;  ///< Width of the rendered text
+    uint16_t height; ///< Height of the rendered text
+    uint8_t  bpp;    ///< Native bits per pixel of the device the text was rendered for
+    void    *buffer; ///< Rendered pixel data
+} painter_text_sprite_t;
+
+/**
+ * @def Number of bytes needed to render text of the given size with \ref qp_text_sprite_render, for a device with the
+ *      given native bits per pixel.
+ */
+#define QP_TEXT_SPRITE_BUFFER_SIZE(width, height, bpp) ((((width) * (height) * (bpp)) + 7) / 8)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API
 
@@ -313,6 +422,70 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
  */
 bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
 
+/**
+ * Draws an anti-aliased line, blending its edges from the foreground color towards the background color.
+ *
+ * @note The display can't be read back, so the background color should match whatever the line is drawn over.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x0[in] the device's x-position to start
+ * @param y0[in] the device's y-position to start
+ * @param x1[in] the device's x-position to finish
+ * @param y1[in] the device's y-position to finish
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if drawing the line succeeded
+ * @return false if drawing the line failed
+ */
+bool qp_line_aa(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Draws an anti-aliased circle, optionally filled, blending its edges from the foreground color towards the background color.
+ *
+ * @note The display can't be read back, so the background color should match whatever the circle is drawn over.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x[in] the x-position of the centre of the circle to draw onto the device
+ * @param y[in] the y-position of the centre of the circle to draw onto the device
+ * @param radius[in] the radius of the circle to draw, up to 4095
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @param filled[in] whether the circle should be filled
+ * @return true if drawing the circle succeeded
+ * @return false if drawing the circle failed
+ */
+bool qp_circle_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg, bool filled);
+
+/**
+ * Draws an anti-aliased ellipse, optionally filled, blending its edges from the foreground color towards the background color.
+ *
+ * @note The display can't be read back, so the background color should match whatever the ellipse is drawn over.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x[in] the x-position of the centre of the ellipse to draw onto the device
+ * @param y[in] the y-position of the centre of the ellipse to draw onto the device
+ * @param sizex[in] the horizontal size of the ellipse, up to 4095
+ * @param sizey[in] the vertical size of the ellipse, up to 4095
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @param filled[in] whether the ellipse should be filled
+ * @return true if drawing the ellipse succeeded
+ * @return false if drawing the ellipse failed
+ */
+bool qp_ellipse_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg, bool filled);
+
 /**
  * Sets up the location on the display to stream raw pixel data to the display, using \ref qp_pixdata.
  *
@@ -488,6 +661,65 @@ int16_t qp_drawtext(painter_device_t device, uint16_t x, uint16_t y, painter_fon
  */
 int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+/**
+ * Renders text once into a buffer in the device's native pixel format, so that it can be drawn repeatedly with
+ * \ref qp_text_sprite_draw without decoding the font again.
+ *
+ * @param device[in] the handle of the device the text will be drawn to
+ * @param sprite[out] the sprite to render into
+ * @param buffer[in] pointer to a buffer of at least `QP_TEXT_SPRITE_BUFFER_SIZE(qp_textwidth(font, str), font->line_height, bpp)` bytes
+ * @param buffer_size[in] the size of the buffer, in bytes
+ * @param font[in] the handle of the font
+ * @param str[in] the string to render
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return the width (in pixels) of the rendered text
+ * @return 0 if rendering failed, such as the buffer being too small
+ */
+int16_t qp_text_sprite_render(painter_device_t device, painter_text_sprite_t *sprite, void *buffer, uint32_t buffer_size, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Draws text previously rendered with \ref qp_text_sprite_render to the display.
+ *
+ * @param device[in] the handle of the device to control
+ * @param sprite[in] the rendered text
+ * @param x[in] the x-position where the text should be drawn onto the device
+ * @param y[in] the y-position where the text should be drawn onto the device
+ * @return true if drawing the text succeeded
+ * @return false if drawing the text failed
+ */
+bool qp_text_sprite_draw(painter_device_t device, const painter_text_sprite_t *sprite, uint16_t x, uint16_t y);
+
+/**
+ * Pre-renders every glyph of a font into the device's native pixel format with the given colors, so that
+ * \ref qp_drawtext_recolor with the same colors (or \ref qp_drawtext, for white on black) can copy glyphs straight
+ * to the display. Less recently used atlases are evicted to keep within `QUANTUM_PAINTER_FONT_ATLAS_SIZE`. Atlases are freed
+ * when the font is closed.
+ *
+ * @param device[in] the handle of the device the text will be drawn to
+ * @param font[in] the handle of the font
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if the atlas was rendered, or already existed
+ * @return false if rendering failed, such as the atlas needing more than `QUANTUM_PAINTER_FONT_ATLAS_SIZE` bytes
+ */
+bool qp_font_atlas_render(painter_device_t device, painter_font_handle_t font, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Retrieves the number of bytes of RAM currently held by font atlases.
+ *
+ * @return the number of bytes used, at most `QUANTUM_PAINTER_FONT_ATLAS_SIZE`
+ */
+uint32_t qp_font_atlas_bytes_used(void);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
@@ -2,6 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_comms.h"
+#include "qp_draw.h"
+
+// The device whose comms were most recently started, and not yet stopped
+static painter_device_t active_device = NULL;
+
+// The device which couldn't restart its comms after a draw yielded, until the draw stops them. The bus may belong to
+// something else in the meantime, so nothing is sent and it isn't stopped.
+static painter_device_t lost_device = NULL;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
@@ -23,7 +31,17 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
-    return driver->comms_vtable->comms_start(device);
+    // The draw which yielded still has the shared buffers, and possibly the bus
+    if (qp_internal_is_yielding()) {
+        qp_dprintf("qp_comms_start: fail (drawing is paused for the keyboard task)\n");
+        return false;
+    }
+
+    if (!driver->comms_vtable->comms_start(device)) {
+        return false;
+    }
+    active_device = device;
+    return true;
 }
 
 void qp_comms_stop(painter_device_t device) {
@@ -33,7 +51,41 @@ void qp_comms_stop(painter_device_t device) {
         return;
     }
 
+    if (device == lost_device) {
+        lost_device = NULL;
+        return;
+    }
+
     driver->comms_vtable->comms_stop(device);
+    if (active_device == device) {
+        active_device = NULL;
+    }
+}
+
+painter_device_t qp_comms_suspend(void) {
+    painter_device_t device = active_device;
+    if (device) {
+        // Waits for any pixel data still in flight, and releases chip select. Panels carry on with the memory write
+        // they were given once selected again.
+        painter_driver_t *driver = (painter_driver_t *)device;
+        driver->comms_vtable->comms_stop(device);
+        active_device = NULL;
+    }
+    return device;
+}
+
+bool qp_comms_resume(painter_device_t device) {
+    if (!device) {
+        return true;
+    }
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->comms_vtable->comms_start(device)) {
+        qp_dprintf("qp_comms_resume: fail (could not restart comms)\n");
+        lost_device = device;
+        return false;
+    }
+    active_device = device;
+    return true;
 }
 
 uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
@@ -42,16 +94,41 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
         qp_dprintf("qp_comms_send: fail (validation_ok == false)\n");
         return false;
     }
+    if (device == lost_device) {
+        return false;
+    }
 
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+uint32_t qp_comms_send_pixdata(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_pixdata: fail (validation_ok == false)\n");
+        return false;
+    }
+    if (device == lost_device) {
+        return false;
+    }
+
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Producers of pixel data swap buffers after sending, so the transfer can carry on in the background
+    if (driver->comms_vtable->comms_send_async) {
+        return driver->comms_vtable->comms_send_async(device, data, byte_count);
+    }
+#endif
+    return driver->comms_vtable->comms_send(device, data, byte_count);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
 bool qp_comms_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *                   driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    if (device == lost_device) {
+        return false;
+    }
     return comms_vtable->send_command(device, cmd);
 }
 
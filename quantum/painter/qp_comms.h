@@ -16,6 +16,15 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+// Stops comms for the device in the middle of a draw, if any, so that other devices can use the bus. Returns the
+// device, to be handed to qp_comms_resume() once the draw can carry on.
+painter_device_t qp_comms_suspend(void);
+bool             qp_comms_resume(painter_device_t device);
+
+// Sends pixel data, which may still be in flight when this returns -- it must be left untouched until the next comms
+// call on the device, which waits for it to complete
+uint32_t qp_comms_send_pixdata(painter_device_t device, const void* data, uint32_t byte_count);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -9,8 +9,21 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
-// Global variable used for native pixel data streaming.
+// Global variable used for native pixel data streaming. When double buffered, this is whichever half is free to fill.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+extern uint8_t* qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Called after handing the pixdata buffer to the driver. If it's going to be refilled, swaps to the other half when
+// double buffered, as the half just sent may still be in flight. Lets the keyboard task run every
+// QUANTUM_PAINTER_YIELD_INTERVAL milliseconds, if set. Returns false if the device couldn't get the bus back afterwards,
+// in which case the draw needs to be abandoned.
+bool qp_internal_pixdata_sent(bool refill);
+
+// Whether the keyboard task is running from within a draw, during which no other drawing can take place
+bool qp_internal_is_yielding(void);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -27,6 +40,35 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// Collects the runs of a single-colour shape, merging each into the previous one where the two make up a larger rect, so
+// that the whole merged area goes out with one viewport. Coordinates are signed so that shapes may hang off the left
+// or top of the display, the parts which do are clipped when the rect is sent. Uses the global pixdata buffer, which
+// needs to be pre-filled with enough native pixels for the largest rect the shape could merge into.
+typedef struct qp_internal_span_batch_t {
+    painter_device_t device;
+    bool             pending;
+    int16_t          left;
+    int16_t          top;
+    int16_t          right;
+    int16_t          bottom;
+} qp_internal_span_batch_t;
+
+void qp_internal_span_batch_init(qp_internal_span_batch_t* batch, painter_device_t device);
+bool qp_internal_span_batch_add(qp_internal_span_batch_t* batch, int16_t left, int16_t top, int16_t right, int16_t bottom);
+bool qp_internal_span_batch_flush(qp_internal_span_batch_t* batch);
+
+// Streams a single row or column of anti-aliased pixels. Each pixel is a coverage level, indexing the palette generated
+// by qp_internal_aa_palette(), from 0 for the background to QP_AA_LEVELS-1 for the foreground. The run may hang off the
+// left or top of the display, those pixels are dropped. Every pixel in the run needs to be appended before finishing.
+#define QP_AA_LEVELS 16
+bool qp_internal_aa_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888);
+bool qp_internal_aa_span_start(painter_device_t device, int16_t left, int16_t top, int16_t right, int16_t bottom);
+bool qp_internal_aa_span_append(painter_device_t device, uint8_t level);
+bool qp_internal_aa_span_finish(painter_device_t device);
+
+// Anti-aliased ellipse shared with qp_circle_aa(), sizes up to 4095
+bool qp_internal_ellipse_aa_impl(painter_device_t device, int16_t centerx, int16_t centery, uint16_t sizex, uint16_t sizey, bool filled);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
 typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
@@ -61,8 +103,12 @@ enum qp_internal_rle_mode_t {
     MARKER_BYTE,
     REPEATING_RUN,
     NON_REPEATING_RUN,
+    BACK_REFERENCE_RUN, // LZ only, copying earlier output which isn't the byte just written
 };
 
+// Number of bytes of decoded output LZ back-references can reach, fixed by the format
+#define QP_LZ_WINDOW_SIZE 512
+
 typedef struct qp_internal_byte_input_state_t {
     painter_device_t device;
     qp_stream_t*     src_stream;
@@ -73,6 +119,13 @@ typedef struct qp_internal_byte_input_state_t {
             enum qp_internal_rle_mode_t mode;
             uint8_t                     remain; // number of bytes remaining in the current mode
         } rle;
+        // LZ-specific, starting with the same mode field as RLE so that resetting rle.mode resets either
+        struct {
+            enum qp_internal_rle_mode_t mode;
+            uint16_t                    remain;   // number of bytes remaining in the current mode
+            uint16_t                    distance; // how far back in the window the current back-reference copies from
+            uint16_t                    pos;      // write position within the window
+        } lz;
     };
 } qp_internal_byte_input_state_t;
 
@@ -93,8 +146,8 @@ typedef struct qp_internal_byte_output_state_t {
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 
 // Helper shared between image and font rendering, sends pixels to the display using:
-//     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
-//     - qp_internal_send_bytes                                  (bpp > 8)
+//     - span-based palette decode, filling repeated runs (bpp <= 8)
+//     - qp_internal_send_bytes                               (bpp > 8)
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
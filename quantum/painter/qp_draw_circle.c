@@ -7,8 +7,37 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 
+// Span batches used by the helper below. Outlines use one per octant, each of which only ever moves along a row or a
+// column, so that its pixels merge into runs. Filled circles use one per set of mirrored lines.
+enum {
+    CIRCLE_BATCH_BOTTOM_CAP_RIGHT,
+    CIRCLE_BATCH_BOTTOM_CAP_LEFT,
+    CIRCLE_BATCH_TOP_CAP_RIGHT,
+    CIRCLE_BATCH_TOP_CAP_LEFT,
+    CIRCLE_BATCH_RIGHT_SIDE_LOWER,
+    CIRCLE_BATCH_LEFT_SIDE_LOWER,
+    CIRCLE_BATCH_RIGHT_SIDE_UPPER,
+    CIRCLE_BATCH_LEFT_SIDE_UPPER,
+    CIRCLE_BATCH_COUNT,
+};
+
+enum {
+    CIRCLE_BATCH_BOTTOM_CAP,
+    CIRCLE_BATCH_TOP_CAP,
+    CIRCLE_BATCH_LOWER_SIDES,
+    CIRCLE_BATCH_UPPER_SIDES,
+};
+
+static inline bool qp_circle_add_pixel(qp_internal_span_batch_t *batches, int batch, int16_t x, int16_t y) {
+    return qp_internal_span_batch_add(&batches[batch], x, y, x, y);
+}
+
+static inline bool qp_circle_add_line(qp_internal_span_batch_t *batches, int batch, int16_t x0, int16_t x1, int16_t y) {
+    return qp_internal_span_batch_add(&batches[batch], x0, y, x1, y);
+}
+
 // Utilize 8-way symmetry to draw circles
-static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+static bool qp_circle_helper_impl(qp_internal_span_batch_t *batches, int16_t centerx, int16_t centery, int16_t offsetx, int16_t offsety, bool filled) {
     /*
     Circles have the property of 8-way symmetry, so eight pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
@@ -24,102 +53,36 @@ static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uin
     would be a single pixel in length, so we write individual pixels instead.
     This also makes half the symmetrical points identical to their twins,
     so we only need four points or two points and one line
+
+    Nothing is sent here, the pixels and lines are added to the batches so
+    that each octant goes out as a handful of runs rather than pixel by pixel.
     */
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
-    int16_t xpy = ((int16_t)centerx) + ((int16_t)offsety);
-    int16_t xmy = ((int16_t)centerx) - ((int16_t)offsety);
-    int16_t ypx = ((int16_t)centery) + ((int16_t)offsetx);
-    int16_t ymx = ((int16_t)centery) - ((int16_t)offsetx);
-    int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
-    int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
+    int16_t xpx = centerx + offsetx;
+    int16_t xmx = centerx - offsetx;
+    int16_t xpy = centerx + offsety;
+    int16_t xmy = centerx - offsety;
+    int16_t ypx = centery + offsetx;
+    int16_t ymx = centery - offsetx;
+    int16_t ypy = centery + offsety;
+    int16_t ymy = centery - offsety;
 
     if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, centerx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, centerx, ymy)) {
-            return false;
-        }
         if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, centery, xmy, centery)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, centery)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, centery)) {
-                return false;
-            }
+            return qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP, centerx, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP, centerx, ymy) && qp_circle_add_line(batches, CIRCLE_BATCH_LOWER_SIDES, xpy, xmy, centery);
         }
+        return qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP_RIGHT, centerx, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP_RIGHT, centerx, ymy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_RIGHT_SIDE_LOWER, xpy, centery) && qp_circle_add_pixel(batches, CIRCLE_BATCH_LEFT_SIDE_LOWER, xmy, centery);
     } else if (offsetx == offsety) {
         if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypy, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymy, xmy, ymy)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymy)) {
-                return false;
-            }
-        }
-
-    } else {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypx, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymx, xmy, ymx)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymx)) {
-                return false;
-            }
+            return qp_circle_add_line(batches, CIRCLE_BATCH_BOTTOM_CAP, xpy, xmy, ypy) && qp_circle_add_line(batches, CIRCLE_BATCH_TOP_CAP, xpy, xmy, ymy);
         }
+        return qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP_RIGHT, xpy, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP_LEFT, xmy, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP_RIGHT, xpy, ymy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP_LEFT, xmy, ymy);
     }
 
-    return true;
+    if (filled) {
+        return qp_circle_add_line(batches, CIRCLE_BATCH_BOTTOM_CAP, xpx, xmx, ypy) && qp_circle_add_line(batches, CIRCLE_BATCH_TOP_CAP, xpx, xmx, ymy) && qp_circle_add_line(batches, CIRCLE_BATCH_LOWER_SIDES, xpy, xmy, ypx) && qp_circle_add_line(batches, CIRCLE_BATCH_UPPER_SIDES, xpy, xmy, ymx);
+    }
+    return qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP_RIGHT, xpx, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_BOTTOM_CAP_LEFT, xmx, ypy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP_RIGHT, xpx, ymy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_TOP_CAP_LEFT, xmx, ymy) && qp_circle_add_pixel(batches, CIRCLE_BATCH_RIGHT_SIDE_LOWER, xpy, ypx) && qp_circle_add_pixel(batches, CIRCLE_BATCH_LEFT_SIDE_LOWER, xmy, ypx) && qp_circle_add_pixel(batches, CIRCLE_BATCH_RIGHT_SIDE_UPPER, xpy, ymx) && qp_circle_add_pixel(batches, CIRCLE_BATCH_LEFT_SIDE_UPPER, xmy, ymx);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -138,15 +101,22 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
     int16_t ycalc = (int16_t)radius;
     int16_t err   = ((5 - (radius >> 2)) >> 2);
 
-    qp_internal_fill_pixdata(device, (radius * 2) + 1, hue, sat, val);
+    // Merged rects can be anything up to the size of the circle's bounding box
+    uint32_t diameter = (radius * 2) + 1;
+    qp_internal_fill_pixdata(device, diameter * diameter, hue, sat, val);
 
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_circle: fail (could not start comms)\n");
         return false;
     }
 
+    qp_internal_span_batch_t batches[CIRCLE_BATCH_COUNT];
+    for (int i = 0; i < CIRCLE_BATCH_COUNT; ++i) {
+        qp_internal_span_batch_init(&batches[i], device);
+    }
+
     bool ret = true;
-    if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
+    if (!qp_circle_helper_impl(batches, x, y, xcalc, ycalc, filled)) {
         ret = false;
     }
 
@@ -159,14 +129,45 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
                 ycalc--;
                 err += ((xcalc - ycalc) << 1) + 1;
             }
-            if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
+            if (!qp_circle_helper_impl(batches, x, y, xcalc, ycalc, filled)) {
                 ret = false;
                 break;
             }
         }
     }
 
+    for (int i = 0; i < CIRCLE_BATCH_COUNT; ++i) {
+        if (!qp_internal_span_batch_flush(&batches[i])) {
+            ret = false;
+        }
+    }
+
     qp_dprintf("qp_circle: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_circle_aa
+
+bool qp_circle_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg, bool filled) {
+    qp_dprintf("qp_circle_aa: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_circle_aa: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_circle_aa: fail (could not start comms)\n");
+        return false;
+    }
+
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    bool       ret       = qp_internal_aa_palette(device, fg_hsv888, bg_hsv888) && qp_internal_ellipse_aa_impl(device, x, y, radius, radius, filled);
+
+    qp_dprintf("qp_circle_aa: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
@@ -6,6 +6,8 @@
 #include "qp_draw.h"
 #include "qp_comms.h"
 
+#include "compiler_support.h"
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Palette / Monochrome-format decoder
 
@@ -126,6 +128,64 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+STATIC_ASSERT((QP_LZ_WINDOW_SIZE & (QP_LZ_WINDOW_SIZE - 1)) == 0, "QP_LZ_WINDOW_SIZE must be a power of two");
+
+// The most recently decoded bytes, which back-references copy from. Only one asset is ever decoded at a time.
+static uint8_t qp_internal_lz_window[QP_LZ_WINDOW_SIZE];
+
+static inline int16_t qp_drawimage_byte_lz_decoder(void* cb_arg) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+
+    // Work out if we're parsing a marker byte
+    if (state->lz.mode == MARKER_BYTE) {
+        int16_t c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return c;
+        }
+        if (c < 128) {
+            state->lz.mode   = NON_REPEATING_RUN; // literal run
+            state->lz.remain = c + 1;
+        } else {
+            int16_t d = qp_stream_get(state->src_stream);
+            if (d < 0) {
+                return d;
+            }
+            state->lz.distance = d + ((c & 0x40) ? 257 : 1);
+            state->lz.remain   = (c & 0x3F) + 3;
+            if ((c & 0x3F) == 0x3F) {
+                // Longer back-references carry on into another byte
+                int16_t e = qp_stream_get(state->src_stream);
+                if (e < 0) {
+                    return e;
+                }
+                state->lz.remain += e;
+            }
+            state->lz.mode = state->lz.distance == 1 ? REPEATING_RUN : BACK_REFERENCE_RUN;
+        }
+    }
+
+    int16_t c;
+    if (state->lz.mode == NON_REPEATING_RUN) {
+        c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return c;
+        }
+    } else {
+        c = qp_internal_lz_window[(state->lz.pos - state->lz.distance) & (QP_LZ_WINDOW_SIZE - 1)];
+    }
+    qp_internal_lz_window[state->lz.pos++ & (QP_LZ_WINDOW_SIZE - 1)] = c;
+
+    // Swap back to querying the marker byte once this run is complete
+    if (--state->lz.remain == 0) {
+        state->lz.mode = MARKER_BYTE;
+    }
+
+    state->curr = c;
+    return c;
+}
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
     qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
     painter_driver_t*                 driver = (painter_driver_t*)state->device;
@@ -139,6 +199,9 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
             return false;
         }
+        if (!qp_internal_pixdata_sent(true)) {
+            return false;
+        }
         state->pixel_write_pos = 0;
     }
 
@@ -159,13 +222,187 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
+        if (!qp_internal_pixdata_sent(true)) {
+            return false;
+        }
         state->byte_write_pos = 0;
     }
 
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Span-based palette decode
+
+STATIC_ASSERT(QUANTUM_PAINTER_DECODE_SPAN_SIZE >= 8, "QUANTUM_PAINTER_DECODE_SPAN_SIZE must hold at least one byte's worth of pixels");
+
+// Returns how many of the bytes following the one just read are repeats of it, up to max, and skips past them
+static inline uint32_t qp_internal_byte_repeats(qp_internal_byte_input_callback input_callback, void* input_arg, uint32_t max) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)input_arg;
+
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+    // Back-references copying bytes the same as the one just written, such as from a flat area of the row above, are
+    // repeats too -- they still need to be kept in the window
+    if (input_callback == qp_drawimage_byte_lz_decoder) {
+        if (state->lz.mode != REPEATING_RUN && state->lz.mode != BACK_REFERENCE_RUN) {
+            return 0;
+        }
+
+        uint32_t repeats = 0;
+        uint32_t limit   = QP_MIN(state->lz.remain, max);
+        while (repeats < limit && qp_internal_lz_window[(state->lz.pos - state->lz.distance) & (QP_LZ_WINDOW_SIZE - 1)] == state->curr) {
+            qp_internal_lz_window[state->lz.pos++ & (QP_LZ_WINDOW_SIZE - 1)] = state->curr;
+            repeats++;
+        }
+        state->lz.remain -= repeats;
+        if (state->lz.remain == 0) {
+            state->lz.mode = MARKER_BYTE;
+        }
+        return repeats;
+    }
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+
+    if (input_callback != qp_drawimage_byte_rle_decoder) {
+        return 0;
+    }
+
+    if (state->rle.mode != REPEATING_RUN) {
+        return 0;
+    }
+
+    uint32_t repeats = QP_MIN(state->rle.remain, max);
+    state->rle.remain -= repeats;
+    if (state->rle.remain == 0) {
+        state->rle.mode = MARKER_BYTE;
+    }
+    return repeats;
+}
+
+// Reads the next byte, calling the built-in decoders directly so that they can be inlined
+static inline int16_t qp_internal_byte_input(qp_internal_byte_input_callback input_callback, void* input_arg) {
+    if (input_callback == qp_drawimage_byte_rle_decoder) {
+        return qp_drawimage_byte_rle_decoder(input_arg);
+    }
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+    if (input_callback == qp_drawimage_byte_lz_decoder) {
+        return qp_drawimage_byte_lz_decoder(input_arg);
+    }
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+    return input_callback(input_arg);
+}
+
+// Sends the pixdata buffer to the display once it's full
+static inline bool qp_internal_pixel_span_flush_full(qp_internal_pixel_output_state_t* state) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    if (state->pixel_write_pos < state->max_pixels) {
+        return true;
+    }
+    if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+        return false;
+    }
+    if (!qp_internal_pixdata_sent(true)) {
+        return false;
+    }
+    state->pixel_write_pos = 0;
+    return true;
+}
+
+// Appends a span of palette indices, splitting it wherever the pixdata buffer fills up
+static bool qp_internal_pixel_span_appender(qp_internal_pixel_output_state_t* state, qp_pixel_t* palette, uint8_t* palette_indices, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    while (pixel_count > 0) {
+        uint32_t count = QP_MIN(pixel_count, state->max_pixels - state->pixel_write_pos);
+        if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos, count, palette_indices)) {
+            return false;
+        }
+        state->pixel_write_pos += count;
+        palette_indices += count;
+        pixel_count -= count;
+        if (!qp_internal_pixel_span_flush_full(state)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Appends a run of the same palette index, using the driver's fill if it has one
+static bool qp_internal_pixel_run_appender(qp_internal_pixel_output_state_t* state, qp_pixel_t* palette, uint8_t palette_index, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    if (!driver->driver_vtable->append_pixel_run) {
+        uint8_t span[QUANTUM_PAINTER_DECODE_SPAN_SIZE];
+        memset(span, palette_index, sizeof(span));
+        while (pixel_count > 0) {
+            uint32_t count = QP_MIN(pixel_count, sizeof(span));
+            if (!qp_internal_pixel_span_appender(state, palette, span, count)) {
+                return false;
+            }
+            pixel_count -= count;
+        }
+        return true;
+    }
+
+    while (pixel_count > 0) {
+        uint32_t count = QP_MIN(pixel_count, state->max_pixels - state->pixel_write_pos);
+        if (!driver->driver_vtable->append_pixel_run(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos, count, palette_index)) {
+            return false;
+        }
+        state->pixel_write_pos += count;
+        pixel_count -= count;
+        if (!qp_internal_pixel_span_flush_full(state)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes palette indices into spans rather than handing them over one at a time, and turns repeated RLE runs of bytes
+// whose pixels all share an index into a single fill
+static bool qp_internal_decode_palette_spans(uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state) {
+    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
+    uint32_t      remaining_pixels = pixel_count;
+    uint8_t       span[QUANTUM_PAINTER_DECODE_SPAN_SIZE];
+    uint8_t       span_length = 0;
+    while (remaining_pixels > 0) {
+        int16_t byteval = qp_internal_byte_input(input_callback, input_arg);
+        if (byteval < 0) {
+            return false;
+        }
+
+        // Only take repeats which are part of this asset, the stream may carry on with the next glyph
+        uint32_t remaining_bytes = (remaining_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        uint32_t repeats         = qp_internal_byte_repeats(input_callback, input_arg, remaining_bytes - 1);
+        uint8_t  index           = byteval & pixel_bitmask;
+        if (repeats > 0 && byteval == index * (0xFF / pixel_bitmask)) {
+            uint32_t run_pixels = QP_MIN(remaining_pixels, (repeats + 1) * pixels_per_byte);
+            if (!qp_internal_pixel_span_appender(output_state, palette, span, span_length) || !qp_internal_pixel_run_appender(output_state, palette, index, run_pixels)) {
+                return false;
+            }
+            span_length = 0;
+            remaining_pixels -= run_pixels;
+            continue;
+        }
+
+        for (uint32_t i = 0; i <= repeats; ++i) {
+            if (span_length + pixels_per_byte > sizeof(span)) {
+                if (!qp_internal_pixel_span_appender(output_state, palette, span, span_length)) {
+                    return false;
+                }
+                span_length = 0;
+            }
+            uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
+            uint8_t bits        = byteval;
+            for (uint8_t q = 0; q < loop_pixels; ++q) {
+                span[span_length++] = bits & pixel_bitmask;
+                bits >>= bits_per_pixel;
+            }
+            remaining_pixels -= loop_pixels;
+        }
+    }
+    return qp_internal_pixel_span_appender(output_state, palette, span, span_length);
+}
+
+// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette_spans) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
@@ -177,10 +414,10 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette_spans(pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos) && qp_internal_pixdata_sent(true);
         }
     }
 
@@ -197,7 +434,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel) && qp_internal_pixdata_sent(true);
         }
     }
 
@@ -212,6 +449,13 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
             return qp_drawimage_byte_rle_decoder;
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+        case IMAGE_COMPRESSED_LZ:
+            input_state->lz.mode   = MARKER_BYTE;
+            input_state->lz.remain = 0;
+            input_state->lz.pos    = 0;
+            return qp_drawimage_byte_lz_decoder;
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
         default:
             return NULL;
     }
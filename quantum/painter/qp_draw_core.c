@@ -7,6 +7,7 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 #include "qgf.h"
+#include "keyboard.h"
 
 STATIC_ASSERT((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE % 16) == 0, "QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE needs to be a non-zero multiple of 16");
 
@@ -21,7 +22,18 @@ STATIC_ASSERT((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXD
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+__attribute__((__aligned__(4))) static uint8_t pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+#if QUANTUM_PAINTER_YIELD_INTERVAL > 0
+// Whether the keyboard task is running from within a draw
+static bool     yielding = false;
+static uint32_t last_yield;
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -42,6 +54,40 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+bool qp_internal_pixdata_sent(bool refill) {
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // The half just sent may still be in flight, so fill the other one
+    if (refill) {
+        qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == pixdata_buffers[0]) ? pixdata_buffers[1] : pixdata_buffers[0];
+    }
+#endif
+
+#if QUANTUM_PAINTER_YIELD_INTERVAL > 0
+    // Draws made from within the keyboard task, or before it has started, run to completion
+    if (!yielding && !is_keyboard_task_busy() && timer_elapsed32(last_yield) >= QUANTUM_PAINTER_YIELD_INTERVAL) {
+        // Let go of the bus while the keyboard task runs, in case it has other devices on it
+        painter_device_t device = qp_comms_suspend();
+        yielding                = true;
+        keyboard_task();
+        yielding   = false;
+        last_yield = timer_read32();
+        if (!qp_comms_resume(device)) {
+            // Something else on the bus kept hold of it, the rest of the draw can't go out
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+bool qp_internal_is_yielding(void) {
+#if QUANTUM_PAINTER_YIELD_INTERVAL > 0
+    return yielding;
+#else
+    return false;
+#endif
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -58,8 +104,12 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     qp_pixel_t color = {.hsv888 = {.h = hue, .s = sat, .v = val}};
     driver->driver_vtable->palette_convert(device, 1, &color);
 
-    // Append the required number of pixels
+    // Append the required number of pixels, in one go if the driver can fill
     uint8_t palette_idx = 0;
+    if (driver->driver_vtable->append_pixel_run) {
+        driver->driver_vtable->append_pixel_run(device, qp_internal_global_pixdata_buffer, &color, 0, num_pixels, palette_idx);
+        return;
+    }
     for (uint32_t i = 0; i < num_pixels; ++i) {
         driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, &color, i, 1, &palette_idx);
     }
@@ -141,6 +191,124 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Span batching
+
+void qp_internal_span_batch_init(qp_internal_span_batch_t *batch, painter_device_t device) {
+    batch->device  = device;
+    batch->pending = false;
+}
+
+bool qp_internal_span_batch_flush(qp_internal_span_batch_t *batch) {
+    if (!batch->pending) {
+        return true;
+    }
+    batch->pending = false;
+
+    // Anything off the left or top of the display is dropped, rather than wrapping around to the far side
+    if (batch->right < 0 || batch->bottom < 0) {
+        return true;
+    }
+    return qp_internal_fillrect_helper_impl(batch->device, QP_MAX(batch->left, 0), QP_MAX(batch->top, 0), batch->right, batch->bottom);
+}
+
+bool qp_internal_span_batch_add(qp_internal_span_batch_t *batch, int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    int16_t l = QP_MIN(left, right);
+    int16_t r = QP_MAX(left, right);
+    int16_t t = QP_MIN(top, bottom);
+    int16_t b = QP_MAX(top, bottom);
+
+    if (batch->pending) {
+        // Already covered, such as the pixels shared by two halves of a symmetric shape
+        if (l >= batch->left && r <= batch->right && t >= batch->top && b <= batch->bottom) {
+            return true;
+        }
+
+        // Same rows, and touching or overlapping horizontally
+        if (t == batch->top && b == batch->bottom && l <= batch->right + 1 && r >= batch->left - 1) {
+            batch->left  = QP_MIN(l, batch->left);
+            batch->right = QP_MAX(r, batch->right);
+            return true;
+        }
+
+        // Same columns, and touching or overlapping vertically
+        if (l == batch->left && r == batch->right && t <= batch->bottom + 1 && b >= batch->top - 1) {
+            batch->top    = QP_MIN(t, batch->top);
+            batch->bottom = QP_MAX(b, batch->bottom);
+            return true;
+        }
+
+        if (!qp_internal_span_batch_flush(batch)) {
+            return false;
+        }
+    }
+
+    batch->pending = true;
+    batch->left    = l;
+    batch->top     = t;
+    batch->right   = r;
+    batch->bottom  = b;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Anti-aliased spans
+
+// State of the anti-aliased run being streamed
+static uint32_t aa_span_skip;     // pixels still to be dropped, as they're off the left or top of the display
+static uint32_t aa_span_buffered; // pixels waiting in the pixdata buffer
+
+bool qp_internal_aa_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // Ensure we aren't reusing any palette, which may have been converted for a different device
+    qp_internal_invalidate_palette();
+    qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, QP_AA_LEVELS);
+    return driver->driver_vtable->palette_convert(device, QP_AA_LEVELS, qp_internal_global_pixel_lookup_table);
+}
+
+bool qp_internal_aa_span_start(painter_device_t device, int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    aa_span_buffered = 0;
+    if (right < 0 || bottom < 0) {
+        aa_span_skip = UINT32_MAX;
+        return true;
+    }
+
+    // Only a row or a column is streamed at a time, so at most one of these is non-zero
+    aa_span_skip = (left < 0 ? -left : 0) + (top < 0 ? -top : 0);
+    return driver->driver_vtable->viewport(device, QP_MAX(left, 0), QP_MAX(top, 0), right, bottom);
+}
+
+bool qp_internal_aa_span_append(painter_device_t device, uint8_t level) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    if (aa_span_skip > 0) {
+        aa_span_skip--;
+        return true;
+    }
+
+    driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, aa_span_buffered, 1, &level);
+    if (++aa_span_buffered == qp_internal_num_pixels_in_buffer(device)) {
+        return qp_internal_aa_span_finish(device);
+    }
+    return true;
+}
+
+bool qp_internal_aa_span_finish(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    if (aa_span_buffered == 0) {
+        return true;
+    }
+
+    bool ret         = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, aa_span_buffered);
+    aa_span_buffered = 0;
+    qp_internal_pixdata_sent(true);
+    return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_setpixel
 
@@ -186,8 +354,6 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         return false;
     }
 
-    qp_internal_fill_pixdata(device, 1, hue, sat, val);
-
     // draw angled line using Bresenham's algo
     int16_t x      = ((int16_t)x0);
     int16_t y      = ((int16_t)y0);
@@ -199,9 +365,15 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
     int16_t e  = dx + dy;
     int16_t e2 = 2 * e;
 
+    // Consecutive pixels on the same row or column are merged into runs, the longest of which spans the major axis
+    qp_internal_fill_pixdata(device, QP_MAX(dx, -dy) + 1, hue, sat, val);
+
+    qp_internal_span_batch_t batch;
+    qp_internal_span_batch_init(&batch, device);
+
     bool ret = true;
     while (x != x1 || y != y1) {
-        if (!qp_internal_setpixel_impl(device, x, y)) {
+        if (!qp_internal_span_batch_add(&batch, x, y, x, y)) {
             ret = false;
             break;
         }
@@ -216,7 +388,7 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         }
     }
     // draw the last pixel
-    if (!qp_internal_setpixel_impl(device, x, y)) {
+    if (!qp_internal_span_batch_add(&batch, x, y, x, y) || !qp_internal_span_batch_flush(&batch)) {
         ret = false;
     }
 
@@ -225,6 +397,103 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
     return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_line_aa
+
+typedef struct qp_line_aa_state_t {
+    int16_t u0; // start along the major axis
+    int16_t v0; // start along the minor axis
+    int32_t gradient;
+} qp_line_aa_state_t;
+
+// Coverage of the pixel at the supplied major/minor position, from how far the line's centre passes from it
+static uint8_t qp_line_aa_level(const qp_line_aa_state_t *state, int16_t u, int16_t v) {
+    int32_t centre   = ((int32_t)state->v0 << 16) + (int32_t)(u - state->u0) * state->gradient;
+    int32_t distance = ((int32_t)v << 16) - centre;
+    if (distance < 0) {
+        distance = -distance;
+    }
+    if (distance >= 0x10000) {
+        return 0;
+    }
+    return (uint8_t)(((0x10000 - distance) * (QP_AA_LEVELS - 1) + 0x8000) >> 16);
+}
+
+bool qp_line_aa(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    if (x0 == x1 || y0 == y1) {
+        qp_dprintf("qp_line_aa(%d, %d, %d, %d): entry (deferring to qp_rect)\n", (int)x0, (int)y0, (int)x1, (int)y1);
+        bool ret = qp_rect(device, x0, y0, x1, y1, hue_fg, sat_fg, val_fg, true);
+        qp_dprintf("qp_line_aa(%d, %d, %d, %d): %s (deferred to qp_rect)\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail");
+        return ret;
+    }
+
+    qp_dprintf("qp_line_aa(%d, %d, %d, %d): entry\n", (int)x0, (int)y0, (int)x1, (int)y1);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_line_aa: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("Failed to start comms in qp_line_aa\n");
+        return false;
+    }
+
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    if (!qp_internal_aa_palette(device, fg_hsv888, bg_hsv888)) {
+        qp_dprintf("qp_line_aa: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
+    }
+
+    // Work along the major axis, so that every step along it covers one or two pixels on the minor axis. Pixels sharing
+    // a minor axis position form a run along the major axis -- a row for shallow lines, a column for steep ones.
+    bool    steep = abs(((int16_t)y1) - ((int16_t)y0)) > abs(((int16_t)x1) - ((int16_t)x0));
+    int16_t u0    = steep ? y0 : x0;
+    int16_t v0    = steep ? x0 : y0;
+    int16_t u1    = steep ? y1 : x1;
+    int16_t v1    = steep ? x1 : y1;
+    if (u0 > u1) {
+        int16_t tu = u0;
+        int16_t tv = v0;
+        u0         = u1;
+        v0         = v1;
+        u1         = tu;
+        v1         = tv;
+    }
+
+    qp_line_aa_state_t state = {.u0 = u0, .v0 = v0, .gradient = ((int32_t)(v1 - v0) << 16) / (u1 - u0)};
+    int16_t            slope = v0 < v1 ? 1 : -1;
+    int16_t            ua    = u0;
+
+    bool ret = true;
+    for (int16_t v = v0; ret; v += slope) {
+        // Runs only ever move forward along the major axis, find where this one starts and ends
+        while (ua < u1 && qp_line_aa_level(&state, ua, v) == 0) {
+            ua++;
+        }
+        int16_t ub = ua;
+        while (ub < u1 && qp_line_aa_level(&state, ub + 1, v) > 0) {
+            ub++;
+        }
+
+        ret = steep ? qp_internal_aa_span_start(device, v, ua, v, ub) : qp_internal_aa_span_start(device, ua, v, ub, v);
+        for (int16_t u = ua; ret && u <= ub; ++u) {
+            ret = qp_internal_aa_span_append(device, qp_line_aa_level(&state, u, v));
+        }
+        ret = ret && qp_internal_aa_span_finish(device);
+
+        if (v == v1) {
+            break;
+        }
+    }
+
+    qp_comms_stop(device);
+    qp_dprintf("qp_line_aa(%d, %d, %d, %d): %s\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail");
+    return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_rect
 
@@ -246,6 +515,8 @@ bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t left, ui
         if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, transmit)) {
             return false;
         }
+        // The same pixels are sent each time, so the buffer stays put
+        qp_internal_pixdata_sent(false);
         remaining -= transmit;
     }
     return true;
@@ -6,8 +6,27 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 
+// Span batches used by the helper below. Outlines use one per quadrant, which moves along a row while the edge is
+// shallow and down a column once it's steep, so that its pixels merge into runs. Filled ellipses use one per half.
+enum {
+    ELLIPSE_BATCH_BOTTOM_RIGHT,
+    ELLIPSE_BATCH_TOP_RIGHT,
+    ELLIPSE_BATCH_BOTTOM_LEFT,
+    ELLIPSE_BATCH_TOP_LEFT,
+    ELLIPSE_BATCH_COUNT,
+};
+
+enum {
+    ELLIPSE_BATCH_BOTTOM,
+    ELLIPSE_BATCH_TOP,
+};
+
+static inline bool qp_ellipse_add_pixel(qp_internal_span_batch_t *batches, int batch, int16_t x, int16_t y) {
+    return qp_internal_span_batch_add(&batches[batch], x, y, x, y);
+}
+
 // Utilize 4-way symmetry to draw an ellipse
-static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+static bool qp_ellipse_helper_impl(qp_internal_span_batch_t *batches, int16_t centerx, int16_t centery, int16_t offsetx, int16_t offsety, bool filled) {
     /*
     Ellipses have the property of 4-way symmetry, so four pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
@@ -16,44 +35,34 @@ static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, ui
     For filled ellipses, we can draw horizontal lines between each pair of
     pixels with the same final value of y.
 
-    When offsetx == 0 only two pixels can be drawn for filled or unfilled ellipses
+    When offsetx == 0 only two pixels can be drawn for filled or unfilled ellipses,
+    and when offsety == 0 the top and bottom halves share their pixels.
+
+    Nothing is sent here, the pixels and lines are added to the batches so
+    that each quadrant goes out as a handful of runs rather than pixel by pixel.
     */
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
-    int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
-    int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
+    int16_t xpx = centerx + offsetx;
+    int16_t xmx = centerx - offsetx;
+    int16_t ypy = centery + offsety;
+    int16_t ymy = centery - offsety;
 
     if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
+        if (filled) {
+            return qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_BOTTOM, xpx, ypy) && qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_TOP, xpx, ymy);
         }
+        return qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_BOTTOM_RIGHT, xpx, ypy) && qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_TOP_RIGHT, xpx, ymy);
     } else if (filled) {
-        if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-            return false;
-        }
-        if (offsety > 0 && !qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-            return false;
-        }
-    } else {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
+        if (!qp_internal_span_batch_add(&batches[ELLIPSE_BATCH_BOTTOM], xpx, ypy, xmx, ypy)) {
             return false;
         }
+        return offsety == 0 || qp_internal_span_batch_add(&batches[ELLIPSE_BATCH_TOP], xpx, ymy, xmx, ymy);
     }
 
-    return true;
+    if (!qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_BOTTOM_RIGHT, xpx, ypy) || !qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_BOTTOM_LEFT, xmx, ypy)) {
+        return false;
+    }
+    return offsety == 0 || (qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_TOP_RIGHT, xpx, ymy) && qp_ellipse_add_pixel(batches, ELLIPSE_BATCH_TOP_LEFT, xmx, ymy));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -75,16 +84,22 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
     int16_t dx = 0;
     int16_t dy = ((int16_t)sizey);
 
-    qp_internal_fill_pixdata(device, QP_MAX(sizex, sizey), hue, sat, val);
+    // Merged rects can be anything up to the size of the ellipse's bounding box
+    qp_internal_fill_pixdata(device, ((uint32_t)sizex * 2 + 1) * ((uint32_t)sizey * 2 + 1), hue, sat, val);
 
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_ellipse: fail (could not start comms)\n");
         return false;
     }
 
+    qp_internal_span_batch_t batches[ELLIPSE_BATCH_COUNT];
+    for (int i = 0; i < ELLIPSE_BATCH_COUNT; ++i) {
+        qp_internal_span_batch_init(&batches[i], device);
+    }
+
     bool ret = true;
     for (int32_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
+        if (!qp_ellipse_helper_impl(batches, x, y, dx, dy, filled)) {
             ret = false;
             break;
         }
@@ -99,7 +114,7 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
     dy = 0;
 
     for (int32_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); aa * dy <= bb * dx; dy++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
+        if (!qp_ellipse_helper_impl(batches, x, y, dx, dy, filled)) {
             ret = false;
             break;
         }
@@ -110,7 +125,181 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
         delta += aa * (4 * dy + 6);
     }
 
+    for (int i = 0; i < ELLIPSE_BATCH_COUNT; ++i) {
+        if (!qp_internal_span_batch_flush(&batches[i])) {
+            ret = false;
+        }
+    }
+
     qp_dprintf("qp_ellipse: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_ellipse_aa
+
+typedef struct qp_ellipse_aa_state_t {
+    uint16_t sizex;
+    uint16_t sizey;
+    bool     filled;
+} qp_ellipse_aa_state_t;
+
+// Integer square root, rounded down
+static uint32_t qp_ellipse_isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit  = 1UL << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// Distance from the centre to the edge, in sixteenths of a pixel, along the row or column `offset` pixels from the
+// centre. `along` is the semi-axis in the direction being measured, `across` the other one.
+static int32_t qp_ellipse_aa_edge(uint16_t along, uint16_t across, uint16_t offset) {
+    uint32_t remaining = (uint32_t)across * across - (uint32_t)offset * offset;
+    return (int32_t)(((uint32_t)along * qp_ellipse_isqrt(remaining << 8)) / across);
+}
+
+// Coverage of the pixel at [x,y] from the centre, given the edge for row y. The distance to the edge is estimated from
+// the horizontal and vertical distances to it, as the distance to the line through those two points of the edge.
+static uint8_t qp_ellipse_aa_level(const qp_ellipse_aa_state_t *state, int32_t row_edge, uint16_t x, uint16_t y) {
+    int32_t dh = QP_MAX(QP_MIN((int32_t)x * 16 - row_edge, 255), -255);
+    int32_t dv = QP_MAX(QP_MIN((int32_t)y * 16 - qp_ellipse_aa_edge(state->sizey, state->sizex, x), 255), -255);
+
+    int32_t distance = 0;
+    if (dh != 0 && dv != 0 && (dh < 0) == (dv < 0)) {
+        int32_t magnitude = ((int32_t)abs((int16_t)dh) * abs((int16_t)dv)) / (int32_t)qp_ellipse_isqrt(dh * dh + dv * dv);
+        distance          = dh < 0 ? -magnitude : magnitude;
+    }
+
+    // Outlines are a pixel wide, centred on the edge. Filled ellipses are solid up to the edge, then fade out over a
+    // pixel, so that they cover the same pixels as qp_ellipse() would.
+    int32_t coverage = 16 - (state->filled ? distance : abs((int16_t)distance));
+    coverage         = QP_MAX(QP_MIN(coverage, 16), 0);
+    return (uint8_t)((coverage * (QP_AA_LEVELS - 1) + 8) >> 4);
+}
+
+// Streams one row of the ellipse, mirrored about the centre. Pixels up to `inner` from the centre are the foreground
+// when filled, or left untouched for outlines, and the rest out to `outer` are anti-aliased.
+static bool qp_ellipse_aa_row(painter_device_t device, const qp_ellipse_aa_state_t *state, int16_t centerx, int16_t row, int32_t row_edge, uint16_t y, int16_t inner, int16_t outer) {
+    if (state->filled || inner < 0) {
+        if (!qp_internal_aa_span_start(device, centerx - outer, row, centerx + outer, row)) {
+            return false;
+        }
+        for (int16_t x = -outer; x <= outer; ++x) {
+            uint16_t offset = abs(x);
+            if (!qp_internal_aa_span_append(device, (int16_t)offset <= inner ? QP_AA_LEVELS - 1 : qp_ellipse_aa_level(state, row_edge, offset, y))) {
+                return false;
+            }
+        }
+        return qp_internal_aa_span_finish(device);
+    }
+
+    // Outlines leave the inside alone, so the row is sent as two runs either side of it
+    for (int side = -1; side <= 1; side += 2) {
+        int16_t l = side < 0 ? centerx - outer : centerx + inner + 1;
+        int16_t r = side < 0 ? centerx - inner - 1 : centerx + outer;
+        if (!qp_internal_aa_span_start(device, l, row, r, row)) {
+            return false;
+        }
+        for (int16_t x = l; x <= r; ++x) {
+            if (!qp_internal_aa_span_append(device, qp_ellipse_aa_level(state, row_edge, abs(x - centerx), y))) {
+                return false;
+            }
+        }
+        if (!qp_internal_aa_span_finish(device)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool qp_internal_ellipse_aa_impl(painter_device_t device, int16_t centerx, int16_t centery, uint16_t sizex, uint16_t sizey, bool filled) {
+    qp_ellipse_aa_state_t state = {.sizex = sizex, .sizey = sizey, .filled = filled};
+
+    // Degenerate ellipses are a solid line along the other axis
+    if (sizex == 0 || sizey == 0) {
+        if (!qp_internal_aa_span_start(device, centerx - sizex, centery - sizey, centerx + sizex, centery + sizey)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < (uint32_t)(sizex + sizey) * 2 + 1; ++i) {
+            if (!qp_internal_aa_span_append(device, QP_AA_LEVELS - 1)) {
+                return false;
+            }
+        }
+        return qp_internal_aa_span_finish(device);
+    }
+
+    // Work through one quadrant a row at a time, each row drawn above and below the centre
+    for (uint16_t y = 0; y <= sizey; ++y) {
+        int32_t row_edge = qp_ellipse_aa_edge(sizex, sizey, y);
+
+        // Find the outermost pixel with any coverage, starting from the first one outside the edge. Moving outwards
+        // from there the distance to the edge only grows.
+        int16_t outer = QP_MIN((int16_t)(row_edge >> 4) + 1, (int16_t)sizex);
+        if (qp_ellipse_aa_level(&state, row_edge, outer, y) > 0) {
+            while (outer < (int16_t)sizex && qp_ellipse_aa_level(&state, row_edge, outer + 1, y) > 0) {
+                outer++;
+            }
+        } else {
+            while (outer > 0 && qp_ellipse_aa_level(&state, row_edge, outer, y) == 0) {
+                outer--;
+            }
+        }
+
+        // ...then inwards, to the last pixel which isn't fully covered (filled) or the first with any coverage (outline)
+        int16_t inner = outer;
+        if (filled) {
+            while (inner >= 0 && qp_ellipse_aa_level(&state, row_edge, inner, y) < QP_AA_LEVELS - 1) {
+                inner--;
+            }
+        } else {
+            while (inner > 0 && qp_ellipse_aa_level(&state, row_edge, inner - 1, y) > 0) {
+                inner--;
+            }
+            inner--;
+        }
+
+        if (!qp_ellipse_aa_row(device, &state, centerx, centery + y, row_edge, y, inner, outer)) {
+            return false;
+        }
+        if (y > 0 && !qp_ellipse_aa_row(device, &state, centerx, centery - y, row_edge, y, inner, outer)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool qp_ellipse_aa(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg, bool filled) {
+    qp_dprintf("qp_ellipse_aa: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_ellipse_aa: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_ellipse_aa: fail (could not start comms)\n");
+        return false;
+    }
+
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    bool       ret       = qp_internal_aa_palette(device, fg_hsv888, bg_hsv888) && qp_internal_ellipse_aa_impl(device, x, y, sizex, sizey, filled);
+
+    qp_dprintf("qp_ellipse_aa: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
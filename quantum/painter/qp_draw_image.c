@@ -4,12 +4,33 @@
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
+#include "compiler_support.h"
 #include "qgf.h"
-#include "deferred_exec.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QGF image handles
 
+typedef struct qgf_frame_info_t {
+    painter_compression_t compression_scheme;
+    uint8_t               bpp;
+    bool                  has_palette;
+    bool                  is_panel_native;
+    bool                  is_delta;
+    uint16_t              left;
+    uint16_t              top;
+    uint16_t              right;
+    uint16_t              bottom;
+    uint16_t              delay;
+} qgf_frame_info_t;
+
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+typedef struct qgf_frame_index_entry_t {
+    qgf_frame_info_t info;
+    uint32_t         palette_offset; // 0 if the frame has no palette
+    uint32_t         data_offset;    // start of the frame's pixel data
+} qgf_frame_index_entry_t;
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+
 typedef struct qgf_image_handle_t {
     painter_image_desc_t base;
     bool                 validate_ok;
@@ -20,10 +41,17 @@ typedef struct qgf_image_handle_t {
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
     };
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+    qgf_frame_index_entry_t *frame_index; // built when first animated, NULL if not
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
 } qgf_image_handle_t;
 
 static qgf_image_handle_t image_descriptors[QUANTUM_PAINTER_NUM_IMAGES] = {0};
 
+#if QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+static void qp_palette_cache_evict_image(const qgf_image_handle_t *qgf_image);
+#endif // QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load image from stream
 
@@ -98,6 +126,13 @@ bool qp_close_image(painter_image_handle_t image) {
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+    free(qgf_image->frame_index);
+    qgf_image->frame_index = NULL;
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+#if QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+    qp_palette_cache_evict_image(qgf_image);
+#endif // QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
     return true;
 }
 
@@ -109,30 +144,11 @@ bool qp_drawimage(painter_device_t device, uint16_t x, uint16_t y, painter_image
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Quantum Painter External API: qp_drawimage_recolor
-
-typedef struct qgf_frame_info_t {
-    painter_compression_t compression_scheme;
-    uint8_t               bpp;
-    bool                  has_palette;
-    bool                  is_panel_native;
-    bool                  is_delta;
-    uint16_t              left;
-    uint16_t              top;
-    uint16_t              right;
-    uint16_t              bottom;
-    uint16_t              delay;
-} qgf_frame_info_t;
-
-static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
-    painter_driver_t *driver = (painter_driver_t *)device;
-
-    // Drop out if we can't actually place the data we read out anywhere
-    if (!info) {
-        qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
-        return false;
-    }
+// Helper: frame descriptors
 
+// Reads the descriptors of a frame, leaving the stream at the start of its pixel data. Any palette is skipped over, with
+// its offset returned so that it can be loaded only if it isn't already cached.
+static bool qp_drawimage_read_frame_info(qgf_image_handle_t *qgf_image, uint16_t frame_number, qgf_frame_info_t *info, uint32_t *palette_offset) {
     // Seek to the frame
     qgf_seek_to_frame_descriptor(&qgf_image->stream, frame_number);
 
@@ -148,39 +164,16 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
     if (!qp_internal_bpp_capable(info->bpp)) {
         qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
-        qp_comms_stop(device);
         return false;
     }
 
-    // Handle palette if needed
-    const uint16_t palette_entries  = 1u << info->bpp;
-    bool           needs_pixconvert = false;
+    // Skip the palette if present
+    *palette_offset = 0;
     if (info->has_palette) {
-        // Load the palette from the stream
-        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
-            return false;
-        }
-
-        needs_pixconvert = true;
-    } else {
-        if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-        }
-    }
-
-    if (needs_pixconvert) {
-        // Convert the palette to native format
-        if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
-            return false;
-        }
+        *palette_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_seek(&qgf_image->stream, sizeof(qgf_palette_v1_t) + (1u << info->bpp) * sizeof(qgf_palette_entry_v1_t), SEEK_CUR);
     }
 
     // Handle delta if needed
@@ -208,31 +201,231 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     return true;
 }
 
-static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
-    qp_dprintf("qp_drawimage_recolor: entry\n");
-    painter_driver_t *driver = (painter_driver_t *)device;
-    if (!driver || !driver->validate_ok) {
-        qp_dprintf("qp_drawimage_recolor: fail (validation_ok == false)\n");
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: frame index
+
+// Whether two frames have the same palette, so that the later one can reuse the earlier one's once converted
+static bool qp_drawimage_palettes_match(qp_stream_t *stream, uint32_t offset_a, uint32_t offset_b, uint8_t bpp) {
+    for (uint16_t i = 0; i < (1u << bpp); ++i) {
+        qgf_palette_entry_v1_t entry_a, entry_b;
+        qp_stream_setpos(stream, offset_a + sizeof(qgf_palette_v1_t) + i * sizeof(qgf_palette_entry_v1_t));
+        if (qp_stream_read(&entry_a, sizeof(qgf_palette_entry_v1_t), 1, stream) != 1) {
+            return false;
+        }
+        qp_stream_setpos(stream, offset_b + sizeof(qgf_palette_v1_t) + i * sizeof(qgf_palette_entry_v1_t));
+        if (qp_stream_read(&entry_b, sizeof(qgf_palette_entry_v1_t), 1, stream) != 1) {
+            return false;
+        }
+        if (memcmp(&entry_a, &entry_b, sizeof(qgf_palette_entry_v1_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads each frame's descriptors into RAM, leaving the image without an index if they couldn't be
+static void qp_drawimage_build_frame_index(qgf_image_handle_t *qgf_image) {
+    if (qgf_image->frame_index) {
+        return;
+    }
+
+    qgf_frame_index_entry_t *frame_index = malloc(qgf_image->base.frame_count * sizeof(qgf_frame_index_entry_t));
+    if (frame_index == NULL) {
+        qp_dprintf("qp_animate: could not allocate enough RAM for frame index, falling back to image data\n");
+        return;
+    }
+
+    for (uint16_t i = 0; i < qgf_image->base.frame_count; ++i) {
+        qgf_frame_index_entry_t *entry = &frame_index[i];
+        memset(&entry->info, 0, sizeof(qgf_frame_info_t));
+        if (!qp_drawimage_read_frame_info(qgf_image, i, &entry->info, &entry->palette_offset)) {
+            qp_dprintf("qp_animate: could not read frame %d, falling back to image data\n", (int)i);
+            free(frame_index);
+            return;
+        }
+        entry->data_offset = qp_stream_tell(&qgf_image->stream);
+
+        // Animations usually repeat the same palette in every frame, which only needs converting once
+        qgf_frame_index_entry_t *previous = i > 0 ? &frame_index[i - 1] : NULL;
+        if (previous && entry->info.has_palette && previous->info.has_palette && entry->info.bpp == previous->info.bpp && qp_drawimage_palettes_match(&qgf_image->stream, previous->palette_offset, entry->palette_offset, entry->info.bpp)) {
+            entry->palette_offset = previous->palette_offset;
+        }
+    }
+
+    qgf_image->frame_index = frame_index;
+}
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+
+#if QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: palette cache
+//
+// Holds palettes already converted to the native pixel format of the display they were drawn to, so that frames with the
+// same palette as an earlier one skip reading and converting it. Palettes of up to 16 colors are cached.
+
+typedef struct qp_palette_cache_entry_t {
+    painter_device_t          device; // NULL if unused
+    const qgf_image_handle_t *image;
+    uint32_t                  palette_offset; // 0 if interpolated between the foreground and background colors
+    qp_pixel_t                fg_hsv888;
+    qp_pixel_t                bg_hsv888;
+    uint8_t                   bpp;
+    uint32_t                  last_used;
+    qp_pixel_t                palette[16];
+} qp_palette_cache_entry_t;
+
+static qp_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE] = {0};
+static uint32_t                 palette_cache_clock                                         = 0;
+
+static inline bool qp_hsv888_equal(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static qp_palette_cache_entry_t *qp_palette_cache_find(painter_device_t device, const qgf_image_handle_t *qgf_image, uint8_t bpp, uint32_t palette_offset, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE; ++i) {
+        qp_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->device != device || entry->image != qgf_image || entry->bpp != bpp || entry->palette_offset != palette_offset) {
+            continue;
+        }
+        // Palettes from the image don't depend on the colors drawn with
+        if (palette_offset != 0 || (qp_hsv888_equal(entry->fg_hsv888, fg_hsv888) && qp_hsv888_equal(entry->bg_hsv888, bg_hsv888))) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Copies a cached palette into the global lookup table, if there is one
+static bool qp_palette_cache_load(painter_device_t device, const qgf_image_handle_t *qgf_image, uint8_t bpp, uint32_t palette_offset, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_palette_cache_entry_t *entry = qp_palette_cache_find(device, qgf_image, bpp, palette_offset, fg_hsv888, bg_hsv888);
+    if (!entry) {
         return false;
     }
 
-    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
-    if (!qgf_image || !qgf_image->validate_ok) {
-        qp_dprintf("qp_drawimage_recolor: fail (invalid image)\n");
+    // The lookup table no longer holds what was last interpolated into it
+    qp_internal_invalidate_palette();
+    memcpy(qp_internal_global_pixel_lookup_table, entry->palette, sizeof(qp_pixel_t) << bpp);
+    entry->last_used = ++palette_cache_clock;
+    return true;
+}
+
+// Keeps a copy of the converted palette in the global lookup table, evicting the least recently used if full
+static void qp_palette_cache_store(painter_device_t device, const qgf_image_handle_t *qgf_image, uint8_t bpp, uint32_t palette_offset, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    if (bpp > 4) {
+        return;
+    }
+
+    qp_palette_cache_entry_t *victim = &palette_cache[0];
+    for (int i = 0; i < QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE; ++i) {
+        qp_palette_cache_entry_t *entry = &palette_cache[i];
+        if (!entry->device) {
+            victim = entry;
+            break;
+        }
+        if (entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+
+    victim->device         = device;
+    victim->image          = qgf_image;
+    victim->palette_offset = palette_offset;
+    victim->fg_hsv888      = fg_hsv888;
+    victim->bg_hsv888      = bg_hsv888;
+    victim->bpp            = bpp;
+    victim->last_used      = ++palette_cache_clock;
+    memcpy(victim->palette, qp_internal_global_pixel_lookup_table, sizeof(qp_pixel_t) << bpp);
+}
+
+static void qp_palette_cache_evict_image(const qgf_image_handle_t *qgf_image) {
+    for (int i = 0; i < QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE; ++i) {
+        if (palette_cache[i].image == qgf_image) {
+            palette_cache[i].device = NULL;
+        }
+    }
+}
+#endif // QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_drawimage_recolor
+
+// Sets up the global palette for the frame, either from the image or interpolated from fg/bg, in the native format
+static bool qp_drawimage_load_frame_palette(painter_device_t device, qgf_image_handle_t *qgf_image, const qgf_frame_info_t *info, uint32_t palette_offset, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // Native pixels don't use a palette
+    if (!info->has_palette && info->bpp > 8) {
+        return true;
+    }
+
+#if QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+    if (qp_palette_cache_load(device, qgf_image, info->bpp, palette_offset, fg_hsv888, bg_hsv888)) {
+        return true;
+    }
+#endif // QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+
+    // Ensure we aren't reusing any palette
+    qp_internal_invalidate_palette();
+
+    const uint16_t palette_entries = 1u << info->bpp;
+    if (info->has_palette) {
+        // Load the palette from the stream, then return to the pixel data
+        uint32_t data_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_setpos(&qgf_image->stream, palette_offset);
+        bool ok = qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp);
+        qp_stream_setpos(&qgf_image->stream, data_offset);
+        if (!ok) {
+            return false;
+        }
+    } else {
+        // Interpolate from fg/bg
+        qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
+    }
+
+    // Convert the palette to native format
+    if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
         return false;
     }
 
-    // Read the frame info
-    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
+#if QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+    qp_palette_cache_store(device, qgf_image, info->bpp, palette_offset, fg_hsv888, bg_hsv888);
+#endif // QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+    return true;
+}
+
+static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
+    // Drop out if we can't actually place the data we read out anywhere
+    if (!info) {
+        qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
         return false;
     }
 
-    if (!qp_comms_start(device)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
+    uint32_t palette_offset = 0;
+    bool     indexed        = false;
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+    // Frames already indexed can go straight to their pixel data
+    if (qgf_image->frame_index && frame_number < qgf_image->base.frame_count) {
+        const qgf_frame_index_entry_t *entry = &qgf_image->frame_index[frame_number];
+        *info                                = entry->info;
+        palette_offset                       = entry->palette_offset;
+        qp_stream_setpos(&qgf_image->stream, entry->data_offset);
+        indexed = true;
+    }
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+
+    if (!indexed && !qp_drawimage_read_frame_info(qgf_image, frame_number, info, &palette_offset)) {
         return false;
     }
 
+    return qp_drawimage_load_frame_palette(device, qgf_image, info, palette_offset, fg_hsv888, bg_hsv888);
+}
+
+// Sends the pixels of a frame readied by qp_drawimage_prepare_frame_for_stream_read(), with comms already started
+static bool qp_drawimage_stream_frame(painter_device_t device, uint16_t x, uint16_t y, qgf_image_handle_t *qgf_image, const qgf_frame_info_t *frame_info) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
     uint16_t l, t, r, b;
     if (frame_info->is_delta) {
         l = x + frame_info->left;
@@ -242,15 +435,14 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     } else {
         l = x;
         t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
+        r = x + qgf_image->base.width - 1;
+        b = y + qgf_image->base.height - 1;
     }
     uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
 
     // Configure where we're going to be rendering to
     if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
         return false;
     }
 
@@ -259,12 +451,39 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
     if (input_callback == NULL) {
         qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
-        qp_comms_stop(device);
         return false;
     }
 
     // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+    return qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+}
+
+static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_dprintf("qp_drawimage_recolor: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (invalid image)\n");
+        return false;
+    }
+
+    // Read the frame info
+    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool ret = qp_drawimage_stream_frame(device, x, y, qgf_image, frame_info);
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
@@ -288,24 +507,29 @@ deferred_token qp_animate(painter_device_t device, uint16_t x, uint16_t y, paint
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_animate_recolor
 
+STATIC_ASSERT(QUANTUM_PAINTER_CONCURRENT_ANIMATIONS < 255, "QUANTUM_PAINTER_CONCURRENT_ANIMATIONS needs to be less than 255, so that each animation has a unique token");
+
 typedef struct animation_state_t {
-    painter_device_t       device;
+    painter_device_t       device; // NULL if the slot is free
     uint16_t               x;
     uint16_t               y;
     painter_image_handle_t image;
     qp_pixel_t             fg_hsv888;
     qp_pixel_t             bg_hsv888;
     uint16_t               frame_number;
-    deferred_token         defer_token;
+    uint32_t               next_frame_time;
+    deferred_token         token;
 } animation_state_t;
 
-static deferred_executor_t animation_executors[QUANTUM_PAINTER_CONCURRENT_ANIMATIONS] = {0};
-static animation_state_t   animation_states[QUANTUM_PAINTER_CONCURRENT_ANIMATIONS]    = {0};
+static animation_state_t animation_states[QUANTUM_PAINTER_CONCURRENT_ANIMATIONS] = {0};
+static deferred_token    last_animation_token                                   = INVALID_DEFERRED_TOKEN;
 
-static deferred_token qp_render_animation_state(animation_state_t *state, uint16_t *delay_ms) {
-    qgf_frame_info_t frame_info = {0};
+// Draws the current frame and moves on to the next, with comms already started
+static bool qp_render_animation_state(animation_state_t *state, uint16_t *delay_ms) {
+    qgf_frame_info_t    frame_info = {0};
+    qgf_image_handle_t *qgf_image  = (qgf_image_handle_t *)state->image;
     qp_dprintf("qp_render_animation_state: entry (frame #%d)\n", (int)state->frame_number);
-    bool ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+    bool ret = qgf_image && qgf_image->validate_ok && qp_drawimage_prepare_frame_for_stream_read(state->device, qgf_image, state->frame_number, state->fg_hsv888, state->bg_hsv888, &frame_info) && qp_drawimage_stream_frame(state->device, state->x, state->y, qgf_image, &frame_info);
     if (ret) {
         ++state->frame_number;
         if (state->frame_number >= state->image->frame_count) {
@@ -317,16 +541,23 @@ static deferred_token qp_render_animation_state(animation_state_t *state, uint16
     return ret;
 }
 
-static uint32_t animation_callback(uint32_t trigger_time, void *cb_arg) {
-    animation_state_t *state    = (animation_state_t *)cb_arg;
-    uint16_t           delay_ms = 0;
-    bool               ret      = qp_render_animation_state(state, &delay_ms);
-    if (!ret) {
-        // Setting the device to NULL clears the animation slot
-        state->device = NULL;
+// Tokens skip any still held by running animations once they wrap around
+static deferred_token qp_next_animation_token(void) {
+    while (true) {
+        if (++last_animation_token == INVALID_DEFERRED_TOKEN) {
+            continue;
+        }
+        bool in_use = false;
+        for (int i = 0; i < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++i) {
+            if (animation_states[i].device && animation_states[i].token == last_animation_token) {
+                in_use = true;
+                break;
+            }
+        }
+        if (!in_use) {
+            return last_animation_token;
+        }
     }
-    // If we're successful, keep animating -- returning 0 cancels the deferred execution
-    return ret ? delay_ms : 0;
 }
 
 deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
@@ -345,33 +576,50 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
         return INVALID_DEFERRED_TOKEN;
     }
 
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (qgf_image && qgf_image->validate_ok) {
+        qp_drawimage_build_frame_index(qgf_image);
+    }
+#endif // QUANTUM_PAINTER_ANIMATION_FRAME_INDEX
+
     // Prepare the animation state
-    anim_state->device       = device;
     anim_state->x            = x;
     anim_state->y            = y;
     anim_state->image        = image;
     anim_state->fg_hsv888    = (qp_pixel_t){.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     anim_state->bg_hsv888    = (qp_pixel_t){.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
     anim_state->frame_number = 0;
+    anim_state->device       = device;
 
     // Draw the first frame
-    uint16_t delay_ms;
-    if (!qp_render_animation_state(anim_state, &delay_ms)) {
+    uint16_t delay_ms = 0;
+    if (!qp_comms_start(device)) {
+        anim_state->device = NULL; // disregard the allocated animation slot
+        qp_dprintf("qp_animate_recolor: fail (could not start comms)\n");
+        return INVALID_DEFERRED_TOKEN;
+    }
+    bool ret = qp_render_animation_state(anim_state, &delay_ms);
+    qp_comms_stop(device);
+    if (!ret) {
         anim_state->device = NULL; // disregard the allocated animation slot
         qp_dprintf("qp_animate_recolor: fail (could not render first frame)\n");
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Set up the timer
-    anim_state->defer_token = defer_exec_advanced(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, delay_ms, animation_callback, anim_state);
-    if (anim_state->defer_token == INVALID_DEFERRED_TOKEN) {
-        anim_state->device = NULL; // disregard the allocated animation slot
-        qp_dprintf("qp_animate_recolor: fail (could not set up animation executor)\n");
+    // Images without a delay only have the one frame to show
+    if (delay_ms == 0) {
+        anim_state->device = NULL;
+        qp_dprintf("qp_animate_recolor: fail (first frame has no delay)\n");
         return INVALID_DEFERRED_TOKEN;
     }
 
-    qp_dprintf("qp_animate_recolor: ok (deferred token = %d)\n", (int)anim_state->defer_token);
-    return anim_state->defer_token;
+    // Set up the timer
+    anim_state->next_frame_time = timer_read32() + delay_ms;
+    anim_state->token           = qp_next_animation_token();
+
+    qp_dprintf("qp_animate_recolor: ok (token = %d)\n", (int)anim_state->token);
+    return anim_state->token;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -379,8 +627,7 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
 
 void qp_stop_animation(deferred_token anim_token) {
     for (int i = 0; i < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++i) {
-        if (animation_states[i].defer_token == anim_token) {
-            cancel_deferred_exec_advanced(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, anim_token);
+        if (animation_states[i].device && animation_states[i].token == anim_token) {
             animation_states[i].device = NULL;
             return;
         }
@@ -392,5 +639,46 @@ void qp_stop_animation(deferred_token anim_token) {
 
 void qp_internal_animation_tick(void) {
     static uint32_t last_anim_exec = 0;
-    deferred_exec_advanced_task(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, &last_anim_exec);
+    uint32_t        now            = timer_read32();
+    if (now == last_anim_exec) {
+        return;
+    }
+    last_anim_exec = now;
+
+    bool due[QUANTUM_PAINTER_CONCURRENT_ANIMATIONS];
+    for (int i = 0; i < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++i) {
+        due[i] = animation_states[i].device && timer_expired32(now, animation_states[i].next_frame_time);
+    }
+
+    // All the frames due on the same display are sent within one comms session
+    for (int i = 0; i < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++i) {
+        if (!due[i]) {
+            continue;
+        }
+
+        // If comms can't be started, such as while a draw is yielding, the frames stay due until the next tick
+        painter_device_t device  = animation_states[i].device;
+        bool             started = qp_comms_start(device);
+        for (int j = i; j < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++j) {
+            animation_state_t *state = &animation_states[j];
+            if (!due[j] || state->device != device) {
+                continue;
+            }
+            due[j] = false;
+            if (!started) {
+                continue;
+            }
+
+            uint16_t delay_ms = 0;
+            if (qp_render_animation_state(state, &delay_ms) && delay_ms > 0) {
+                state->next_frame_time += delay_ms;
+            } else {
+                // Setting the device to NULL clears the animation slot
+                state->device = NULL;
+            }
+        }
+        if (started) {
+            qp_comms_stop(device);
+        }
+    }
 }
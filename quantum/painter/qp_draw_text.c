@@ -12,6 +12,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QFF font handles
 
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX || QUANTUM_PAINTER_FONT_ATLASES > 0
+typedef struct qff_glyph_index_entry_t {
+    uint32_t code_point;
+    uint32_t value; // Uses QFF_GLYPH_*_(BITS|MASK)
+} qff_glyph_index_entry_t;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX || QUANTUM_PAINTER_FONT_ATLASES > 0
+
 typedef struct qff_font_handle_t {
     painter_font_desc_t   base;
     bool                  validate_ok;
@@ -32,10 +39,137 @@ typedef struct qff_font_handle_t {
     bool  owns_buffer;
     void *buffer;
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    qff_glyph_index_entry_t *glyph_index; // ascii glyphs first if there's an ascii table, then unicode glyphs sorted by code point
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
 } qff_font_handle_t;
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+static void qp_glyph_cache_evict_font(const qff_font_handle_t *qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+static void qp_font_atlas_evict_font(const qff_font_handle_t *qff_font);
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: locating blocks within the font
+
+static inline uint32_t qff_unicode_table_offset(qff_font_handle_t *qff_font) {
+    return sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
+           + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
+           + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
+}
+
+static inline uint32_t qff_glyph_data_offset(qff_font_handle_t *qff_font) {
+    return sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
+           + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
+           + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+           + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
+           + sizeof(qgf_block_header_v1_t);                                                                                                                     // Skip the data block header
+}
+
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX || QUANTUM_PAINTER_FONT_ATLASES > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: glyph tables in RAM
+
+static int qff_glyph_index_compare(const void *a, const void *b) {
+    uint32_t lhs = ((const qff_glyph_index_entry_t *)a)->code_point;
+    uint32_t rhs = ((const qff_glyph_index_entry_t *)b)->code_point;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static inline uint16_t qff_num_glyphs(const qff_font_handle_t *font) {
+    return (font->has_ascii_table ? 95 : 0) + font->num_unicode_glyphs;
+}
+
+// Reads the glyph tables into the supplied array of qff_num_glyphs() entries: ascii glyphs first if there's an ascii
+// table, then unicode glyphs sorted by code point
+static bool qff_read_glyph_table(qff_font_handle_t *font, qff_glyph_index_entry_t *glyph_table) {
+    uint16_t num_ascii_glyphs = font->has_ascii_table ? 95 : 0;
+
+    qp_stream_setpos(&font->stream, sizeof(qff_font_descriptor_v1_t) + sizeof(qgf_block_header_v1_t));
+    for (uint16_t i = 0; i < num_ascii_glyphs; ++i) {
+        qff_ascii_glyph_v1_t glyph_info;
+        if (qp_stream_read(&glyph_info, sizeof(qff_ascii_glyph_v1_t), 1, &font->stream) != 1) {
+            qp_dprintf("qff_read_glyph_table: could not read ascii glyph info\n");
+            return false;
+        }
+        glyph_table[i].code_point = 0x20 + i;
+        glyph_table[i].value      = glyph_info.value;
+    }
+
+    qp_stream_setpos(&font->stream, qff_unicode_table_offset(font));
+    for (uint16_t i = 0; i < font->num_unicode_glyphs; ++i) {
+        qff_unicode_glyph_v1_t glyph_info;
+        if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &font->stream) != 1) {
+            qp_dprintf("qff_read_glyph_table: could not read unicode glyph info\n");
+            return false;
+        }
+        glyph_table[num_ascii_glyphs + i].code_point = glyph_info.code_point;
+        glyph_table[num_ascii_glyphs + i].value      = glyph_info.value;
+    }
+
+    // Sorted, so that unicode glyphs can be found with a binary search
+    qsort(&glyph_table[num_ascii_glyphs], font->num_unicode_glyphs, sizeof(qff_glyph_index_entry_t), qff_glyph_index_compare);
+    return true;
+}
+
+static bool qff_glyph_table_lookup(const qff_font_handle_t *qff_font, const qff_glyph_index_entry_t *glyph_table, uint32_t code_point, uint32_t *value) {
+    uint16_t num_ascii_glyphs = qff_font->has_ascii_table ? 95 : 0;
+    if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
+        *value = glyph_table[code_point - 0x20].value;
+        return true;
+    }
+
+    const qff_glyph_index_entry_t *unicode_glyphs = &glyph_table[num_ascii_glyphs];
+    uint16_t                       lo             = 0;
+    uint16_t                       hi             = qff_font->num_unicode_glyphs;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (unicode_glyphs[mid].code_point < code_point) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < qff_font->num_unicode_glyphs && unicode_glyphs[lo].code_point == code_point) {
+        *value = unicode_glyphs[lo].value;
+        return true;
+    }
+
+    // Not found
+    qp_dprintf("Failed to find unicode glyph info\n");
+    return false;
+}
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX || QUANTUM_PAINTER_FONT_ATLASES > 0
+
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+// Reads the glyph tables into RAM, leaving the font without an index if they couldn't be
+static void qp_load_font_glyph_index(qff_font_handle_t *font) {
+    uint16_t num_glyphs = qff_num_glyphs(font);
+    font->glyph_index   = NULL;
+    if (num_glyphs == 0) {
+        return;
+    }
+
+    qff_glyph_index_entry_t *glyph_index = malloc(num_glyphs * sizeof(qff_glyph_index_entry_t));
+    if (glyph_index == NULL) {
+        qp_dprintf("qp_load_font: could not allocate enough RAM for glyph index, falling back to font data\n");
+        return;
+    }
+
+    if (!qff_read_glyph_table(font, glyph_index)) {
+        qp_dprintf("qp_load_font: could not read glyph tables, falling back to font data\n");
+        free(glyph_index);
+        return;
+    }
+    font->glyph_index = glyph_index;
+}
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -106,6 +240,10 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
         return NULL;
     }
 
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    qp_load_font_glyph_index(font);
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
     // Validation success, we can return the handle
     font->validate_ok = true;
     qp_dprintf("qp_load_font: ok\n");
@@ -151,6 +289,19 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    free(qff_font->glyph_index);
+    qff_font->glyph_index = NULL;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    qp_glyph_cache_evict_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+    qp_font_atlas_evict_font(qff_font);
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -173,6 +324,9 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
         return false;
     }
 
+    // Ensure we aren't reusing any palette, which may have been converted for a different device
+    qp_internal_invalidate_palette();
+
     // Work out where we're reading from
     uint32_t offset = sizeof(qff_font_descriptor_v1_t);
     if (qff_font->has_ascii_table) {
@@ -205,7 +359,6 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
             qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
             return false;
         }
     }
@@ -214,7 +367,14 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
-static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+// Finds the glyph's width and offset within the glyph data
+static inline bool qp_drawtext_lookup_glyph(qff_font_handle_t *qff_font, uint32_t code_point, uint32_t *value) {
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    if (qff_font->glyph_index) {
+        return qff_glyph_table_lookup(qff_font, qff_font->glyph_index, code_point, value);
+    }
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
         qff_ascii_glyph_v1_t glyph_info;
@@ -231,29 +391,11 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
+        *value = glyph_info.value;
         return true;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
-        uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
-                                     + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
-                                     + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
-
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
+        if (qp_stream_setpos(&qff_font->stream, qff_unicode_table_offset(qff_font)) < 0) {
             qp_dprintf("Failed to set stream position while preparing glyph data\n");
             return false;
         }
@@ -266,21 +408,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             }
 
             if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
+                *value = glyph_info.value;
                 return true;
             }
         }
@@ -292,6 +420,22 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
     return false;
 }
 
+static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    uint32_t value;
+    if (!qp_drawtext_lookup_glyph(qff_font, code_point, &value)) {
+        return false;
+    }
+
+    uint32_t glyph_offset = ((value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    if (qp_stream_setpos(&qff_font->stream, qff_glyph_data_offset(qff_font) + glyph_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        return false;
+    }
+
+    *width = (uint8_t)(value & QFF_GLYPH_WIDTH_MASK);
+    return true;
+}
+
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
 static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
     while (*str) {
@@ -334,6 +478,331 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Decoding glyphs into native pixel buffers
+
+// Writes a glyph's pixels into a buffer of native pixels, which may be wider than the glyph
+typedef struct qp_native_writer_state_t {
+    painter_device_t device;
+    uint8_t *        buffer;
+    uint16_t         stride; // pixels per row of the buffer
+    uint16_t         left;   // column of the buffer the glyph starts at
+    uint8_t          width;
+    uint32_t         write_pos; // pixels, or bytes of native pixel data, written so far
+    uint8_t          span_length;
+    uint8_t          span[QUANTUM_PAINTER_DECODE_SPAN_SIZE];
+} qp_native_writer_state_t;
+
+static bool qp_native_writer_flush(qp_native_writer_state_t *state, qp_pixel_t *palette) {
+    painter_driver_t *driver  = (painter_driver_t *)state->device;
+    uint8_t *         indices = state->span;
+    while (state->span_length > 0) {
+        // Convert up to the end of each row of the glyph in one go
+        uint32_t row    = state->write_pos / state->width;
+        uint32_t column = state->write_pos % state->width;
+        uint32_t count  = QP_MIN((uint32_t)state->span_length, state->width - column);
+        if (!driver->driver_vtable->append_pixels(state->device, state->buffer, palette, row * state->stride + state->left + column, count, indices)) {
+            return false;
+        }
+        state->write_pos += count;
+        state->span_length -= count;
+        indices += count;
+    }
+    return true;
+}
+
+static bool qp_native_writer_pixel(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_native_writer_state_t *state = (qp_native_writer_state_t *)cb_arg;
+    state->span[state->span_length++] = index;
+    return state->span_length < sizeof(state->span) || qp_native_writer_flush(state, palette);
+}
+
+static bool qp_native_writer_byte(uint8_t byteval, void *cb_arg) {
+    qp_native_writer_state_t *state           = (qp_native_writer_state_t *)cb_arg;
+    painter_driver_t *        driver          = (painter_driver_t *)state->device;
+    uint8_t                   bytes_per_pixel = driver->native_bits_per_pixel / 8;
+    uint32_t                  pixel           = state->write_pos / bytes_per_pixel;
+    uint32_t                  target_pixel    = (pixel / state->width) * state->stride + state->left + (pixel % state->width);
+    state->buffer[target_pixel * bytes_per_pixel + state->write_pos % bytes_per_pixel] = byteval;
+    state->write_pos++;
+    return true;
+}
+
+// Decodes the glyph at the current stream position into a buffer of native pixels
+static bool qp_drawtext_decode_glyph(painter_device_t device, qff_font_handle_t *qff_font, uint8_t width, uint8_t height, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t *input_state, uint8_t *buffer, uint16_t stride, uint16_t left) {
+    painter_driver_t *       driver      = (painter_driver_t *)device;
+    uint32_t                 pixel_count = ((uint32_t)width) * height;
+    qp_native_writer_state_t state       = {.device = device, .buffer = buffer, .stride = stride, .left = left, .width = width, .write_pos = 0, .span_length = 0};
+
+    // Reset the input state's RLE mode, as each glyph is compressed separately
+    input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+
+    if (qff_font->bpp <= 8) {
+        return qp_internal_decode_palette(device, pixel_count, qff_font->bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_native_writer_pixel, &state) && qp_native_writer_flush(&state, qp_internal_global_pixel_lookup_table);
+    }
+    if (qff_font->bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("Font's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", qff_font->bpp, driver->native_bits_per_pixel);
+        return false;
+    }
+    return qp_internal_send_bytes(device, pixel_count * qff_font->bpp / 8, input_callback, input_state, qp_native_writer_byte, &state);
+}
+
+// Sends native pixels to the current viewport, a pixdata buffer at a time
+static bool qp_drawtext_send_native(painter_device_t device, const uint8_t *pixdata, uint32_t pixel_count) {
+    painter_driver_t *driver     = (painter_driver_t *)device;
+    uint32_t          max_pixels = qp_internal_num_pixels_in_buffer(device);
+    while (pixel_count > 0) {
+        uint32_t count = QP_MIN(pixel_count, max_pixels);
+        uint32_t bytes = (count * driver->native_bits_per_pixel + 7) / 8;
+        memcpy(qp_internal_global_pixdata_buffer, pixdata, bytes);
+        if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, count)) {
+            return false;
+        }
+        if (!qp_internal_pixdata_sent(true)) {
+            return false;
+        }
+        pixdata += bytes;
+        pixel_count -= count;
+    }
+    return true;
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0 || QUANTUM_PAINTER_FONT_ATLASES > 0
+// Key for the colors glyphs were decoded with, so that they're only reused for the same colors
+static inline uint32_t qp_drawtext_color_key(qp_pixel_t color) {
+    return ((uint32_t)color.hsv888.h << 16) | ((uint32_t)color.hsv888.s << 8) | color.hsv888.v;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0 || QUANTUM_PAINTER_FONT_ATLASES > 0
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+STATIC_ASSERT(QUANTUM_PAINTER_GLYPH_CACHE_SIZE <= UINT16_MAX, "QUANTUM_PAINTER_GLYPH_CACHE_SIZE must be at most 65535 bytes");
+STATIC_ASSERT(QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0 && QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES <= UINT8_MAX, "QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES must be between 1 and 255");
+
+typedef struct qp_glyph_cache_entry_t {
+    const qff_font_handle_t *font;
+    painter_device_t         device;
+    uint32_t                 code_point;
+    uint32_t                 fg; // hsv888 of the colours the glyph was drawn with, zero if the font has its own palette
+    uint32_t                 bg;
+    uint32_t                 last_used;
+    uint16_t                 offset; // of the glyph's native pixels within the cache data
+    uint16_t                 length;
+} qp_glyph_cache_entry_t;
+
+// Entries are kept in the same order as their data, which is packed from the start of the cache
+static qp_glyph_cache_entry_t                  glyph_cache_entries[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES];
+__attribute__((__aligned__(4))) static uint8_t glyph_cache_data[QUANTUM_PAINTER_GLYPH_CACHE_SIZE];
+static uint8_t                                 glyph_cache_count = 0;
+static uint16_t                                glyph_cache_used  = 0;
+static uint32_t                                glyph_cache_clock = 0;
+
+static void qp_glyph_cache_remove(uint8_t index) {
+    qp_glyph_cache_entry_t *entry  = &glyph_cache_entries[index];
+    uint16_t                length = entry->length;
+    uint16_t                end    = entry->offset + length;
+
+    // Close the gap in the data, then the entries
+    memmove(&glyph_cache_data[entry->offset], &glyph_cache_data[end], glyph_cache_used - end);
+    for (uint8_t i = index + 1; i < glyph_cache_count; ++i) {
+        glyph_cache_entries[i].offset -= length;
+    }
+    memmove(entry, entry + 1, (glyph_cache_count - index - 1) * sizeof(qp_glyph_cache_entry_t));
+    glyph_cache_count--;
+    glyph_cache_used -= length;
+}
+
+static void qp_glyph_cache_evict_font(const qff_font_handle_t *qff_font) {
+    for (uint8_t i = glyph_cache_count; i > 0; --i) {
+        if (glyph_cache_entries[i - 1].font == qff_font) {
+            qp_glyph_cache_remove(i - 1);
+        }
+    }
+}
+
+// Finds the glyph in the cache, decoding it into the cache if it isn't there. Returns false if decoding failed, and
+// sets the entry to NULL if the glyph can't be cached, leaving the stream where it was.
+static bool qp_glyph_cache_get(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, uint32_t fg, uint32_t bg, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t *input_state, const qp_glyph_cache_entry_t **out) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (qff_font->has_palette) {
+        fg = bg = 0;
+    }
+
+    glyph_cache_clock++;
+    for (uint8_t i = 0; i < glyph_cache_count; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache_entries[i];
+        if (entry->font == qff_font && entry->device == device && entry->code_point == code_point && entry->fg == fg && entry->bg == bg) {
+            entry->last_used = glyph_cache_clock;
+            *out             = entry;
+            return true;
+        }
+    }
+
+    uint32_t length = QP_TEXT_SPRITE_BUFFER_SIZE((uint32_t)width, height, driver->native_bits_per_pixel);
+    if (length == 0 || length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        *out = NULL;
+        return true;
+    }
+
+    // Make room by evicting the least recently used glyphs
+    while (glyph_cache_count == QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES || glyph_cache_used + length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        uint8_t oldest = 0;
+        for (uint8_t i = 1; i < glyph_cache_count; ++i) {
+            if (glyph_cache_entries[i].last_used < glyph_cache_entries[oldest].last_used) {
+                oldest = i;
+            }
+        }
+        qp_glyph_cache_remove(oldest);
+    }
+
+    if (!qp_drawtext_decode_glyph(device, qff_font, width, height, input_callback, input_state, &glyph_cache_data[glyph_cache_used], width, 0)) {
+        return false;
+    }
+
+    qp_glyph_cache_entry_t *entry = &glyph_cache_entries[glyph_cache_count++];
+    entry->font                   = qff_font;
+    entry->device                 = device;
+    entry->code_point             = code_point;
+    entry->fg                     = fg;
+    entry->bg                     = bg;
+    entry->last_used              = glyph_cache_clock;
+    entry->offset                 = glyph_cache_used;
+    entry->length                 = length;
+    glyph_cache_used += length;
+    *out = entry;
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Font atlases
+
+STATIC_ASSERT(QUANTUM_PAINTER_FONT_ATLASES <= UINT8_MAX, "QUANTUM_PAINTER_FONT_ATLASES must be at most 255");
+STATIC_ASSERT(QUANTUM_PAINTER_FONT_ATLAS_SIZE <= (1UL << QFF_GLYPH_OFFSET_BITS), "QUANTUM_PAINTER_FONT_ATLAS_SIZE must be at most 262144 bytes");
+
+// Every glyph of a font, decoded into the native pixel format of a device with a given pair of colors. A single
+// allocation holds the glyph table, laid out as the font's glyph index but with offsets into the atlas's pixel data,
+// followed by each glyph's native pixels.
+typedef struct qp_font_atlas_t {
+    const qff_font_handle_t *font;
+    painter_device_t         device;
+    uint32_t                 fg; // hsv888 of the colors the glyphs were decoded with, zero if the font has its own palette
+    uint32_t                 bg;
+    uint32_t                 last_used;
+    uint32_t                 size; // bytes allocated
+    qff_glyph_index_entry_t *glyphs;
+    uint8_t *                data;
+} qp_font_atlas_t;
+
+static qp_font_atlas_t font_atlases[QUANTUM_PAINTER_FONT_ATLASES];
+static uint32_t        font_atlas_used  = 0;
+static uint32_t        font_atlas_clock = 0;
+
+static void qp_font_atlas_free(qp_font_atlas_t *atlas) {
+    free(atlas->glyphs);
+    font_atlas_used -= atlas->size;
+    memset(atlas, 0, sizeof(qp_font_atlas_t));
+}
+
+static void qp_font_atlas_evict_font(const qff_font_handle_t *qff_font) {
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_FONT_ATLASES; ++i) {
+        if (font_atlases[i].glyphs && font_atlases[i].font == qff_font) {
+            qp_font_atlas_free(&font_atlases[i]);
+        }
+    }
+}
+
+// Finds the atlas for the font, device and colors, marking it as used
+static qp_font_atlas_t *qp_font_atlas_find(painter_device_t device, const qff_font_handle_t *qff_font, uint32_t fg, uint32_t bg) {
+    if (qff_font->has_palette) {
+        fg = bg = 0;
+    }
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_FONT_ATLASES; ++i) {
+        qp_font_atlas_t *atlas = &font_atlases[i];
+        if (atlas->glyphs && atlas->font == qff_font && atlas->device == device && atlas->fg == fg && atlas->bg == bg) {
+            atlas->last_used = ++font_atlas_clock;
+            return atlas;
+        }
+    }
+    return NULL;
+}
+
+// Evicts the least recently used atlases until there's a free slot with room for size bytes
+static qp_font_atlas_t *qp_font_atlas_make_room(uint32_t size) {
+    while (true) {
+        qp_font_atlas_t *free_slot = NULL;
+        qp_font_atlas_t *oldest    = NULL;
+        for (uint8_t i = 0; i < QUANTUM_PAINTER_FONT_ATLASES; ++i) {
+            qp_font_atlas_t *atlas = &font_atlases[i];
+            if (!atlas->glyphs) {
+                free_slot = atlas;
+            } else if (!oldest || atlas->last_used < oldest->last_used) {
+                oldest = atlas;
+            }
+        }
+        if (free_slot && font_atlas_used + size <= QUANTUM_PAINTER_FONT_ATLAS_SIZE) {
+            return free_slot;
+        }
+        qp_font_atlas_free(oldest);
+    }
+}
+
+// Decodes every glyph of the font into the atlas data, rewriting each glyph's offset to where it ends up
+static bool qp_font_atlas_decode(painter_device_t device, qff_font_handle_t *qff_font, qff_glyph_index_entry_t *glyphs, uint8_t *data) {
+    painter_driver_t *              driver         = (painter_driver_t *)device;
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_font_atlas_render: fail (invalid font compression scheme)\n");
+        return false;
+    }
+
+    uint32_t offset = 0;
+    for (uint16_t i = 0; i < qff_num_glyphs(qff_font); ++i) {
+        uint8_t  width        = glyphs[i].value & QFF_GLYPH_WIDTH_MASK;
+        uint32_t glyph_offset = (glyphs[i].value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS;
+        if (qp_stream_setpos(&qff_font->stream, qff_glyph_data_offset(qff_font) + glyph_offset) < 0 || !qp_drawtext_decode_glyph(device, qff_font, width, qff_font->base.line_height, input_callback, &input_state, &data[offset], width, 0)) {
+            qp_dprintf("qp_font_atlas_render: fail (could not decode glyph)\n");
+            return false;
+        }
+        glyphs[i].value = (offset << QFF_GLYPH_WIDTH_BITS) | width;
+        offset += QP_TEXT_SPRITE_BUFFER_SIZE((uint32_t)width, qff_font->base.line_height, driver->native_bits_per_pixel);
+    }
+    return true;
+}
+
+// Draws each glyph straight from the atlas, advancing xpos past it
+static bool qp_font_atlas_drawtext(painter_device_t device, const qp_font_atlas_t *atlas, int16_t *xpos, uint16_t y, const char *str) {
+    painter_driver_t *       driver   = (painter_driver_t *)device;
+    const qff_font_handle_t *qff_font = atlas->font;
+    uint8_t                  height   = qff_font->base.line_height;
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+        if (code_point < 0) {
+            qp_dprintf("Invalid unicode code point decoded. Cannot render.\n");
+            return false;
+        }
+
+        uint32_t value;
+        if (!qff_glyph_table_lookup(qff_font, atlas->glyphs, code_point, &value)) {
+            return false;
+        }
+
+        uint8_t width = value & QFF_GLYPH_WIDTH_MASK;
+        driver->driver_vtable->viewport(device, *xpos, y, *xpos + width - 1, y + height - 1);
+        if (!qp_drawtext_send_native(device, &atlas->data[(value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS], ((uint32_t)width) * height)) {
+            return false;
+        }
+        *xpos += width;
+    }
+    return true;
+}
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String drawing implementation
 
@@ -345,6 +814,10 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    uint32_t fg;
+    uint32_t bg;
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
@@ -352,6 +825,19 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Send the glyph from the cache, decoding it into the cache first if need be
+    const qp_glyph_cache_entry_t *entry;
+    if (!qp_glyph_cache_get(state->device, qff_font, code_point, width, height, state->fg, state->bg, state->input_callback, state->input_state, &entry)) {
+        return false;
+    }
+    if (entry) {
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+        state->xpos += width;
+        return qp_drawtext_send_native(state->device, &glyph_cache_data[entry->offset], ((uint32_t)width) * height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
@@ -411,11 +897,26 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_drawtext_recolor: fail (could not start comms)\n");
         return 0;
     }
 
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+    // Copy the glyphs straight out of the atlas for these colors, if one has been rendered
+    qp_font_atlas_t *atlas = qp_font_atlas_find(device, qff_font, qp_drawtext_color_key(fg_hsv888), qp_drawtext_color_key(bg_hsv888));
+    if (atlas) {
+        int16_t xpos = x;
+        bool    ok   = qp_font_atlas_drawtext(device, atlas, &xpos, y, str);
+        qp_dprintf("qp_drawtext_recolor: %s\n", ok ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ok ? (xpos - x) : 0;
+    }
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+
     // Set up the byte input state and input callback
     qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
     qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
@@ -439,15 +940,18 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                // Output
                                                .output_state = &output_state};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
+    uint32_t data_offset;
     if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
         qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
         qp_comms_stop(device);
         return false;
     }
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    state.fg = qp_drawtext_color_key(fg_hsv888);
+    state.bg = qp_drawtext_color_key(bg_hsv888);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
 
@@ -455,3 +959,201 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     qp_comms_stop(device);
     return ret ? (state.xpos - x) : 0;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_text_sprite_render
+
+// Callback state
+typedef struct code_point_iter_sprite_state_t {
+    painter_device_t                device;
+    painter_text_sprite_t *         sprite;
+    uint16_t                        xpos;
+    qp_internal_byte_input_callback input_callback;
+    qp_internal_byte_input_state_t *input_state;
+} code_point_iter_sprite_state_t;
+
+// Codepoint handler callback: rendering into a sprite
+static inline bool qp_font_code_point_handler_sprite(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+    code_point_iter_sprite_state_t *state = (code_point_iter_sprite_state_t *)cb_arg;
+
+    // Decode the glyph alongside the previous one
+    bool ok = qp_drawtext_decode_glyph(state->device, qff_font, width, height, state->input_callback, state->input_state, state->sprite->buffer, state->sprite->width, state->xpos);
+    state->xpos += width;
+    return ok;
+}
+
+int16_t qp_text_sprite_render(painter_device_t device, painter_text_sprite_t *sprite, void *buffer, uint32_t buffer_size, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_dprintf("qp_text_sprite_render: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok || !sprite) {
+        qp_dprintf("qp_text_sprite_render: fail (validation_ok == false)\n");
+        return 0;
+    }
+
+    qff_font_handle_t *qff_font = (qff_font_handle_t *)font;
+    if (!qff_font || !qff_font->validate_ok) {
+        qp_dprintf("qp_text_sprite_render: fail (invalid font)\n");
+        return 0;
+    }
+
+    int16_t width = qp_textwidth(font, str);
+    if (width <= 0 || buffer_size < QP_TEXT_SPRITE_BUFFER_SIZE((uint32_t)width, qff_font->base.line_height, driver->native_bits_per_pixel)) {
+        qp_dprintf("qp_text_sprite_render: fail (empty string, or buffer too small)\n");
+        return 0;
+    }
+
+    sprite->width  = width;
+    sprite->height = qff_font->base.line_height;
+    sprite->bpp    = driver->native_bits_per_pixel;
+    sprite->buffer = buffer;
+
+    // Set up the byte input state and input callback
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_text_sprite_render: fail (invalid font compression scheme)\n");
+        return 0;
+    }
+
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    uint32_t   data_offset;
+    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
+        qp_dprintf("qp_text_sprite_render: fail (failed to prepare font for rendering)\n");
+        return 0;
+    }
+
+    // Iterate the codepoints with the sprite callback
+    code_point_iter_sprite_state_t state = {.device = device, .sprite = sprite, .xpos = 0, .input_callback = input_callback, .input_state = &input_state};
+    bool                           ret   = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_sprite, &state);
+
+    qp_dprintf("qp_text_sprite_render: %s\n", ret ? "ok" : "fail");
+    return ret ? width : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_text_sprite_draw
+
+bool qp_text_sprite_draw(painter_device_t device, const painter_text_sprite_t *sprite, uint16_t x, uint16_t y) {
+    qp_dprintf("qp_text_sprite_draw: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_text_sprite_draw: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!sprite || !sprite->buffer || sprite->bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("qp_text_sprite_draw: fail (sprite not rendered for this device's pixel format)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_text_sprite_draw: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool ret = driver->driver_vtable->viewport(device, x, y, x + sprite->width - 1, y + sprite->height - 1) && qp_drawtext_send_native(device, sprite->buffer, ((uint32_t)sprite->width) * sprite->height);
+
+    qp_dprintf("qp_text_sprite_draw: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_font_atlas_render
+
+bool qp_font_atlas_render(painter_device_t device, painter_font_handle_t font, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_dprintf("qp_font_atlas_render: entry\n");
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_font_atlas_render: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qff_font_handle_t *qff_font = (qff_font_handle_t *)font;
+    if (!qff_font || !qff_font->validate_ok) {
+        qp_dprintf("qp_font_atlas_render: fail (invalid font)\n");
+        return false;
+    }
+
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    uint32_t   fg        = qp_drawtext_color_key(fg_hsv888);
+    uint32_t   bg        = qp_drawtext_color_key(bg_hsv888);
+    if (qp_font_atlas_find(device, qff_font, fg, bg)) {
+        qp_dprintf("qp_font_atlas_render: ok (already rendered)\n");
+        return true;
+    }
+
+    uint16_t num_glyphs = qff_num_glyphs(qff_font);
+    uint32_t table_size = num_glyphs * sizeof(qff_glyph_index_entry_t);
+    if (num_glyphs == 0 || table_size > QUANTUM_PAINTER_FONT_ATLAS_SIZE) {
+        qp_dprintf("qp_font_atlas_render: fail (font too large)\n");
+        return false;
+    }
+
+    // Read the glyph tables first, to work out how much room the glyphs need
+    qff_glyph_index_entry_t *glyphs = malloc(table_size);
+    if (glyphs == NULL) {
+        qp_dprintf("qp_font_atlas_render: fail (could not allocate RAM for glyph table)\n");
+        return false;
+    }
+    if (!qff_read_glyph_table(qff_font, glyphs)) {
+        free(glyphs);
+        return false;
+    }
+    uint32_t size = table_size;
+    for (uint16_t i = 0; i < num_glyphs; ++i) {
+        size += QP_TEXT_SPRITE_BUFFER_SIZE((uint32_t)(glyphs[i].value & QFF_GLYPH_WIDTH_MASK), qff_font->base.line_height, driver->native_bits_per_pixel);
+    }
+    if (size > QUANTUM_PAINTER_FONT_ATLAS_SIZE) {
+        qp_dprintf("qp_font_atlas_render: fail (atlas needs %u bytes, more than QUANTUM_PAINTER_FONT_ATLAS_SIZE)\n", (unsigned)size);
+        free(glyphs);
+        return false;
+    }
+
+    // Evict the least recently used atlases to make room, then grow the table to hold the glyphs as well
+    qp_font_atlas_t         *atlas  = qp_font_atlas_make_room(size);
+    qff_glyph_index_entry_t *buffer = realloc(glyphs, size);
+    if (buffer == NULL) {
+        qp_dprintf("qp_font_atlas_render: fail (could not allocate RAM for glyphs)\n");
+        free(glyphs);
+        return false;
+    }
+    glyphs = buffer;
+
+    // Ensure we aren't reusing any palette, then convert it for this device as text drawing would
+    uint32_t data_offset;
+    if (!qp_drawtext_prepare_font_for_render(device, qff_font, fg_hsv888, bg_hsv888, &data_offset) || !qp_font_atlas_decode(device, qff_font, glyphs, (uint8_t *)glyphs + table_size)) {
+        free(glyphs);
+        return false;
+    }
+
+    atlas->font      = qff_font;
+    atlas->device    = device;
+    atlas->fg        = qff_font->has_palette ? 0 : fg;
+    atlas->bg        = qff_font->has_palette ? 0 : bg;
+    atlas->last_used = ++font_atlas_clock;
+    atlas->size      = size;
+    atlas->glyphs    = glyphs;
+    atlas->data      = (uint8_t *)glyphs + table_size;
+    font_atlas_used += size;
+    qp_dprintf("qp_font_atlas_render: ok (%u bytes)\n", (unsigned)size);
+    return true;
+#else
+    qp_dprintf("qp_font_atlas_render: fail (QUANTUM_PAINTER_FONT_ATLASES is 0)\n");
+    return false;
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_font_atlas_bytes_used
+
+uint32_t qp_font_atlas_bytes_used(void) {
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+    return font_atlas_used;
+#else
+    return 0;
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
+}
@@ -17,6 +17,7 @@ typedef bool (*painter_driver_pixdata_func)(painter_device_t device, const void
 typedef bool (*painter_driver_convert_palette_func)(painter_device_t device, int16_t palette_size, qp_pixel_t *palette);
 typedef bool (*painter_driver_append_pixels)(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices);
 typedef bool (*painter_driver_append_pixdata)(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
+typedef bool (*painter_driver_append_pixel_run)(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index);
 
 // Driver vtable definition
 typedef struct painter_driver_vtable_t {
@@ -29,6 +30,7 @@ typedef struct painter_driver_vtable_t {
     painter_driver_convert_palette_func palette_convert;
     painter_driver_append_pixels        append_pixels;
     painter_driver_append_pixdata       append_pixdata;
+    painter_driver_append_pixel_run     append_pixel_run; // optional, fills pixel_count pixels with the same palette index
 } painter_driver_vtable_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +46,7 @@ typedef struct painter_comms_vtable_t {
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_send_func  comms_send_async; // optional, returns before the data has been sent
 } painter_comms_vtable_t;
 
 typedef bool (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
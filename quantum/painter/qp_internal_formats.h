@@ -49,4 +49,4 @@ typedef enum qp_image_format_t {
     RGB888_24BPP   = 0x09, // Natively streamed to the panel, no interpolation or palette handling
 } qp_image_format_t;
 
-typedef enum painter_compression_t { IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE } painter_compression_t;
+typedef enum painter_compression_t { IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE, IMAGE_COMPRESSED_LZ } painter_compression_t;
@@ -57,6 +57,10 @@
 #    include "process_midi.h"
 #endif
 
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+#    include "nvm_commit_queue.h"
+#endif
+
 #if !defined(NO_ACTION_LAYER)
 #    include "process_default_layer.h"
 #endif
@@ -235,6 +239,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+    nvm_commit_queue_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -533,6 +540,11 @@ void suspend_power_down_quantum(void) {
     pointing_device_task();
 #    endif
 #endif
+
+#ifdef NVM_COMMIT_QUEUE_ENABLE
+    // Power may be cut while suspended, don't leave updates in RAM
+    nvm_commit_queue_flush();
+#endif
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
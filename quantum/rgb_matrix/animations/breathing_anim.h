@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_BREATHING
-RGB_MATRIX_EFFECT(BREATHING)
+RGB_MATRIX_EFFECT(BREATHING, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 hsv_t BREATHING_math(hsv_t hsv, uint8_t i, uint8_t time) {
@@ -7,9 +7,25 @@ hsv_t BREATHING_math(hsv_t hsv, uint8_t i, uint8_t time) {
     return hsv;
 }
 
+#        ifdef RGB_MATRIX_COLOR16_ENABLE
+// Same curve as BREATHING_math, evaluated with a 16-bit phase and brightness so the dim end of the fade is smooth
+bool BREATHING(effect_params_t* params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint16_t phase = (uint16_t)g_rgb_timer * qadd8(rgb_matrix_config.speed / 4, 1);
+    uint16_t level = abs(sin16(phase / 2)) * 2;
+    rgb16_t  rgb   = hsv_to_rgb16(rgb_matrix_config.hsv.h, rgb_matrix_config.hsv.s, ((uint32_t)level * (rgb_matrix_config.hsv.v + 1)) >> 8);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color16(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+#        else
 bool BREATHING(effect_params_t* params) {
     return effect_runner_i(params, &BREATHING_math);
 }
+#        endif // RGB_MATRIX_COLOR16_ENABLE
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 #endif     // ENABLE_RGB_MATRIX_BREATHING
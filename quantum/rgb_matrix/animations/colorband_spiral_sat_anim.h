@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT
-RGB_MATRIX_EFFECT(BAND_SPIRAL_SAT)
+RGB_MATRIX_EFFECT(BAND_SPIRAL_SAT, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t BAND_SPIRAL_SAT_math(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint8_t time) {
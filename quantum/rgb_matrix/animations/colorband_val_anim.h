@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_BAND_VAL
-RGB_MATRIX_EFFECT(BAND_VAL)
+RGB_MATRIX_EFFECT(BAND_VAL, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t BAND_VAL_math(hsv_t hsv, uint8_t i, uint8_t time) {
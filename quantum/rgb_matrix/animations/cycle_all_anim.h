@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_CYCLE_ALL
-RGB_MATRIX_EFFECT(CYCLE_ALL)
+RGB_MATRIX_EFFECT(CYCLE_ALL, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t CYCLE_ALL_math(hsv_t hsv, uint8_t i, uint8_t time) {
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_CYCLE_OUT_IN
-RGB_MATRIX_EFFECT(CYCLE_OUT_IN)
+RGB_MATRIX_EFFECT(CYCLE_OUT_IN, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t CYCLE_OUT_IN_math(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint8_t time) {
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_CYCLE_PINWHEEL
-RGB_MATRIX_EFFECT(CYCLE_PINWHEEL)
+RGB_MATRIX_EFFECT(CYCLE_PINWHEEL, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t CYCLE_PINWHEEL_math(hsv_t hsv, int16_t dx, int16_t dy, uint8_t time) {
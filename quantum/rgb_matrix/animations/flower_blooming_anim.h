@@ -15,7 +15,7 @@
  */
 
 #ifdef ENABLE_RGB_MATRIX_FLOWER_BLOOMING
-RGB_MATRIX_EFFECT(FLOWER_BLOOMING)
+RGB_MATRIX_EFFECT(FLOWER_BLOOMING, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 typedef hsv_t (*flower_blooming_f)(hsv_t hsv, uint8_t i, uint8_t time);
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_HUE_BREATHING
-RGB_MATRIX_EFFECT(HUE_BREATHING)
+RGB_MATRIX_EFFECT(HUE_BREATHING, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // Hue Breathing - All LED's light up
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_HUE_WAVE
-RGB_MATRIX_EFFECT(HUE_WAVE)
+RGB_MATRIX_EFFECT(HUE_WAVE, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // Change huedelta to adjust range of hue change. 0-255.
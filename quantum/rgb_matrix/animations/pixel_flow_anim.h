@@ -2,7 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0+
 
 #ifdef ENABLE_RGB_MATRIX_PIXEL_FLOW
-RGB_MATRIX_EFFECT(PIXEL_FLOW)
+RGB_MATRIX_EFFECT(PIXEL_FLOW, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static bool PIXEL_FLOW(effect_params_t* params) {
@@ -10,6 +10,9 @@ static bool PIXEL_FLOW(effect_params_t* params) {
     static rgb_t led[RGB_MATRIX_LED_COUNT];
 
     static uint32_t wait_timer = 0;
+    if (params->init) {
+        wait_timer = 0;
+    }
     if (wait_timer > g_rgb_timer) {
         return false;
     }
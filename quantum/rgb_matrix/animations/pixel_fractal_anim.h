@@ -3,7 +3,7 @@
 // Inspired by 4x12 fractal from @GEIGEIGEIST
 
 #ifdef ENABLE_RGB_MATRIX_PIXEL_FRACTAL
-RGB_MATRIX_EFFECT(PIXEL_FRACTAL)
+RGB_MATRIX_EFFECT(PIXEL_FRACTAL, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static bool PIXEL_FRACTAL(effect_params_t* params) {
@@ -21,6 +21,8 @@ static bool PIXEL_FRACTAL(effect_params_t* params) {
 
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
+        memset(led, 0, sizeof(led));
+        wait_timer = 0;
     }
 
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
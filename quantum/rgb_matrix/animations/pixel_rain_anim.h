@@ -2,13 +2,18 @@
 // SPDX-License-Identifier: GPL-2.0+
 
 #ifdef ENABLE_RGB_MATRIX_PIXEL_RAIN
-RGB_MATRIX_EFFECT(PIXEL_RAIN)
+RGB_MATRIX_EFFECT(PIXEL_RAIN, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static bool PIXEL_RAIN(effect_params_t* params) {
     static fast_timer_t timer = 0;
     static uint16_t     index = RGB_MATRIX_LED_COUNT + 1;
 
+    if (params->init) {
+        timer = timer_read_fast();
+        index = RGB_MATRIX_LED_COUNT + 1;
+    }
+
     if ((params->iter == 0) && (timer_elapsed_fast(timer) > (320 - rgb_matrix_config.speed))) {
         index = random8_max(RGB_MATRIX_LED_COUNT);
         timer = timer_read_fast();
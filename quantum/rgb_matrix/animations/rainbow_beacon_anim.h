@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_RAINBOW_BEACON
-RGB_MATRIX_EFFECT(RAINBOW_BEACON)
+RGB_MATRIX_EFFECT(RAINBOW_BEACON, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t RAINBOW_BEACON_math(hsv_t hsv, int8_t sin, int8_t cos, uint8_t i, uint8_t time) {
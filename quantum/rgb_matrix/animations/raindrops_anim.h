@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_RAINDROPS
-RGB_MATRIX_EFFECT(RAINDROPS)
+RGB_MATRIX_EFFECT(RAINDROPS, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static void raindrops_set_color(uint8_t i, effect_params_t* params) {
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_RIVERFLOW
-RGB_MATRIX_EFFECT(RIVERFLOW)
+RGB_MATRIX_EFFECT(RIVERFLOW, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // inspired by @PleasureTek's Massdrop Alt LED animation
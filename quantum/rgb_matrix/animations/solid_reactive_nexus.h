@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_NEXUS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_NEXUS, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTINEXUS)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTINEXUS, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
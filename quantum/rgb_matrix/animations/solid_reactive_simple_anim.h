@@ -1,6 +1,6 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 #    ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
-RGB_MATRIX_EFFECT(SOLID_REACTIVE_SIMPLE)
+RGB_MATRIX_EFFECT(SOLID_REACTIVE_SIMPLE, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t SOLID_REACTIVE_SIMPLE_math(hsv_t hsv, uint16_t offset) {
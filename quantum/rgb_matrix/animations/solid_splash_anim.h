@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SOLID_SPLASH) || defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH)
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
-RGB_MATRIX_EFFECT(SOLID_SPLASH)
+RGB_MATRIX_EFFECT(SOLID_SPLASH, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
-RGB_MATRIX_EFFECT(SOLID_MULTISPLASH)
+RGB_MATRIX_EFFECT(SOLID_MULTISPLASH, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
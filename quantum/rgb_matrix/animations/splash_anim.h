@@ -2,11 +2,11 @@
 #    if defined(ENABLE_RGB_MATRIX_SPLASH) || defined(ENABLE_RGB_MATRIX_MULTISPLASH)
 
 #        ifdef ENABLE_RGB_MATRIX_SPLASH
-RGB_MATRIX_EFFECT(SPLASH)
+RGB_MATRIX_EFFECT(SPLASH, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef ENABLE_RGB_MATRIX_MULTISPLASH
-RGB_MATRIX_EFFECT(MULTISPLASH)
+RGB_MATRIX_EFFECT(MULTISPLASH, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #        endif
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
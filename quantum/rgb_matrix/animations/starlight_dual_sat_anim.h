@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_STARLIGHT_DUAL_SAT
-RGB_MATRIX_EFFECT(STARLIGHT_DUAL_SAT)
+RGB_MATRIX_EFFECT(STARLIGHT_DUAL_SAT, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static void set_starlight_dual_sat_color(uint8_t i, effect_params_t* params) {
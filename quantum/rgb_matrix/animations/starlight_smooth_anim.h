@@ -2,7 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0+
 
 #ifdef ENABLE_RGB_MATRIX_STARLIGHT_SMOOTH
-RGB_MATRIX_EFFECT(STARLIGHT_SMOOTH)
+RGB_MATRIX_EFFECT(STARLIGHT_SMOOTH, RGB_MATRIX_INPUT_TIME)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static uint8_t phase_offsets[RGB_MATRIX_LED_COUNT];
@@ -1,5 +1,5 @@
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
-RGB_MATRIX_EFFECT(TYPING_HEATMAP)
+RGB_MATRIX_EFFECT(TYPING_HEATMAP, RGB_MATRIX_INPUT_TIME | RGB_MATRIX_INPUT_KEYS)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP
 #            define RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP 32
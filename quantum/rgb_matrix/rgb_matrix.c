@@ -22,6 +22,11 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#    include "action_layer.h"
+#    include "action_util.h"
+#    include "host.h"
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -43,7 +48,7 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
-#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_EFFECT(name, ...)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #include "rgb_matrix_effects.inc"
@@ -85,6 +90,30 @@ static uint32_t rgb_timer_buffer;
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+// Everything a frame may depend on, compared against the last flushed frame to decide whether it needs rendering
+typedef struct {
+    uint64_t      config;
+    uint8_t       effect;
+    uint8_t       key_events;
+    uint8_t       mods;
+    uint8_t       leds;
+    layer_state_t layers;
+} rgb_frame_inputs_t;
+
+static rgb_frame_inputs_t rgb_last_inputs;
+static uint8_t            rgb_key_events     = 0;
+static bool               rgb_render_pending = true;
+static bool               rgb_flush_pending  = true;
+// FNV-1a over every colour written during the frame, so identical frames are not sent to the driver again
+static uint32_t rgb_frame_hash;
+static uint32_t rgb_last_frame_hash;
+
+static inline void rgb_frame_hash_add(uint32_t value) {
+    rgb_frame_hash = (rgb_frame_hash ^ value) * 16777619u;
+}
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
@@ -159,11 +188,27 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_add((uint32_t)(index & 0xFF) << 24 | (uint32_t)red << 16 | (uint16_t)green << 8 | blue);
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#if defined(RGB_MATRIX_COMPOSITOR_ENABLE)
+    rgb_matrix_compositor_set_color(index, red, green, blue);
+#elif defined(RGB_MATRIX_COLOR16_ENABLE)
+    rgb_matrix_color16_set_color(index, red * 257, green * 257, blue * 257);
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_add((uint32_t)0xFF << 24 | (uint32_t)red << 16 | (uint16_t)green << 8 | blue);
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#if defined(RGB_MATRIX_COMPOSITOR_ENABLE)
+    rgb_matrix_compositor_set_color_all(red, green, blue);
+#elif defined(RGB_MATRIX_COLOR16_ENABLE)
+    rgb_matrix_color16_set_color_all(red * 257, green * 257, blue * 257);
+#elif defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -171,11 +216,32 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+// Rounds a 16-bit channel to 8 bits, the inverse of widening by 257
+static inline uint8_t color16_to_8(uint16_t value) {
+    return (value - (value >> 8) + 0x80) >> 8;
+}
+
+void rgb_matrix_set_color16(int index, uint16_t red, uint16_t green, uint16_t blue) {
+#if defined(RGB_MATRIX_COLOR16_ENABLE) && !defined(RGB_MATRIX_COMPOSITOR_ENABLE)
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_add((uint32_t)(index & 0xFF) << 16 | red);
+    rgb_frame_hash_add((uint32_t)green << 16 | blue);
+#    endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_matrix_color16_set_color(index, red, green, blue);
+#else
+    rgb_matrix_set_color(index, color16_to_8(red), color16_to_8(green), color16_to_8(blue));
+#endif
+}
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_key_events++;
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     uint8_t led[LED_HITS_TO_REMEMBER];
     uint8_t led_count = 0;
@@ -214,7 +280,11 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
     if (pressed)
 #    endif // defined(RGB_MATRIX_KEYRELEASES)
     {
+#    ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+        if (rgb_matrix_config.mode == RGB_MATRIX_TYPING_HEATMAP || rgb_matrix_compositor_has_mode(RGB_MATRIX_TYPING_HEATMAP)) {
+#    else
         if (rgb_matrix_config.mode == RGB_MATRIX_TYPING_HEATMAP) {
+#    endif // RGB_MATRIX_COMPOSITOR_ENABLE
             process_rgb_matrix_typing_heatmap(row, col);
         }
     }
@@ -276,13 +346,120 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    if (sync_timer_elapsed32(g_rgb_timer) >= rgb_matrix_governor_flush_interval()) rgb_task_state = STARTING;
+#else
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
 }
 
-static void rgb_task_start(void) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+static uint8_t rgb_effect_inputs(uint8_t effect) {
+    // effects that do not declare their inputs are assumed to depend on everything
+#    define RGB_MATRIX_EFFECT_INPUTS(name, inputs, ...) (inputs)
+    switch (effect) {
+        case RGB_MATRIX_NONE:
+            return RGB_MATRIX_INPUT_NONE;
+
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_##name:          \
+            return RGB_MATRIX_EFFECT_INPUTS(name, ##__VA_ARGS__, RGB_MATRIX_INPUT_ALL);
+#    include "rgb_matrix_effects.inc"
+#    undef RGB_MATRIX_EFFECT
+
+#    ifdef COMMUNITY_MODULES_ENABLE
+#        define RGB_MATRIX_EFFECT(name, ...)         \
+            case RGB_MATRIX_COMMUNITY_MODULE_##name: \
+                return RGB_MATRIX_EFFECT_INPUTS(name, ##__VA_ARGS__, RGB_MATRIX_INPUT_ALL);
+#        include "rgb_matrix_community_modules.inc"
+#        undef RGB_MATRIX_EFFECT
+#    endif
+
+#    if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#        define RGB_MATRIX_EFFECT(name, ...) \
+            case RGB_MATRIX_CUSTOM_##name:   \
+                return RGB_MATRIX_EFFECT_INPUTS(name, ##__VA_ARGS__, RGB_MATRIX_INPUT_ALL);
+#        ifdef RGB_MATRIX_CUSTOM_KB
+#            include "rgb_matrix_kb.inc"
+#        endif
+#        ifdef RGB_MATRIX_CUSTOM_USER
+#            include "rgb_matrix_user.inc"
+#        endif
+#        undef RGB_MATRIX_EFFECT
+#    endif
+    }
+#    undef RGB_MATRIX_EFFECT_INPUTS
+    return RGB_MATRIX_INPUT_ALL;
+}
+
+static uint8_t rgb_frame_inputs(uint8_t effect) {
+    uint8_t inputs = rgb_effect_inputs(effect);
+#    ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    if (effect != RGB_MATRIX_NONE) {
+        for (uint8_t layer = 0; layer < RGB_MATRIX_COMPOSITOR_LAYERS; layer++) {
+            inputs |= rgb_effect_inputs(rgb_matrix_compositor_get_layer(layer)->mode);
+        }
+    }
+#    endif // RGB_MATRIX_COMPOSITOR_ENABLE
+    // indicators are only drawn on top of an effect
+    if (effect != RGB_MATRIX_NONE) {
+        inputs |= RGB_MATRIX_INDICATOR_INPUTS;
+    }
+    return inputs;
+}
+
+// Returns true if nothing the frame depends on has changed since the last flushed frame, and records the current inputs.
+static bool rgb_frame_unchanged(uint8_t effect) {
+    uint8_t            inputs = rgb_frame_inputs(effect);
+    rgb_frame_inputs_t current;
+    current.config     = rgb_matrix_config.raw;
+    current.effect     = effect;
+    current.key_events = (inputs & RGB_MATRIX_INPUT_KEYS) ? rgb_key_events : 0;
+#    ifndef NO_ACTION_ONESHOT
+    current.mods = (inputs & RGB_MATRIX_INPUT_MODS) ? get_mods() | get_oneshot_mods() : 0;
+#    else
+    current.mods = (inputs & RGB_MATRIX_INPUT_MODS) ? get_mods() : 0;
+#    endif // NO_ACTION_ONESHOT
+    current.leds   = (inputs & RGB_MATRIX_INPUT_LEDS) ? host_keyboard_led_state().raw : 0;
+    current.layers = (inputs & RGB_MATRIX_INPUT_LAYER) ? layer_state | default_layer_state : 0;
+
+    bool unchanged = !rgb_render_pending && !(inputs & RGB_MATRIX_INPUT_TIME) && current.config == rgb_last_inputs.config && current.effect == rgb_last_inputs.effect && current.key_events == rgb_last_inputs.key_events && current.mods == rgb_last_inputs.mods && current.leds == rgb_last_inputs.leds && current.layers == rgb_last_inputs.layers;
+    rgb_last_inputs    = current;
+    rgb_render_pending = false;
+    return unchanged;
+}
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
+void rgb_matrix_invalidate(void) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_render_pending = true;
+    rgb_flush_pending  = true;
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+}
+
+static void rgb_task_start(uint8_t effect) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    if (rgb_frame_unchanged(effect)) {
+        // nothing to render, check again after another flush interval
+        g_rgb_timer    = rgb_timer_buffer;
+        rgb_task_state = SYNCING;
+        return;
+    }
+    rgb_frame_hash = 2166136261u;
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    // size this frame's render slices from the measured cost of the effect
+    rgb_matrix_governor_frame_start(effect);
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
+
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    rgb_matrix_compositor_frame_start();
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -293,44 +470,33 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
-    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
-        rgb_effect_params.flags = rgb_matrix_config.flags;
-        rgb_matrix_set_color_all(0, 0, 0);
-    }
-
+static bool rgb_effect_render(uint8_t effect, effect_params_t *params) {
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
         case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
+            return rgb_matrix_none(params);
 
 // ---------------------------------------------
 // -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
+#define RGB_MATRIX_EFFECT(name, ...) \
+    case RGB_MATRIX_##name:          \
+        return name(params);
 #include "rgb_matrix_effects.inc"
 #undef RGB_MATRIX_EFFECT
 
 #ifdef COMMUNITY_MODULES_ENABLE
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_COMMUNITY_MODULE_##name:  \
-            rendering = name(&rgb_effect_params); \
-            break;
+#    define RGB_MATRIX_EFFECT(name, ...)         \
+        case RGB_MATRIX_COMMUNITY_MODULE_##name: \
+            return name(params);
 #    include "rgb_matrix_community_modules.inc"
 #    undef RGB_MATRIX_EFFECT
 #endif
 
 #if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_CUSTOM_##name:   \
+            return name(params);
 #    ifdef RGB_MATRIX_CUSTOM_KB
 #        include "rgb_matrix_kb.inc"
 #    endif
@@ -341,14 +507,47 @@ static void rgb_task_render(uint8_t effect) {
 #endif
             // -----End rgb effect switch case macros-------
             // ---------------------------------------------
+    }
+    return false;
+}
 
-        // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+static bool rgb_task_render_layers(void) {
+    bool rendering = false;
+    for (uint8_t layer = 0; layer < RGB_MATRIX_COMPOSITOR_LAYERS; layer++) {
+        effect_params_t params;
+        uint8_t         mode = rgb_matrix_compositor_layer_begin(layer, rgb_effect_params.iter, rgb_effect_params.init, &params);
+        if (mode == RGB_MATRIX_NONE) continue;
+        rendering |= rgb_matrix_compositor_layer_end(layer, rgb_effect_render(mode, &params));
     }
+    return rendering;
+}
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
+
+static void rgb_task_render(uint8_t effect) {
+    bool rendering         = false;
+    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    rgb_matrix_compositor_select_base();
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
+    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
+        rgb_effect_params.flags = rgb_matrix_config.flags;
+        rgb_matrix_set_color_all(0, 0, 0);
+    }
+
+    // Factory default magic value
+    if (effect == UINT8_MAX) {
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
+    }
+
+    rendering = rgb_effect_render(effect, &rgb_effect_params);
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    if (effect != RGB_MATRIX_NONE) {
+        rendering |= rgb_task_render_layers();
+    }
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
 
     rgb_effect_params.iter++;
 
@@ -367,8 +566,34 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    // blend all layers into the driver in a single pass
+    rgb_matrix_compositor_compose(effect != RGB_MATRIX_NONE);
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
+
+    bool changed = true;
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    changed             = rgb_flush_pending || rgb_frame_hash != rgb_last_frame_hash;
+    rgb_last_frame_hash = rgb_frame_hash;
+    rgb_flush_pending   = false;
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
+#ifdef RGB_MATRIX_COLOR16_ENABLE
+#    ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    if (rgb_matrix_color16_flush(rgb_matrix_governor_flush_interval())) {
+#    else
+    if (rgb_matrix_color16_flush(RGB_MATRIX_LED_FLUSH_LIMIT)) {
+#    endif // RGB_MATRIX_GOVERNOR_ENABLE
+        // dithered output keeps changing even if the effect wrote the same colours
+        changed = true;
+        rgb_matrix_invalidate();
+    }
+#endif // RGB_MATRIX_COLOR16_ENABLE
+
     // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
+    if (changed) {
+        rgb_matrix_update_pwm_buffers();
+    }
 
     // next task
     rgb_task_state = SYNCING;
@@ -389,19 +614,39 @@ void rgb_matrix_task(void) {
 
     switch (rgb_task_state) {
         case STARTING:
-            rgb_task_start();
+            rgb_task_start(effect);
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+            struct rgb_matrix_limits_t slice = rgb_matrix_get_limits(rgb_effect_params.iter);
+            rgb_matrix_governor_slice_start();
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
             rgb_task_render(effect);
             if (effect) {
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+                rgb_matrix_compositor_select_indicators();
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+                rgb_matrix_compositor_select_base();
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
             }
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+            rgb_matrix_governor_slice_end(effect, slice.led_max_index > slice.led_min_index ? slice.led_max_index - slice.led_min_index : 0);
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
             break;
+        }
         case FLUSHING:
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+            rgb_matrix_governor_slice_start();
+            rgb_task_flush(effect);
+            rgb_matrix_governor_flush_end();
+#else
             rgb_task_flush(effect);
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
             break;
         case SYNCING:
             rgb_task_sync();
@@ -428,7 +673,19 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_GOVERNOR_ENABLE)
+    uint8_t  process_limit = rgb_matrix_governor_leds_per_slice();
+    uint16_t led_min_index = (uint16_t)process_limit * iter;
+    uint16_t led_max_index = led_min_index + process_limit;
+    if (led_min_index > RGB_MATRIX_LED_COUNT) led_min_index = RGB_MATRIX_LED_COUNT;
+    if (led_max_index > RGB_MATRIX_LED_COUNT) led_max_index = RGB_MATRIX_LED_COUNT;
+    limits.led_min_index = led_min_index;
+    limits.led_max_index = led_max_index;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
+    if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
+#    endif
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -479,6 +736,19 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_invalidate();
+
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    rgb_matrix_governor_init();
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
+
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+    rgb_matrix_compositor_init();
+#endif // RGB_MATRIX_COMPOSITOR_ENABLE
+
+#ifdef RGB_MATRIX_COLOR16_ENABLE
+    rgb_matrix_color16_init();
+#endif // RGB_MATRIX_COLOR16_ENABLE
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -503,6 +773,7 @@ void rgb_matrix_init(void) {
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_MATRIX_SLEEP
     if (state && !suspend_state) { // only run if turning off, and only once
+        rgb_matrix_invalidate();   // make sure the flush below is not skipped
         rgb_task_render(0);        // turn off all LEDs when suspending
         rgb_task_flush(0);         // and actually flash led state to LEDs
     }
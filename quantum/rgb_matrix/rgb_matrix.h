@@ -90,6 +90,22 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_INDICATOR_INPUTS
+#    define RGB_MATRIX_INDICATOR_INPUTS (RGB_MATRIX_INPUT_KEYS | RGB_MATRIX_INPUT_MODS | RGB_MATRIX_INPUT_LAYER | RGB_MATRIX_INPUT_LEDS)
+#endif
+
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+#    include "rgb_matrix_governor.h"
+#endif
+
+#ifdef RGB_MATRIX_COMPOSITOR_ENABLE
+#    include "rgb_matrix_compositor.h"
+#endif
+
+#ifdef RGB_MATRIX_COLOR16_ENABLE
+#    include "rgb_matrix_color16.h"
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -155,10 +171,14 @@ int rgb_matrix_led_index(int index);
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+// 16 bits per channel, rounded to 8 bits unless the 16-bit colour pipeline is enabled
+void rgb_matrix_set_color16(int index, uint16_t red, uint16_t green, uint16_t blue);
 
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
+// Forces the next frame to be rendered and flushed when RGB_MATRIX_SKIP_UNCHANGED_FRAMES is enabled
+void rgb_matrix_invalidate(void);
 
 // This runs after another backlight effect and replaces
 // colors already set
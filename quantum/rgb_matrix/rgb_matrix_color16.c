@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "rgb_matrix_color16.h"
+#include <string.h>
+
+static rgb16_t frame[RGB_MATRIX_LED_COUNT];
+static uint8_t dither_error[RGB_MATRIX_LED_COUNT][3];
+
+void rgb_matrix_color16_init(void) {
+    memset(frame, 0, sizeof(frame));
+    memset(dither_error, 0, sizeof(dither_error));
+}
+
+void rgb_matrix_color16_set_color(int index, uint16_t red, uint16_t green, uint16_t blue) {
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+    frame[index].r = red;
+    frame[index].g = green;
+    frame[index].b = blue;
+}
+
+void rgb_matrix_color16_set_color_all(uint16_t red, uint16_t green, uint16_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        frame[i].r = red;
+        frame[i].g = green;
+        frame[i].b = blue;
+    }
+}
+
+// Maps 0..65535 onto 0..255 in 8.8 fixed point, so that 8-bit colours widened by 257 come back unchanged.
+static inline uint16_t to_fixed(uint16_t value) {
+    return value - (value >> 8);
+}
+
+static inline uint8_t quantise_dither(uint16_t value, uint8_t *error) {
+    uint16_t sum = to_fixed(value) + *error;
+    *error       = sum & 0xFF;
+    return sum >> 8;
+}
+
+static inline uint8_t quantise_round(uint16_t value) {
+    return (to_fixed(value) + 0x80) >> 8;
+}
+
+bool rgb_matrix_color16_flush(uint8_t flush_interval_ms) {
+    if (rgb_matrix_driver.set_color16) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_driver.set_color16(rgb_matrix_led_index(i), frame[i].r, frame[i].g, frame[i].b);
+        }
+        return false;
+    }
+
+    if (flush_interval_ms > RGB_MATRIX_DITHER_MAX_FLUSH_MS) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_driver.set_color(rgb_matrix_led_index(i), quantise_round(frame[i].r), quantise_round(frame[i].g), quantise_round(frame[i].b));
+        }
+        return false;
+    }
+
+    uint8_t residual = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t r = quantise_dither(frame[i].r, &dither_error[i][0]);
+        uint8_t g = quantise_dither(frame[i].g, &dither_error[i][1]);
+        uint8_t b = quantise_dither(frame[i].b, &dither_error[i][2]);
+        rgb_matrix_driver.set_color(rgb_matrix_led_index(i), r, g, b);
+        residual |= dither_error[i][0] | dither_error[i][1] | dither_error[i][2];
+    }
+    return residual != 0;
+}
@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+
+/*
+    The 16-bit colour pipeline keeps a frame of 16 bits per channel between the effects and the driver, so effects can
+    draw with rgb_matrix_set_color16() and keep resolution that 8-bit PWM would otherwise lose in dim colours and slow
+    fades. 8-bit writes through rgb_matrix_set_color() are widened losslessly.
+
+    On flush, drivers that provide set_color16 receive the full values. Everything else gets 8 bits per channel with
+    temporal dithering: the quantisation error of each channel is carried to the next frame, so the average output
+    over a few frames matches the 16-bit value. Dithering at low frame rates shows up as flicker rather than smoothing,
+    so it is only applied while the flush interval is at most RGB_MATRIX_DITHER_MAX_FLUSH_MS, and values are rounded
+    otherwise.
+*/
+
+// Longest flush interval in milliseconds at which 8-bit outputs are dithered, 0 disables dithering.
+#ifndef RGB_MATRIX_DITHER_MAX_FLUSH_MS
+#    define RGB_MATRIX_DITHER_MAX_FLUSH_MS 16
+#endif
+
+void rgb_matrix_color16_init(void);
+void rgb_matrix_color16_set_color(int index, uint16_t red, uint16_t green, uint16_t blue);
+void rgb_matrix_color16_set_color_all(uint16_t red, uint16_t green, uint16_t blue);
+// Writes the frame to the driver, dithering 8-bit outputs if the flush interval allows it. Returns true if the output
+// will change on the next flush even if the frame does not, because values between two 8-bit levels are being dithered.
+bool rgb_matrix_color16_flush(uint8_t flush_interval_ms);
@@ -0,0 +1,198 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "rgb_matrix_compositor.h"
+#include <string.h>
+
+#if RGB_MATRIX_COMPOSITOR_LAYERS < 1
+#    error RGB_MATRIX_COMPOSITOR_LAYERS must be at least 1
+#endif
+
+static rgb_t              base_buffer[RGB_MATRIX_LED_COUNT];
+static rgb_t              layer_buffer[RGB_MATRIX_COMPOSITOR_LAYERS][RGB_MATRIX_LED_COUNT];
+static rgb_t              indicator_buffer[RGB_MATRIX_LED_COUNT];
+static uint8_t            indicator_written[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static rgb_matrix_layer_t layers[RGB_MATRIX_COMPOSITOR_LAYERS];
+static uint8_t            layer_last_mode[RGB_MATRIX_COMPOSITOR_LAYERS];
+static bool               layer_done[RGB_MATRIX_COMPOSITOR_LAYERS];
+static uint8_t            indicator_blend = RGB_MATRIX_BLEND_REPLACE;
+static uint8_t            indicator_alpha = UINT8_MAX;
+
+static rgb_t  *target            = base_buffer;
+static bool    target_indicators = false;
+static hsv_t   saved_hsv;
+static uint8_t saved_speed;
+
+void rgb_matrix_compositor_init(void) {
+    memset(base_buffer, 0, sizeof(base_buffer));
+    memset(layer_buffer, 0, sizeof(layer_buffer));
+    memset(indicator_buffer, 0, sizeof(indicator_buffer));
+    memset(indicator_written, 0, sizeof(indicator_written));
+    memset(layers, 0, sizeof(layers));
+    memset(layer_last_mode, RGB_MATRIX_NONE, sizeof(layer_last_mode));
+    memset(layer_done, 0, sizeof(layer_done));
+    indicator_blend = RGB_MATRIX_BLEND_REPLACE;
+    indicator_alpha = UINT8_MAX;
+    rgb_matrix_compositor_select_base();
+}
+
+void rgb_matrix_compositor_set_layer(uint8_t layer, const rgb_matrix_layer_t *config) {
+    if (layer >= RGB_MATRIX_COMPOSITOR_LAYERS) return;
+    layers[layer] = *config;
+    rgb_matrix_invalidate();
+}
+
+const rgb_matrix_layer_t *rgb_matrix_compositor_get_layer(uint8_t layer) {
+    if (layer >= RGB_MATRIX_COMPOSITOR_LAYERS) return NULL;
+    return &layers[layer];
+}
+
+void rgb_matrix_compositor_clear_layer(uint8_t layer) {
+    if (layer >= RGB_MATRIX_COMPOSITOR_LAYERS) return;
+    memset(&layers[layer], 0, sizeof(layers[layer]));
+    rgb_matrix_invalidate();
+}
+
+void rgb_matrix_compositor_set_indicator_blend(uint8_t blend, uint8_t alpha) {
+    indicator_blend = blend;
+    indicator_alpha = alpha;
+    rgb_matrix_invalidate();
+}
+
+bool rgb_matrix_compositor_has_mode(uint8_t mode) {
+    for (uint8_t i = 0; i < RGB_MATRIX_COMPOSITOR_LAYERS; i++) {
+        if (layers[i].mode == mode) return true;
+    }
+    return false;
+}
+
+// Rounded x / 255 for x <= 255 * 255 without a division.
+static inline uint8_t div255(uint16_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline uint8_t blend_channel(uint8_t below, uint8_t above, uint8_t blend, uint8_t alpha) {
+    switch (blend) {
+        case RGB_MATRIX_BLEND_ADD:
+            return below > UINT8_MAX - above ? UINT8_MAX : below + above;
+        case RGB_MATRIX_BLEND_MULTIPLY:
+            return div255((uint16_t)below * above);
+        case RGB_MATRIX_BLEND_MAX:
+            return below > above ? below : above;
+        case RGB_MATRIX_BLEND_ALPHA:
+            return div255((uint16_t)above * alpha + (uint16_t)below * (UINT8_MAX - alpha));
+        case RGB_MATRIX_BLEND_REPLACE:
+        default:
+            return above;
+    }
+}
+
+rgb_t rgb_matrix_compositor_blend(rgb_t below, rgb_t above, uint8_t blend, uint8_t alpha) {
+    rgb_t out;
+    out.r = blend_channel(below.r, above.r, blend, alpha);
+    out.g = blend_channel(below.g, above.g, blend, alpha);
+    out.b = blend_channel(below.b, above.b, blend, alpha);
+    return out;
+}
+
+void rgb_matrix_compositor_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+    target[index].r = red;
+    target[index].g = green;
+    target[index].b = blue;
+    if (target_indicators) {
+        indicator_written[index / 8] |= 1 << (index % 8);
+    }
+}
+
+void rgb_matrix_compositor_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        target[i].r = red;
+        target[i].g = green;
+        target[i].b = blue;
+    }
+    if (target_indicators) {
+        memset(indicator_written, 0xFF, sizeof(indicator_written));
+    }
+}
+
+void rgb_matrix_compositor_frame_start(void) {
+    memset(indicator_written, 0, sizeof(indicator_written));
+    memset(layer_done, 0, sizeof(layer_done));
+}
+
+void rgb_matrix_compositor_select_base(void) {
+    target            = base_buffer;
+    target_indicators = false;
+}
+
+void rgb_matrix_compositor_select_indicators(void) {
+    target            = indicator_buffer;
+    target_indicators = true;
+}
+
+uint8_t rgb_matrix_compositor_layer_begin(uint8_t layer, uint8_t iter, bool init, effect_params_t *params) {
+    rgb_matrix_layer_t *config = &layers[layer];
+    if (config->mode == RGB_MATRIX_NONE || layer_done[layer]) {
+        return RGB_MATRIX_NONE;
+    }
+
+    params->iter  = iter;
+    params->flags = config->flags;
+    params->init  = init || (config->mode != layer_last_mode[layer]);
+    if (params->init && iter == 0 && config->mode != layer_last_mode[layer]) {
+        // don't let a previous effect's pixels bleed into the new one
+        memset(layer_buffer[layer], 0, sizeof(layer_buffer[layer]));
+    }
+
+    saved_hsv               = rgb_matrix_config.hsv;
+    saved_speed             = rgb_matrix_config.speed;
+    rgb_matrix_config.hsv   = config->hsv;
+    rgb_matrix_config.speed = config->speed;
+    target                  = layer_buffer[layer];
+    target_indicators       = false;
+    return config->mode;
+}
+
+bool rgb_matrix_compositor_layer_end(uint8_t layer, bool rendering) {
+    rgb_matrix_config.hsv   = saved_hsv;
+    rgb_matrix_config.speed = saved_speed;
+    rgb_matrix_compositor_select_base();
+    if (!rendering) {
+        layer_done[layer] = true;
+    }
+    return rendering;
+}
+
+void rgb_matrix_compositor_compose(bool overlays) {
+    uint8_t active[RGB_MATRIX_COMPOSITOR_LAYERS];
+    uint8_t active_count = 0;
+    if (overlays) {
+        for (uint8_t l = 0; l < RGB_MATRIX_COMPOSITOR_LAYERS; l++) {
+            if (layers[l].mode != RGB_MATRIX_NONE) {
+                active[active_count++] = l;
+            }
+            layer_last_mode[l] = layers[l].mode;
+        }
+    }
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_t color = base_buffer[i];
+        for (uint8_t a = 0; a < active_count; a++) {
+            const rgb_matrix_layer_t *config = &layers[active[a]];
+            if (HAS_ANY_FLAGS(g_led_config.flags[i], config->flags)) {
+                color = rgb_matrix_compositor_blend(color, layer_buffer[active[a]][i], config->blend, config->alpha);
+            }
+        }
+        if (indicator_written[i / 8] & (1 << (i % 8))) {
+            color = rgb_matrix_compositor_blend(color, indicator_buffer[i], indicator_blend, indicator_alpha);
+        }
+#ifdef RGB_MATRIX_COLOR16_ENABLE
+        rgb_matrix_color16_set_color(i, color.r * 257, color.g * 257, color.b * 257);
+#else
+        rgb_matrix_driver.set_color(rgb_matrix_led_index(i), color.r, color.g, color.b);
+#endif // RGB_MATRIX_COLOR16_ENABLE
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+#include "rgb_matrix_types.h"
+
+/*
+    The compositor renders a small stack of effects into per-layer buffers and blends them into the driver once per
+    frame, instead of the base effect writing to the driver directly:
+
+      - The base layer is the regular effect selected by rgb_matrix_config.mode. It covers every LED.
+      - RGB_MATRIX_COMPOSITOR_LAYERS overlay layers are drawn on top, in order. Each has its own effect, LED flag mask,
+        blend mode, colour and speed. An overlay set to RGB_MATRIX_NONE is skipped.
+      - Anything written from the indicator callbacks lands in an indicator layer, which is blended last and only covers
+        the LEDs that were actually written during the frame.
+
+    Overlays sharing an effect with the base layer or with each other also share that effect's static state.
+*/
+
+// Number of overlay layers drawn above the base effect.
+#ifndef RGB_MATRIX_COMPOSITOR_LAYERS
+#    define RGB_MATRIX_COMPOSITOR_LAYERS 2
+#endif
+
+typedef enum rgb_matrix_blend_t {
+    RGB_MATRIX_BLEND_REPLACE,  // layer colour replaces what is below
+    RGB_MATRIX_BLEND_ADD,      // saturating per-channel add
+    RGB_MATRIX_BLEND_MULTIPLY, // per-channel multiply, white leaves the layer below unchanged
+    RGB_MATRIX_BLEND_MAX,      // per-channel maximum
+    RGB_MATRIX_BLEND_ALPHA,    // mix with the layer below by the layer's alpha
+} rgb_matrix_blend_t;
+
+typedef struct rgb_matrix_layer_t {
+    uint8_t mode;  // effect to render, RGB_MATRIX_NONE disables the layer
+    uint8_t flags; // only LEDs with any of these flags are rendered and blended
+    uint8_t blend; // one of rgb_matrix_blend_t
+    uint8_t alpha; // opacity used by RGB_MATRIX_BLEND_ALPHA
+    hsv_t   hsv;   // colour the effect renders with, in place of rgb_matrix_config.hsv
+    uint8_t speed; // speed the effect renders with, in place of rgb_matrix_config.speed
+} rgb_matrix_layer_t;
+
+void                      rgb_matrix_compositor_init(void);
+void                      rgb_matrix_compositor_set_layer(uint8_t layer, const rgb_matrix_layer_t *config);
+const rgb_matrix_layer_t *rgb_matrix_compositor_get_layer(uint8_t layer);
+void                      rgb_matrix_compositor_clear_layer(uint8_t layer);
+void                      rgb_matrix_compositor_set_indicator_blend(uint8_t blend, uint8_t alpha);
+bool                      rgb_matrix_compositor_has_mode(uint8_t mode);
+
+rgb_t rgb_matrix_compositor_blend(rgb_t below, rgb_t above, uint8_t blend, uint8_t alpha);
+
+// Render pipeline hooks, called from rgb_matrix.c
+void rgb_matrix_compositor_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_compositor_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_compositor_frame_start(void);
+void rgb_matrix_compositor_select_base(void);
+void rgb_matrix_compositor_select_indicators(void);
+// Returns the effect an overlay should render this iteration, or RGB_MATRIX_NONE if there is nothing to do.
+uint8_t rgb_matrix_compositor_layer_begin(uint8_t layer, uint8_t iter, bool init, effect_params_t *params);
+bool    rgb_matrix_compositor_layer_end(uint8_t layer, bool rendering);
+void    rgb_matrix_compositor_compose(bool overlays);
@@ -23,7 +23,7 @@
 
 /* Each driver needs to define the struct
  *    const rgb_matrix_driver_t rgb_matrix_driver;
- * All members must be provided.
+ * All members except set_color16 must be provided.
  * Keyboard custom drivers can define this in their own files, it should only
  * be here if shared between boards.
  */
@@ -46,6 +46,8 @@ typedef struct {
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
+    /* Optional: set the colour of a single LED with 16 bits per channel, used by the 16-bit colour pipeline. */
+    void (*set_color16)(int index, uint16_t r, uint16_t g, uint16_t b);
 } rgb_matrix_driver_t;
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
@@ -0,0 +1,200 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "rgb_matrix_governor.h"
+#include "timer.h"
+#include "debug.h"
+#include <string.h>
+
+#if defined(RGB_MATRIX_GOVERNOR_CUSTOM_TIMER)
+// rgb_matrix_governor_timer_us() is provided by the keyboard
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#elif defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#    if defined(TIFR0)
+#        define TIMER_COMPARE_FLAGS TIFR0
+#    else
+#        define TIMER_COMPARE_FLAGS TIFR
+#    endif
+#    if defined(OCF0A)
+#        define TIMER_COMPARE_FLAG OCF0A
+#    else
+#        define TIMER_COMPARE_FLAG OCF0
+#    endif
+#else
+// Slices are a fraction of a millisecond, so they can't be measured with timer_read32()
+#    error RGB_MATRIX_GOVERNOR_ENABLE requires a microsecond timer, which this platform lacks -- define RGB_MATRIX_GOVERNOR_CUSTOM_TIMER and implement rgb_matrix_governor_timer_us()
+#endif
+
+#if RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS > RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS
+#    error RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS must not be larger than RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS
+#endif
+
+#define GOVERNOR_STATS_WINDOW_MS 1000
+
+static uint16_t effect_cost[RGB_MATRIX_EFFECT_MAX]; // per-LED cost in 1/16 us, zero if not yet measured
+static uint8_t  leds_per_slice;
+static uint8_t  flush_interval;
+static uint32_t slice_start_us;
+static uint32_t frame_cost_us;
+static uint8_t  frame_slices;
+static uint16_t window_frames;
+static uint32_t window_start;
+
+static rgb_matrix_governor_stats_t governor_stats;
+
+#if !defined(RGB_MATRIX_GOVERNOR_CUSTOM_TIMER)
+__attribute__((weak)) uint32_t rgb_matrix_governor_timer_us(void) {
+#    if defined(PROTOCOL_CHIBIOS)
+    // Accumulate tick deltas so that 16-bit system timers wrapping does not corrupt the result.
+    static systime_t last_ticks = 0;
+    static uint32_t  elapsed_us = 0;
+    systime_t        now        = chVTGetSystemTimeX();
+    elapsed_us += TIME_I2US(chTimeDiffX(last_ticks, now));
+    last_ticks = now;
+    return elapsed_us;
+#    else
+    // The millisecond count, plus how far timer 0 has counted towards the next one
+    uint32_t ms;
+    uint8_t  ticks;
+    bool     pending;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms      = timer_count;
+        ticks   = TIMER_RAW;
+        pending = TIMER_COMPARE_FLAGS & _BV(TIMER_COMPARE_FLAG);
+    }
+    // The counter may have wrapped with the interrupt yet to count the millisecond
+    if (pending && ticks < TIMER_RAW_TOP / 2) {
+        ms++;
+    }
+    return ms * 1000 + (uint32_t)ticks * 1000 / (TIMER_RAW_TOP + 1);
+#    endif
+}
+#endif // RGB_MATRIX_GOVERNOR_CUSTOM_TIMER
+
+static inline uint8_t clamp_leds(uint32_t leds) {
+    if (leds < 1) return 1;
+    if (leds > RGB_MATRIX_LED_COUNT) return RGB_MATRIX_LED_COUNT;
+    return (uint8_t)leds;
+}
+
+void rgb_matrix_governor_init(void) {
+    memset(effect_cost, 0, sizeof(effect_cost));
+    leds_per_slice = clamp_leds(RGB_MATRIX_LED_PROCESS_LIMIT);
+    flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+    if (flush_interval < RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS) flush_interval = RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS;
+    if (flush_interval > RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS) flush_interval = RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS;
+    frame_cost_us = 0;
+    frame_slices  = 0;
+    rgb_matrix_governor_reset_stats();
+}
+
+uint8_t rgb_matrix_governor_frame_start(uint8_t effect) {
+    uint16_t cost = effect < RGB_MATRIX_EFFECT_MAX ? effect_cost[effect] : 0;
+    if (cost == 0) {
+        // Nothing measured yet for this effect, stay with the static default until the first frame completes
+        leds_per_slice = clamp_leds(RGB_MATRIX_LED_PROCESS_LIMIT);
+    } else {
+        leds_per_slice = clamp_leds(((uint32_t)RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US << RGB_MATRIX_GOVERNOR_COST_SHIFT) / cost);
+    }
+    frame_cost_us = 0;
+    frame_slices  = 0;
+    return leds_per_slice;
+}
+
+void rgb_matrix_governor_slice_start(void) {
+    slice_start_us = rgb_matrix_governor_timer_us();
+}
+
+static uint32_t governor_slice_elapsed(void) {
+    uint32_t elapsed = rgb_matrix_governor_timer_us() - slice_start_us;
+    frame_cost_us += elapsed;
+    if (elapsed > governor_stats.worst_slice_us) {
+        governor_stats.worst_slice_us = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    }
+    return elapsed;
+}
+
+void rgb_matrix_governor_slice_end(uint8_t effect, uint8_t led_count) {
+    uint32_t elapsed = governor_slice_elapsed();
+    if (frame_slices < UINT8_MAX) frame_slices++;
+
+    if (led_count == 0 || effect >= RGB_MATRIX_EFFECT_MAX) {
+        return;
+    }
+
+    uint32_t sample = (elapsed << RGB_MATRIX_GOVERNOR_COST_SHIFT) / led_count;
+    if (sample > UINT16_MAX) sample = UINT16_MAX;
+    if (sample == 0) sample = 1;
+
+    // React quickly to cost increases so slices stay inside the budget, decay slowly when the effect gets cheaper
+    uint16_t cost = effect_cost[effect];
+    if (cost == 0) {
+        cost = sample;
+    } else if (sample > cost) {
+        cost += (sample - cost + 1) / 2;
+    } else {
+        cost -= (cost - sample) / 8;
+    }
+    effect_cost[effect] = cost;
+}
+
+void rgb_matrix_governor_flush_end(void) {
+    governor_slice_elapsed();
+
+    // Adjust the frame rate so lighting stays within its share of wall time
+    uint32_t load = frame_cost_us * 100 / ((uint32_t)flush_interval * 1000);
+    if (load > RGB_MATRIX_GOVERNOR_TARGET_LOAD) {
+        if (flush_interval < RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS) flush_interval++;
+    } else if (load * 2 < RGB_MATRIX_GOVERNOR_TARGET_LOAD) {
+        if (flush_interval > RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS) flush_interval--;
+    }
+
+    governor_stats.slices_per_frame  = frame_slices;
+    governor_stats.leds_per_slice    = leds_per_slice;
+    governor_stats.flush_interval_ms = flush_interval;
+    governor_stats.frame_cost_us     = frame_cost_us > UINT16_MAX ? UINT16_MAX : frame_cost_us;
+
+    window_frames++;
+    uint32_t window_elapsed = timer_elapsed32(window_start);
+    if (window_elapsed >= GOVERNOR_STATS_WINDOW_MS) {
+        governor_stats.fps = (uint32_t)window_frames * 1000 / window_elapsed;
+        window_frames      = 0;
+        window_start       = timer_read32();
+#ifdef RGB_MATRIX_GOVERNOR_DEBUG
+        rgb_matrix_governor_print_stats();
+#endif
+    }
+}
+
+uint8_t rgb_matrix_governor_leds_per_slice(void) {
+    return leds_per_slice;
+}
+
+uint8_t rgb_matrix_governor_flush_interval(void) {
+    return flush_interval;
+}
+
+uint16_t rgb_matrix_governor_effect_cost(uint8_t effect) {
+    return effect < RGB_MATRIX_EFFECT_MAX ? effect_cost[effect] : 0;
+}
+
+void rgb_matrix_governor_get_stats(rgb_matrix_governor_stats_t *stats) {
+    *stats = governor_stats;
+}
+
+void rgb_matrix_governor_reset_stats(void) {
+    memset(&governor_stats, 0, sizeof(governor_stats));
+    governor_stats.leds_per_slice    = leds_per_slice;
+    governor_stats.flush_interval_ms = flush_interval;
+    window_frames                    = 0;
+    window_start                     = timer_read32();
+}
+
+void rgb_matrix_governor_print_stats(void) {
+    dprintf("rgb matrix governor: %u fps, %u slices/frame, %u leds/slice, %ums interval, worst slice %uus, frame cost %uus\n", (unsigned)governor_stats.fps, (unsigned)governor_stats.slices_per_frame, (unsigned)governor_stats.leds_per_slice, (unsigned)governor_stats.flush_interval_ms, (unsigned)governor_stats.worst_slice_us, (unsigned)governor_stats.frame_cost_us);
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    The render governor replaces the static RGB_MATRIX_LED_PROCESS_LIMIT / RGB_MATRIX_LED_FLUSH_LIMIT pair with values
+    derived from the measured cost of the active effect:
+
+      - Each RENDERING slice is timed, and a per-effect cost-per-LED estimate is maintained.
+      - At the start of each frame the number of LEDs processed per slice is sized so that a slice fits within
+        RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US.
+      - The flush interval is lowered (higher frame rate) while rendering uses less than RGB_MATRIX_GOVERNOR_TARGET_LOAD
+        percent of wall time, and raised again when it exceeds it.
+*/
+
+// Maximum time in microseconds a single render slice should take.
+#ifndef RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US
+#    define RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US 250
+#endif
+
+// Percentage of wall time the governor allows lighting to consume before backing off the frame rate.
+#ifndef RGB_MATRIX_GOVERNOR_TARGET_LOAD
+#    define RGB_MATRIX_GOVERNOR_TARGET_LOAD 20
+#endif
+
+// Shortest flush interval (fastest frame rate) the governor will select, in milliseconds.
+#ifndef RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS
+#    define RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS 8
+#endif
+
+// Longest flush interval (slowest frame rate) the governor will select, in milliseconds.
+#ifndef RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS
+#    define RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS (RGB_MATRIX_LED_FLUSH_LIMIT * 2)
+#endif
+
+typedef struct rgb_matrix_governor_stats_t {
+    uint16_t fps;               // frames flushed during the last full second
+    uint8_t  slices_per_frame;  // render slices used by the last completed frame
+    uint8_t  leds_per_slice;    // LEDs processed per slice for the current frame
+    uint8_t  flush_interval_ms; // currently selected flush interval
+    uint16_t worst_slice_us;    // longest slice observed since the stats were last reset
+    uint16_t frame_cost_us;     // total render + flush time of the last completed frame
+} rgb_matrix_governor_stats_t;
+
+// Per-LED cost estimates are kept in fixed point with this many fractional bits (1/16 us resolution).
+#define RGB_MATRIX_GOVERNOR_COST_SHIFT 4
+
+void     rgb_matrix_governor_init(void);
+uint8_t  rgb_matrix_governor_frame_start(uint8_t effect);
+void     rgb_matrix_governor_slice_start(void);
+void     rgb_matrix_governor_slice_end(uint8_t effect, uint8_t led_count);
+void     rgb_matrix_governor_flush_end(void);
+uint8_t  rgb_matrix_governor_leds_per_slice(void);
+uint8_t  rgb_matrix_governor_flush_interval(void);
+uint16_t rgb_matrix_governor_effect_cost(uint8_t effect);
+
+void rgb_matrix_governor_get_stats(rgb_matrix_governor_stats_t *stats);
+void rgb_matrix_governor_reset_stats(void);
+void rgb_matrix_governor_print_stats(void);
+
+/**
+ * @brief Monotonic microsecond timestamp used to measure slices. Weakly defined on ChibiOS and AVR; on other platforms,
+ * keyboards need to define RGB_MATRIX_GOVERNOR_CUSTOM_TIMER and implement it.
+ */
+uint32_t rgb_matrix_governor_timer_us(void);
@@ -52,6 +52,17 @@ typedef struct PACKED {
     bool        init;
 } effect_params_t;
 
+// Inputs an effect's output depends on, besides rgb_matrix_config, declared as the second argument of RGB_MATRIX_EFFECT()
+enum rgb_matrix_effect_inputs {
+    RGB_MATRIX_INPUT_NONE  = 0,
+    RGB_MATRIX_INPUT_TIME  = (1 << 0), // g_rgb_timer
+    RGB_MATRIX_INPUT_KEYS  = (1 << 1), // key presses and releases
+    RGB_MATRIX_INPUT_MODS  = (1 << 2), // active and one shot modifiers
+    RGB_MATRIX_INPUT_LAYER = (1 << 3), // layer and default layer state
+    RGB_MATRIX_INPUT_LEDS  = (1 << 4), // host keyboard LED state
+    RGB_MATRIX_INPUT_ALL   = 0xFF,
+};
+
 typedef struct PACKED {
     uint8_t x;
     uint8_t y;
@@ -0,0 +1,137 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+}
+
+static uint32_t fake_us = 0;
+
+extern "C" uint32_t rgb_matrix_governor_timer_us(void) {
+    return fake_us;
+}
+
+class RgbMatrixGovernor : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        fake_us = 0;
+        set_time(0);
+        rgb_matrix_governor_init();
+    }
+
+    // Synthetic cost model: every slice costs a fixed overhead plus a per-LED cost, the flush costs a fixed amount.
+    // Renders one full frame the same way rgb_matrix_task() drives the governor and returns the slice count.
+    uint8_t render_frame(uint8_t effect, uint32_t per_led_us, uint32_t flush_us, uint32_t overhead_us = 5) {
+        uint8_t leds   = rgb_matrix_governor_frame_start(effect);
+        uint8_t slices = 0;
+        for (uint16_t led_min = 0; led_min < RGB_MATRIX_LED_COUNT; led_min += leds) {
+            uint8_t count = (led_min + leds > RGB_MATRIX_LED_COUNT) ? RGB_MATRIX_LED_COUNT - led_min : leds;
+            rgb_matrix_governor_slice_start();
+            fake_us += overhead_us + per_led_us * count;
+            rgb_matrix_governor_slice_end(effect, count);
+            slices++;
+        }
+        rgb_matrix_governor_slice_start();
+        fake_us += flush_us;
+        rgb_matrix_governor_flush_end();
+
+        // Idle in SYNCING until the governor's flush interval elapses
+        uint8_t interval = rgb_matrix_governor_flush_interval();
+        fake_us += interval * 1000;
+        advance_time(interval);
+        return slices;
+    }
+
+    rgb_matrix_governor_stats_t stats(void) {
+        rgb_matrix_governor_stats_t s;
+        rgb_matrix_governor_get_stats(&s);
+        return s;
+    }
+};
+
+TEST_F(RgbMatrixGovernor, UsesStaticLimitUntilMeasured) {
+    EXPECT_EQ(rgb_matrix_governor_frame_start(RGB_MATRIX_SOLID_COLOR), RGB_MATRIX_LED_PROCESS_LIMIT);
+    EXPECT_EQ(rgb_matrix_governor_effect_cost(RGB_MATRIX_SOLID_COLOR), 0);
+    EXPECT_EQ(rgb_matrix_governor_flush_interval(), RGB_MATRIX_LED_FLUSH_LIMIT);
+}
+
+TEST_F(RgbMatrixGovernor, ExpensiveEffectIsSlicedWithinBudget) {
+    // 20us per LED -> a 60 LED frame is 1.2ms, must be split into slices of roughly 250us
+    for (int i = 0; i < 10; ++i) {
+        render_frame(RGB_MATRIX_CYCLE_ALL, 20, 50);
+    }
+    rgb_matrix_governor_reset_stats();
+    uint8_t slices = render_frame(RGB_MATRIX_CYCLE_ALL, 20, 50);
+
+    EXPECT_GE(slices, 5);
+    EXPECT_LE(rgb_matrix_governor_leds_per_slice(), RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US / 20);
+    EXPECT_LE(stats().worst_slice_us, RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US);
+}
+
+TEST_F(RgbMatrixGovernor, CheapEffectRendersInOneSlice) {
+    // 2us per LED -> the whole frame fits in the budget
+    for (int i = 0; i < 5; ++i) {
+        render_frame(RGB_MATRIX_SOLID_COLOR, 2, 50);
+    }
+    EXPECT_EQ(render_frame(RGB_MATRIX_SOLID_COLOR, 2, 50), 1);
+    EXPECT_EQ(rgb_matrix_governor_leds_per_slice(), RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixGovernor, CostIsTrackedPerEffect) {
+    for (int i = 0; i < 5; ++i) {
+        render_frame(RGB_MATRIX_SOLID_COLOR, 2, 50);
+        render_frame(RGB_MATRIX_CYCLE_ALL, 40, 50);
+    }
+    EXPECT_LT(rgb_matrix_governor_effect_cost(RGB_MATRIX_SOLID_COLOR), rgb_matrix_governor_effect_cost(RGB_MATRIX_CYCLE_ALL));
+    EXPECT_EQ(rgb_matrix_governor_frame_start(RGB_MATRIX_SOLID_COLOR), RGB_MATRIX_LED_COUNT);
+    EXPECT_LE(rgb_matrix_governor_frame_start(RGB_MATRIX_CYCLE_ALL), RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US / 40);
+}
+
+TEST_F(RgbMatrixGovernor, ReactsQuicklyToCostIncrease) {
+    for (int i = 0; i < 10; ++i) {
+        render_frame(RGB_MATRIX_CYCLE_ALL, 2, 50);
+    }
+    ASSERT_EQ(rgb_matrix_governor_leds_per_slice(), RGB_MATRIX_LED_COUNT);
+
+    // The effect suddenly becomes 10x more expensive, the slice size must shrink within a few frames
+    for (int i = 0; i < 4; ++i) {
+        render_frame(RGB_MATRIX_CYCLE_ALL, 20, 50);
+    }
+    rgb_matrix_governor_reset_stats();
+    render_frame(RGB_MATRIX_CYCLE_ALL, 20, 50);
+    EXPECT_LE(stats().worst_slice_us, RGB_MATRIX_GOVERNOR_SLICE_BUDGET_US);
+}
+
+TEST_F(RgbMatrixGovernor, RaisesFrameRateWithHeadroom) {
+    for (int i = 0; i < 50; ++i) {
+        render_frame(RGB_MATRIX_SOLID_COLOR, 1, 20);
+    }
+    EXPECT_EQ(rgb_matrix_governor_flush_interval(), RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS);
+}
+
+TEST_F(RgbMatrixGovernor, LowersFrameRateWhenOverloaded) {
+    // 100us per LED is 6ms of rendering per frame, far above the target load at 16ms
+    for (int i = 0; i < 50; ++i) {
+        render_frame(RGB_MATRIX_CYCLE_ALL, 100, 500);
+    }
+    EXPECT_EQ(rgb_matrix_governor_flush_interval(), RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS);
+}
+
+TEST_F(RgbMatrixGovernor, ReportsStats) {
+    for (int i = 0; i < 200; ++i) {
+        render_frame(RGB_MATRIX_SOLID_COLOR, 1, 20);
+    }
+    auto s = stats();
+    EXPECT_NEAR(s.fps, 1000 / RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS, 5);
+    EXPECT_EQ(s.slices_per_frame, 1);
+    EXPECT_EQ(s.leds_per_slice, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(s.flush_interval_ms, RGB_MATRIX_GOVERNOR_MIN_FLUSH_MS);
+    EXPECT_GT(s.worst_slice_us, 0);
+    EXPECT_GT(s.frame_cost_us, 0);
+}
@@ -0,0 +1,20 @@
+rgb_matrix_governor_DEFS := \
+	-DRGB_MATRIX_ENABLE \
+	-DRGB_MATRIX_GOVERNOR_ENABLE \
+	-DRGB_MATRIX_GOVERNOR_CUSTOM_TIMER \
+	-DRGB_MATRIX_LED_COUNT=60 \
+	-DMATRIX_ROWS=5 \
+	-DMATRIX_COLS=12 \
+	-DENABLE_RGB_MATRIX_SOLID_COLOR \
+	-DENABLE_RGB_MATRIX_CYCLE_ALL \
+	-DRGB_MATRIX_GOVERNOR_SLICE_BUDGET_US=250
+
+rgb_matrix_governor_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_governor_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_governor.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+rgb_matrix_governor_INC := \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations
@@ -0,0 +1,232 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "compiler_support.h"
+#include "split_delta.h"
+
+#define SPLIT_DELTA_RUN_LITERAL 0x00
+#define SPLIT_DELTA_RUN_SKIP 0x80
+#define SPLIT_DELTA_RUN_REPEAT 0xC0
+#define SPLIT_DELTA_RUN_TYPE_MASK 0xC0
+#define SPLIT_DELTA_RUN_MAX 64
+
+// A block encodes to at most one byte more than its length, so any block fits after the sequence and block index
+STATIC_ASSERT(SPLIT_DELTA_BLOCK_SIZE <= SPLIT_DELTA_RUN_MAX, "SPLIT_DELTA_BLOCK_SIZE too large for a single run");
+STATIC_ASSERT(SPLIT_DELTA_PACKET_SIZE >= 3 + SPLIT_DELTA_BLOCK_SIZE, "SPLIT_DELTA_PACKET_SIZE too small for a block");
+
+static inline uint8_t split_delta_blocks(uint16_t size) {
+    return (size + SPLIT_DELTA_BLOCK_SIZE - 1) / SPLIT_DELTA_BLOCK_SIZE;
+}
+
+static inline uint8_t split_delta_block_length(uint16_t size, uint8_t block) {
+    uint16_t remaining = size - block * SPLIT_DELTA_BLOCK_SIZE;
+    return remaining < SPLIT_DELTA_BLOCK_SIZE ? remaining : SPLIT_DELTA_BLOCK_SIZE;
+}
+
+static inline bool split_delta_is_dirty(const split_delta_encoder_t *encoder, uint8_t block) {
+    return encoder->dirty[block / 8] & (1 << (block % 8));
+}
+
+// Walks the blocks of a packet, applying them to the buffer if given, returns false if the packet is malformed
+static bool split_delta_walk(uint8_t *buffer, uint16_t size, const uint8_t *packet, uint8_t length) {
+    uint8_t offset = 1;
+    while (offset < length) {
+        uint8_t block = packet[offset++];
+        if (block >= split_delta_blocks(size)) return false;
+
+        uint8_t *data      = buffer ? &buffer[block * SPLIT_DELTA_BLOCK_SIZE] : NULL;
+        uint8_t  remaining = split_delta_block_length(size, block);
+        while (remaining > 0) {
+            if (offset >= length) return false;
+            uint8_t control = packet[offset++];
+            uint8_t count   = (control & ~SPLIT_DELTA_RUN_TYPE_MASK) + 1;
+            if (count > remaining) return false;
+
+            switch (control & SPLIT_DELTA_RUN_TYPE_MASK) {
+                case SPLIT_DELTA_RUN_SKIP:
+                    break;
+                case SPLIT_DELTA_RUN_REPEAT:
+                    if (offset >= length) return false;
+                    if (data) {
+                        for (uint8_t i = 0; i < count; ++i) {
+                            data[i] ^= packet[offset];
+                        }
+                    }
+                    offset++;
+                    break;
+                case SPLIT_DELTA_RUN_LITERAL:
+                    if (offset + count > length) return false;
+                    if (data) {
+                        for (uint8_t i = 0; i < count; ++i) {
+                            data[i] ^= packet[offset + i];
+                        }
+                    }
+                    offset += count;
+                    break;
+                default:
+                    return false;
+            }
+            if (data) {
+                data += count;
+            }
+            remaining -= count;
+        }
+    }
+    return true;
+}
+
+// Encodes the XOR of a block and its shadow, returns the encoded length, which is at most one more than the block's
+static uint8_t split_delta_encode_block(const uint8_t *buffer, const uint8_t *shadow, uint8_t length, uint8_t *out) {
+    uint8_t used = 0;
+    uint8_t i    = 0;
+    while (i < length) {
+        uint8_t delta = buffer[i] ^ shadow[i];
+        uint8_t run   = 1;
+        while (i + run < length && (buffer[i + run] ^ shadow[i + run]) == delta) {
+            run++;
+        }
+
+        if (delta == 0) {
+            out[used++] = SPLIT_DELTA_RUN_SKIP | (run - 1);
+            i += run;
+        } else if (run >= 3) {
+            out[used++] = SPLIT_DELTA_RUN_REPEAT | (run - 1);
+            out[used++] = delta;
+            i += run;
+        } else {
+            // Literal bytes until a run which is cheaper on its own, so that each literal saves at least a byte
+            // afterwards, paying for its control byte
+            uint8_t *control = &out[used++];
+            uint8_t  count   = 0;
+            while (i < length) {
+                delta = buffer[i] ^ shadow[i];
+                run   = 1;
+                while (run < 3 && i + run < length && (buffer[i + run] ^ shadow[i + run]) == delta) {
+                    run++;
+                }
+                if (count > 0 && (delta == 0 ? run >= 2 : run >= 3)) break;
+                out[used++] = delta;
+                count++;
+                i++;
+            }
+            *control = SPLIT_DELTA_RUN_LITERAL | (count - 1);
+        }
+    }
+    return used;
+}
+
+void split_delta_encoder_init(split_delta_encoder_t *encoder, const uint8_t *buffer, uint8_t *shadow, uint8_t *dirty, uint16_t size) {
+    encoder->buffer   = buffer;
+    encoder->shadow   = shadow;
+    encoder->dirty    = dirty;
+    encoder->size     = size;
+    encoder->sequence = 0;
+    split_delta_reset(encoder);
+}
+
+void split_delta_mark_dirty(split_delta_encoder_t *encoder, uint16_t offset, uint16_t length) {
+    if (length == 0 || offset >= encoder->size) return;
+    if (length > encoder->size - offset) {
+        length = encoder->size - offset;
+    }
+    for (uint8_t block = offset / SPLIT_DELTA_BLOCK_SIZE; block <= (offset + length - 1) / SPLIT_DELTA_BLOCK_SIZE; ++block) {
+        encoder->dirty[block / 8] |= 1 << (block % 8);
+    }
+}
+
+void split_delta_mark_changes(split_delta_encoder_t *encoder) {
+    for (uint8_t block = 0; block < split_delta_blocks(encoder->size); ++block) {
+        uint16_t offset = block * SPLIT_DELTA_BLOCK_SIZE;
+        if (memcmp(&encoder->buffer[offset], &encoder->shadow[offset], split_delta_block_length(encoder->size, block)) != 0) {
+            encoder->dirty[block / 8] |= 1 << (block % 8);
+        }
+    }
+}
+
+void split_delta_reset(split_delta_encoder_t *encoder) {
+    memset(encoder->shadow, 0, encoder->size);
+    memset(encoder->dirty, 0xFF, SPLIT_DELTA_DIRTY_SIZE(encoder->size));
+    encoder->cursor = 0;
+    encoder->reset  = true;
+    encoder->length = 0;
+}
+
+uint8_t split_delta_encode(split_delta_encoder_t *encoder) {
+    if (encoder->length > 0) {
+        return encoder->length;
+    }
+
+    uint8_t blocks = split_delta_blocks(encoder->size);
+    uint8_t used   = 1;
+    uint8_t block  = encoder->cursor;
+    for (uint8_t i = 0; i < blocks; ++i, block = block + 1 < blocks ? block + 1 : 0) {
+        if (!split_delta_is_dirty(encoder, block)) continue;
+
+        uint16_t offset = block * SPLIT_DELTA_BLOCK_SIZE;
+        uint8_t  length = split_delta_block_length(encoder->size, block);
+        if (memcmp(&encoder->buffer[offset], &encoder->shadow[offset], length) == 0) {
+            encoder->dirty[block / 8] &= ~(1 << (block % 8));
+            continue;
+        }
+
+        uint8_t encoded[SPLIT_DELTA_BLOCK_SIZE + 1];
+        uint8_t encoded_length = split_delta_encode_block(&encoder->buffer[offset], &encoder->shadow[offset], length, encoded);
+        if (used + 1 + encoded_length > SPLIT_DELTA_PACKET_SIZE) break;
+        encoder->packet[used++] = block;
+        memcpy(&encoder->packet[used], encoded, encoded_length);
+        used += encoded_length;
+    }
+    encoder->cursor = block;
+
+    // A reset is sent even when the buffer is empty, so that the other half clears its copy
+    if (used == 1 && !encoder->reset) {
+        return 0;
+    }
+    encoder->packet[0] = encoder->sequence | (encoder->reset ? SPLIT_DELTA_RESET : 0);
+    encoder->length    = used;
+    return used;
+}
+
+void split_delta_acknowledge(split_delta_encoder_t *encoder, uint8_t acknowledgement) {
+    if (acknowledgement == SPLIT_DELTA_NEEDS_RESET) {
+        split_delta_reset(encoder);
+        return;
+    }
+    if (encoder->length == 0 || acknowledgement != encoder->sequence) return;
+
+    // The other half now has what was sent, on top of an empty copy after a reset, and blocks which have changed again
+    // since are still dirty
+    split_delta_walk(encoder->shadow, encoder->size, encoder->packet, encoder->length);
+    encoder->sequence = (encoder->sequence + 1) & ~SPLIT_DELTA_RESET;
+    encoder->reset    = false;
+    encoder->length   = 0;
+}
+
+void split_delta_decoder_init(split_delta_decoder_t *decoder, uint8_t *buffer, uint16_t size) {
+    decoder->buffer   = buffer;
+    decoder->size     = size;
+    decoder->sequence = SPLIT_DELTA_NEEDS_RESET;
+}
+
+uint8_t split_delta_apply(split_delta_decoder_t *decoder, const uint8_t *packet, uint8_t length) {
+    if (length == 0) return decoder->sequence;
+
+    uint8_t sequence = packet[0] & ~SPLIT_DELTA_RESET;
+    bool    reset    = packet[0] & SPLIT_DELTA_RESET;
+    // Without a reset, the packet only applies on top of the one before it, which may have been sent again
+    if (!reset && (decoder->sequence == SPLIT_DELTA_NEEDS_RESET || decoder->sequence == sequence)) {
+        return decoder->sequence;
+    }
+    if (!split_delta_walk(NULL, decoder->size, packet, length)) {
+        return decoder->sequence;
+    }
+
+    if (reset) {
+        memset(decoder->buffer, 0, decoder->size);
+    }
+    split_delta_walk(decoder->buffer, decoder->size, packet, length);
+    decoder->sequence = sequence;
+    return sequence;
+}
@@ -0,0 +1,76 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Mirrors a buffer from one half of a split keyboard to the other, sending only what changed since the other half
+ * last acknowledged it.
+ *
+ * The buffer is tracked in blocks of SPLIT_DELTA_BLOCK_SIZE bytes. Each packet carries a sequence number and as many
+ * changed blocks as fit, starting after the last block sent, with each block encoded as the XOR of its new and
+ * previous contents, run-length encoded:
+ *
+ *   Packet: | sequence, with SPLIT_DELTA_RESET set if the copy must be cleared first | { block index | runs } ... |
+ *   Runs:   0b00nnnnnn followed by n+1 bytes to XOR in, 0b10nnnnnn skipping n+1 unchanged bytes, or 0b11nnnnnn
+ *           followed by one byte to XOR into the next n+1 bytes, until the block is covered
+ *
+ * The packets may be sent over any transport, such as an RPC from SPLIT_TRANSACTION_IDS_USER. The receiving half
+ * answers each one with the sequence number it now holds, which is passed back to split_delta_acknowledge(). Until
+ * then, the same packet is returned by split_delta_encode(), so that a packet which is lost, or whose acknowledgement
+ * is lost, is sent again unchanged and applied only once.
+ *
+ * Buffers may be up to 255 blocks long.
+ */
+
+#ifndef SPLIT_DELTA_BLOCK_SIZE
+#    define SPLIT_DELTA_BLOCK_SIZE 16
+#endif // SPLIT_DELTA_BLOCK_SIZE
+
+#ifndef SPLIT_DELTA_PACKET_SIZE
+#    define SPLIT_DELTA_PACKET_SIZE 32
+#endif // SPLIT_DELTA_PACKET_SIZE
+
+#define SPLIT_DELTA_RESET 0x80
+// Acknowledgement from a receiver which has yet to be sent the whole buffer
+#define SPLIT_DELTA_NEEDS_RESET 0xFF
+
+// Bytes of dirty bitmap needed for a buffer of the given size
+#define SPLIT_DELTA_DIRTY_SIZE(size) ((((size) + SPLIT_DELTA_BLOCK_SIZE - 1) / SPLIT_DELTA_BLOCK_SIZE + 7) / 8)
+
+typedef struct split_delta_encoder_t {
+    const uint8_t *buffer; // the data being mirrored
+    uint8_t       *shadow; // the other half's copy as last acknowledged, the same size as the buffer
+    uint8_t       *dirty;  // one bit per block which may differ from the shadow, SPLIT_DELTA_DIRTY_SIZE(size) bytes
+    uint16_t       size;
+    uint8_t        cursor;   // block to start the next packet from
+    uint8_t        sequence; // of the next packet
+    bool           reset;    // the next packet tells the other half to clear its copy
+    uint8_t        length;   // of the packet awaiting acknowledgement, if any
+    uint8_t        packet[SPLIT_DELTA_PACKET_SIZE];
+} split_delta_encoder_t;
+
+typedef struct split_delta_decoder_t {
+    uint8_t *buffer;
+    uint16_t size;
+    uint8_t  sequence; // of the last packet applied, or SPLIT_DELTA_NEEDS_RESET
+} split_delta_decoder_t;
+
+void split_delta_encoder_init(split_delta_encoder_t *encoder, const uint8_t *buffer, uint8_t *shadow, uint8_t *dirty, uint16_t size);
+// Marks part of the buffer as changed
+void split_delta_mark_dirty(split_delta_encoder_t *encoder, uint16_t offset, uint16_t length);
+// Compares the whole buffer against the other half's copy, for callers which don't track their writes
+void split_delta_mark_changes(split_delta_encoder_t *encoder);
+// Starts again from an empty copy, e.g. when the other half has restarted
+void split_delta_reset(split_delta_encoder_t *encoder);
+// Returns the length of the packet to send from encoder->packet, or 0 if the other half is up to date
+uint8_t split_delta_encode(split_delta_encoder_t *encoder);
+// Handles the other half's answer to the packet, which is returned again by the next encode unless acknowledged
+void split_delta_acknowledge(split_delta_encoder_t *encoder, uint8_t acknowledgement);
+
+void split_delta_decoder_init(split_delta_decoder_t *decoder, uint8_t *buffer, uint16_t size);
+// Applies a packet to the buffer, returning the acknowledgement for it
+uint8_t split_delta_apply(split_delta_decoder_t *decoder, const uint8_t *packet, uint8_t length);
@@ -0,0 +1,5 @@
+split_delta_INC := $(QUANTUM_PATH)/split_common
+
+split_delta_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_delta_tests.cpp \
+	$(QUANTUM_PATH)/split_common/split_delta.c
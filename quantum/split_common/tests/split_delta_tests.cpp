@@ -0,0 +1,236 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "split_delta.h"
+}
+
+// A 128x32 OLED, and per-LED RGB overrides for a 64 LED half
+#define OLED_SIZE 512
+#define RGB_SIZE (64 * 3)
+
+class SplitDeltaTest : public ::testing::Test {
+   protected:
+    uint8_t               source[OLED_SIZE];
+    uint8_t               shadow[OLED_SIZE];
+    uint8_t               dirty[SPLIT_DELTA_DIRTY_SIZE(OLED_SIZE)];
+    uint8_t               mirror[OLED_SIZE];
+    split_delta_encoder_t encoder;
+    split_delta_decoder_t decoder;
+    uint32_t              random_state = 1;
+
+    // Per frame counts of the last sync
+    uint32_t packets;
+    uint32_t bytes;
+
+    void init(uint16_t size) {
+        memset(source, 0, sizeof(source));
+        memset(mirror, 0xAA, sizeof(mirror));
+        split_delta_encoder_init(&encoder, source, shadow, dirty, size);
+        split_delta_decoder_init(&decoder, mirror, size);
+    }
+
+    uint32_t random(void) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state;
+    }
+
+    void write(uint16_t offset, const void *data, uint16_t length) {
+        memcpy(&source[offset], data, length);
+        split_delta_mark_dirty(&encoder, offset, length);
+    }
+
+    // Sends packets until the mirror is up to date, losing the given share of packets and acknowledgements
+    void sync(uint32_t loss_percent = 0) {
+        packets = 0;
+        bytes   = 0;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            uint8_t length = split_delta_encode(&encoder);
+            if (length == 0) return;
+            ASSERT_LE(length, SPLIT_DELTA_PACKET_SIZE);
+            packets++;
+            bytes += length;
+            if (random() % 100 < loss_percent) continue;
+            uint8_t acknowledgement = split_delta_apply(&decoder, encoder.packet, length);
+            if (random() % 100 < loss_percent) continue;
+            split_delta_acknowledge(&encoder, acknowledgement);
+        }
+        FAIL() << "Never caught up";
+    }
+
+    void expect_mirrored(uint16_t size) {
+        EXPECT_EQ(memcmp(source, mirror, size), 0);
+        EXPECT_EQ(memcmp(source, shadow, size), 0);
+    }
+};
+
+TEST_F(SplitDeltaTest, FirstSyncClearsMirror) {
+    init(OLED_SIZE);
+    sync();
+    EXPECT_EQ(packets, 1u) << "An empty buffer should only need the reset";
+    expect_mirrored(OLED_SIZE);
+
+    sync();
+    EXPECT_EQ(packets, 0u) << "Nothing should be sent once up to date";
+}
+
+TEST_F(SplitDeltaTest, ReconstructsRandomEdits) {
+    init(OLED_SIZE);
+    for (uint32_t frame = 0; frame < 500; ++frame) {
+        for (uint32_t edit = random() % 8; edit > 0; --edit) {
+            uint8_t  data[40];
+            uint16_t length = 1 + random() % sizeof(data);
+            uint16_t offset = random() % (OLED_SIZE - length);
+            for (uint16_t i = 0; i < length; ++i) {
+                data[i] = random() % 4 == 0 ? source[offset + i] : random();
+            }
+            write(offset, data, length);
+        }
+        sync();
+        expect_mirrored(OLED_SIZE);
+    }
+}
+
+TEST_F(SplitDeltaTest, UntrackedWritesFoundByComparing) {
+    init(RGB_SIZE);
+    sync();
+    source[7]  = 0x40;
+    source[90] = 0x01;
+    split_delta_mark_changes(&encoder);
+    sync();
+    EXPECT_EQ(packets, 1u);
+    expect_mirrored(RGB_SIZE);
+}
+
+TEST_F(SplitDeltaTest, PartialLastBlock) {
+    const uint16_t size = SPLIT_DELTA_BLOCK_SIZE * 3 + 5;
+    init(size);
+    uint8_t data[5] = {1, 2, 3, 4, 5};
+    write(size - sizeof(data), data, sizeof(data));
+    sync();
+    expect_mirrored(size);
+}
+
+TEST_F(SplitDeltaTest, RecoversFromLostPacketsAndAcknowledgements) {
+    init(OLED_SIZE);
+    for (uint32_t frame = 0; frame < 500; ++frame) {
+        uint8_t data[12];
+        for (uint8_t &byte : data) {
+            byte = random();
+        }
+        write(random() % (OLED_SIZE - sizeof(data)), data, sizeof(data));
+        // Also changes data while a packet is awaiting acknowledgement
+        if (frame % 3 == 0) {
+            split_delta_encode(&encoder);
+        }
+        sync(30);
+        expect_mirrored(OLED_SIZE);
+    }
+}
+
+TEST_F(SplitDeltaTest, ReceiverRestartResendsEverything) {
+    init(OLED_SIZE);
+    memset(source, 0x3C, OLED_SIZE);
+    split_delta_mark_dirty(&encoder, 0, OLED_SIZE);
+    sync();
+    expect_mirrored(OLED_SIZE);
+
+    memset(mirror, 0, sizeof(mirror));
+    split_delta_decoder_init(&decoder, mirror, OLED_SIZE);
+    uint8_t data = 0x55;
+    write(100, &data, 1);
+    sync();
+    expect_mirrored(OLED_SIZE);
+}
+
+TEST_F(SplitDeltaTest, SenderRestartResetsMirror) {
+    init(OLED_SIZE);
+    uint8_t data[4] = {9, 8, 7, 6};
+    write(200, data, sizeof(data));
+    sync();
+
+    // Even if its sequence happens to match the receiver's, the reset is applied
+    memset(source, 0, sizeof(source));
+    split_delta_encoder_init(&encoder, source, shadow, dirty, OLED_SIZE);
+    sync();
+    expect_mirrored(OLED_SIZE);
+}
+
+TEST_F(SplitDeltaTest, MalformedPacketIgnored) {
+    init(OLED_SIZE);
+    sync();
+    uint8_t before[OLED_SIZE];
+    memcpy(before, mirror, sizeof(before));
+
+    // Out of range block, truncated literal, and a run past the end of the block
+    const uint8_t  bad_block[] = {1, OLED_SIZE / SPLIT_DELTA_BLOCK_SIZE, 0x8F};
+    const uint8_t  truncated[] = {1, 0, 0x05, 0xFF};
+    const uint8_t  past_end[]  = {1, 0, 0x80 | SPLIT_DELTA_BLOCK_SIZE};
+    const uint8_t *packets[]   = {bad_block, truncated, past_end};
+    const uint8_t  lengths[]   = {sizeof(bad_block), sizeof(truncated), sizeof(past_end)};
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(split_delta_apply(&decoder, packets[i], lengths[i]), 0) << "Packet " << i;
+    }
+    EXPECT_EQ(memcmp(before, mirror, sizeof(before)), 0);
+}
+
+/**
+ * Reports the bytes sent per frame for typical display and lighting updates, against sending the whole buffer
+ * through RPC_M2S_BUFFER_SIZE sized transactions.
+ */
+TEST_F(SplitDeltaTest, BytesPerFrame) {
+    init(OLED_SIZE);
+
+    // Full screen of text, 6x8 glyphs on 4 rows
+    for (uint16_t i = 0; i < OLED_SIZE; ++i) {
+        source[i] = (i % 6 == 5) ? 0 : (uint8_t)(i * 37 + 11);
+    }
+    split_delta_mark_dirty(&encoder, 0, OLED_SIZE);
+    sync();
+    printf("%-10s %-16s %8u %8u\n", "delta", "oled full", packets, bytes);
+    EXPECT_LE(bytes, OLED_SIZE + OLED_SIZE / 4);
+
+    // A WPM counter redrawn every frame, two or three glyphs changing
+    uint32_t total = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        uint8_t glyph[6] = {(uint8_t)random(), (uint8_t)random(), (uint8_t)random(), (uint8_t)random(), (uint8_t)random(), 0};
+        write(128 * 3 + 6 * (frame % 3), glyph, sizeof(glyph));
+        sync();
+        total += bytes;
+    }
+    printf("%-10s %-16s %8.1f\n", "delta", "oled counter", total / 100.0);
+    EXPECT_LE(total / 100, 12u);
+
+    // Inverting a 32 pixel wide highlight bar
+    for (uint16_t i = 0; i < 32; ++i) {
+        source[128 + i] ^= 0xFF;
+    }
+    split_delta_mark_dirty(&encoder, 128, 32);
+    sync();
+    printf("%-10s %-16s %8u %8u\n", "delta", "oled highlight", packets, bytes);
+    EXPECT_LE(bytes, 10u);
+    expect_mirrored(OLED_SIZE);
+
+    // Three RGB overrides changing each frame
+    init(RGB_SIZE);
+    sync();
+    total = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        for (int led = 0; led < 3; ++led) {
+            uint8_t rgb[3] = {(uint8_t)random(), (uint8_t)random(), (uint8_t)random()};
+            write(3 * (random() % 64), rgb, sizeof(rgb));
+        }
+        sync();
+        total += bytes;
+    }
+    printf("%-10s %-16s %8.1f\n", "delta", "rgb overrides", total / 100.0);
+    expect_mirrored(RGB_SIZE);
+    printf("%-10s %-16s %8u\n", "full", "oled", OLED_SIZE);
+}
@@ -120,6 +120,12 @@ enum serial_transaction_id {
     PUT_DETECTED_OS,
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+    SYNC_FRAME_POLL,
+    SYNC_FRAME_SHORT,
+    SYNC_FRAME,
+#endif // SPLIT_SYNC_FRAME_ENABLE
+
     NUM_TOTAL_TRANSACTIONS
 };
 
@@ -30,6 +30,7 @@
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "util.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -84,9 +85,41 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+// Priority of each master handler, which decides how the link quality and sync scheduler options treat it
+enum {
+    SYNC_PRIORITY_CRITICAL, // slave input and the master matrix, which every keypress waits for
+    SYNC_PRIORITY_STATE,    // small state which changes what the slave does, such as layers and modifiers
+    SYNC_PRIORITY_BULK,     // everything else, such as lighting and displays
+    SYNC_PRIORITY_QUEUED,   // bulk data queued by the keyboard or keymap, which is sent as soon as there's room for it
+};
+
+#ifdef SPLIT_LINK_QUALITY_ENABLE
+static bool link_quality_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define link_transport_execute_transaction link_quality_execute_transaction
+#else // SPLIT_LINK_QUALITY_ENABLE
+#    define link_transport_execute_transaction transport_execute_transaction
+#endif // SPLIT_LINK_QUALITY_ENABLE
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+static bool sync_scheduler_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define link_execute_transaction sync_scheduler_execute_transaction
+// Each handler's data is resent at the longest interval of its priority
+#    define FORCED_SYNC_INTERVAL_MS sync_scheduler.forced_interval
+#else // SPLIT_SYNC_SCHEDULER_ENABLE
+#    define link_execute_transaction link_transport_execute_transaction
+#    define FORCED_SYNC_INTERVAL_MS FORCED_SYNC_THROTTLE_MS
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+static bool sync_frame_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transaction_execute sync_frame_execute_transaction
+#else // SPLIT_SYNC_FRAME_ENABLE
+#    define transaction_execute link_execute_transaction
+#endif // SPLIT_SYNC_FRAME_ENABLE
+
+#define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -94,9 +127,536 @@ void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *i
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+////////////////////////////////////////////////////
+// Sync frame
+//
+// While transactions_master() runs, transactions which carry QMK core sync data are coalesced into a single exchange:
+// writes and commands are queued in the shared memory and marked in a dirty bitmap, and the first read sends them all
+// in one frame, receiving every slave to master item in the response. Later reads in the same scan are served from the
+// response, and anything queued after it is sent in a final frame at the end of the scan.
+//
+// Master to slave frame:   | crc8 | length | dirty bitmap | payload of each dirty item, in transaction ID order |
+// Slave to master frame:   | crc8 | data of each slave to master item, in transaction ID order |
+//
+// Transports which always send the whole buffer of a transaction are kept from paying for it on every scan by using
+// one of three transactions: SYNC_FRAME_POLL when nothing is queued, which sends no master to slave frame at all,
+// SYNC_FRAME_SHORT when it fits within SPLIT_SYNC_FRAME_SHORT_SIZE, and SYNC_FRAME otherwise. Items which don't fit
+// within the frame buffers, as well as RPC, fall back to their own transactions.
+
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+
+// One bit for each transaction ID below the frames themselves
+#    define SYNC_FRAME_BITMAP_SIZE ((SYNC_FRAME_POLL + 7) / 8)
+#    define SYNC_FRAME_M2S_HEADER_SIZE (2 + SYNC_FRAME_BITMAP_SIZE)
+
+STATIC_ASSERT(SPLIT_SYNC_FRAME_SHORT_SIZE >= SYNC_FRAME_M2S_HEADER_SIZE, "SPLIT_SYNC_FRAME_SHORT_SIZE too small for the frame header");
+STATIC_ASSERT(SPLIT_SYNC_FRAME_M2S_SIZE >= SPLIT_SYNC_FRAME_SHORT_SIZE, "SPLIT_SYNC_FRAME_M2S_SIZE must not be smaller than SPLIT_SYNC_FRAME_SHORT_SIZE");
+STATIC_ASSERT(SPLIT_SYNC_FRAME_M2S_SIZE <= UINT8_MAX && SPLIT_SYNC_FRAME_S2M_SIZE <= UINT8_MAX, "Sync frame buffers too large for a transaction");
+
+static struct {
+    bool    active;   // transactions_master() is running, so transactions may be coalesced
+    bool    received; // slave to master items have been received during this scan
+    uint8_t length;   // master to slave frame length, including the header
+    uint8_t dirty[SYNC_FRAME_BITMAP_SIZE];
+} sync_frame = {.length = SYNC_FRAME_M2S_HEADER_SIZE};
+
+static bool sync_frame_is_item(int8_t id) {
+#    ifdef USE_I2C
+    if (id == I2C_EXECUTE_CALLBACK) return false;
+#    endif // USE_I2C
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPC has runtime-sized buffers, only sync data after it is carried
+    if (id >= PUT_RPC_INFO) {
+#        if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+        return id == PUT_DETECTED_OS;
+#        else  // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+        return false;
+#        endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+    }
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return id >= 0 && id < SYNC_FRAME_POLL;
+}
+
+static inline bool sync_frame_bit(const uint8_t *bitmap, int8_t id) {
+    return bitmap[id / 8] & (1 << (id % 8));
+}
+
+// Whether anything is queued, including commands such as CMD_ENCODER_DRAIN which carry no payload
+static bool sync_frame_pending(void) {
+    for (uint8_t i = 0; i < SYNC_FRAME_BITMAP_SIZE; ++i) {
+        if (sync_frame.dirty[i]) return true;
+    }
+    return false;
+}
+
+// Copies every slave to master item between the shared memory and a frame, returns the offset of the requested item
+// within the frame, or 0 if it isn't carried
+static uint8_t sync_frame_copy_s2m(uint8_t *frame, bool to_frame, int8_t find_id) {
+    uint8_t offset = 1;
+    uint8_t found  = 0;
+    for (int8_t id = 0; id < SYNC_FRAME_POLL; ++id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        uint8_t                   size  = trans->target2initiator_buffer_size;
+        if (size == 0 || !sync_frame_is_item(id) || offset + size > SPLIT_SYNC_FRAME_S2M_SIZE) continue;
+        if (to_frame) {
+            memcpy(&frame[offset], split_trans_target2initiator_buffer(trans), size);
+        } else if (frame) {
+            memcpy(split_trans_target2initiator_buffer(trans), &frame[offset], size);
+        }
+        if (id == find_id) {
+            found = offset;
+        }
+        offset += size;
+    }
+    return found;
+}
+
+static bool sync_frame_exchange(void) {
+    uint8_t m2s[SPLIT_SYNC_FRAME_M2S_SIZE] = {0};
+    uint8_t s2m[SPLIT_SYNC_FRAME_S2M_SIZE];
+
+    uint8_t length = SYNC_FRAME_M2S_HEADER_SIZE;
+    memcpy(&m2s[2], sync_frame.dirty, SYNC_FRAME_BITMAP_SIZE);
+    for (int8_t id = 0; id < SYNC_FRAME_POLL; ++id) {
+        if (!sync_frame_bit(sync_frame.dirty, id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(&m2s[length], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        length += trans->initiator2target_buffer_size;
+    }
+    m2s[1] = length;
+    m2s[0] = crc8(&m2s[1], length - 1);
+
+    int8_t frame_id = !sync_frame_pending() ? SYNC_FRAME_POLL : length <= SPLIT_SYNC_FRAME_SHORT_SIZE ? SYNC_FRAME_SHORT : SYNC_FRAME;
+    if (!link_execute_transaction(frame_id, m2s, split_transaction_table[frame_id].initiator2target_buffer_size, s2m, sizeof(s2m))) {
+        return false;
+    }
+    if (crc8(&s2m[1], sizeof(s2m) - 1) != s2m[0]) {
+        return false;
+    }
+
+    sync_frame_copy_s2m(s2m, false, -1);
+    memset(sync_frame.dirty, 0, sizeof(sync_frame.dirty));
+    sync_frame.length   = SYNC_FRAME_M2S_HEADER_SIZE;
+    sync_frame.received = true;
+    return true;
+}
+
+static bool sync_frame_queue(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!sync_frame_bit(sync_frame.dirty, id)) {
+        if (sync_frame.length + trans->initiator2target_buffer_size > SPLIT_SYNC_FRAME_M2S_SIZE) {
+            return false;
+        }
+        sync_frame.length += trans->initiator2target_buffer_size;
+        sync_frame.dirty[id / 8] |= 1 << (id % 8);
+    }
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+    return true;
+}
+
+static bool sync_frame_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (sync_frame.active && sync_frame_is_item(id)) {
+        if (target2initiator_length == 0) {
+            if (sync_frame_queue(id, initiator2target_buf, initiator2target_length)) {
+                return true;
+            }
+        } else if (initiator2target_length == 0 && sync_frame_copy_s2m(NULL, false, id) != 0) {
+            if (!sync_frame.received && !sync_frame_exchange()) {
+                return false;
+            }
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            size_t                    len   = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+            memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+            return true;
+        }
+    }
+    return link_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool sync_frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Send anything queued after the slave to master items were received
+    return !sync_frame_pending() || sync_frame_exchange();
+}
+
+static void slave_sync_frame_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The frame carries its own length, as a poll doesn't send one and some transports run the callback before receiving
+    uint8_t *m2s    = (uint8_t *)initiator2target_buffer;
+    uint8_t  length = m2s[1];
+    if (length >= SYNC_FRAME_M2S_HEADER_SIZE && length <= SPLIT_SYNC_FRAME_M2S_SIZE && crc8(&m2s[1], length - 1) == m2s[0]) {
+        uint8_t offset = SYNC_FRAME_M2S_HEADER_SIZE;
+        for (int8_t id = 0; id < SYNC_FRAME_POLL; ++id) {
+            if (!sync_frame_bit(&m2s[2], id) || !sync_frame_is_item(id)) continue;
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (offset + trans->initiator2target_buffer_size > length) break;
+            memcpy(split_trans_initiator2target_buffer(trans), &m2s[offset], trans->initiator2target_buffer_size);
+            offset += trans->initiator2target_buffer_size;
+            if (trans->slave_callback) {
+                trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+        }
+    }
+    // Don't apply the same frame again on the next poll
+    m2s[1] = 0;
+
+    uint8_t *s2m = (uint8_t *)target2initiator_buffer;
+    sync_frame_copy_s2m(s2m, true, -1);
+    s2m[0] = crc8(&s2m[1], SPLIT_SYNC_FRAME_S2M_SIZE - 1);
+}
+
+// clang-format off
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS \
+    [SYNC_FRAME_POLL]  = { 0, offsetof(split_shared_memory_t, sync_frame.m2s), SPLIT_SYNC_FRAME_S2M_SIZE, offsetof(split_shared_memory_t, sync_frame.s2m), slave_sync_frame_callback }, \
+    [SYNC_FRAME_SHORT] = { SPLIT_SYNC_FRAME_SHORT_SIZE, offsetof(split_shared_memory_t, sync_frame.m2s), SPLIT_SYNC_FRAME_S2M_SIZE, offsetof(split_shared_memory_t, sync_frame.s2m), slave_sync_frame_callback }, \
+    [SYNC_FRAME]       = { SPLIT_SYNC_FRAME_M2S_SIZE, offsetof(split_shared_memory_t, sync_frame.m2s), SPLIT_SYNC_FRAME_S2M_SIZE, offsetof(split_shared_memory_t, sync_frame.s2m), slave_sync_frame_callback },
+// clang-format on
+
+#else // SPLIT_SYNC_FRAME_ENABLE
+
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
+
+#endif // SPLIT_SYNC_FRAME_ENABLE
+
+////////////////////////////////////////////////////
+// Event push
+//
+// The slave pushes its matrix, encoder and pointing state to the master as soon as it changes, over the otherwise
+// idle direction of a full-duplex link, instead of the master polling for it on every scan. Pushed state lands in the
+// shared memory just as a read would have left it. The master still polls every SPLIT_EVENT_PUSH_KEEPALIVE_MS, both
+// to notice a disconnected slave and to recover from a lost push, as well as straight after a corrupted one.
+//
+// Pushed frame:   | crc8 | data of each slave to master item, in transaction ID order |
+
+#if defined(SPLIT_EVENT_PUSH_ENABLE) && defined(SPLIT_SYNC_FRAME_ENABLE)
+#    error SPLIT_EVENT_PUSH_ENABLE is not supported with SPLIT_SYNC_FRAME_ENABLE
+#endif
+
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+
+STATIC_ASSERT(SPLIT_EVENT_PUSH_SIZE <= UINT8_MAX, "Event push frame too large for the transport");
+
+static const int8_t event_push_items[] = {
+    GET_SLAVE_MATRIX_CHECKSUM,
+    GET_SLAVE_MATRIX_DATA,
+#    ifdef ENCODER_ENABLE
+    GET_ENCODERS_CHECKSUM,
+    GET_ENCODERS_DATA,
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    GET_POINTING_CHECKSUM,
+    GET_POINTING_DATA,
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+};
+
+static struct {
+    bool     poll;      // slave to master items are read over the transport during this scan
+    uint32_t last_poll; // time of the last keepalive poll
+} event_push = {.poll = true};
+
+// Copies each slave to master item between the shared memory and a pushed frame
+static void event_push_copy(uint8_t *frame, bool to_frame) {
+    uint8_t offset = 1;
+    for (uint8_t i = 0; i < ARRAY_SIZE(event_push_items); ++i) {
+        split_transaction_desc_t *trans = &split_transaction_table[event_push_items[i]];
+        if (to_frame) {
+            memcpy(&frame[offset], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        } else {
+            memcpy(split_trans_target2initiator_buffer(trans), &frame[offset], trans->target2initiator_buffer_size);
+        }
+        offset += trans->target2initiator_buffer_size;
+    }
+}
+
+static bool event_push_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    uint8_t frame[SPLIT_EVENT_PUSH_SIZE];
+    uint8_t length = transport_receive_push(frame, sizeof(frame));
+    bool    valid  = length == sizeof(frame) && crc8(&frame[1], sizeof(frame) - 1) == frame[0];
+    if (valid) {
+        event_push_copy(frame, false);
+    }
+
+    event_push.poll = (length > 0 && !valid) || timer_elapsed32(event_push.last_poll) >= SPLIT_EVENT_PUSH_KEEPALIVE_MS;
+    if (event_push.poll) {
+        event_push.last_poll = timer_read32();
+    }
+    return true;
+}
+
+static void event_push_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t last_frame[SPLIT_EVENT_PUSH_SIZE] = {0};
+    uint8_t        frame[SPLIT_EVENT_PUSH_SIZE];
+
+    split_shared_memory_lock();
+    event_push_copy(frame, true);
+    split_shared_memory_unlock();
+    frame[0] = crc8(&frame[1], sizeof(frame) - 1);
+
+    // Push as soon as anything changed, retrying on the next scan if the transport was busy
+    if (memcmp(frame, last_frame, sizeof(frame)) != 0 && transport_push(frame, sizeof(frame))) {
+        memcpy(last_frame, frame, sizeof(frame));
+    }
+}
+
+#    define TRANSACTIONS_EVENT_PUSH_MASTER() TRANSACTION_HANDLER_MASTER(event_push)
+#    define TRANSACTIONS_EVENT_PUSH_SLAVE() TRANSACTION_HANDLER_SLAVE(event_push)
+
+#else // SPLIT_EVENT_PUSH_ENABLE
+
+#    define TRANSACTIONS_EVENT_PUSH_MASTER()
+#    define TRANSACTIONS_EVENT_PUSH_SLAVE()
+
+#endif // SPLIT_EVENT_PUSH_ENABLE
+
+////////////////////////////////////////////////////
+// Link quality
+//
+// Every transaction is counted, along with its failures and the longest it took, and a running error rate is kept
+// across all of them. Failed handlers are retried without waiting in between: essential sync is retried up to
+// SPLIT_LINK_RETRIES times within the scan and then again on the next one, while optional handlers back off
+// exponentially across scans, up to SPLIT_LINK_BACKOFF_MAX_MS, and are skipped altogether while the error rate is above
+// SPLIT_LINK_DEGRADED_ERROR_RATE percent. Their data is sent once the link recovers, as it is still out of date.
+
+#ifdef SPLIT_LINK_QUALITY_ENABLE
+
+// Weight of the most recent transaction in the running error rate, as a power of two
+#    define LINK_QUALITY_ERROR_RATE_SHIFT 4
+#    define LINK_QUALITY_DEGRADED_THRESHOLD ((uint16_t)((uint32_t)UINT16_MAX * (SPLIT_LINK_DEGRADED_ERROR_RATE) / 100))
+
+typedef struct {
+    uint8_t  failures;     // consecutive failures of the handler
+    uint16_t last_attempt; // time of the last failure, for the backoff
+} link_quality_backoff_t;
+
+static split_link_stats_t link_stats;
+static bool               link_degraded;
+
+static inline void link_quality_count(uint16_t *counter) {
+    if (*counter < UINT16_MAX) {
+        (*counter)++;
+    }
+}
+
+static bool link_quality_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    uint32_t start = timer_read32();
+    bool     okay  = transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    uint32_t took  = timer_elapsed32(start);
+
+    split_link_transaction_stats_t *stats = &link_stats.transactions[id];
+    link_quality_count(&stats->attempts);
+    if (!okay) {
+        link_quality_count(&stats->failures);
+    }
+    if (took > stats->worst_ms) {
+        stats->worst_ms = took < UINT8_MAX ? took : UINT8_MAX;
+    }
+
+    if (okay) {
+        // Rounded up, so that a clean link gets back to zero
+        link_stats.error_rate -= (link_stats.error_rate + (1 << LINK_QUALITY_ERROR_RATE_SHIFT) - 1) >> LINK_QUALITY_ERROR_RATE_SHIFT;
+    } else {
+        link_stats.error_rate += (UINT16_MAX - link_stats.error_rate) >> LINK_QUALITY_ERROR_RATE_SHIFT;
+    }
+    // Only recover once well below the threshold, so that optional sync doesn't flap on a marginal link
+    if (link_stats.error_rate > LINK_QUALITY_DEGRADED_THRESHOLD) {
+        link_degraded = true;
+    } else if (link_stats.error_rate < LINK_QUALITY_DEGRADED_THRESHOLD / 2) {
+        link_degraded = false;
+    }
+    return okay;
+}
+
+static bool link_quality_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]), link_quality_backoff_t *backoff, bool optional) {
+    if (optional && backoff->failures > 0) {
+        uint8_t  shift = backoff->failures - 1 < 15 ? backoff->failures - 1 : 15;
+        uint16_t delay = (1U << shift) < (SPLIT_LINK_BACKOFF_MAX_MS) ? (1U << shift) : (SPLIT_LINK_BACKOFF_MAX_MS);
+        if (timer_elapsed(backoff->last_attempt) < delay) {
+            link_quality_count(&link_stats.skipped);
+            return true;
+        }
+    }
+    if (optional && link_degraded) {
+        link_quality_count(&link_stats.skipped);
+        return true;
+    }
+
+    // Essential sync gets a few immediate attempts, so that a noisy link isn't mistaken for a disconnected one
+    uint8_t attempts = !optional && is_transport_connected() ? 1 + (SPLIT_LINK_RETRIES) : 1;
+    for (uint8_t i = 0; i < attempts; ++i) {
+        if (i > 0 || backoff->failures > 0) {
+            link_quality_count(&link_stats.retries);
+        }
+        if (handler(master_matrix, slave_matrix)) {
+            backoff->failures = 0;
+            return true;
+        }
+    }
+
+    if (backoff->failures < UINT8_MAX) {
+        backoff->failures++;
+    }
+    backoff->last_attempt = timer_read();
+    dprintf("Failed to execute %s\n", prefix);
+    // Optional sync failing doesn't hold up the rest of the scan
+    return optional;
+}
+
+const split_link_stats_t *split_link_get_stats(void) {
+    return &link_stats;
+}
+
+void split_link_reset_stats(void) {
+    uint16_t error_rate = link_stats.error_rate;
+    memset(&link_stats, 0, sizeof(link_stats));
+    link_stats.error_rate = error_rate;
+}
+
+bool split_link_is_degraded(void) {
+    return link_degraded;
+}
+
+void split_link_print_stats(void) {
+    uprintf("SPLIT: error rate %u%%%s, %u retries, %u skipped\n", (unsigned)((uint32_t)link_stats.error_rate * 100 / UINT16_MAX), link_degraded ? " (degraded)" : "", link_stats.retries, link_stats.skipped);
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        const split_link_transaction_stats_t *stats = &link_stats.transactions[id];
+        if (stats->attempts == 0) continue;
+        uprintf("SPLIT: transaction %2u: %5u attempts, %5u failures, worst %3u ms\n", id, stats->attempts, stats->failures, stats->worst_ms);
+    }
+}
+
+#endif // SPLIT_LINK_QUALITY_ENABLE
+
+////////////////////////////////////////////////////
+// Sync scheduler
+//
+// Critical handlers run on every scan. State and bulk handlers run at most every SPLIT_SYNC_*_MIN_INTERVAL_MS, and
+// once the transactions of a scan have sent and received SPLIT_SYNC_SCAN_BUDGET bytes, those which are still due are
+// deferred to a later scan, unless they haven't run for SPLIT_SYNC_*_MAX_INTERVAL_MS. Unchanged data is resent at that
+// same longest interval. Critical handlers run first, so the budget only ever holds back the others.
+//
+// RPC queued with transaction_rpc_queue() is bulk sync too, without the minimum interval: its info, request data and
+// execute transactions are sent one after another while within the budget, and otherwise carry on from where they
+// left off on the next scan.
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+
+static const struct {
+    uint16_t min_interval;
+    uint16_t max_interval;
+} sync_scheduler_intervals[] = {
+    [SYNC_PRIORITY_CRITICAL] = {0, FORCED_SYNC_THROTTLE_MS},
+    [SYNC_PRIORITY_STATE]    = {SPLIT_SYNC_STATE_MIN_INTERVAL_MS, SPLIT_SYNC_STATE_MAX_INTERVAL_MS},
+    [SYNC_PRIORITY_BULK]     = {SPLIT_SYNC_BULK_MIN_INTERVAL_MS, SPLIT_SYNC_BULK_MAX_INTERVAL_MS},
+    [SYNC_PRIORITY_QUEUED]   = {0, SPLIT_SYNC_BULK_MAX_INTERVAL_MS},
+};
+
+static struct {
+    uint16_t bytes;           // sent and received by the transactions of this scan
+    uint16_t forced_interval; // how often the running handler resends unchanged data
+} sync_scheduler = {.forced_interval = FORCED_SYNC_THROTTLE_MS};
+
+static bool sync_scheduler_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // The transaction ID and its acknowledgement, then both buffers, which some transports send in full regardless
+    const split_transaction_desc_t *trans = &split_transaction_table[id];
+    sync_scheduler.bytes += 2 + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    return link_transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool sync_scheduler_is_due(uint16_t *last_run, uint8_t priority) {
+    if (priority != SYNC_PRIORITY_CRITICAL) {
+        uint16_t elapsed = timer_elapsed(*last_run);
+        if (elapsed < sync_scheduler_intervals[priority].min_interval) {
+            return false;
+        }
+        if (sync_scheduler.bytes >= (SPLIT_SYNC_SCAN_BUDGET) && elapsed < sync_scheduler_intervals[priority].max_interval) {
+            return false;
+        }
+    }
+    *last_run                      = timer_read();
+    sync_scheduler.forced_interval = sync_scheduler_intervals[priority].max_interval;
+    return true;
+}
+
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+enum { RPC_QUEUE_IDLE, RPC_QUEUE_INFO, RPC_QUEUE_REQ_DATA, RPC_QUEUE_EXECUTE };
+
+static struct {
+    uint8_t         stage; // the next transaction to send
+    rpc_sync_info_t info;
+    uint8_t         data[RPC_M2S_BUFFER_SIZE];
+} rpc_queue;
+
+bool transaction_rpc_queue(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent sizing issues
+    if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
+
+    // Data for the same transaction may be replaced until it's been sent, otherwise wait for the queue to empty
+    bool same = rpc_queue.info.payload.transaction_id == transaction_id;
+    if (rpc_queue.stage == RPC_QUEUE_EXECUTE || (rpc_queue.stage != RPC_QUEUE_IDLE && !same)) {
+        return false;
+    }
+    if (rpc_queue.stage == RPC_QUEUE_IDLE || rpc_queue.info.payload.m2s_length != initiator2target_buffer_size) {
+        rpc_queue.stage = RPC_QUEUE_INFO;
+    }
+
+    rpc_queue.info = (rpc_sync_info_t){.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = 0}};
+    rpc_queue.info.checksum = crc8(&rpc_queue.info.payload, sizeof(rpc_queue.info.payload));
+    memcpy(rpc_queue.data, initiator2target_buffer, initiator2target_buffer_size);
+    return true;
+}
+
+static bool rpc_queue_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    while (rpc_queue.stage != RPC_QUEUE_IDLE) {
+        bool okay = true;
+        switch (rpc_queue.stage) {
+            case RPC_QUEUE_INFO:
+                okay = transport_write(PUT_RPC_INFO, &rpc_queue.info, sizeof(rpc_queue.info));
+                break;
+            case RPC_QUEUE_REQ_DATA:
+                // Make sure the local side knows that we're not sending the full block of data
+                split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = rpc_queue.info.payload.m2s_length;
+                split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = 0;
+                okay = transport_write(PUT_RPC_REQ_DATA, rpc_queue.data, rpc_queue.info.payload.m2s_length);
+                break;
+            case RPC_QUEUE_EXECUTE:
+                okay = transport_write(EXECUTE_RPC, &rpc_queue.info.payload.transaction_id, sizeof(rpc_queue.info.payload.transaction_id));
+                break;
+        }
+        if (!okay) {
+            // Start over on the next scan, as the slave may have missed any part of it
+            rpc_queue.stage = RPC_QUEUE_INFO;
+            return false;
+        }
+        rpc_queue.stage = rpc_queue.stage == RPC_QUEUE_EXECUTE ? RPC_QUEUE_IDLE : rpc_queue.stage + 1;
+        if (sync_scheduler.bytes >= (SPLIT_SYNC_SCAN_BUDGET)) {
+            break;
+        }
+    }
+    return true;
+}
+
+#        define TRANSACTIONS_RPC_QUEUE_MASTER() TRANSACTION_HANDLER_MASTER_PRIORITY(rpc_queue, SYNC_PRIORITY_QUEUED)
+
+#    else // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#        define TRANSACTIONS_RPC_QUEUE_MASTER()
+
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#else // SPLIT_SYNC_SCHEDULER_ENABLE
+
+#    define TRANSACTIONS_RPC_QUEUE_MASTER()
+
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+
 ////////////////////////////////////////////////////
 // Helpers
 
+#ifndef SPLIT_LINK_QUALITY_ENABLE
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
     int num_retries = is_transport_connected() ? 10 : 1;
     for (int iter = 1; iter <= num_retries; ++iter) {
@@ -112,11 +672,56 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     dprintf("Failed to execute %s\n", prefix);
     return false;
 }
+#endif // SPLIT_LINK_QUALITY_ENABLE
+
+#if defined(SPLIT_LINK_QUALITY_ENABLE) || defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+typedef struct {
+#    ifdef SPLIT_LINK_QUALITY_ENABLE
+    link_quality_backoff_t backoff;
+#    endif // SPLIT_LINK_QUALITY_ENABLE
+#    ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    uint16_t last_run;
+#    endif // SPLIT_SYNC_SCHEDULER_ENABLE
+} transaction_handler_state_t;
+
+static bool transaction_handler_master_priority(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]), transaction_handler_state_t *state, uint8_t priority) {
+#    ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    if (!sync_scheduler_is_due(&state->last_run, priority)) {
+        return true;
+    }
+#    endif // SPLIT_SYNC_SCHEDULER_ENABLE
+#    ifdef SPLIT_LINK_QUALITY_ENABLE
+    return link_quality_handler_master(master_matrix, slave_matrix, prefix, handler, &state->backoff, priority >= SYNC_PRIORITY_BULK);
+#    else  // SPLIT_LINK_QUALITY_ENABLE
+    return transaction_handler_master(master_matrix, slave_matrix, prefix, handler);
+#    endif // SPLIT_LINK_QUALITY_ENABLE
+}
 
-#define TRANSACTION_HANDLER_MASTER(prefix)                                                                              \
-    do {                                                                                                                \
-        if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
-    } while (0)
+#    define TRANSACTION_HANDLER_MASTER_PRIORITY(prefix, priority)                                                                                  \
+        do {                                                                                                                                       \
+            static transaction_handler_state_t state = {0};                                                                                        \
+            if (!transaction_handler_master_priority(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master, &state, priority)) return false; \
+        } while (0)
+#else // defined(SPLIT_LINK_QUALITY_ENABLE) || defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+#    define TRANSACTION_HANDLER_MASTER_PRIORITY(prefix, priority)                                                   \
+        do {                                                                                                        \
+            if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
+        } while (0)
+#endif // defined(SPLIT_LINK_QUALITY_ENABLE) || defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+
+#define TRANSACTION_HANDLER_MASTER(prefix) TRANSACTION_HANDLER_MASTER_PRIORITY(prefix, SYNC_PRIORITY_CRITICAL)
+
+/**
+ * @brief Constructs a transaction handler for state which changes what the slave does, but which isn't needed for
+ * the master to see keypresses, and so may be rate limited.
+ */
+#define TRANSACTION_HANDLER_MASTER_STATE(prefix) TRANSACTION_HANDLER_MASTER_PRIORITY(prefix, SYNC_PRIORITY_STATE)
+
+/**
+ * @brief Constructs a transaction handler for sync which isn't needed for typing, and so may be deferred while the
+ * link is unreliable or busy.
+ */
+#define TRANSACTION_HANDLER_MASTER_OPTIONAL(prefix) TRANSACTION_HANDLER_MASTER_PRIORITY(prefix, SYNC_PRIORITY_BULK)
 
 /**
  * @brief Constructs a transaction handler that doesn't acquire a lock to the
@@ -145,9 +750,18 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+    // Between polls the shared memory holds the last state pushed by the slave, unless it's since been modified here
+    const uint8_t *pushed_checksum = split_trans_target2initiator_buffer(&split_transaction_table[trans_id_checksum]);
+    if (!event_push.poll && *pushed_checksum == crc8(equiv_shmem, length)) {
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+#endif // SPLIT_EVENT_PUSH_ENABLE
+
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
-    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
+    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_INTERVAL_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
         okay &= curr_checksum == crc8(equiv_shmem, length);
         if (okay) {
@@ -161,7 +775,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
-    if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
+    if (timer_elapsed32(*last_update) >= FORCED_SYNC_INTERVAL_MS || condition) {
         okay &= transport_write(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
@@ -300,7 +914,7 @@ static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_
     static uint32_t last_update = 0;
 
     bool okay = true;
-    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+    if (timer_elapsed32(last_update) >= FORCED_SYNC_INTERVAL_MS) {
         uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
         okay &= transport_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
         if (okay) {
@@ -318,7 +932,7 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     }
 }
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
+#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER_STATE(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
 
@@ -352,7 +966,7 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 }
 
 // clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
+#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER_STATE(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
     [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
@@ -383,7 +997,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
+#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER_STATE(led_state)
 #    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(led_state)
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
 
@@ -402,7 +1016,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_INTERVAL_MS;
     split_mods_sync_t new_mods;
     new_mods.real_mods = get_mods();
     if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
@@ -450,7 +1064,7 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 #    endif
 }
 
-#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods)
+#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER_STATE(mods)
 #    define TRANSACTIONS_MODS_SLAVE() TRANSACTION_HANDLER_SLAVE(mods)
 #    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
 
@@ -481,7 +1095,7 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     backlight_level_noeeprom(backlight_level);
 }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight)
+#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(backlight)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight)
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
@@ -523,7 +1137,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
+#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
@@ -557,7 +1171,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
+#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
@@ -591,7 +1205,7 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
 
@@ -618,7 +1232,7 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
     set_current_wpm(split_shmem->current_wpm);
 }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm)
+#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(wpm)
 #    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm)
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
@@ -653,7 +1267,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(oled)
 #    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
 #    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
 
@@ -688,7 +1302,7 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(st7565)
 #    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
 #    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
 
@@ -803,7 +1417,7 @@ static void watchdog_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     split_watchdog_update(split_shmem->watchdog_pinged);
 }
 
-#    define TRANSACTIONS_WATCHDOG_MASTER() TRANSACTION_HANDLER_MASTER(watchdog)
+#    define TRANSACTIONS_WATCHDOG_MASTER() TRANSACTION_HANDLER_MASTER_STATE(watchdog)
 #    define TRANSACTIONS_WATCHDOG_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(watchdog)
 #    define TRANSACTIONS_WATCHDOG_REGISTRATIONS [PUT_WATCHDOG] = trans_initiator2target_initializer(watchdog_pinged),
 
@@ -844,7 +1458,7 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 }
 
 // clang-format off
-#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER(haptic)
+#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(haptic)
 #    define TRANSACTIONS_HAPTIC_SLAVE() TRANSACTION_HANDLER_SLAVE(haptic)
 #    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer(haptic_sync),
 // clang-format on
@@ -873,7 +1487,7 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 // clang-format off
-#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER(activity)
+#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(activity)
 #    define TRANSACTIONS_ACTIVITY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(activity)
 #    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer(activity_sync),
 // clang-format on
@@ -902,7 +1516,7 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
     slave_update_detected_host_os(split_shmem->detected_os);
 }
 
-#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER(detected_os)
+#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER_OPTIONAL(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer(detected_os),
 
@@ -944,6 +1558,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -954,10 +1569,55 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+
+static bool sync_frame_transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Queue the master to slave items first, so that the exchange for the first read carries them
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    TRANSACTION_HANDLER_MASTER(sync_frame);
+    TRANSACTIONS_RPC_QUEUE_MASTER();
+    return true;
+}
+
+#endif // SPLIT_SYNC_FRAME_ENABLE
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    sync_scheduler.bytes = 0;
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+    TRANSACTIONS_EVENT_PUSH_MASTER();
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+    sync_frame.active   = true;
+    sync_frame.received = false;
+    bool okay           = sync_frame_transactions_master(master_matrix, slave_matrix);
+    sync_frame.active   = false;
+    return okay;
+#else  // SPLIT_SYNC_FRAME_ENABLE
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
+#    ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    // Critical handlers all run before the budget is spent on anything else
+    TRANSACTIONS_POINTING_MASTER();
+#    endif // SPLIT_SYNC_SCHEDULER_ENABLE
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
     TRANSACTIONS_LED_STATE_MASTER();
@@ -969,12 +1629,16 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
+#    ifndef SPLIT_SYNC_SCHEDULER_ENABLE
     TRANSACTIONS_POINTING_MASTER();
+#    endif // SPLIT_SYNC_SCHEDULER_ENABLE
     TRANSACTIONS_WATCHDOG_MASTER();
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_QUEUE_MASTER();
     return true;
+#endif // SPLIT_SYNC_FRAME_ENABLE
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -997,6 +1661,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_EVENT_PUSH_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -1030,6 +1695,13 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = initiator2target_buffer_size;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = target2initiator_buffer_size;
 
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    // This replaces whatever part of a queued call the slave has, so send all of it again
+    if (rpc_queue.stage != RPC_QUEUE_IDLE) {
+        rpc_queue.stage = RPC_QUEUE_INFO;
+    }
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+
     // Run through the sequence:
     // * set the transaction ID and lengths
     // * send the request data
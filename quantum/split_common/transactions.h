@@ -41,6 +41,63 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 #define split_trans_initiator2target_buffer(trans) (split_shmem_offset_ptr((trans)->initiator2target_offset))
 #define split_trans_target2initiator_buffer(trans) (split_shmem_offset_ptr((trans)->target2initiator_offset))
 
+#ifdef SPLIT_LINK_QUALITY_ENABLE
+#    ifndef SPLIT_LINK_RETRIES
+#        define SPLIT_LINK_RETRIES 2
+#    endif // SPLIT_LINK_RETRIES
+
+#    ifndef SPLIT_LINK_BACKOFF_MAX_MS
+#        define SPLIT_LINK_BACKOFF_MAX_MS 100
+#    endif // SPLIT_LINK_BACKOFF_MAX_MS
+
+#    ifndef SPLIT_LINK_DEGRADED_ERROR_RATE
+#        define SPLIT_LINK_DEGRADED_ERROR_RATE 10
+#    endif // SPLIT_LINK_DEGRADED_ERROR_RATE
+
+typedef struct _split_link_transaction_stats_t {
+    uint16_t attempts; // saturating counts since the last reset
+    uint16_t failures;
+    uint8_t  worst_ms; // longest any attempt took, including timeouts
+} split_link_transaction_stats_t;
+
+typedef struct _split_link_stats_t {
+    split_link_transaction_stats_t transactions[NUM_TOTAL_TRANSACTIONS];
+    uint16_t                       retries;    // handlers run again after failing on an earlier scan
+    uint16_t                       skipped;    // optional handlers skipped while backing off or degraded
+    uint16_t                       error_rate; // running failure rate of recent transactions, out of UINT16_MAX
+} split_link_stats_t;
+
+const split_link_stats_t *split_link_get_stats(void);
+// Clears the counts, but keeps the running error rate
+void split_link_reset_stats(void);
+// True while optional sync is being skipped due to errors
+bool split_link_is_degraded(void);
+// Prints the stats to the console
+void split_link_print_stats(void);
+#endif // SPLIT_LINK_QUALITY_ENABLE
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+#    ifndef SPLIT_SYNC_SCAN_BUDGET
+#        define SPLIT_SYNC_SCAN_BUDGET 32
+#    endif // SPLIT_SYNC_SCAN_BUDGET
+
+#    ifndef SPLIT_SYNC_STATE_MIN_INTERVAL_MS
+#        define SPLIT_SYNC_STATE_MIN_INTERVAL_MS 0
+#    endif // SPLIT_SYNC_STATE_MIN_INTERVAL_MS
+
+#    ifndef SPLIT_SYNC_STATE_MAX_INTERVAL_MS
+#        define SPLIT_SYNC_STATE_MAX_INTERVAL_MS FORCED_SYNC_THROTTLE_MS
+#    endif // SPLIT_SYNC_STATE_MAX_INTERVAL_MS
+
+#    ifndef SPLIT_SYNC_BULK_MIN_INTERVAL_MS
+#        define SPLIT_SYNC_BULK_MIN_INTERVAL_MS 10
+#    endif // SPLIT_SYNC_BULK_MIN_INTERVAL_MS
+
+#    ifndef SPLIT_SYNC_BULK_MAX_INTERVAL_MS
+#        define SPLIT_SYNC_BULK_MAX_INTERVAL_MS 500
+#    endif // SPLIT_SYNC_BULK_MAX_INTERVAL_MS
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+
 // returns false if valid data not received from slave
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
@@ -49,5 +106,10 @@ void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
+#if defined(SPLIT_SYNC_SCHEDULER_ENABLE) && (defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER))
+// Queues a call to be sent as bulk sync over the following scans, returns false while another call is being sent
+bool transaction_rpc_queue(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer);
+#endif // defined(SPLIT_SYNC_SCHEDULER_ENABLE) && (defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER))
+
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
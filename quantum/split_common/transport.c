@@ -36,6 +36,10 @@
 #    include "i2c_master.h"
 #    include "i2c_slave.h"
 
+#    ifdef SPLIT_EVENT_PUSH_ENABLE
+#        error "SPLIT_EVENT_PUSH_ENABLE requires a full-duplex serial transport, the I2C slave can't initiate transfers"
+#    endif // SPLIT_EVENT_PUSH_ENABLE
+
 // Ensure the I2C buffer has enough space
 STATIC_ASSERT(sizeof(split_shared_memory_t) <= I2C_SLAVE_REG_COUNT, "split_shared_memory_t too large for I2C_SLAVE_REG_COUNT");
 
@@ -120,6 +124,16 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_EVENT_PUSH_ENABLE
+bool transport_push(const void *data, uint8_t length) {
+    return soft_serial_target_push(data, length);
+}
+
+uint8_t transport_receive_push(void *data, uint8_t length) {
+    return soft_serial_initiator_receive_push(data, length);
+}
+#    endif // SPLIT_EVENT_PUSH_ENABLE
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
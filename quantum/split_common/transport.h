@@ -147,6 +147,51 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+// Slave to master state, as carried by sync frames and event pushes: each item's checksum and data
+#define SPLIT_SLAVE_STATE_MATRIX_SIZE (1 + sizeof(matrix_row_t) * ((MATRIX_ROWS) / 2))
+#ifdef ENCODER_ENABLE
+#    define SPLIT_SLAVE_STATE_ENCODERS_SIZE (1 + sizeof(encoder_events_t))
+#else // ENCODER_ENABLE
+#    define SPLIT_SLAVE_STATE_ENCODERS_SIZE 0
+#endif // ENCODER_ENABLE
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    define SPLIT_SLAVE_STATE_POINTING_SIZE (1 + sizeof(report_mouse_t))
+#else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    define SPLIT_SLAVE_STATE_POINTING_SIZE 0
+#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+#define SPLIT_SLAVE_STATE_SIZE (SPLIT_SLAVE_STATE_MATRIX_SIZE + SPLIT_SLAVE_STATE_ENCODERS_SIZE + SPLIT_SLAVE_STATE_POINTING_SIZE)
+
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+#    ifndef SPLIT_SYNC_FRAME_M2S_SIZE
+#        define SPLIT_SYNC_FRAME_M2S_SIZE 48
+#    endif // SPLIT_SYNC_FRAME_M2S_SIZE
+
+#    ifndef SPLIT_SYNC_FRAME_SHORT_SIZE
+#        define SPLIT_SYNC_FRAME_SHORT_SIZE 12
+#    endif // SPLIT_SYNC_FRAME_SHORT_SIZE
+
+#    define SPLIT_SYNC_FRAME_S2M_SIZE (1 + SPLIT_SLAVE_STATE_SIZE)
+
+typedef struct _split_sync_frame_t {
+    uint8_t m2s[SPLIT_SYNC_FRAME_M2S_SIZE];
+    uint8_t s2m[SPLIT_SYNC_FRAME_S2M_SIZE];
+} split_sync_frame_t;
+#endif // SPLIT_SYNC_FRAME_ENABLE
+
+#ifdef SPLIT_EVENT_PUSH_ENABLE
+#    ifndef SPLIT_EVENT_PUSH_KEEPALIVE_MS
+#        define SPLIT_EVENT_PUSH_KEEPALIVE_MS 50
+#    endif // SPLIT_EVENT_PUSH_KEEPALIVE_MS
+
+#    define SPLIT_EVENT_PUSH_SIZE (1 + SPLIT_SLAVE_STATE_SIZE)
+
+// Sends the slave's state to the master unprompted, returns false if the transport couldn't
+bool transport_push(const void *data, uint8_t length);
+// Copies the most recent state pushed by the slave, returns its length or 0 if nothing new arrived
+uint8_t transport_receive_push(void *data, uint8_t length);
+#endif // SPLIT_EVENT_PUSH_ENABLE
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -231,6 +276,10 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+    split_sync_frame_t sync_frame;
+#endif // SPLIT_SYNC_FRAME_ENABLE
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
@@ -702,6 +702,21 @@ void via_qmk_rgb_matrix_get_value(uint8_t *data) {
             value_data[1] = rgb_matrix_get_sat();
             break;
         }
+#    ifdef RGB_MATRIX_GOVERNOR_ENABLE
+        case id_qmk_rgb_matrix_render_stats: {
+            // read-only: [ fps_hi, fps_lo, slices_per_frame, leds_per_slice, flush_interval_ms, worst_slice_us_hi, worst_slice_us_lo ]
+            rgb_matrix_governor_stats_t stats;
+            rgb_matrix_governor_get_stats(&stats);
+            value_data[0] = stats.fps >> 8;
+            value_data[1] = stats.fps & 0xFF;
+            value_data[2] = stats.slices_per_frame;
+            value_data[3] = stats.leds_per_slice;
+            value_data[4] = stats.flush_interval_ms;
+            value_data[5] = stats.worst_slice_us >> 8;
+            value_data[6] = stats.worst_slice_us & 0xFF;
+            break;
+        }
+#    endif // RGB_MATRIX_GOVERNOR_ENABLE
     }
 }
 
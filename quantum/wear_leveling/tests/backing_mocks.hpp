@@ -94,13 +94,18 @@ class MockBackingStore {
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    // Reads don't modify the backing store, but still count as transactions
+    mutable std::uint64_t backing_read_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
     // Whether erase should succeed
     std::function<bool(std::uint64_t)> erase_success_callback;
+    // Whether partial erases should succeed
+    std::function<bool(std::uint64_t, std::uint32_t)> erase_range_success_callback;
     // Whether unlocks should succeed
     std::function<bool(std::uint64_t)> unlock_success_callback;
     // Whether writes should succeed
@@ -141,12 +146,18 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,9 +170,11 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::size_t length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count) const;
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -170,6 +183,9 @@ class MockBackingStore {
     void set_erase_callback(std::function<bool(std::uint64_t)> callback) {
         erase_success_callback = callback;
     }
+    void set_erase_range_callback(std::function<bool(std::uint64_t, std::uint32_t)> callback) {
+        erase_range_success_callback = callback;
+    }
     void set_unlock_callback(std::function<bool(std::uint64_t)> callback) {
         unlock_success_callback = callback;
     }
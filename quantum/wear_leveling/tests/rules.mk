@@ -64,3 +64,64 @@ wear_leveling_8byte_SRC := \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
 	$(wear_leveling_common_INC)
+
+wear_leveling_double_banked_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_DOUBLE_BANKED \
+	-DBACKING_STORE_ERASE_SIZE=64 \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=16
+wear_leveling_double_banked_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_double_banked.cpp
+wear_leveling_double_banked_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoint_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32 \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=16
+wear_leveling_checkpoint_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoint.cpp
+wear_leveling_checkpoint_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_boot_benchmark_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=256
+wear_leveling_boot_benchmark_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_boot_benchmark.cpp
+
+wear_leveling_boot_4k_DEFS := \
+	$(wear_leveling_boot_benchmark_DEFS) \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=4096
+wear_leveling_boot_4k_SRC := \
+	$(wear_leveling_boot_benchmark_SRC)
+wear_leveling_boot_4k_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_boot_32k_DEFS := \
+	$(wear_leveling_boot_benchmark_DEFS) \
+	-DWEAR_LEVELING_BACKING_SIZE=65536 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32768
+wear_leveling_boot_32k_SRC := \
+	$(wear_leveling_boot_benchmark_SRC)
+wear_leveling_boot_32k_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_boot_128k_DEFS := \
+	$(wear_leveling_boot_benchmark_DEFS) \
+	-DWEAR_LEVELING_BACKING_SIZE=262144 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=131072
+wear_leveling_boot_128k_SRC := \
+	$(wear_leveling_boot_benchmark_SRC)
+wear_leveling_boot_128k_INC := \
+	$(wear_leveling_common_INC)
@@ -3,4 +3,9 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_double_banked \
+	wear_leveling_checkpoint \
+	wear_leveling_boot_4k \
+	wear_leveling_boot_32k \
+	wear_leveling_boot_128k
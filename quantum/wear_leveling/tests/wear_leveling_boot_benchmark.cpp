@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Bytes of write log used by each benchmark write: a 4-byte multi-byte entry is 8 bytes on a 2-byte backing store
+#define BYTES_PER_WRITE 8
+// Fraction of the write log filled before timing playback, leaving room for checkpoints
+#define LOG_FILL_PERCENT 75
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+static logical_data_t verify_data;
+
+class WearLevelingBootBenchmark : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+};
+
+namespace {
+
+logical_data_t read_all() {
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    return readback;
+}
+
+// Times a single init, returning the number of backing store read transactions it took
+std::uint64_t time_init(const char* name) {
+    auto&         inst  = MockBackingStore::Instance();
+    std::uint64_t reads = inst.read_invoke_count();
+    auto          start = std::chrono::steady_clock::now();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    reads       = inst.read_invoke_count() - reads;
+    printf("%-8s %-10s %14" PRIu64 " %10" PRIu64 "\n", "boot", name, ns, reads);
+    EXPECT_EQ(inst.erasure_count(), 0) << "Playback should not have consolidated";
+    return reads;
+}
+
+} // namespace
+
+/**
+ * This test reports the cost of initialisation with an empty write log, which only reads the consolidated data and the
+ * first log entry.
+ */
+TEST_F(WearLevelingBootBenchmark, EmptyLog) {
+    EXPECT_LE(time_init("empty"), 3) << "Empty log playback should only need the consolidated data, hash and first log read";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+}
+
+/**
+ * This test reports the cost of playing back a mostly-full, checkpointed write log, checking that reads are buffered
+ * rather than performed word-by-word.
+ */
+TEST_F(WearLevelingBootBenchmark, FullLog) {
+    const uint32_t writes = ((WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) * LOG_FILL_PERCENT / 100) / BYTES_PER_WRITE;
+
+    // Pseudo-random 4-byte writes above the single-word encodings, so that each one is a full multi-byte entry
+    uint32_t seed = 0x1234;
+    for (uint32_t i = 0; i < writes; ++i) {
+        seed             = seed * 1103515245 + 12345;
+        uint32_t address = 64 + (seed >> 8) % (WEAR_LEVELING_LOGICAL_SIZE - 64 - 4);
+        uint8_t  value[4];
+        for (auto& v : value) {
+            v = (uint8_t)(i | 0x80);
+        }
+        memcpy(&verify_data[address], value, sizeof(value));
+        ASSERT_EQ(wear_leveling_write(address, value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    std::uint64_t reads = time_init("full");
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+
+    // Each log byte is read at most twice -- once to verify its checkpoint, once to apply it
+    const std::uint64_t log_bytes = (std::uint64_t)writes * BYTES_PER_WRITE;
+    EXPECT_LE(reads, 2 * (2 * log_bytes / WEAR_LEVELING_PLAYBACK_BUFFER_SIZE + 4 + log_bytes / WEAR_LEVELING_CHECKPOINT_INTERVAL)) << "Playback reads were not buffered";
+}
@@ -0,0 +1,194 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Number of single-byte writes between checkpoints, each is one 2-byte log entry
+#define WRITES_PER_CHECKPOINT (WEAR_LEVELING_CHECKPOINT_INTERVAL / BACKING_STORE_WRITE_SIZE)
+// Number of backing store writes used by a checkpoint
+#define CHECKPOINT_WRITES (sizeof(write_log_entry_t) / BACKING_STORE_WRITE_SIZE)
+// Address of the first write log entry
+#define LOG_START (WEAR_LEVELING_LOGICAL_SIZE + 8)
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+static logical_data_t verify_data;
+
+class WearLevelingCheckpoint : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+};
+
+namespace {
+
+// Writes one byte at an address below 64, so that it is logged as a single backing store write
+wear_leveling_status_t write_byte(logical_data_t& verify, uint32_t counter) {
+    uint32_t address = counter % WEAR_LEVELING_LOGICAL_SIZE;
+    uint8_t  value   = (uint8_t)(counter / WEAR_LEVELING_LOGICAL_SIZE + 0x10);
+    verify[address]  = value;
+    return wear_leveling_write(address, &value, sizeof(value));
+}
+
+logical_data_t read_all() {
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    return readback;
+}
+
+// Replaces the value stored at the supplied backing store address, as seen by the wear-leveling algorithm
+void overwrite(uint32_t address, backing_store_int_t value) {
+    auto& element = *(MockBackingStore::Instance().storage_begin() + address / BACKING_STORE_WRITE_SIZE);
+    element.erase();
+    element.set(~value);
+}
+
+} // namespace
+
+/**
+ * This test verifies that a checkpoint holding the log position and the hash of the preceding log is written once the
+ * checkpoint interval has been reached.
+ */
+TEST_F(WearLevelingCheckpoint, CheckpointWrittenAfterInterval) {
+    auto& inst = MockBackingStore::Instance();
+    for (uint32_t i = 0; i < WRITES_PER_CHECKPOINT; ++i) {
+        EXPECT_EQ(write_byte(verify_data, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    ASSERT_EQ(std::distance(inst.log_begin(), inst.log_end()), WRITES_PER_CHECKPOINT + CHECKPOINT_WRITES);
+
+    Fnv32_t hash = FNV1_32A_INIT;
+    for (auto it = inst.log_begin(); it != inst.log_begin() + WRITES_PER_CHECKPOINT; ++it) {
+        hash = fnv_32a_buf(&it->value, sizeof(it->value), hash);
+    }
+
+    write_log_entry_t e;
+    for (std::size_t i = 0; i < CHECKPOINT_WRITES; ++i) {
+        auto write_iter = inst.log_begin() + WRITES_PER_CHECKPOINT + i;
+        EXPECT_EQ(write_iter->address, LOG_START + WEAR_LEVELING_CHECKPOINT_INTERVAL + i * BACKING_STORE_WRITE_SIZE) << "Invalid checkpoint address";
+        e.raw16[i] = write_iter->value;
+    }
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_CHECKPOINT) << "Invalid write log entry type";
+    EXPECT_EQ(LOG_ENTRY_CHECKPOINT_GET_POSITION(e), (uint32_t)WEAR_LEVELING_CHECKPOINT_INTERVAL) << "Invalid checkpoint position";
+    EXPECT_EQ(LOG_ENTRY_CHECKPOINT_GET_HASH(e), hash) << "Invalid checkpoint hash";
+}
+
+/**
+ * This test verifies that a checkpointed log is played back in full, and that the running hash resumes so that later
+ * checkpoints still verify after re-initialisation.
+ */
+TEST_F(WearLevelingCheckpoint, PlaybackResumesAfterInit) {
+    auto&    inst    = MockBackingStore::Instance();
+    uint32_t counter = 0;
+
+    // Two full runs and a partial tail, played back without consolidating
+    for (; counter < 2 * WRITES_PER_CHECKPOINT + 3; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+    EXPECT_EQ(inst.erasure_count(), 0) << "Playback should not have consolidated";
+
+    // The next write continues directly after the last entry, completing the run with a checkpoint of its own
+    auto last_address = (inst.log_end() - 1)->address;
+    for (; counter < 3 * WRITES_PER_CHECKPOINT; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ((inst.log_end() - CHECKPOINT_WRITES - (WRITES_PER_CHECKPOINT - 3))->address, last_address + BACKING_STORE_WRITE_SIZE) << "Log did not resume at the end";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+    EXPECT_EQ(inst.erasure_count(), 0) << "Playback should not have consolidated";
+}
+
+/**
+ * This test verifies that a run of entries which doesn't match its checkpoint is discarded as a whole, and that the
+ * data from the verified runs before it is consolidated.
+ */
+TEST_F(WearLevelingCheckpoint, CorruptRunIsDiscarded) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint32_t counter = 0;
+    for (; counter < WRITES_PER_CHECKPOINT; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    logical_data_t expected = verify_data;
+    for (; counter < 2 * WRITES_PER_CHECKPOINT; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Change the value of an entry in the second run, keeping it a valid log entry
+    uint32_t          address = LOG_START + WEAR_LEVELING_CHECKPOINT_INTERVAL + CHECKPOINT_WRITES * BACKING_STORE_WRITE_SIZE + 2 * BACKING_STORE_WRITE_SIZE;
+    write_log_entry_t e       = LOG_ENTRY_MAKE_OPTIMIZED_64(WRITES_PER_CHECKPOINT + 2, 0x55);
+    overwrite(address, e.raw16[0]);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match the verified data";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Corrupt log should have been consolidated";
+
+    // The consolidated data survives another init
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match the verified data";
+}
+
+/**
+ * This test verifies that a checkpoint cut short at the end of the log, as happens with power loss, doesn't cause the
+ * run before it to be discarded.
+ */
+TEST_F(WearLevelingCheckpoint, TornCheckpointIsTolerated) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint32_t counter = 0;
+    for (; counter < 2 * WRITES_PER_CHECKPOINT; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Drop the hash from the last checkpoint
+    uint32_t checkpoint = (inst.log_end() - CHECKPOINT_WRITES)->address;
+    for (std::size_t i = CHECKPOINT_WRITES / 2; i < CHECKPOINT_WRITES; ++i) {
+        (inst.storage_begin() + checkpoint / BACKING_STORE_WRITE_SIZE + i)->erase();
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+    EXPECT_EQ(inst.erasure_count(), 0) << "Playback should not have consolidated";
+
+    // Later runs still verify against the hash, including the torn checkpoint
+    for (; counter < 3 * WRITES_PER_CHECKPOINT + 1; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+    EXPECT_EQ(inst.erasure_count(), 0) << "Playback should not have consolidated";
+}
+
+/**
+ * This test verifies that a checkpoint which falls off the end of the log is handled by normal consolidation.
+ */
+TEST_F(WearLevelingCheckpoint, ConsolidationResetsCheckpoints) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint32_t counter = 0;
+    while (inst.erasure_count() == 0) {
+        ASSERT_NE(write_byte(verify_data, counter++), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+
+    for (uint32_t i = 0; i < WRITES_PER_CHECKPOINT; ++i) {
+        EXPECT_EQ(write_byte(verify_data, counter++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    write_log_entry_t e;
+    for (std::size_t i = 0; i < CHECKPOINT_WRITES; ++i) {
+        e.raw16[i] = (inst.log_end() - CHECKPOINT_WRITES + i)->value;
+    }
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_CHECKPOINT) << "Invalid write log entry type";
+    EXPECT_EQ(LOG_ENTRY_CHECKPOINT_GET_POSITION(e), (uint32_t)WEAR_LEVELING_CHECKPOINT_INTERVAL) << "Invalid checkpoint position";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Playback should not have consolidated";
+}
@@ -0,0 +1,269 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Upper bound on the number of background steps a single consolidation can take
+#define MAX_CONSOLIDATION_STEPS 1000
+// Number of single-byte writes needed to start background consolidation, each is one 2-byte log entry
+#define WRITES_TO_THRESHOLD (WEAR_LEVELING_CONSOLIDATION_THRESHOLD / BACKING_STORE_WRITE_SIZE)
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+static logical_data_t verify_data;
+
+class WearLevelingDoubleBanked : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+};
+
+namespace {
+
+// Writes one byte at an address below 64, so that it is logged as a single backing store write
+wear_leveling_status_t write_byte(logical_data_t& verify, uint32_t counter) {
+    uint32_t address = counter % WEAR_LEVELING_LOGICAL_SIZE;
+    uint8_t  value   = (uint8_t)(counter / WEAR_LEVELING_LOGICAL_SIZE + 1);
+    verify[address]  = value;
+    return wear_leveling_write(address, &value, sizeof(value));
+}
+
+logical_data_t read_all() {
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    return readback;
+}
+
+wear_leveling_status_t run_consolidation() {
+    for (int i = 0; i < MAX_CONSOLIDATION_STEPS; ++i) {
+        wear_leveling_status_t status = wear_leveling_task();
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+} // namespace
+
+/**
+ * This test verifies that the first write after initialisation occurs after the FNV1a_64 hash and commit record.
+ */
+TEST_F(WearLevelingDoubleBanked, FirstWriteOccursAfterCommitRecord) {
+    auto& inst = MockBackingStore::Instance();
+    EXPECT_EQ(write_byte(verify_data, 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid first write address.";
+}
+
+/**
+ * This test verifies that passing the threshold only schedules consolidation, and that each background step is bounded
+ * by the configured erase and copy sizes.
+ */
+TEST_F(WearLevelingDoubleBanked, ConsolidationRunsInBoundedSteps) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint32_t i = 0; i < WRITES_TO_THRESHOLD; ++i) {
+        EXPECT_EQ(write_byte(verify_data, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Writes should never erase the whole backing store";
+    EXPECT_EQ(inst.erase_range_invoke_count(), 0) << "Writes should only schedule consolidation";
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    int                    steps  = 0;
+    while (status == WEAR_LEVELING_SUCCESS && steps < MAX_CONSOLIDATION_STEPS) {
+        uint64_t writes = inst.write_invoke_count();
+        uint64_t erases = inst.erase_range_invoke_count();
+        status          = wear_leveling_task();
+        ++steps;
+        // Copying the last of the write log is followed by the hash and commit record in the same step
+        EXPECT_LE(inst.write_invoke_count() - writes, (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE + 16) / BACKING_STORE_WRITE_SIZE) << "Too many writes in one step";
+        EXPECT_LE(inst.erase_range_invoke_count() - erases, 1) << "Too many erases in one step";
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation did not complete";
+
+    // Erase the spare bank, write the consolidated data, then commit as nothing was written in the meantime
+    EXPECT_EQ(steps, (WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) + 1) << "Unexpected number of steps";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Nothing should be left to do";
+
+    // Next write goes into the second bank's log
+    auto log_size = std::distance(inst.log_begin(), inst.log_end());
+    EXPECT_EQ(write_byte(verify_data, WEAR_LEVELING_LOGICAL_SIZE), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ((inst.log_begin() + log_size)->address, WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid write address after switching banks";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+}
+
+/**
+ * This test verifies that writes made while consolidation is in progress are carried over to the new bank.
+ */
+TEST_F(WearLevelingDoubleBanked, WritesDuringConsolidationAreCarriedOver) {
+    uint32_t counter = 0;
+    for (; counter < WRITES_TO_THRESHOLD; ++counter) {
+        EXPECT_EQ(write_byte(verify_data, counter), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; status == WEAR_LEVELING_SUCCESS && i < MAX_CONSOLIDATION_STEPS; ++i) {
+        EXPECT_EQ(write_byte(verify_data, counter++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        status = wear_leveling_task();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation did not complete";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+}
+
+/**
+ * This test verifies that if the main loop never gets a chance to consolidate, a full log consolidates in-line.
+ */
+TEST_F(WearLevelingDoubleBanked, FullLogConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    int consolidations = 0;
+    for (uint32_t i = 0; i < 4 * (WEAR_LEVELING_BANK_SIZE / BACKING_STORE_WRITE_SIZE); ++i) {
+        wear_leveling_status_t status = write_byte(verify_data, i);
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write failed";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            ++consolidations;
+        }
+    }
+    EXPECT_GE(consolidations, 2) << "Expected in-line consolidation";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Consolidation should never erase the whole backing store";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+}
+
+/**
+ * This test verifies that a write too large for the remaining log is still persisted.
+ */
+TEST_F(WearLevelingDoubleBanked, LargeWriteConsolidatesInline) {
+    for (uint32_t i = 0; i < WRITES_TO_THRESHOLD; ++i) {
+        EXPECT_EQ(write_byte(verify_data, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    std::iota(verify_data.begin(), verify_data.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write(0, verify_data.data(), verify_data.size()), WEAR_LEVELING_CONSOLIDATED) << "Write returned incorrect status";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), verify_data) << "Readback did not match";
+}
+
+/**
+ * This test verifies that if the newest bank is corrupted, the previous bank and its write log are used instead.
+ */
+TEST_F(WearLevelingDoubleBanked, CorruptNewestBankFallsBackToPrevious) {
+    auto& inst = MockBackingStore::Instance();
+
+    // First consolidation into bank 1, then fill bank 1's log and consolidate back into bank 0
+    uint32_t counter = 0;
+    for (int bank = 0; bank < 2; ++bank) {
+        for (uint32_t i = 0; i < WRITES_TO_THRESHOLD; ++i) {
+            EXPECT_EQ(write_byte(verify_data, counter++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+        EXPECT_EQ(run_consolidation(), WEAR_LEVELING_CONSOLIDATED) << "Consolidation did not complete";
+    }
+    logical_data_t committed = verify_data;
+    EXPECT_NE(committed[0], 0) << "Test data needs to be non-zero to detect corruption";
+
+    // Writes made after the switch are only in bank 0's log
+    EXPECT_EQ(write_byte(verify_data, counter++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    // Corrupt the first word of bank 0's consolidated data
+    inst.storage_begin()->erase();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), committed) << "Readback should have come from the previous bank";
+}
+
+/**
+ * This test verifies that erasing resets the active bank.
+ */
+TEST_F(WearLevelingDoubleBanked, EraseResetsActiveBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint32_t i = 0; i < WRITES_TO_THRESHOLD; ++i) {
+        EXPECT_EQ(write_byte(verify_data, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(run_consolidation(), WEAR_LEVELING_CONSOLIDATED) << "Consolidation did not complete";
+
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase failed";
+    verify_data.fill(0);
+    EXPECT_EQ(read_all(), verify_data) << "Erase should have cleared the data";
+
+    EXPECT_EQ(write_byte(verify_data, 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid first write address after erase.";
+}
+
+/**
+ * This test cuts power at every backing store write or erase in turn while data is written and consolidated in the
+ * background, then restarts. Every write that completed before the cut must survive; the interrupted write may or may
+ * not have been persisted.
+ */
+TEST_F(WearLevelingDoubleBanked, PowerCutAtAnyPointPreservesData) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Enough writes to go through the full consolidation cycle a few times
+    const uint32_t script_length = 6 * WRITES_TO_THRESHOLD;
+
+    for (uint64_t cut = 1;; ++cut) {
+        inst.reset_instance();
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Initialisation failed";
+
+        // Fail the cut-th operation and everything after it
+        uint64_t operations = 0;
+        auto     powered    = [&]() { return ++operations < cut; };
+        inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+        inst.set_erase_range_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+
+        logical_data_t committed{};
+        logical_data_t in_flight{};
+        bool           interrupted    = false;
+        int            consolidations = 0;
+        for (uint32_t i = 0; i < script_length && !interrupted; ++i) {
+            in_flight = committed;
+            if (write_byte(in_flight, i) == WEAR_LEVELING_FAILED) {
+                interrupted = true;
+                break;
+            }
+            committed = in_flight;
+
+            switch (wear_leveling_task()) {
+                case WEAR_LEVELING_FAILED:
+                    interrupted = true;
+                    break;
+                case WEAR_LEVELING_CONSOLIDATED:
+                    ++consolidations;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (!interrupted) {
+            EXPECT_GE(consolidations, 4) << "Script should have consolidated multiple times";
+            break;
+        }
+
+        // Restore power and restart
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_range_callback([](std::uint64_t, std::uint32_t) { return true; });
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed after power cut at operation " << cut;
+
+        logical_data_t readback = read_all();
+        EXPECT_TRUE(readback == committed || readback == in_flight) << "Data lost after power cut at operation " << cut;
+
+        // The store must also be usable afterwards
+        EXPECT_NE(write_byte(readback, 0x3F), WEAR_LEVELING_FAILED) << "Write failed after power cut at operation " << cut;
+        EXPECT_NE(run_consolidation(), WEAR_LEVELING_FAILED) << "Consolidation failed after power cut at operation " << cut;
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed after power cut at operation " << cut;
+        EXPECT_EQ(read_all(), readback) << "Readback did not match after power cut at operation " << cut;
+    }
+}
@@ -154,7 +154,62 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Double-banked consolidation:
+
+        With WEAR_LEVELING_DOUBLE_BANKED, the backing store is split into two
+        banks, each with its own consolidated data, hash and write log. The
+        hash is followed by an 8-byte commit record -- a generation counter and
+        its complement -- so the write log starts 16 bytes after the
+        consolidated data:
+
+        ╔ Bank ══════════╦════════╦════════╦═════════╗
+        ║  Consolidated  ║FNV1a_64║ Commit ║Write log║
+        ║      data      ║  hash  ║ record ║   ...   ║
+        ╚════════════════╩════════╩════════╩═════════╝
+
+        Once the active bank's log passes WEAR_LEVELING_CONSOLIDATION_THRESHOLD
+        the spare bank is rebuilt in the background by wear_leveling_task(),
+        in steps bounded by WEAR_LEVELING_ERASE_STEP_SIZE and
+        WEAR_LEVELING_CONSOLIDATION_STEP_SIZE: the spare bank is erased, the
+        cache is written to its consolidated area, and log entries appended to
+        the active bank in the meantime are copied across. The hash and commit
+        record are written last; at that point the spare bank becomes active.
+
+        On startup, the bank with a valid commit record, matching hash and the
+        newest generation is used. A consolidation interrupted by power loss
+        leaves the spare bank without a commit record, so the previous bank and
+        its write log are still intact.
+
+        Writes that would not fit in the remaining log finish (or perform) the
+        consolidation in-line, the same as the single-bank layout.
+
+    Checkpoints:
+
+        With WEAR_LEVELING_CHECKPOINT_INTERVAL, a checkpoint entry is appended
+        once at least that many bytes of write log have been written since the
+        previous one. It holds the entry's position (in bytes from the start of
+        the write log) and a FNV1a_32 hash of every log byte before it:
+
+        ╔ Checkpoint Log Entry ═════════════════════════════════════════════════╗
+        ║11PPPPPP║PPPPPPPP║PPPPPPPP║00000000║HHHHHHHH║HHHHHHHH║HHHHHHHH║HHHHHHHH║
+        ║  └─┬──┘║└──┬───┘║└──┬───┘║        ║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║
+        ║Position║Position║Position║        ║Hash[0] ║Hash[1] ║Hash[2] ║Hash[3] ║
+        ╚════════╩════════╩════════╩════════╩════════╩════════╩════════╩════════╝
+
+        During playback, each run of entries up to the next checkpoint is parsed
+        and verified against it before any of it is applied to the cache. A run
+        that fails verification is treated like any other corrupt log entry --
+        playback stops and the data read so far is consolidated. Entries after
+        the last checkpoint are applied as-is, as are runs ending in a checkpoint
+        that was cut short by power loss.
+
+    Playback:
+
+        The write log is read WEAR_LEVELING_PLAYBACK_BUFFER_SIZE bytes at a
+        time using backing_store_read_bulk(), so that backing stores with a high
+        per-transaction cost (such as SPI flash) are not read word-by-word. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,9 +217,25 @@
 static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
-    bool                                                           unlocked;
+    uint32_t                                                       bank_base;
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    uint32_t generation;
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    Fnv32_t  log_hash;           // FNV1a_32 of the write log written so far
+    uint32_t checkpoint_address; // address directly after the most recent checkpoint
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    bool unlocked;
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+// +16 is due to the FNV1a_64 of the consolidated buffer and the commit record
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+#else
+// +8 is due to the FNV1a_64 of the consolidated buffer
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
 /**
  * Locking helper: status
  */
@@ -203,18 +274,28 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = wear_leveling.bank_base + (WEAR_LEVELING_LOG_OFFSET);
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash           = FNV1_32A_INIT;
+    wear_leveling.checkpoint_address = wear_leveling.write_address;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 }
 
 /**
- * Reads the consolidated data from the backing store into the cache.
+ * Reads the consolidated data from the active bank of the backing store into the cache.
  * Does not consider the write log.
+ *
+ * @param verified[out] optional, set to whether the consolidated data matched its hash
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+static wear_leveling_status_t wear_leveling_read_consolidated(bool *verified) {
     wl_dprintf("Reading consolidated data\n");
 
+    const uint32_t         base   = wear_leveling.bank_base;
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (verified) {
+        *verified = false;
+    }
+    if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -225,16 +306,19 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
 #if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
+        backing_store_read_bulk(base + (WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
 #elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
+        backing_store_read_bulk(base + (WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
 #elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
+        backing_store_read(base + (WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
 #endif
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+            if (verified) {
+                *verified = true;
+            }
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -249,6 +333,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+#ifndef WEAR_LEVELING_DOUBLE_BANKED
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -317,7 +402,11 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_OFFSET);
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash           = FNV1_32A_INIT;
+    wear_leveling.checkpoint_address = wear_leveling.write_address;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 
     return status;
 }
@@ -336,6 +425,247 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
 
     return WEAR_LEVELING_SUCCESS;
 }
+#else  // WEAR_LEVELING_DOUBLE_BANKED
+/**
+ * Background consolidation state.
+ */
+typedef enum wear_leveling_consolidation_state_t { CONSOLIDATION_IDLE, CONSOLIDATION_ERASE, CONSOLIDATION_WRITE_DATA, CONSOLIDATION_COPY_LOG } wear_leveling_consolidation_state_t;
+
+static struct {
+    wear_leveling_consolidation_state_t state;
+    uint32_t                            target_base; // base address of the bank being built
+    uint32_t                            log_start;   // active bank's write address when consolidation started
+    uint32_t                            progress;    // bytes erased, written or copied so far in the current state
+    uint64_t                            hash;        // FNV1a_64 of the consolidated data written so far
+} consolidation;
+
+/**
+ * Reads an 8-byte hash or commit record from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#    endif
+}
+
+/**
+ * Writes an 8-byte hash or commit record to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#    endif
+}
+
+/**
+ * Reads the generation from a bank's commit record.
+ *
+ * @return false if the commit record was never written, or only partially written
+ */
+static bool wear_leveling_read_generation(uint32_t base, uint32_t *generation) {
+    write_log_entry_t record;
+    if (!wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &record)) {
+        return false;
+    }
+    if (record.raw32[0] != ~record.raw32[1]) {
+        return false;
+    }
+    *generation = record.raw32[0];
+    return true;
+}
+
+/**
+ * Starts building the spare bank. No backing store operations occur until the first step.
+ */
+static void wear_leveling_consolidate_start(void) {
+    wl_dprintf("Starting consolidation\n");
+    consolidation.state       = CONSOLIDATION_ERASE;
+    consolidation.target_base = wear_leveling.bank_base == 0 ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    consolidation.log_start   = wear_leveling.write_address;
+    consolidation.progress    = 0;
+}
+
+/**
+ * Performs one bounded step of building the spare bank: erasing part of it, writing part of the consolidated data, or
+ * copying log entries appended to the active bank since consolidation started. Once the spare bank has caught up with
+ * the active bank, its hash and commit record are written and it becomes the active bank.
+ * If a step fails, consolidation is abandoned -- the active bank is untouched, and the next attempt starts over.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the spare bank has become the active bank
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    switch (consolidation.state) {
+        case CONSOLIDATION_IDLE:
+            return WEAR_LEVELING_SUCCESS;
+
+        case CONSOLIDATION_ERASE: {
+            if (!backing_store_erase_range(consolidation.target_base + consolidation.progress, (WEAR_LEVELING_ERASE_STEP_SIZE))) {
+                wl_dprintf("Failed to erase spare bank\n");
+                break;
+            }
+            consolidation.progress += (WEAR_LEVELING_ERASE_STEP_SIZE);
+            if (consolidation.progress >= (WEAR_LEVELING_BANK_SIZE)) {
+                consolidation.state    = CONSOLIDATION_WRITE_DATA;
+                consolidation.progress = 0;
+                consolidation.hash     = FNV1A_64_INIT;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_WRITE_DATA: {
+            // The hash covers exactly what was written, even if the cache changes between steps -- those changes are in the log
+            const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - consolidation.progress;
+            const uint32_t length    = remaining < (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? remaining : (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+            uint8_t *      data      = &wear_leveling.cache[consolidation.progress];
+            if (!backing_store_write_bulk(consolidation.target_base + consolidation.progress, (backing_store_int_t *)data, length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Failed to write consolidated data\n");
+                break;
+            }
+            consolidation.hash = fnv_64a_buf(data, length, consolidation.hash);
+            consolidation.progress += length;
+            if (consolidation.progress >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                consolidation.state    = CONSOLIDATION_COPY_LOG;
+                consolidation.progress = 0;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_COPY_LOG: {
+            const uint32_t source  = consolidation.log_start + consolidation.progress;
+            const uint32_t pending = wear_leveling.write_address - source;
+            if (pending > 0) {
+                const uint32_t      length = pending < (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? pending : (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+                backing_store_int_t buffer[8];
+                bool                ok = true;
+                for (uint32_t offset = 0; ok && offset < length; offset += sizeof(buffer)) {
+                    const uint32_t count = (length - offset) < sizeof(buffer) ? (length - offset) / sizeof(backing_store_int_t) : sizeof(buffer) / sizeof(backing_store_int_t);
+                    ok                   = backing_store_read_bulk(source + offset, buffer, count) && backing_store_write_bulk(consolidation.target_base + (WEAR_LEVELING_LOG_OFFSET) + consolidation.progress + offset, buffer, count);
+                }
+                if (!ok) {
+                    wl_dprintf("Failed to copy write log\n");
+                    break;
+                }
+                consolidation.progress += length;
+                if (length < pending) {
+                    return WEAR_LEVELING_SUCCESS;
+                }
+            }
+
+            // Caught up with the active bank -- the commit record is written last, making the spare bank valid
+            write_log_entry_t entry = {.raw64 = consolidation.hash};
+            if (!wear_leveling_write_entry(consolidation.target_base + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+                wl_dprintf("Failed to write checksum\n");
+                break;
+            }
+            entry.raw32[0] = wear_leveling.generation + 1;
+            entry.raw32[1] = ~entry.raw32[0];
+            if (!wear_leveling_write_entry(consolidation.target_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+                wl_dprintf("Failed to write commit record\n");
+                break;
+            }
+
+            wl_dprintf("Consolidation complete\n");
+            wear_leveling.bank_base     = consolidation.target_base;
+            wear_leveling.write_address = consolidation.target_base + (WEAR_LEVELING_LOG_OFFSET) + consolidation.progress;
+            wear_leveling.generation++;
+            consolidation.state = CONSOLIDATION_IDLE;
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
+    }
+
+    consolidation.state = CONSOLIDATION_IDLE;
+    return WEAR_LEVELING_FAILED;
+}
+
+/**
+ * Finishes any consolidation in progress in-line, or performs a complete one if none was in progress.
+ * Power loss at any point leaves either the previous bank or the new bank valid.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    if (consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidate_start();
+    }
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+
+/**
+ * Never consolidates in-line after a log append -- room for each write is reserved before it is logged, so the log
+ * cannot fill part-way through an entry.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Starts background consolidation once the active bank's write log passes the threshold.
+ * Must only be called between log entries.
+ */
+static void wear_leveling_consolidate_schedule(void) {
+    if (consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address - wear_leveling.bank_base - (WEAR_LEVELING_LOG_OFFSET) >= (WEAR_LEVELING_CONSOLIDATION_THRESHOLD)) {
+        wear_leveling_consolidate_start();
+    }
+}
+
+/**
+ * Picks the bank holding the newest valid consolidated data and reads it into the cache.
+ * With no valid bank -- nothing consolidated yet, or both corrupted -- the cache is cleared and bank 0's write log is used.
+ */
+static wear_leveling_status_t wear_leveling_select_bank(void) {
+    consolidation.state = CONSOLIDATION_IDLE;
+
+    uint32_t generation[2] = {0};
+    bool     valid[2];
+    for (uint8_t i = 0; i < 2; ++i) {
+        valid[i] = wear_leveling_read_generation(i * (WEAR_LEVELING_BANK_SIZE), &generation[i]);
+    }
+
+    // Newest first, comparing generations in a wrap-safe manner
+    uint8_t newest = (valid[1] && (!valid[0] || (int32_t)(generation[1] - generation[0]) > 0)) ? 1 : 0;
+    for (uint8_t i = 0; i < 2; ++i) {
+        uint8_t bank = i == 0 ? newest : 1 - newest;
+        if (!valid[bank]) {
+            continue;
+        }
+
+        wear_leveling.bank_base  = bank * (WEAR_LEVELING_BANK_SIZE);
+        wear_leveling.generation = generation[bank];
+
+        bool                   verified;
+        wear_leveling_status_t status = wear_leveling_read_consolidated(&verified);
+        if (status == WEAR_LEVELING_FAILED || verified) {
+            return status;
+        }
+        wl_dprintf("Bank %d failed verification\n", (int)bank);
+    }
+
+    wear_leveling.bank_base  = 0;
+    wear_leveling.generation = 0;
+    wear_leveling_clear_cache();
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANKED
 
 /**
  * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
@@ -349,9 +679,43 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash = fnv_32a_buf(&value, sizeof(value), wear_leveling.log_hash);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
     return wear_leveling_consolidate_if_needed();
 }
 
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * Appends a checkpoint to the write log if enough has been written since the last one.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_append_checkpoint(void) {
+    if (wear_leveling.write_address - wear_leveling.checkpoint_address < (WEAR_LEVELING_CHECKPOINT_INTERVAL)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    const uint32_t          position = wear_leveling.write_address - (WEAR_LEVELING_LOG_OFFSET);
+    const write_log_entry_t log      = LOG_ENTRY_MAKE_CHECKPOINT(position, wear_leveling.log_hash);
+    wl_dprintf("Writing checkpoint at 0x%04X\n", (int)position);
+
+    // Checkpoints are always written in full, regardless of write size
+    for (uint8_t i = 0; i < sizeof(log) / (BACKING_STORE_WRITE_SIZE); ++i) {
+        backing_store_int_t value;
+        memcpy(&value, &log.raw8[i * (BACKING_STORE_WRITE_SIZE)], sizeof(value));
+        wear_leveling_status_t status = wear_leveling_append_raw(value);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            // Consolidation already discarded the partial checkpoint along with the rest of the log
+            return status;
+        }
+    }
+
+    wear_leveling.checkpoint_address = wear_leveling.write_address;
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 /**
  * Handles writing multi_byte-encoded data to the backing store.
  *
@@ -471,131 +835,245 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
 }
 
 /**
- * "Replays" the write log from the backing store, updating the local cache with updated values.
+ * Buffered reader used for write log playback.
  */
-static wear_leveling_status_t wear_leveling_playback_log(void) {
-    wl_dprintf("Playback write log\n");
+typedef struct wear_leveling_log_reader_t {
+    uint32_t            address; // backing store address of the first buffered value
+    uint32_t            count;   // number of buffered values
+    backing_store_int_t buffer[(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+} wear_leveling_log_reader_t;
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
-        backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
-        if (!ok) {
-            wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-            cancel_playback = true;
-            status          = WEAR_LEVELING_FAILED;
-            break;
+/**
+ * Reads a single value from the write log, refilling the reader's buffer as required.
+ * Addresses past the end of the active bank read back as empty.
+ */
+static bool wear_leveling_log_read(wear_leveling_log_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    const uint32_t end = wear_leveling.bank_base + (WEAR_LEVELING_BANK_SIZE);
+    if (address >= end) {
+        *value = 0;
+        return true;
+    }
+
+    if (reader->count == 0 || address < reader->address || address >= reader->address + reader->count * (BACKING_STORE_WRITE_SIZE)) {
+        uint32_t count = sizeof(reader->buffer) / sizeof(backing_store_int_t);
+        if (address + count * (BACKING_STORE_WRITE_SIZE) > end) {
+            count = (end - address) / (BACKING_STORE_WRITE_SIZE);
         }
-        if (value == 0) {
-            wl_dprintf("Found empty slot, no more log entries\n");
-            cancel_playback = true;
-            break;
+        reader->count = 0;
+        if (!backing_store_read_bulk(address, reader->buffer, count)) {
+            return false;
         }
+        reader->address = address;
+        reader->count   = count;
+    }
 
-        // If we got a nonzero value, then we need to increment the address to ensure next write occurs at next location
-        address += (BACKING_STORE_WRITE_SIZE);
+    *value = reader->buffer[(address - reader->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
+/**
+ * Result of parsing a write log entry during playback.
+ */
+typedef enum wear_leveling_playback_result_t {
+    PLAYBACK_ENTRY,          // a data entry was parsed
+    PLAYBACK_CHECKPOINT,     // a checkpoint was parsed, and it matched the log preceding it or was never completed
+    PLAYBACK_BAD_CHECKPOINT, // a checkpoint was parsed, but it did not match the log preceding it
+    PLAYBACK_END,            // an empty slot or the end of the active bank was reached
+    PLAYBACK_FAILED,         // the backing store could not be read, or the entry was invalid
+} wear_leveling_playback_result_t;
 
-        // Read from the write log
-        write_log_entry_t log;
+/**
+ * Reads the next value of the current log entry, updating the running hash if checkpoints are enabled.
+ */
+static bool wear_leveling_playback_read(wear_leveling_log_reader_t *reader, uint32_t *address, backing_store_int_t *value) {
+    if (!wear_leveling_log_read(reader, *address, value)) {
+        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+        return false;
+    }
+    *address += (BACKING_STORE_WRITE_SIZE);
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash = fnv_32a_buf(value, sizeof(*value), wear_leveling.log_hash);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    return true;
+}
+
+/**
+ * Parses the write log entry at the supplied address, advancing the address past it.
+ *
+ * @param apply whether data entries are written to the cache, or only validated
+ */
+static wear_leveling_playback_result_t wear_leveling_playback_entry(wear_leveling_log_reader_t *reader, uint32_t *address, bool apply) {
+    backing_store_int_t value;
+    if (*address >= wear_leveling.bank_base + (WEAR_LEVELING_BANK_SIZE)) {
+        return PLAYBACK_END;
+    }
+    if (!wear_leveling_log_read(reader, *address, &value)) {
+        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+        return PLAYBACK_FAILED;
+    }
+    if (value == 0) {
+        wl_dprintf("Found empty slot, no more log entries\n");
+        return PLAYBACK_END;
+    }
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    // Checkpoints cover the log preceding them, so keep the hash from before this entry
+    const Fnv32_t  hash     = wear_leveling.log_hash;
+    const uint32_t position = *address - wear_leveling.bank_base - (WEAR_LEVELING_LOG_OFFSET);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+    // If we got a nonzero value, then we need to increment the address to ensure next write occurs at next location
+    if (!wear_leveling_playback_read(reader, address, &value)) {
+        return PLAYBACK_FAILED;
+    }
+
+    // Read from the write log
+    write_log_entry_t log = {0};
 #if BACKING_STORE_WRITE_SIZE == 2
-        log.raw16[0] = value;
+    log.raw16[0] = value;
 #elif BACKING_STORE_WRITE_SIZE == 4
-        log.raw32[0] = value;
+    log.raw32[0] = value;
 #elif BACKING_STORE_WRITE_SIZE == 8
-        log.raw64 = value;
+    log.raw64 = value;
 #endif
 
-        switch (LOG_ENTRY_GET_TYPE(log)) {
-            case LOG_ENTRY_TYPE_MULTIBYTE: {
+    switch (LOG_ENTRY_GET_TYPE(log)) {
+        case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
-                if (!ok) {
-                    wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
-                address += (BACKING_STORE_WRITE_SIZE);
+            if (!wear_leveling_playback_read(reader, address, &log.raw16[1])) {
+                return PLAYBACK_FAILED;
+            }
 #endif // BACKING_STORE_WRITE_SIZE == 2
-                const uint32_t a = LOG_ENTRY_MULTIBYTE_GET_ADDRESS(log);
-                const uint8_t  l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
+            const uint32_t a = LOG_ENTRY_MULTIBYTE_GET_ADDRESS(log);
+            const uint8_t  l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
 
-                if (a + l > (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
+            if (a + l > (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return PLAYBACK_FAILED;
+            }
 
 #if BACKING_STORE_WRITE_SIZE == 2
-                if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status          = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
+            if (l > 1) {
+                if (!wear_leveling_playback_read(reader, address, &log.raw16[2])) {
+                    return PLAYBACK_FAILED;
                 }
-                if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status          = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
+            }
+            if (l > 3) {
+                if (!wear_leveling_playback_read(reader, address, &log.raw16[3])) {
+                    return PLAYBACK_FAILED;
                 }
+            }
 #elif BACKING_STORE_WRITE_SIZE == 4
-                if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
+            if (l > 1) {
+                if (!wear_leveling_playback_read(reader, address, &log.raw32[1])) {
+                    return PLAYBACK_FAILED;
                 }
+            }
 #endif
 
+            if (apply) {
                 memcpy(&wear_leveling.cache[a], &log.raw8[3], l);
-            } break;
+            }
+        } break;
 #if BACKING_STORE_WRITE_SIZE == 2
-            case LOG_ENTRY_TYPE_OPTIMIZED_64: {
-                const uint32_t a = LOG_ENTRY_OPTIMIZED_64_GET_ADDRESS(log);
-                const uint8_t  v = LOG_ENTRY_OPTIMIZED_64_GET_VALUE(log);
+        case LOG_ENTRY_TYPE_OPTIMIZED_64: {
+            const uint32_t a = LOG_ENTRY_OPTIMIZED_64_GET_ADDRESS(log);
+            const uint8_t  v = LOG_ENTRY_OPTIMIZED_64_GET_VALUE(log);
 
-                if (a >= (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
+            if (a >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return PLAYBACK_FAILED;
+            }
 
+            if (apply) {
                 wear_leveling.cache[a] = v;
-            } break;
-            case LOG_ENTRY_TYPE_WORD_01: {
-                const uint32_t a = LOG_ENTRY_WORD_01_GET_ADDRESS(log);
-                const uint8_t  v = LOG_ENTRY_WORD_01_GET_VALUE(log);
-
-                if (a + 1 >= (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
+            }
+        } break;
+        case LOG_ENTRY_TYPE_WORD_01: {
+            const uint32_t a = LOG_ENTRY_WORD_01_GET_ADDRESS(log);
+            const uint8_t  v = LOG_ENTRY_WORD_01_GET_VALUE(log);
 
+            if (a + 1 >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return PLAYBACK_FAILED;
+            }
+
+            if (apply) {
                 wear_leveling.cache[a + 0] = v;
                 wear_leveling.cache[a + 1] = 0;
-            } break;
+            }
+        } break;
 #endif // BACKING_STORE_WRITE_SIZE == 2
-            default: {
-                cancel_playback = true;
-                status          = WEAR_LEVELING_FAILED;
-            } break;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        case LOG_ENTRY_TYPE_CHECKPOINT: {
+            for (uint8_t i = 1; i < sizeof(log) / (BACKING_STORE_WRITE_SIZE); ++i) {
+                if (!wear_leveling_playback_read(reader, address, &value)) {
+                    return PLAYBACK_FAILED;
+                }
+                memcpy(&log.raw8[i * (BACKING_STORE_WRITE_SIZE)], &value, sizeof(value));
+            }
+
+            if (LOG_ENTRY_CHECKPOINT_GET_POSITION(log) != position || LOG_ENTRY_CHECKPOINT_GET_HASH(log) != hash) {
+                if (value == 0) {
+                    // The checkpoint was cut short by power loss -- the run before it is accepted as-is, the same as the end of the log
+                    wl_dprintf("Incomplete checkpoint at 0x%04X\n", (int)position);
+                    return PLAYBACK_CHECKPOINT;
+                }
+                wl_dprintf("Checkpoint mismatch at 0x%04X\n", (int)position);
+                return PLAYBACK_BAD_CHECKPOINT;
+            }
+            return PLAYBACK_CHECKPOINT;
+        }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+        default: {
+            return PLAYBACK_FAILED;
+        }
+    }
+
+    return PLAYBACK_ENTRY;
+}
+
+/**
+ * Parses write log entries until the next checkpoint, the end of the log, or a failure.
+ */
+static wear_leveling_playback_result_t wear_leveling_playback_run(wear_leveling_log_reader_t *reader, uint32_t *address, bool apply) {
+    wear_leveling_playback_result_t result;
+    do {
+        result = wear_leveling_playback_entry(reader, address, apply);
+    } while (result == PLAYBACK_ENTRY);
+    return result;
+}
+
+/**
+ * "Replays" the write log from the backing store, updating the local cache with updated values.
+ */
+static wear_leveling_status_t wear_leveling_playback_log(void) {
+    wl_dprintf("Playback write log\n");
+
+    wear_leveling_log_reader_t      reader  = {0};
+    wear_leveling_status_t          status  = WEAR_LEVELING_SUCCESS;
+    uint32_t                        address = wear_leveling.bank_base + (WEAR_LEVELING_LOG_OFFSET);
+    wear_leveling_playback_result_t result  = PLAYBACK_END;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash           = FNV1_32A_INIT;
+    wear_leveling.checkpoint_address = address;
+    do {
+        // Validate the run up to the next checkpoint before applying any of it
+        const Fnv32_t run_hash    = wear_leveling.log_hash;
+        uint32_t      run_address = address;
+        if (wear_leveling_playback_run(&reader, &run_address, false) == PLAYBACK_BAD_CHECKPOINT) {
+            status = WEAR_LEVELING_FAILED;
+            break;
         }
+
+        wear_leveling.log_hash = run_hash;
+        result                 = wear_leveling_playback_run(&reader, &address, true);
+        if (result == PLAYBACK_CHECKPOINT) {
+            wear_leveling.checkpoint_address = address;
+        }
+    } while (result == PLAYBACK_CHECKPOINT);
+#else
+    result = wear_leveling_playback_run(&reader, &address, true);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    if (result == PLAYBACK_FAILED) {
+        status = WEAR_LEVELING_FAILED;
     }
 
     // We've reached the end of the log, so we're at the new write location
@@ -607,6 +1085,9 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     } else {
         // Consolidate the cache + write log if required
         status = wear_leveling_consolidate_if_needed();
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+        wear_leveling_consolidate_schedule();
+#endif // WEAR_LEVELING_DOUBLE_BANKED
     }
 
     return status;
@@ -629,7 +1110,11 @@ wear_leveling_status_t wear_leveling_init(void) {
     }
 
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    wear_leveling_status_t status = wear_leveling_select_bank();
+#else
+    wear_leveling_status_t status = wear_leveling_read_consolidated(NULL);
+#endif // WEAR_LEVELING_DOUBLE_BANKED
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -662,6 +1147,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    consolidation.state      = CONSOLIDATION_IDLE;
+    wear_leveling.bank_base  = 0;
+    wear_leveling.generation = 0;
+#endif // WEAR_LEVELING_DOUBLE_BANKED
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -672,6 +1162,35 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+/**
+ * Appends a write to the active bank's write log, first making sure the whole write fits so that a log entry never
+ * straddles a bank switch. The cache must already hold the written data.
+ */
+static wear_leveling_status_t wear_leveling_write_banked(uint32_t address, const void *value, size_t length) {
+    // At most two bytes of log per logical byte, plus one partially-filled multi-byte entry
+    const uint32_t         required = 2 * length + 8;
+    wear_leveling_status_t status   = WEAR_LEVELING_SUCCESS;
+    if (wear_leveling.write_address + required > wear_leveling.bank_base + (WEAR_LEVELING_BANK_SIZE)) {
+        status = wear_leveling_consolidate_force();
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+        if (wear_leveling.write_address + required > wear_leveling.bank_base + (WEAR_LEVELING_BANK_SIZE)) {
+            // Still too large for the new bank's log -- consolidating again captures the write, as it's already in the cache
+            return wear_leveling_consolidate_force();
+        }
+    }
+
+    if (wear_leveling_write_raw(address, value, length) == WEAR_LEVELING_FAILED) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_consolidate_schedule();
+    return status;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -700,6 +1219,9 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     // Perform the actual write
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    wear_leveling_status_t status = wear_leveling_write_banked(address, value, length);
+#else
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
@@ -708,6 +1230,13 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
             break;
 
         case WEAR_LEVELING_SUCCESS:
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+            // Checkpoint the write log if required
+            status = wear_leveling_append_checkpoint();
+            if (status != WEAR_LEVELING_SUCCESS) {
+                break;
+            }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
             // Consolidate the cache + write log if required
             status = wear_leveling_consolidate_if_needed();
             break;
@@ -717,6 +1246,33 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
             status = WEAR_LEVELING_FAILED;
             break;
     }
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Performs one step of background consolidation, if any is pending.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+    if (consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
 
     if (lock_status == STATUS_SUCCESS) {
         if (wear_leveling_lock() == STATUS_FAILURE) {
@@ -725,6 +1281,9 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_DOUBLE_BANKED
 }
 
 /**
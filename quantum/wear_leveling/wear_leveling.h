@@ -43,6 +43,16 @@ wear_leveling_status_t wear_leveling_erase(void);
  */
 wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value, size_t length);
 
+/**
+ * Wear-leveling background task.
+ *
+ * Performs one bounded step of any consolidation in progress. Only does anything with WEAR_LEVELING_DOUBLE_BANKED,
+ * and should be called regularly from the main loop.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once a consolidation completes, otherwise the status of the step
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
 /**
  * Reads logical data from the cache.
  *
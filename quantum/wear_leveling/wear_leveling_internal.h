@@ -59,10 +59,55 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+// Each bank holds its own consolidated data and write log, consolidation builds the spare bank then switches to it
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+
+// Number of bytes of the spare bank erased by each background consolidation step, one erase unit of the backing store
+// unless configured otherwise
+#    ifndef WEAR_LEVELING_ERASE_STEP_SIZE
+#        ifdef BACKING_STORE_ERASE_SIZE
+#            define WEAR_LEVELING_ERASE_STEP_SIZE (BACKING_STORE_ERASE_SIZE)
+#        else
+#            error WEAR_LEVELING_DOUBLE_BANKED needs WEAR_LEVELING_ERASE_STEP_SIZE, as the backing store does not define BACKING_STORE_ERASE_SIZE
+#        endif
+#    endif
+
+// Number of bytes of consolidated data or write log copied into the spare bank by each background consolidation step
+#    ifndef WEAR_LEVELING_CONSOLIDATION_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_STEP_SIZE 256
+#    endif
+
+// Number of bytes of write log used before background consolidation starts
+#    ifndef WEAR_LEVELING_CONSOLIDATION_THRESHOLD
+#        define WEAR_LEVELING_CONSOLIDATION_THRESHOLD (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - 16) / 2)
+#    endif
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#endif // WEAR_LEVELING_DOUBLE_BANKED
+
+// Number of bytes read from the write log at a time during playback
+#ifndef WEAR_LEVELING_PLAYBACK_BUFFER_SIZE
+#    define WEAR_LEVELING_PLAYBACK_BUFFER_SIZE 64
+#endif
+
+#if defined(WEAR_LEVELING_CHECKPOINT_INTERVAL) && defined(WEAR_LEVELING_DOUBLE_BANKED)
+#    error WEAR_LEVELING_CHECKPOINT_INTERVAL is not supported with WEAR_LEVELING_DOUBLE_BANKED
+#endif
+
 // Compile-time validation of configurable options
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 STATIC_ASSERT(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+STATIC_ASSERT(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback buffer size must be a multiple of write size");
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE <= (1 << 22), "Checkpoint positions only cover the first 4MB of backing store");
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+STATIC_ASSERT(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Each bank must be at least twice the size of the logical size");
+STATIC_ASSERT(WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_ERASE_STEP_SIZE == 0, "Bank size must be a multiple of the erase step size");
+STATIC_ASSERT(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+#endif // WEAR_LEVELING_DOUBLE_BANKED
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -73,6 +118,9 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_DOUBLE_BANKED
+bool backing_store_erase_range(uint32_t address, size_t length); // erases part of the backing store, address and length are multiples of WEAR_LEVELING_ERASE_STEP_SIZE
+#endif // WEAR_LEVELING_DOUBLE_BANKED
 
 /**
  * Helper type used to contain a write log entry.
@@ -99,6 +147,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Checkpoint: log position and running hash of the write log
+    LOG_ENTRY_TYPE_CHECKPOINT,
+
     LOG_ENTRY_TYPES
 };
 
@@ -147,3 +198,20 @@ STATIC_ASSERT(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit into
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+#define LOG_ENTRY_CHECKPOINT_GET_POSITION(entry) (((((uint32_t)((entry).raw8[0])) & BITMASK_FOR_BITCOUNT(6)) << 16) | (((uint32_t)((entry).raw8[1])) << 8) | (entry).raw8[2])
+#define LOG_ENTRY_CHECKPOINT_GET_HASH(entry) (((uint32_t)((entry).raw8[4])) | (((uint32_t)((entry).raw8[5])) << 8) | (((uint32_t)((entry).raw8[6])) << 16) | (((uint32_t)((entry).raw8[7])) << 24))
+#define LOG_ENTRY_MAKE_CHECKPOINT(position, hash)                                                         \
+    (write_log_entry_t) {                                                                                 \
+        .raw8 = {                                                                                         \
+            [0] = (((((uint8_t)LOG_ENTRY_TYPE_CHECKPOINT) & BITMASK_FOR_BITCOUNT(2)) << 6) /* type */     \
+                   | ((((uint8_t)((position) >> 16))) & BITMASK_FOR_BITCOUNT(6))          /* position */ \
+                   ),                                                                                     \
+            [1] = (uint8_t)((position) >> 8),  /* position */                                             \
+            [2] = (uint8_t)(position),         /* position */                                             \
+            [4] = (uint8_t)(hash),             /* hash */                                                 \
+            [5] = (uint8_t)((hash) >> 8),      /* hash */                                                 \
+            [6] = (uint8_t)((hash) >> 16),     /* hash */                                                 \
+            [7] = (uint8_t)((hash) >> 24),     /* hash */                                                 \
+        }                                                                                                 \
+    }
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../dynamic_keymap_test_config.h"
+
+// Fewer pages than a full sweep of the keymap touches, so eviction is exercised
+#define DYNAMIC_KEYMAP_CACHE_PAGES 4
+#define DYNAMIC_KEYMAP_CACHE_PAGE_SIZE 32
@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../dynamic_keymap_test_config.h"
+
+#define DYNAMIC_KEYMAP_RAM_MIRROR
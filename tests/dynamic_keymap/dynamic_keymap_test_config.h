@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Shared configuration for the dynamic keymap suites, each suite only differs in how the keymap is cached.
+
+// The default test EEPROM only holds eeconfig
+#define TEST_EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_LAYER_COUNT 4
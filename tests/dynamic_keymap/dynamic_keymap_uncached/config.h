@@ -0,0 +1,6 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../dynamic_keymap_test_config.h"
@@ -0,0 +1,203 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "nvm_dynamic_keymap.h"
+#include "eeprom_test_harness.h"
+}
+
+// Keys per layer in the test matrix
+#define KEYS_PER_LAYER (MATRIX_ROWS * MATRIX_COLS)
+// Full keymap sweeps performed by the benchmark
+#define BENCHMARK_SWEEPS 8
+// Per-transaction latency of the slow EEPROM model, roughly a random read from SPI EEPROM
+#define BENCHMARK_SLOW_EEPROM_NS 10000
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+#    define CACHE_MODE "ram mirror"
+#elif defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+#    define CACHE_MODE "page cache"
+#else
+#    define CACHE_MODE "uncached"
+#endif
+
+namespace {
+
+// Looks up the key at a linear index over layer/row/column, which matches its position in EEPROM.
+uint16_t get_key(uint16_t index) {
+    return dynamic_keymap_get_keycode(index / KEYS_PER_LAYER, (index % KEYS_PER_LAYER) / MATRIX_COLS, index % MATRIX_COLS);
+}
+
+void set_key(uint16_t index, uint16_t keycode) {
+    dynamic_keymap_set_keycode(index / KEYS_PER_LAYER, (index % KEYS_PER_LAYER) / MATRIX_COLS, index % MATRIX_COLS, keycode);
+}
+
+void sweep_keymap(uint8_t layers) {
+    for (uint16_t i = 0; i < layers * KEYS_PER_LAYER; i++) {
+        get_key(i);
+    }
+}
+
+} // namespace
+
+class DynamicKeymap : public TestFixture {
+   public:
+    void SetUp() override {
+        test_eeprom_set_transaction_latency_ns(0);
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        test_eeprom_reset_stats();
+    }
+};
+
+TEST_F(DynamicKeymap, ResetCopiesFlashKeymap) {
+    TestDriver driver;
+
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER; i++) {
+        // The test keymap only defines layer 0, every other layer reads back as transparent
+        EXPECT_EQ(get_key(i), i < KEYS_PER_LAYER ? KC_NO : KC_TRNS) << "key " << i;
+    }
+}
+
+TEST_F(DynamicKeymap, SetKeycodeIsWrittenThrough) {
+    TestDriver driver;
+
+    set_key(0, KC_A);
+    set_key(KEYS_PER_LAYER + 5, KC_B);
+    set_key(DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER - 1, QK_BOOT);
+    EXPECT_GT(test_eeprom_get_stats()->write_transactions, 0u);
+
+    // Drop anything cached so the values have to come back from EEPROM
+    nvm_dynamic_keymap_erase();
+    EXPECT_EQ(get_key(0), KC_A);
+    EXPECT_EQ(get_key(KEYS_PER_LAYER + 5), KC_B);
+    EXPECT_EQ(get_key(DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER - 1), QK_BOOT);
+}
+
+TEST_F(DynamicKeymap, UnchangedKeycodeSkipsWrite) {
+    TestDriver driver;
+
+    set_key(3, KC_C);
+    get_key(3);
+    test_eeprom_reset_stats();
+    set_key(3, KC_C);
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    EXPECT_EQ(test_eeprom_get_stats()->write_transactions, 0u);
+#else
+    EXPECT_EQ(test_eeprom_get_stats()->write_transactions, 2u);
+#endif
+}
+
+TEST_F(DynamicKeymap, BufferRoundTrip) {
+    TestDriver driver;
+
+    std::vector<uint8_t> data(3 * MATRIX_COLS * 2);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 7;
+    }
+    dynamic_keymap_set_buffer(KEYS_PER_LAYER * 2 + 4, data.size(), data.data());
+
+    std::vector<uint8_t> read(data.size());
+    dynamic_keymap_get_buffer(KEYS_PER_LAYER * 2 + 4, read.size(), read.data());
+    EXPECT_EQ(read, data);
+
+    uint16_t index = KEYS_PER_LAYER + 2;
+    EXPECT_EQ(get_key(index), (data[0] << 8) | data[1]);
+
+    nvm_dynamic_keymap_erase();
+    dynamic_keymap_get_buffer(KEYS_PER_LAYER * 2 + 4, read.size(), read.data());
+    EXPECT_EQ(read, data);
+}
+
+TEST_F(DynamicKeymap, MacroRoundTrip) {
+    TestDriver driver;
+
+    uint8_t macro[] = {'q', 'm', 'k', 0, 'v', 'i', 'a', 0};
+    dynamic_keymap_macro_set_buffer(10, sizeof(macro), macro);
+
+    uint8_t read[sizeof(macro)] = {0};
+    dynamic_keymap_macro_get_buffer(10, sizeof(read), read);
+    EXPECT_EQ(memcmp(read, macro, sizeof(macro)), 0);
+
+    // The block reset has to replace cached macro bytes too
+    dynamic_keymap_macro_reset();
+    uint8_t zero[sizeof(macro)] = {0};
+    dynamic_keymap_macro_get_buffer(10, sizeof(read), read);
+    EXPECT_EQ(memcmp(read, zero, sizeof(zero)), 0);
+}
+
+TEST_F(DynamicKeymap, LookupsAreServedFromRam) {
+    TestDriver driver;
+
+    // Warm up with a single layer, which fits in every cache configuration
+    sweep_keymap(1);
+    test_eeprom_reset_stats();
+    for (int i = 0; i < BENCHMARK_SWEEPS; i++) {
+        sweep_keymap(1);
+    }
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+    EXPECT_EQ(test_eeprom_get_stats()->read_transactions, 0u);
+#else
+    EXPECT_EQ(test_eeprom_get_stats()->read_transactions, 2u * BENCHMARK_SWEEPS * KEYS_PER_LAYER);
+#endif
+}
+
+#if defined(DYNAMIC_KEYMAP_CACHE_PAGES)
+// Number of keys held by one cache page
+#    define KEYS_PER_PAGE (DYNAMIC_KEYMAP_CACHE_PAGE_SIZE / 2)
+
+TEST_F(DynamicKeymap, PageCacheEvictsLeastRecentlyUsed) {
+    TestDriver driver;
+
+    // Touch pages 0-3 to fill the cache, then page 0 again to make page 1 the oldest
+    nvm_dynamic_keymap_erase();
+    for (uint8_t page = 0; page < DYNAMIC_KEYMAP_CACHE_PAGES; page++) {
+        get_key(page * KEYS_PER_PAGE);
+    }
+    get_key(0);
+    EXPECT_EQ(test_eeprom_get_stats()->read_transactions, (uint32_t)DYNAMIC_KEYMAP_CACHE_PAGES);
+
+    // Page 4 evicts page 1, page 0 survives
+    get_key(DYNAMIC_KEYMAP_CACHE_PAGES * KEYS_PER_PAGE);
+    test_eeprom_reset_stats();
+    get_key(0);
+    EXPECT_EQ(test_eeprom_get_stats()->read_transactions, 0u);
+    get_key(KEYS_PER_PAGE);
+    EXPECT_EQ(test_eeprom_get_stats()->read_transactions, 1u);
+}
+#endif // DYNAMIC_KEYMAP_CACHE_PAGES
+
+/*
+ * Reports the cost of keycode lookups against the test EEPROM, both as-is and with a fixed per-transaction latency to
+ * model external EEPROM. This is a baseline for comparing the cache configurations, not a pass/fail check.
+ */
+TEST_F(DynamicKeymap, LookupCost) {
+    TestDriver driver;
+
+    printf("%-12s %-12s %14s %16s\n", "mode", "eeprom", "ns/lookup", "reads/lookup");
+    for (uint32_t latency : {0u, (uint32_t)BENCHMARK_SLOW_EEPROM_NS}) {
+        test_eeprom_set_transaction_latency_ns(latency);
+        nvm_dynamic_keymap_erase();
+        test_eeprom_reset_stats();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCHMARK_SWEEPS; i++) {
+            sweep_keymap(DYNAMIC_KEYMAP_LAYER_COUNT);
+        }
+        uint64_t ns      = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        uint32_t lookups = BENCHMARK_SWEEPS * DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER;
+
+        printf("%-12s %-12s %14" PRIu64 " %16.3f\n", CACHE_MODE, latency ? "slow" : "fast", ns / lookups, (double)test_eeprom_get_stats()->read_transactions / lookups);
+    }
+    test_eeprom_set_transaction_latency_ns(0);
+}
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// The default test EEPROM only holds eeconfig
+#define TEST_EEPROM_SIZE 1024
+
+#define NVM_COMMIT_QUEUE_SLOTS 4
+#define NVM_COMMIT_QUEUE_PAGE_SIZE 16
@@ -0,0 +1,6 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+NVM_COMMIT_QUEUE_ENABLE = yes
+DYNAMIC_KEYMAP_ENABLE = yes
@@ -0,0 +1,182 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "dynamic_keymap.h"
+#include "nvm_commit_queue.h"
+#include "suspend.h"
+#include "eeprom_test_harness.h"
+}
+
+// Scratch area well clear of eeconfig and the dynamic keymap
+#define SCRATCH_ADDR 896
+
+class NvmCommitQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        nvm_commit_queue_flush();
+        test_eeprom_reset_stats();
+    }
+
+    uint32_t physical_writes(void) {
+        return test_eeprom_get_stats()->write_transactions;
+    }
+
+    void update_byte(uintptr_t address, uint8_t value) {
+        nvm_commit_queue_update(&value, address, 1);
+    }
+};
+
+TEST_F(NvmCommitQueue, UpdatesAreDeferredUntilIdle) {
+    TestDriver driver;
+
+    // A held key repeating a config change
+    for (uint32_t i = 0; i < 50; i++) {
+        eeconfig_update_user(i);
+        idle_for(30);
+    }
+    EXPECT_EQ(physical_writes(), 0u);
+    EXPECT_EQ(eeconfig_read_user(), 49u);
+    EXPECT_TRUE(nvm_commit_queue_pending());
+
+    idle_for(NVM_COMMIT_QUEUE_IDLE_MS);
+    EXPECT_EQ(physical_writes(), 1u);
+    EXPECT_FALSE(nvm_commit_queue_pending());
+
+    // Anything left in the queue would be lost here, so the value must have come from EEPROM
+    nvm_commit_queue_discard();
+    EXPECT_EQ(eeconfig_read_user(), 49u);
+}
+
+TEST_F(NvmCommitQueue, ContinuousUpdatesAreWrittenAfterMaxDelay) {
+    TestDriver driver;
+
+    uint32_t elapsed = 0;
+    for (uint32_t i = 0; physical_writes() == 0 && elapsed < 2 * NVM_COMMIT_QUEUE_MAX_DELAY_MS; i++) {
+        eeconfig_update_user(i);
+        idle_for(100);
+        elapsed += 100;
+    }
+    EXPECT_EQ(physical_writes(), 1u);
+    EXPECT_GE(elapsed, (uint32_t)NVM_COMMIT_QUEUE_MAX_DELAY_MS);
+    EXPECT_LE(elapsed, (uint32_t)NVM_COMMIT_QUEUE_MAX_DELAY_MS + 100);
+}
+
+TEST_F(NvmCommitQueue, FlushIsABarrier) {
+    TestDriver driver;
+
+    eeconfig_update_user(0x12345678);
+    update_byte(SCRATCH_ADDR, 0xAA);
+    EXPECT_EQ(physical_writes(), 0u);
+
+    nvm_commit_queue_flush();
+    EXPECT_EQ(physical_writes(), 2u);
+    EXPECT_FALSE(nvm_commit_queue_pending());
+
+    nvm_commit_queue_discard();
+    EXPECT_EQ(eeconfig_read_user(), 0x12345678u);
+}
+
+TEST_F(NvmCommitQueue, SuspendFlushes) {
+    TestDriver driver;
+
+    eeconfig_update_user(0xCAFE);
+    suspend_power_down_quantum();
+    EXPECT_FALSE(nvm_commit_queue_pending());
+    EXPECT_EQ(physical_writes(), 1u);
+}
+
+TEST_F(NvmCommitQueue, UpdatesAreBatchedPerPage) {
+    TestDriver driver;
+
+    // 32 contiguous bytes starting mid-page, written out of order, touch three pages
+    for (uint8_t i = 0; i < 32; i++) {
+        uint8_t offset = (i * 7) % 32;
+        update_byte(SCRATCH_ADDR + 4 + offset, offset);
+    }
+    nvm_commit_queue_flush();
+    EXPECT_EQ(physical_writes(), 3u);
+    EXPECT_EQ(test_eeprom_get_stats()->bytes_written, 32u);
+
+    // Separate runs within a page are written separately, without touching the bytes in between
+    test_eeprom_reset_stats();
+    update_byte(SCRATCH_ADDR, 1);
+    update_byte(SCRATCH_ADDR + 1, 2);
+    update_byte(SCRATCH_ADDR + 8, 3);
+    nvm_commit_queue_flush();
+    EXPECT_EQ(physical_writes(), 2u);
+    EXPECT_EQ(test_eeprom_get_stats()->bytes_written, 3u);
+}
+
+TEST_F(NvmCommitQueue, ReadsSeePendingUpdates) {
+    TestDriver driver;
+
+    uint8_t data[24];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+    nvm_commit_queue_update(data, SCRATCH_ADDR, sizeof(data));
+    nvm_commit_queue_flush();
+
+    update_byte(SCRATCH_ADDR + 3, 0xF3);
+    update_byte(SCRATCH_ADDR + 20, 0xF4);
+    uint8_t read[sizeof(data)];
+    nvm_commit_queue_read(read, SCRATCH_ADDR + 2, 20);
+    for (uint8_t i = 0; i < 20; i++) {
+        uint8_t expected = i == 1 ? 0xF3 : i == 18 ? 0xF4 : i + 2;
+        EXPECT_EQ(read[i], expected) << "byte " << +i;
+    }
+}
+
+TEST_F(NvmCommitQueue, FullQueueWritesOldestPage) {
+    TestDriver driver;
+
+    for (uint8_t page = 0; page < NVM_COMMIT_QUEUE_SLOTS; page++) {
+        update_byte(SCRATCH_ADDR + page * NVM_COMMIT_QUEUE_PAGE_SIZE, page);
+    }
+    EXPECT_EQ(physical_writes(), 0u);
+
+    // Coalescing into a pending page doesn't need a slot
+    update_byte(SCRATCH_ADDR + 1, 0xFF);
+    EXPECT_EQ(physical_writes(), 0u);
+
+    update_byte(SCRATCH_ADDR + NVM_COMMIT_QUEUE_SLOTS * NVM_COMMIT_QUEUE_PAGE_SIZE, 0xEE);
+    EXPECT_EQ(physical_writes(), 1u);
+    EXPECT_EQ(test_eeprom_get_stats()->bytes_written, 2u);
+}
+
+TEST_F(NvmCommitQueue, TaskWritesOnePagePerCall) {
+    TestDriver driver;
+
+    for (uint8_t page = 0; page < NVM_COMMIT_QUEUE_SLOTS; page++) {
+        update_byte(SCRATCH_ADDR + page * NVM_COMMIT_QUEUE_PAGE_SIZE, page);
+    }
+    for (uint32_t i = 0; physical_writes() == 0 && i <= NVM_COMMIT_QUEUE_IDLE_MS; i++) {
+        run_one_scan_loop();
+    }
+    for (uint32_t writes = 1; writes <= NVM_COMMIT_QUEUE_SLOTS; writes++) {
+        EXPECT_EQ(physical_writes(), writes);
+        run_one_scan_loop();
+    }
+    EXPECT_FALSE(nvm_commit_queue_pending());
+}
+
+TEST_F(NvmCommitQueue, KeymapEditsAreCoalesced) {
+    TestDriver driver;
+
+    // A configurator repeatedly rewriting the same key
+    for (uint16_t i = 0; i < 20; i++) {
+        dynamic_keymap_set_keycode(1, 2, 3, KC_A + (i % 4));
+    }
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_D);
+    EXPECT_EQ(physical_writes(), 0u);
+
+    idle_for(NVM_COMMIT_QUEUE_IDLE_MS + NVM_COMMIT_QUEUE_SLOTS);
+    // Two bytes, split across at most two pages
+    EXPECT_GE(physical_writes(), 1u);
+    EXPECT_LE(physical_writes(), 2u);
+    EXPECT_EQ(test_eeprom_get_stats()->bytes_written, 2u);
+}
@@ -0,0 +1,9 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+OLED_ENABLE = yes
+OLED_TRANSPORT = i2c
+
+SRC += tests/oled/test_oled.cpp \
+	i2c_master.c
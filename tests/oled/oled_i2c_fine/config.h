@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// 64 blocks of 8 bytes
+#define OLED_BLOCK_TYPE uint64_t
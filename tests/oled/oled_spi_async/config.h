@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define OLED_CS_PIN 1
+#define OLED_DC_PIN 2
+#define OLED_ASYNC_FLUSH
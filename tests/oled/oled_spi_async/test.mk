@@ -0,0 +1,10 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+OLED_ENABLE = yes
+OLED_TRANSPORT = spi
+
+SRC += tests/oled/test_oled.cpp \
+	gpio_mock.c \
+	spi_master.c
@@ -0,0 +1,403 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "test_common.hpp"
+
+extern "C" {
+#include "oled_driver.h"
+#if defined(OLED_TRANSPORT_SPI)
+#    include "spi_mock.h"
+#else
+#    include "i2c_mock.h"
+#endif
+
+extern uint8_t         oled_buffer[OLED_MATRIX_SIZE];
+extern OLED_BLOCK_TYPE oled_dirty;
+}
+
+#define OLED_I2C_HZ 400000
+#define OLED_SPI_HZ 8000000
+
+#if defined(OLED_TRANSPORT_SPI) && defined(OLED_ASYNC_FLUSH)
+#    define OLED_MODE "spi async"
+#    define OTHER_CS_PIN 3
+#elif defined(OLED_TRANSPORT_SPI)
+#    define OLED_MODE "spi"
+#else
+#    define OLED_MODE "i2c"
+#endif
+
+namespace {
+
+// Enough of an SSD1306 to follow the addressing commands and write data into its memory
+struct Ssd1306Model {
+    uint8_t  gddram[8][128];
+    bool     horizontal;
+    uint8_t  command;
+    uint8_t  params; // parameters the current command is still expecting
+    uint8_t  param;
+    uint8_t  column_start, column_end, page_start, page_end;
+    uint8_t  column, page;
+    bool     writing;
+    uint32_t writes;     // data writes started after commands, one per window
+    uint32_t data_bytes; // bytes written to memory
+
+    void reset(void) {
+        memset(this, 0, sizeof(*this));
+        column_end = 127;
+        page_end   = 7;
+    }
+
+    void receive_command(uint8_t byte) {
+        writing = false;
+        if (params) {
+            parameter(byte);
+            return;
+        }
+        command = byte;
+        param   = 0;
+        switch (byte) {
+            case 0x20: // Memory addressing mode
+            case 0x23: // Fade / blink
+            case 0x81: // Contrast
+            case 0x8D: // Charge pump
+            case 0xA8: // Multiplex ratio
+            case 0xD3: // Display offset
+            case 0xD5: // Display clock
+            case 0xD9: // Pre-charge period
+            case 0xDA: // COM pins
+            case 0xDB: // VCOMH deselect level
+                params = 1;
+                break;
+            case 0x21: // Column address
+            case 0x22: // Page address
+                params = 2;
+                break;
+            case 0x29: // Vertical and horizontal scroll
+            case 0x2A:
+                params = 5;
+                break;
+            case 0x26: // Horizontal scroll
+            case 0x27:
+                params = 6;
+                break;
+            default:
+                if (byte >= 0xB0 && byte <= 0xB7) {
+                    page = byte & 0x07;
+                } else if (byte <= 0x0F) {
+                    column = (column & 0xF0) | byte;
+                } else if (byte <= 0x1F) {
+                    column = (column & 0x0F) | (byte & 0x0F) << 4;
+                }
+                break;
+        }
+    }
+
+    void parameter(uint8_t byte) {
+        params--;
+        switch (command) {
+            case 0x20:
+                horizontal = byte == 0x00;
+                break;
+            case 0x21:
+                if (param == 0) {
+                    column_start = column = byte;
+                } else {
+                    column_end = byte;
+                }
+                break;
+            case 0x22:
+                if (param == 0) {
+                    page_start = page = byte;
+                } else {
+                    page_end = byte;
+                }
+                break;
+        }
+        param++;
+    }
+
+    void receive_data(uint8_t byte) {
+        if (!writing) {
+            writing = true;
+            writes++;
+        }
+        data_bytes++;
+        gddram[page % 8][column % 128] = byte;
+        if (!horizontal) {
+            column++;
+        } else if (++column > column_end) {
+            column = column_start;
+            page   = page < page_end ? page + 1 : page_start;
+        }
+    }
+
+    // Physical pixel, with row 0 at the top of the display
+    bool pixel(uint8_t col, uint8_t row) const {
+        return gddram[row / 8][col] & (1 << (row % 8));
+    }
+};
+
+Ssd1306Model model;
+
+#if defined(OLED_TRANSPORT_SPI)
+void oled_receive(uint8_t byte, bool dc) {
+    if (dc) {
+        model.receive_data(byte);
+    } else {
+        model.receive_command(byte);
+    }
+}
+#else
+void oled_receive(uint8_t address, const uint8_t *data, uint16_t length) {
+    // The first byte is the control byte, all commands or all data
+    for (uint16_t i = 1; i < length; ++i) {
+        if (data[0] == 0x40) {
+            model.receive_data(data[i]);
+        } else {
+            model.receive_command(data[i]);
+        }
+    }
+}
+#endif
+
+struct BusCost {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint64_t ns;
+};
+
+void configure(bool dma) {
+#if defined(OLED_TRANSPORT_SPI)
+    spi_mock_config_t config = {};
+    config.clock_hz          = OLED_SPI_HZ;
+    config.dma               = dma;
+    config.dc_pin            = OLED_DC_PIN;
+    spi_mock_configure(&config, oled_receive);
+#else
+    i2c_mock_config_t config = {};
+    config.clock_hz          = OLED_I2C_HZ;
+    i2c_mock_configure(&config, oled_receive);
+#endif
+}
+
+void reset_costs(void) {
+#if defined(OLED_TRANSPORT_SPI)
+    spi_mock_reset_stats();
+#else
+    i2c_mock_reset_stats();
+#endif
+    model.writes     = 0;
+    model.data_bytes = 0;
+}
+
+BusCost costs(void) {
+#if defined(OLED_TRANSPORT_SPI)
+    const spi_mock_stats_t *stats = spi_mock_get_stats();
+    return {stats->transfers, stats->bytes, stats->busy_ns};
+#else
+    const i2c_mock_stats_t *stats = i2c_mock_get_stats();
+    return {stats->transactions, stats->bytes, stats->busy_ns};
+#endif
+}
+
+void fill_noise(uint32_t seed) {
+    srand(seed);
+    for (uint16_t i = 0; i < OLED_MATRIX_SIZE; ++i) {
+        oled_write_raw_byte(rand() & 0xFF, i);
+    }
+}
+
+} // namespace
+
+class Oled : public TestFixture {
+   public:
+    void SetUp() override {
+        model.reset();
+        configure(true);
+    }
+
+    void TearDown() override {
+        oled_send_wait();
+    }
+
+    // Renders everything dirty, and waits for it to reach the display
+    void flush(void) {
+        oled_render_dirty(true);
+        oled_send_wait();
+        EXPECT_FALSE(oled_dirty);
+    }
+
+    void expect_matches_buffer(void) {
+        for (uint8_t page = 0; page < OLED_DISPLAY_HEIGHT / 8; ++page) {
+            for (uint8_t col = 0; col < OLED_DISPLAY_WIDTH; ++col) {
+                ASSERT_EQ(model.gddram[page][col], oled_buffer[page * OLED_DISPLAY_WIDTH + col]) << "page " << (int)page << " column " << (int)col;
+            }
+        }
+    }
+
+    // When rotated, the buffer runs up each 8px column of the display from the bottom, and then to the right
+    void expect_matches_buffer_90(void) {
+        for (uint8_t y = 0; y < OLED_DISPLAY_WIDTH; ++y) {
+            for (uint8_t x = 0; x < OLED_DISPLAY_HEIGHT; ++x) {
+                bool set = oled_buffer[y / 8 * OLED_DISPLAY_HEIGHT + x] & (1 << (y % 8));
+                ASSERT_EQ(model.pixel(y, OLED_DISPLAY_HEIGHT - 1 - x), set) << "x " << (int)x << " y " << (int)y;
+            }
+        }
+    }
+};
+
+TEST_F(Oled, RendersBufferToDisplay) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    fill_noise(1);
+    flush();
+    expect_matches_buffer();
+
+    // Sprinkle changes over the display, leaving gaps between some of them
+    for (uint16_t i = 0; i < OLED_MATRIX_SIZE; i += 7 + i % 29) {
+        oled_write_raw_byte(~oled_buffer[i], i);
+    }
+    flush();
+    expect_matches_buffer();
+}
+
+TEST_F(Oled, OnePixelSendsOneBlock) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    flush();
+    reset_costs();
+
+    oled_write_pixel(70, 20, true);
+    flush();
+    EXPECT_EQ(model.writes, 1);
+    EXPECT_EQ(model.data_bytes, OLED_BLOCK_SIZE);
+    expect_matches_buffer();
+}
+
+TEST_F(Oled, AdjacentBlocksShareATransfer) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    flush();
+
+    // A line of text dirties a run of blocks along the top page, which go out as one window
+    reset_costs();
+    oled_write_ln("Adjacent dirty block", false);
+    uint32_t blocks = __builtin_popcountll(oled_dirty);
+    EXPECT_GT(blocks, 1);
+    flush();
+    EXPECT_EQ(model.writes, 1);
+    EXPECT_EQ(model.data_bytes, blocks * OLED_BLOCK_SIZE);
+    expect_matches_buffer();
+
+    // Without rendering everything, no more than OLED_UPDATE_PROCESS_LIMIT blocks go at a time
+    reset_costs();
+    oled_set_cursor(0, 0);
+    oled_write_ln("Adjacent dirty block", true);
+    blocks           = __builtin_popcountll(oled_dirty);
+    uint32_t renders = 0;
+    while (oled_dirty && renders < OLED_MATRIX_SIZE) {
+        oled_render();
+        renders++;
+        EXPECT_LE(model.data_bytes, renders * OLED_UPDATE_PROCESS_LIMIT * OLED_BLOCK_SIZE);
+    }
+    oled_send_wait();
+    EXPECT_EQ(renders, (blocks + OLED_UPDATE_PROCESS_LIMIT - 1) / OLED_UPDATE_PROCESS_LIMIT);
+    expect_matches_buffer();
+}
+
+TEST_F(Oled, Rotation90) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_90));
+    fill_noise(2);
+    flush();
+    expect_matches_buffer_90();
+
+    for (uint16_t i = 0; i < OLED_MATRIX_SIZE; i += 5 + i % 37) {
+        oled_write_raw_byte(~oled_buffer[i], i);
+    }
+    flush();
+    expect_matches_buffer_90();
+
+    // A single pixel, in the top left corner of the rotated display
+    reset_costs();
+    oled_write_pixel(0, 0, !(oled_buffer[0] & 1));
+    flush();
+    EXPECT_EQ(model.writes, 1);
+    EXPECT_EQ(model.data_bytes, OLED_BLOCK_SIZE);
+    expect_matches_buffer_90();
+}
+
+#if defined(OLED_TRANSPORT_SPI) && defined(OLED_ASYNC_FLUSH)
+TEST_F(Oled, AsyncFlushCompletesInTask) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    fill_noise(3);
+    reset_costs();
+
+    // The last of the data is still on the bus once rendering returns, and goes out during the next OLED task
+    oled_render_dirty(true);
+    EXPECT_LT(model.data_bytes, OLED_MATRIX_SIZE);
+    oled_task();
+    EXPECT_EQ(model.data_bytes, OLED_MATRIX_SIZE);
+    expect_matches_buffer();
+
+    // Nothing was modified or switched while on the bus
+    EXPECT_EQ(spi_mock_get_stats()->corruptions, 0);
+    EXPECT_EQ(spi_mock_get_stats()->pin_changes, 0);
+}
+
+TEST_F(Oled, AsyncFlushReleasedByOtherDevice) {
+    ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    fill_noise(4);
+    reset_costs();
+
+    // Another device can start on the bus without waiting for the OLED itself, and its start finishes the OLED's data
+    oled_render_dirty(true);
+    EXPECT_LT(model.data_bytes, OLED_MATRIX_SIZE);
+    ASSERT_TRUE(spi_start(OTHER_CS_PIN, false, 0, 2));
+    EXPECT_EQ(model.data_bytes, OLED_MATRIX_SIZE);
+    expect_matches_buffer();
+
+    // The OLED task leaves the other device's transaction alone
+    oled_task();
+    EXPECT_FALSE(spi_start(OTHER_CS_PIN, false, 0, 2));
+    spi_stop();
+
+    EXPECT_EQ(spi_mock_get_stats()->corruptions, 0);
+    EXPECT_EQ(spi_mock_get_stats()->pin_changes, 0);
+}
+#endif
+
+TEST_F(Oled, FlushCosts) {
+    struct Case {
+        const char     *name;
+        oled_rotation_t rotation;
+        bool            full;
+    } cases[] = {
+        {"full screen", OLED_ROTATION_0, true},
+        {"text line", OLED_ROTATION_0, false},
+        {"full screen 90", OLED_ROTATION_90, true},
+        {"text line 90", OLED_ROTATION_90, false},
+    };
+
+    printf("%-10s %-16s %6s %9s %7s %10s\n", "mode", "case", "blocks", "transfers", "bytes", "bus us");
+    for (const Case &c : cases) {
+        ASSERT_TRUE(oled_init(c.rotation));
+        flush();
+        reset_costs();
+        if (c.full) {
+            fill_noise(4);
+        } else {
+            oled_write_ln("Layer: Base", false);
+        }
+        uint8_t blocks = __builtin_popcountll(oled_dirty);
+        flush();
+        if (c.rotation == OLED_ROTATION_0) {
+            expect_matches_buffer();
+        } else {
+            expect_matches_buffer_90();
+        }
+
+        BusCost cost = costs();
+        printf("%-10s %-16s %6u %9u %7u %10.1f\n", OLED_MODE, c.name, blocks, cost.transfers, cost.bytes, cost.ns / 1000.0);
+    }
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_CONCURRENT_ANIMATIONS 32
+#define QUANTUM_PAINTER_ANIMATION_FRAME_INDEX 1
+#define QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE 4
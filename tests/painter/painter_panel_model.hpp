@@ -0,0 +1,60 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+#include "qp_ili9xxx_opcodes.h"
+}
+
+namespace painter_test {
+
+// Enough of an ILI9341 to follow the window and write commands into its memory
+template <uint16_t Width, uint16_t Height>
+struct PanelModel {
+    uint8_t  gram[Width * Height * 2];
+    uint8_t  command;
+    uint32_t param;
+    uint16_t xs, xe, ys, ye, x, y;
+    uint32_t windows; // memory writes started, one per viewport
+
+    void receive(uint8_t byte, bool dc) {
+        if (!dc) {
+            command = byte;
+            param   = 0;
+            x       = xs;
+            y       = ys;
+            if (command == ILI9XXX_SET_MEM) {
+                windows++;
+            }
+            return;
+        }
+        switch (command) {
+            case ILI9XXX_SET_COL_ADDR:
+                set_range(&xs, &xe, byte);
+                break;
+            case ILI9XXX_SET_PAGE_ADDR:
+                set_range(&ys, &ye, byte);
+                break;
+            case ILI9XXX_SET_MEM:
+                if (x < Width && y < Height) {
+                    gram[(y * Width + x) * 2 + param % 2] = byte;
+                }
+                if (param % 2 == 1 && ++x > xe) {
+                    x = xs;
+                    y = y < ye ? y + 1 : ys;
+                }
+                break;
+        }
+        param++;
+    }
+
+    void set_range(uint16_t *start, uint16_t *end, uint8_t byte) {
+        uint16_t *value = param < 2 ? start : end;
+        *value          = param % 2 == 0 ? (byte << 8) | (*value & 0xFF) : (*value & 0xFF00) | byte;
+    }
+};
+
+} // namespace painter_test
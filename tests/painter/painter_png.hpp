@@ -0,0 +1,425 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Reads and writes the 8-bit RGB PNGs used as golden images, without pulling in zlib or libpng
+namespace painter_test {
+
+inline uint32_t png_crc(const uint8_t *data, size_t length, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+inline uint32_t png_adler32(const std::vector<uint8_t> &data) {
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : data) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+inline void png_append_u32(std::vector<uint8_t> &out, uint32_t value) {
+    out.insert(out.end(), {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value});
+}
+
+inline uint32_t png_read_u32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+inline void png_append_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+    png_append_u32(out, data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    png_append_u32(out, png_crc(&out[start], out.size() - start));
+}
+
+static const uint16_t png_length_base[29]  = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t  png_length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t png_dist_base[30]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t  png_dist_extra[30]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Deflates with the fixed codes, only looking for repeats of the previous byte. With the Sub filter, flat areas are
+// runs of zeroes, which is all the golden images need to stay small.
+struct PngDeflater {
+    std::vector<uint8_t> out;
+    uint32_t             bit_buffer = 0;
+    int                  bit_count  = 0;
+
+    void put_bits(uint32_t value, int count) {
+        bit_buffer |= value << bit_count;
+        bit_count += count;
+        while (bit_count >= 8) {
+            out.push_back(bit_buffer);
+            bit_buffer >>= 8;
+            bit_count -= 8;
+        }
+    }
+
+    // Huffman codes are packed starting from their most significant bit
+    void put_code(uint32_t code, int length) {
+        for (int i = length - 1; i >= 0; --i) {
+            put_bits((code >> i) & 1, 1);
+        }
+    }
+
+    void put_symbol(uint16_t symbol) {
+        if (symbol < 144) {
+            put_code(0x30 + symbol, 8);
+        } else if (symbol < 256) {
+            put_code(0x190 + symbol - 144, 9);
+        } else if (symbol < 280) {
+            put_code(symbol - 256, 7);
+        } else {
+            put_code(0xC0 + symbol - 280, 8);
+        }
+    }
+
+    std::vector<uint8_t> deflate(const std::vector<uint8_t> &data) {
+        put_bits(1, 1); // final block
+        put_bits(1, 2); // fixed codes
+        size_t i = 0;
+        while (i < data.size()) {
+            size_t run = 0;
+            while (i > 0 && i + run < data.size() && run < 258 && data[i + run] == data[i - 1]) {
+                ++run;
+            }
+            if (run < 3) {
+                put_symbol(data[i++]);
+                continue;
+            }
+            int code = 28;
+            while (png_length_base[code] > run) {
+                --code;
+            }
+            put_symbol(257 + code);
+            put_bits(run - png_length_base[code], png_length_extra[code]);
+            put_code(0, 5); // distance of one byte
+            i += run;
+        }
+        put_symbol(256);
+        put_bits(0, 7); // flush the last byte
+        return out;
+    }
+};
+
+struct PngHuffman {
+    uint16_t count[16];
+    uint16_t symbol[288];
+
+    void build(const uint8_t *lengths, int n) {
+        uint16_t offsets[16] = {0};
+        memset(count, 0, sizeof(count));
+        for (int i = 0; i < n; ++i) {
+            count[lengths[i]]++;
+        }
+        for (int length = 1; length < 15; ++length) {
+            offsets[length + 1] = offsets[length] + count[length];
+        }
+        for (int i = 0; i < n; ++i) {
+            if (lengths[i]) {
+                symbol[offsets[lengths[i]]++] = i;
+            }
+        }
+    }
+};
+
+// Inflates any zlib stream, so that goldens recompressed by other tools can still be read
+struct PngInflater {
+    const std::vector<uint8_t> &in;
+    size_t                      pos        = 2; // past the zlib header
+    uint32_t                    bit_buffer = 0;
+    int                         bit_count  = 0;
+    bool                        error      = false;
+    std::vector<uint8_t>        out;
+
+    explicit PngInflater(const std::vector<uint8_t> &data) : in(data) {}
+
+    uint32_t bits(int count) {
+        while (bit_count < count) {
+            if (pos >= in.size()) {
+                error = true;
+                return 0;
+            }
+            bit_buffer |= (uint32_t)in[pos++] << bit_count;
+            bit_count += 8;
+        }
+        uint32_t value = bit_buffer & ((1u << count) - 1);
+        bit_buffer >>= count;
+        bit_count -= count;
+        return value;
+    }
+
+    int decode(const PngHuffman &huffman) {
+        int code = 0, first = 0, index = 0;
+        for (int length = 1; length < 16 && !error; ++length) {
+            code |= bits(1);
+            int count = huffman.count[length];
+            if (code - first < count) {
+                return huffman.symbol[index + code - first];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        error = true;
+        return -1;
+    }
+
+    void codes(const PngHuffman &lengths, const PngHuffman &distances) {
+        while (!error) {
+            int symbol = decode(lengths);
+            if (symbol < 256) {
+                out.push_back(symbol);
+                continue;
+            }
+            if (symbol == 256) {
+                return;
+            }
+            symbol -= 257;
+            if (symbol >= 29) {
+                break;
+            }
+            uint32_t length   = png_length_base[symbol] + bits(png_length_extra[symbol]);
+            int      distance = decode(distances);
+            if (distance < 0 || distance >= 30) {
+                break;
+            }
+            size_t back = png_dist_base[distance] + bits(png_dist_extra[distance]);
+            if (back > out.size()) {
+                break;
+            }
+            for (uint32_t i = 0; i < length; ++i) {
+                out.push_back(out[out.size() - back]);
+            }
+        }
+        error = true;
+    }
+
+    void fixed(void) {
+        uint8_t    lengths[288];
+        PngHuffman length_codes, distance_codes;
+        memset(lengths, 8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        length_codes.build(lengths, 288);
+        memset(lengths, 5, 30);
+        distance_codes.build(lengths, 30);
+        codes(length_codes, distance_codes);
+    }
+
+    void dynamic(void) {
+        static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        int     num_lengths = bits(5) + 257, num_distances = bits(5) + 1, num_codes = bits(4) + 4;
+        uint8_t lengths[320] = {0};
+        for (int i = 0; i < num_codes; ++i) {
+            lengths[order[i]] = bits(3);
+        }
+        PngHuffman code_codes;
+        code_codes.build(lengths, 19);
+
+        memset(lengths, 0, sizeof(lengths));
+        int i = 0;
+        while (i < num_lengths + num_distances && !error) {
+            int symbol = decode(code_codes);
+            if (symbol < 16) {
+                lengths[i++] = symbol;
+                continue;
+            }
+            uint8_t value  = 0;
+            int     repeat = 0;
+            if (symbol == 16) {
+                if (i == 0) {
+                    error = true;
+                    return;
+                }
+                value  = lengths[i - 1];
+                repeat = 3 + bits(2);
+            } else if (symbol == 17) {
+                repeat = 3 + bits(3);
+            } else {
+                repeat = 11 + bits(7);
+            }
+            if (i + repeat > num_lengths + num_distances) {
+                error = true;
+                return;
+            }
+            while (repeat--) {
+                lengths[i++] = value;
+            }
+        }
+
+        PngHuffman length_codes, distance_codes;
+        length_codes.build(lengths, num_lengths);
+        distance_codes.build(lengths + num_lengths, num_distances);
+        codes(length_codes, distance_codes);
+    }
+
+    bool inflate(void) {
+        bool last = false;
+        while (!last && !error) {
+            last     = bits(1);
+            int type = bits(2);
+            if (type == 0) {
+                bit_buffer = 0;
+                bit_count  = 0;
+                if (pos + 4 > in.size()) {
+                    return false;
+                }
+                size_t length = in[pos] | (in[pos + 1] << 8);
+                pos += 4;
+                if (pos + length > in.size()) {
+                    return false;
+                }
+                out.insert(out.end(), in.begin() + pos, in.begin() + pos + length);
+                pos += length;
+            } else if (type == 1) {
+                fixed();
+            } else if (type == 2) {
+                dynamic();
+            } else {
+                error = true;
+            }
+        }
+        return !error;
+    }
+};
+
+inline std::vector<uint8_t> encode_png(uint16_t width, uint16_t height, const uint8_t *rgb888) {
+    // Each row is filtered against the pixel to its left
+    std::vector<uint8_t> filtered;
+    for (uint16_t y = 0; y < height; ++y) {
+        const uint8_t *row = &rgb888[(size_t)y * width * 3];
+        filtered.push_back(1);
+        for (size_t x = 0; x < (size_t)width * 3; ++x) {
+            filtered.push_back(row[x] - (x >= 3 ? row[x - 3] : 0));
+        }
+    }
+
+    std::vector<uint8_t> header;
+    png_append_u32(header, width);
+    png_append_u32(header, height);
+    header.insert(header.end(), {8, 2, 0, 0, 0}); // 8-bit RGB, not interlaced
+
+    std::vector<uint8_t> data = {0x78, 0x01};
+    std::vector<uint8_t> body = PngDeflater().deflate(filtered);
+    data.insert(data.end(), body.begin(), body.end());
+    png_append_u32(data, png_adler32(filtered));
+
+    std::vector<uint8_t> out = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png_append_chunk(out, "IHDR", header);
+    png_append_chunk(out, "IDAT", data);
+    png_append_chunk(out, "IEND", {});
+    return out;
+}
+
+// Decodes an 8-bit, non-interlaced RGB or RGBA PNG into RGB888, dropping any alpha
+inline bool decode_png(const std::vector<uint8_t> &png, uint16_t *width, uint16_t *height, std::vector<uint8_t> *rgb888) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (png.size() < 8 || memcmp(png.data(), signature, 8) != 0) {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t              channels = 0;
+    for (size_t pos = 8; pos + 12 <= png.size();) {
+        uint32_t       length = png_read_u32(&png[pos]);
+        const uint8_t *chunk  = &png[pos + 8];
+        if (pos + 12 + length > png.size()) {
+            return false;
+        }
+        if (memcmp(&png[pos + 4], "IHDR", 4) == 0) {
+            *width   = png_read_u32(chunk);
+            *height  = png_read_u32(chunk + 4);
+            channels = chunk[9] == 2 ? 3 : chunk[9] == 6 ? 4 : 0;
+            if (chunk[8] != 8 || channels == 0 || chunk[12] != 0) {
+                return false;
+            }
+        } else if (memcmp(&png[pos + 4], "IDAT", 4) == 0) {
+            data.insert(data.end(), chunk, chunk + length);
+        }
+        pos += 12 + length;
+    }
+
+    PngInflater inflater(data);
+    size_t      stride = (size_t)*width * channels;
+    if (channels == 0 || !inflater.inflate() || inflater.out.size() < (stride + 1) * *height) {
+        return false;
+    }
+
+    std::vector<uint8_t> previous(stride), row(stride);
+    rgb888->resize((size_t)*width * *height * 3);
+    for (uint16_t y = 0; y < *height; ++y) {
+        const uint8_t *line   = &inflater.out[y * (stride + 1)];
+        uint8_t        filter = line[0];
+        for (size_t x = 0; x < stride; ++x) {
+            int a = x >= channels ? row[x - channels] : 0, b = previous[x], c = x >= channels ? previous[x - channels] : 0;
+            int predicted = 0;
+            switch (filter) {
+                case 1:
+                    predicted = a;
+                    break;
+                case 2:
+                    predicted = b;
+                    break;
+                case 3:
+                    predicted = (a + b) / 2;
+                    break;
+                case 4: {
+                    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+                    predicted = (pa <= pb && pa <= pc) ? a : pb <= pc ? b : c;
+                    break;
+                }
+            }
+            row[x] = line[1 + x] + predicted;
+        }
+        for (uint16_t x = 0; x < *width; ++x) {
+            memcpy(&(*rgb888)[((size_t)y * *width + x) * 3], &row[x * channels], 3);
+        }
+        previous.swap(row);
+    }
+    return true;
+}
+
+inline bool read_file(const std::string &path, std::vector<uint8_t> *data) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buffer[4096];
+    size_t  count;
+    data->clear();
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return true;
+}
+
+inline bool write_file(const std::string &path, const std::vector<uint8_t> &data) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+} // namespace painter_test
@@ -0,0 +1,10 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = ili9341_spi surface
+
+SRC += tests/painter/test_painter_surface.cpp \
+	gpio_mock.c \
+	spi_master.c
@@ -0,0 +1,387 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+#include "qgf.h"
+#include "qff.h"
+}
+
+// Builds QGF images and QFF fonts in memory, and the sorts of pixels drawn with them
+namespace painter_test {
+
+inline std::vector<uint8_t> pack_pixels(const std::vector<uint8_t> &indices, uint8_t bpp) {
+    std::vector<uint8_t> packed((indices.size() * bpp + 7) / 8);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        packed[i * bpp / 8] |= indices[i] << ((i * bpp) % 8);
+    }
+    return packed;
+}
+
+// Matches compress_bytes_qmk_rle() in lib/python/qmk/painter.py
+inline std::vector<uint8_t> compress_rle(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    size_t               i = 0;
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && run < 127 && data[i + run] == data[i]) {
+            ++run;
+        }
+        if (run >= 2) {
+            out.push_back(run);
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        size_t literal = 0;
+        while (i + literal < data.size() && literal < 128 && (i + literal + 1 >= data.size() || data[i + literal + 1] != data[i + literal])) {
+            ++literal;
+        }
+        literal = literal ? literal : 1;
+        out.push_back(127 + literal);
+        out.insert(out.end(), data.begin() + i, data.begin() + i + literal);
+        i += literal;
+    }
+    return out;
+}
+
+// Matches compress_bytes_qmk_lz() in lib/python/qmk/painter.py
+inline std::vector<uint8_t> compress_lz(const std::vector<uint8_t> &data) {
+    const size_t window_size = 512, min_match = 3, max_match = 321, max_candidates = 64;
+
+    std::vector<uint8_t>                    out;
+    std::vector<uint8_t>                    literals;
+    std::map<uint32_t, std::vector<size_t>> chains; // positions of each 3-byte prefix seen so far, oldest first
+
+    auto prefix       = [&](size_t p) { return (uint32_t)data[p] | (data[p + 1] << 8) | (data[p + 2] << 16); };
+    auto add_position = [&](size_t p) {
+        if (p + min_match <= data.size()) {
+            chains[prefix(p)].push_back(p);
+        }
+    };
+    auto append_literals = [&]() {
+        for (size_t i = 0; i < literals.size(); i += 128) {
+            size_t count = std::min<size_t>(128, literals.size() - i);
+            out.push_back(count - 1);
+            out.insert(out.end(), literals.begin() + i, literals.begin() + i + count);
+        }
+        literals.clear();
+    };
+
+    size_t n = 0;
+    while (n < data.size()) {
+        // Find the longest match within the window, preferring the nearest
+        size_t best_length = 0, best_distance = 0;
+        if (n + min_match <= data.size()) {
+            size_t                     limit      = std::min(max_match, data.size() - n);
+            const std::vector<size_t> &candidates = chains[prefix(n)];
+            size_t                     first      = candidates.size() > max_candidates ? candidates.size() - max_candidates : 0;
+            for (size_t c = candidates.size(); c > first; --c) {
+                size_t p = candidates[c - 1];
+                if (n - p > window_size) {
+                    break;
+                }
+                size_t length = 0;
+                while (length < limit && data[p + length] == data[n + length]) {
+                    ++length;
+                }
+                if (length > best_length) {
+                    best_length   = length;
+                    best_distance = n - p;
+                    if (length == limit) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (best_length < min_match) {
+            literals.push_back(data[n]);
+            add_position(n++);
+            continue;
+        }
+
+        append_literals();
+        bool far = best_distance > 256;
+        out.push_back(0x80 | (far ? 0x40 : 0) | std::min<size_t>(best_length - min_match, 0x3F));
+        out.push_back(best_distance - (far ? 257 : 1));
+        if (best_length - min_match >= 0x3F) {
+            out.push_back(best_length - min_match - 0x3F);
+        }
+        for (size_t p = n; p < n + best_length; ++p) {
+            add_position(p);
+        }
+        n += best_length;
+    }
+
+    append_literals();
+    return out;
+}
+
+inline std::vector<uint8_t> compress(const std::vector<uint8_t> &data, painter_compression_t compression) {
+    switch (compression) {
+        case IMAGE_COMPRESSED_RLE:
+            return compress_rle(data);
+        case IMAGE_COMPRESSED_LZ:
+            return compress_lz(data);
+        default:
+            return data;
+    }
+}
+
+inline const char *compression_name(painter_compression_t compression) {
+    switch (compression) {
+        case IMAGE_COMPRESSED_RLE:
+            return "rle";
+        case IMAGE_COMPRESSED_LZ:
+            return "lz";
+        default:
+            return "raw";
+    }
+}
+
+template <typename T>
+inline void append_block(std::vector<uint8_t> &out, const T &block) {
+    const uint8_t *bytes = (const uint8_t *)&block;
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+inline void append_header(std::vector<uint8_t> &out, uint8_t type_id, uint32_t length) {
+    qgf_block_header_v1_t header = {};
+    header.type_id               = type_id;
+    header.neg_type_id           = ~type_id;
+    header.length                = length;
+    append_block(out, header);
+}
+
+// Area of the image a delta frame redraws, inclusive. Frames which aren't deltas redraw the whole image.
+struct FrameDelta {
+    bool     is_delta;
+    uint16_t left;
+    uint16_t top;
+    uint16_t right;
+    uint16_t bottom;
+};
+
+// Builds a QGF animation with a frame for each set of pixels, grayscale if the palette is empty. Frames listed as deltas
+// only hold the pixels of their area.
+inline std::vector<uint8_t> make_animated_qgf(uint16_t width, uint16_t height, uint8_t bpp, const std::vector<qp_pixel_t> &palette, const std::vector<std::vector<uint8_t>> &frames, uint16_t delay, painter_compression_t compression, const std::vector<FrameDelta> &deltas = {}) {
+    auto frame_delta = [&](size_t i) { return i < deltas.size() ? deltas[i] : FrameDelta{}; };
+    auto frame_size  = [&](size_t i, size_t data_size) { return sizeof(qgf_frame_v1_t) + (palette.empty() ? 0 : sizeof(qgf_palette_v1_t) + 3 * palette.size()) + (frame_delta(i).is_delta ? sizeof(qgf_delta_v1_t) : 0) + sizeof(qgf_data_v1_t) + data_size; };
+
+    std::vector<std::vector<uint8_t>> data;
+    uint32_t                          total = sizeof(qgf_graphics_descriptor_v1_t) + sizeof(qgf_frame_offsets_v1_t) + frames.size() * sizeof(uint32_t);
+    for (const std::vector<uint8_t> &indices : frames) {
+        data.push_back(compress(pack_pixels(indices, bpp), compression));
+        total += frame_size(data.size() - 1, data.back().size());
+    }
+
+    std::vector<uint8_t>         out;
+    qgf_graphics_descriptor_v1_t descriptor = {};
+    descriptor.header.type_id               = QGF_GRAPHICS_DESCRIPTOR_TYPEID;
+    descriptor.header.neg_type_id           = ~QGF_GRAPHICS_DESCRIPTOR_TYPEID;
+    descriptor.header.length                = sizeof(descriptor) - sizeof(qgf_block_header_v1_t);
+    descriptor.magic                        = QGF_MAGIC;
+    descriptor.qgf_version                  = 0x01;
+    descriptor.total_file_size              = total;
+    descriptor.neg_total_file_size          = ~total;
+    descriptor.image_width                  = width;
+    descriptor.image_height                 = height;
+    descriptor.frame_count                  = frames.size();
+    append_block(out, descriptor);
+
+    // Frames follow the offsets one after another
+    append_header(out, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, frames.size() * sizeof(uint32_t));
+    uint32_t offset = out.size() + frames.size() * sizeof(uint32_t);
+    for (size_t i = 0; i < data.size(); ++i) {
+        append_block(out, offset);
+        offset += frame_size(i, data[i].size());
+    }
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        FrameDelta     delta     = frame_delta(i);
+        qgf_frame_v1_t frame     = {};
+        frame.header.type_id     = QGF_FRAME_DESCRIPTOR_TYPEID;
+        frame.header.neg_type_id = ~QGF_FRAME_DESCRIPTOR_TYPEID;
+        frame.header.length      = sizeof(frame) - sizeof(qgf_block_header_v1_t);
+        frame.format             = (qp_image_format_t)((palette.empty() ? GRAYSCALE_1BPP : PALETTE_1BPP) + __builtin_ctz(bpp));
+        frame.flags              = delta.is_delta ? QGF_FRAME_FLAG_DELTA : 0;
+        frame.compression_scheme = compression;
+        frame.delay              = delay;
+        append_block(out, frame);
+
+        if (!palette.empty()) {
+            append_header(out, QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, 3 * palette.size());
+            for (const qp_pixel_t &entry : palette) {
+                out.insert(out.end(), {entry.hsv888.h, entry.hsv888.s, entry.hsv888.v});
+            }
+        }
+
+        if (delta.is_delta) {
+            qgf_delta_v1_t delta_descriptor     = {};
+            delta_descriptor.header.type_id     = QGF_FRAME_DELTA_DESCRIPTOR_TYPEID;
+            delta_descriptor.header.neg_type_id = ~QGF_FRAME_DELTA_DESCRIPTOR_TYPEID;
+            delta_descriptor.header.length      = sizeof(delta_descriptor) - sizeof(qgf_block_header_v1_t);
+            delta_descriptor.left               = delta.left;
+            delta_descriptor.top                = delta.top;
+            delta_descriptor.right              = delta.right;
+            delta_descriptor.bottom             = delta.bottom;
+            append_block(out, delta_descriptor);
+        }
+
+        append_header(out, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data[i].size());
+        out.insert(out.end(), data[i].begin(), data[i].end());
+    }
+    return out;
+}
+
+// Builds a single frame QGF image, grayscale if the palette is empty
+inline std::vector<uint8_t> make_qgf(uint16_t width, uint16_t height, uint8_t bpp, const std::vector<qp_pixel_t> &palette, const std::vector<uint8_t> &indices, painter_compression_t compression) {
+    return make_animated_qgf(width, height, bpp, palette, {indices}, 0, compression);
+}
+
+inline std::vector<uint8_t> make_qgf(uint16_t width, uint16_t height, uint8_t bpp, const std::vector<qp_pixel_t> &palette, const std::vector<uint8_t> &indices, bool rle) {
+    return make_qgf(width, height, bpp, palette, indices, rle ? IMAGE_COMPRESSED_RLE : IMAGE_UNCOMPRESSED);
+}
+
+// A glyph of a grayscale QFF font, with its pixels as palette indices
+struct Glyph {
+    uint32_t             code_point;
+    uint8_t              width;
+    std::vector<uint8_t> indices;
+};
+
+// Builds a grayscale QFF font, with an ascii table if the first 95 glyphs are 0x20..0x7E, and unicode glyphs after
+inline std::vector<uint8_t> make_qff(uint8_t line_height, uint8_t bpp, const std::vector<Glyph> &glyphs, bool rle) {
+    bool     has_ascii_table = glyphs.size() >= 95 && glyphs[0].code_point == 0x20 && glyphs[94].code_point == 0x7E;
+    uint16_t num_unicode     = glyphs.size() - (has_ascii_table ? 95 : 0);
+
+    // Each glyph is compressed separately, and found by its offset from the start of the data
+    std::vector<uint8_t>  data;
+    std::vector<uint32_t> values;
+    for (const Glyph &glyph : glyphs) {
+        std::vector<uint8_t> packed = pack_pixels(glyph.indices, bpp);
+        if (rle) {
+            packed = compress_rle(packed);
+        }
+        values.push_back(glyph.width | (data.size() << QFF_GLYPH_WIDTH_BITS));
+        data.insert(data.end(), packed.begin(), packed.end());
+    }
+
+    uint32_t total = sizeof(qff_font_descriptor_v1_t) + (has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) + (num_unicode > 0 ? sizeof(qgf_block_header_v1_t) + num_unicode * sizeof(qff_unicode_glyph_v1_t) : 0) + sizeof(qgf_block_header_v1_t) + data.size();
+
+    std::vector<uint8_t>     out;
+    qff_font_descriptor_v1_t descriptor = {};
+    descriptor.header.type_id           = QFF_FONT_DESCRIPTOR_TYPEID;
+    descriptor.header.neg_type_id       = ~QFF_FONT_DESCRIPTOR_TYPEID;
+    descriptor.header.length            = sizeof(descriptor) - sizeof(qgf_block_header_v1_t);
+    descriptor.magic                    = QFF_MAGIC;
+    descriptor.qff_version              = 0x01;
+    descriptor.total_file_size          = total;
+    descriptor.neg_total_file_size      = ~total;
+    descriptor.line_height              = line_height;
+    descriptor.has_ascii_table          = has_ascii_table;
+    descriptor.num_unicode_glyphs       = num_unicode;
+    descriptor.format                   = (qp_image_format_t)(GRAYSCALE_1BPP + __builtin_ctz(bpp));
+    descriptor.compression_scheme       = rle ? IMAGE_COMPRESSED_RLE : IMAGE_UNCOMPRESSED;
+    append_block(out, descriptor);
+
+    size_t glyph = 0;
+    if (has_ascii_table) {
+        append_header(out, QFF_ASCII_GLYPH_DESCRIPTOR_TYPEID, 95 * sizeof(qff_ascii_glyph_v1_t));
+        for (; glyph < 95; ++glyph) {
+            qff_ascii_glyph_v1_t info = {};
+            info.value                = values[glyph];
+            append_block(out, info);
+        }
+    }
+    if (num_unicode > 0) {
+        append_header(out, QFF_UNICODE_GLYPH_DESCRIPTOR_TYPEID, num_unicode * sizeof(qff_unicode_glyph_v1_t));
+        for (; glyph < glyphs.size(); ++glyph) {
+            qff_unicode_glyph_v1_t info = {};
+            info.code_point             = glyphs[glyph].code_point;
+            info.value                  = values[glyph];
+            append_block(out, info);
+        }
+    }
+
+    append_header(out, QFF_FONT_DATA_DESCRIPTOR_TYPEID, data.size());
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+inline std::vector<qp_pixel_t> make_palette(uint8_t bpp) {
+    std::vector<qp_pixel_t> palette(1 << bpp);
+    for (size_t i = 0; i < palette.size(); ++i) {
+        palette[i].hsv888.h = i * 37;
+        palette[i].hsv888.s = 255 - i * 11;
+        palette[i].hsv888.v = i % 2 ? 255 : 128 + i;
+    }
+    return palette;
+}
+
+// Flat backgrounds and panels with some text-like noise, the sort of thing drawn as a full-screen background
+inline std::vector<uint8_t> make_ui_indices(uint16_t width, uint16_t height, uint8_t bpp, uint32_t seed) {
+    std::vector<uint8_t> indices(width * height);
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            uint8_t index = (y / 40 + x / 80) % (1 << bpp);
+            if (y % 40 > 30 && x % 80 < 60) {
+                seed  = seed * 1103515245 + 12345;
+                index = (seed >> 16) % (1 << bpp);
+            }
+            indices[y * width + x] = index;
+        }
+    }
+    return indices;
+}
+
+inline std::vector<uint8_t> make_noise_indices(uint32_t count, uint8_t bpp, uint32_t seed) {
+    std::vector<uint8_t> indices(count);
+    for (uint8_t &index : indices) {
+        seed  = seed * 1103515245 + 12345;
+        index = (seed >> 16) % (1 << bpp);
+    }
+    return indices;
+}
+
+// A gradient with ordered dithering, which byte RLE barely compresses
+inline std::vector<uint8_t> make_dithered_indices(uint16_t width, uint16_t height, uint8_t bpp) {
+    static const uint8_t bayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    std::vector<uint8_t> indices(width * height);
+    uint8_t              levels = (1 << bpp) - 1;
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            uint32_t value         = (x + y) * 16 * levels / (width + height); // 16ths of a level
+            indices[y * width + x] = QP_MIN(levels, value / 16 + ((value % 16) > bayer[y % 4][x % 4] ? 1 : 0));
+        }
+    }
+    return indices;
+}
+
+// Filled circles on a flat background, with anti-aliased edges
+inline std::vector<uint8_t> make_antialiased_indices(uint16_t width, uint16_t height, uint8_t bpp) {
+    std::vector<uint8_t> indices(width * height);
+    uint8_t              levels = (1 << bpp) - 1;
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            // Distance from the centre of the nearest circle, on a 64 pixel grid, in 16ths of a pixel
+            int32_t dx       = (x % 64) * 16 + 8 - 32 * 16;
+            int32_t dy       = (y % 64) * 16 + 8 - 32 * 16;
+            int32_t distance = (int32_t)std::sqrt((double)(dx * dx + dy * dy));
+            int32_t coverage       = QP_MIN(16, QP_MAX(0, 24 * 16 + 8 - distance)); // radius 24
+            indices[y * width + x] = coverage * levels / 16;
+        }
+    }
+    return indices;
+}
+
+} // namespace painter_test
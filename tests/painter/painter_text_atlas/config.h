@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_FONT_ATLASES 4
+#define QUANTUM_PAINTER_FONT_ATLAS_SIZE 57344
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_FONT_GLYPH_INDEX 1
+#define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 8192
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 48
@@ -0,0 +1,312 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "test_common.hpp"
+#include "painter_test_helpers.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_test_display.h"
+
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+using namespace painter_test;
+
+// Two 128x64 displays, each showing a grid of animated 12x12 icons
+#define PANEL_WIDTH 128
+#define PANEL_HEIGHT 64
+#define ICON_SIZE 12
+#define ICON_FRAMES 4
+#define ICON_DELAY 40
+
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX && QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+#    define ANIMATION_MODE "indexed"
+#else
+#    define ANIMATION_MODE "plain"
+#endif
+
+namespace {
+
+uint8_t          framebuffers[2][QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(PANEL_WIDTH, PANEL_HEIGHT)];
+painter_device_t displays[2];
+
+// A dot circling the icon, one frame for each corner
+std::vector<std::vector<uint8_t>> make_spinner_frames(uint16_t size, uint8_t frames) {
+    std::vector<std::vector<uint8_t>> out(frames, std::vector<uint8_t>(size * size));
+    for (uint8_t frame = 0; frame < frames; ++frame) {
+        uint16_t dot_x = (frame == 1 || frame == 2) ? size / 2 : 0;
+        uint16_t dot_y = (frame >= 2) ? size / 2 : 0;
+        for (uint16_t y = 0; y < size; ++y) {
+            for (uint16_t x = 0; x < size; ++x) {
+                bool dot                 = x >= dot_x && x < dot_x + size / 2 && y >= dot_y && y < dot_y + size / 2;
+                out[frame][y * size + x] = dot ? 3 : ((x + y) % 4 == 0 ? 1 : 0);
+            }
+        }
+    }
+    return out;
+}
+
+// Where the n-th icon on a display goes, filling rows of 10
+uint16_t icon_x(int n) {
+    return (n % 10) * ICON_SIZE;
+}
+
+uint16_t icon_y(int n) {
+    return (n / 10) * ICON_SIZE;
+}
+
+// Copies the pixels of an icon out of the framebuffer
+std::vector<uint8_t> capture(int display, uint16_t x, uint16_t y) {
+    std::vector<uint8_t> out;
+    for (uint16_t row = 0; row < ICON_SIZE; ++row) {
+        const uint8_t *start = &framebuffers[display][((y + row) * PANEL_WIDTH + x) * 3];
+        out.insert(out.end(), start, start + ICON_SIZE * 3);
+    }
+    return out;
+}
+
+} // namespace
+
+class PainterAnimation : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        for (int i = 0; i < 2; ++i) {
+            displays[i] = qp_test_display_make_device(PANEL_WIDTH, PANEL_HEIGHT, framebuffers[i]);
+        }
+    }
+
+    void SetUp() override {
+        for (painter_device_t display : displays) {
+            ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+        }
+    }
+
+    void TearDown() override {
+        for (deferred_token token : tokens) {
+            qp_stop_animation(token);
+        }
+        for (painter_image_handle_t image : images) {
+            qp_close_image(image);
+        }
+    }
+
+    painter_image_handle_t load(const std::vector<uint8_t> &qgf) {
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        images.push_back(image);
+        return image;
+    }
+
+    deferred_token animate(int display, uint16_t x, uint16_t y, painter_image_handle_t image) {
+        deferred_token token = qp_animate(displays[display], x, y, image);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void tick(uint32_t ms) {
+        advance_time(ms);
+        qp_internal_animation_tick();
+    }
+
+    void reset_stats(void) {
+        for (painter_device_t display : displays) {
+            qp_test_display_reset_stats(display);
+        }
+    }
+
+    std::vector<painter_image_handle_t> images;
+    std::vector<deferred_token>         tokens;
+};
+
+TEST_F(PainterAnimation, DueFramesShareOneSessionPerDisplay) {
+    std::vector<uint8_t>   spinner = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY, IMAGE_COMPRESSED_RLE);
+    std::vector<uint8_t>   slow    = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY * 2, IMAGE_COMPRESSED_RLE);
+    painter_image_handle_t image   = load(spinner);
+    painter_image_handle_t image2  = load(slow);
+    ASSERT_NE(image, nullptr);
+    ASSERT_NE(image2, nullptr);
+
+    // Twenty on the first display and eight on the second share an image, the last two on the second are slower
+    for (int n = 0; n < 20; ++n) {
+        ASSERT_NE(animate(0, icon_x(n), icon_y(n), image), INVALID_DEFERRED_TOKEN);
+    }
+    for (int n = 0; n < 10; ++n) {
+        ASSERT_NE(animate(1, icon_x(n), icon_y(n), n < 8 ? image : image2), INVALID_DEFERRED_TOKEN);
+    }
+
+    // Each animation's token is its own
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        for (size_t j = i + 1; j < tokens.size(); ++j) {
+            EXPECT_NE(tokens[i], tokens[j]);
+        }
+    }
+
+    std::vector<uint8_t> first = capture(0, icon_x(0), icon_y(0));
+    reset_stats();
+    tick(ICON_DELAY);
+
+    const qp_test_display_stats_t *stats0 = qp_test_display_get_stats(displays[0]);
+    const qp_test_display_stats_t *stats1 = qp_test_display_get_stats(displays[1]);
+    EXPECT_EQ(stats0->sessions, 1);
+    EXPECT_EQ(stats0->viewports, 20);
+    EXPECT_EQ(stats0->pixels, 20 * ICON_SIZE * ICON_SIZE);
+    EXPECT_EQ(stats1->sessions, 1);
+    EXPECT_EQ(stats1->viewports, 8);
+
+    // Every icon moved on to the same frame
+    std::vector<uint8_t> second = capture(0, icon_x(0), icon_y(0));
+    EXPECT_NE(first, second);
+    for (int n = 1; n < 20; ++n) {
+        EXPECT_EQ(capture(0, icon_x(n), icon_y(n)), second) << "icon " << n;
+    }
+    EXPECT_EQ(capture(1, icon_x(7), icon_y(7)), second);
+    EXPECT_EQ(capture(1, icon_x(8), icon_y(8)), first);
+
+    // Nothing is sent until the next frames are due, then the slower ones join in
+    reset_stats();
+    tick(ICON_DELAY / 2);
+    EXPECT_EQ(stats0->sessions, 0);
+    EXPECT_EQ(stats1->sessions, 0);
+    tick(ICON_DELAY / 2);
+    EXPECT_EQ(stats0->viewports, 20);
+    EXPECT_EQ(stats1->sessions, 1);
+    EXPECT_EQ(stats1->viewports, 10);
+    EXPECT_EQ(capture(1, icon_x(9), icon_y(9)), second);
+}
+
+TEST_F(PainterAnimation, DeltaFramesSendOnlyTheirArea) {
+    // The dot moves between corners, so the later frames only redraw the quarters it left and entered
+    std::vector<std::vector<uint8_t>> frames = make_spinner_frames(ICON_SIZE, 2);
+    const uint16_t                    half   = ICON_SIZE / 2;
+    std::vector<uint8_t>              delta(frames[1].begin(), frames[1].begin() + ICON_SIZE * half);
+    std::vector<uint8_t>              qgf   = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), {frames[0], delta}, ICON_DELAY, IMAGE_COMPRESSED_RLE, {{}, {true, 0, 0, ICON_SIZE - 1, half - 1}});
+    painter_image_handle_t            image = load(qgf);
+    ASSERT_NE(image, nullptr);
+
+    ASSERT_NE(animate(0, 20, 10, image), INVALID_DEFERRED_TOKEN);
+    reset_stats();
+    tick(ICON_DELAY);
+
+    const qp_test_display_stats_t    *stats     = qp_test_display_get_stats(displays[0]);
+    uint32_t                          count     = 0;
+    const qp_test_display_viewport_t *viewports = qp_test_display_get_viewports(displays[0], &count);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(viewports[0].left, 20);
+    EXPECT_EQ(viewports[0].top, 10);
+    EXPECT_EQ(viewports[0].right, 20 + ICON_SIZE - 1);
+    EXPECT_EQ(viewports[0].bottom, 10 + half - 1);
+    EXPECT_EQ(stats->pixels, ICON_SIZE * half);
+    EXPECT_EQ(stats->bytes, QP_TEST_DISPLAY_VIEWPORT_BYTES + ICON_SIZE * half * 3);
+
+    // The full frame is drawn again once the animation loops
+    reset_stats();
+    tick(ICON_DELAY);
+    EXPECT_EQ(stats->pixels, ICON_SIZE * ICON_SIZE);
+}
+
+TEST_F(PainterAnimation, SharedPalettesAreConvertedOnce) {
+    std::vector<uint8_t>   palette   = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY, IMAGE_COMPRESSED_RLE);
+    std::vector<uint8_t>   grayscale = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, {}, make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY, IMAGE_COMPRESSED_RLE);
+    painter_image_handle_t image     = load(palette);
+    painter_image_handle_t image2    = load(grayscale);
+    ASSERT_NE(image, nullptr);
+    ASSERT_NE(image2, nullptr);
+
+    for (int n = 0; n < 2; ++n) {
+        ASSERT_NE(animate(0, icon_x(n), icon_y(n), image), INVALID_DEFERRED_TOKEN);
+        ASSERT_NE(animate(0, icon_x(n + 10), icon_y(n + 10), image2), INVALID_DEFERRED_TOKEN);
+    }
+
+    // Every frame repeats the same palette, and the grayscale frames are all recolored the same way
+    reset_stats();
+    for (int frame = 0; frame < ICON_FRAMES; ++frame) {
+        tick(ICON_DELAY);
+    }
+    const qp_test_display_stats_t *stats = qp_test_display_get_stats(displays[0]);
+    EXPECT_EQ(stats->viewports, 4 * ICON_FRAMES);
+#if QUANTUM_PAINTER_ANIMATION_FRAME_INDEX && QUANTUM_PAINTER_ANIMATION_PALETTE_CACHE_SIZE > 0
+    EXPECT_EQ(stats->converted, 0);
+#else
+    EXPECT_EQ(stats->converted, 4 * ICON_FRAMES * 4);
+#endif
+
+    // A different display needs its own conversion
+    ASSERT_NE(animate(1, 0, 0, image), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(qp_test_display_get_stats(displays[1])->converted, 4);
+}
+
+TEST_F(PainterAnimation, StoppedAndClosedAnimationsFreeTheirSlots) {
+    std::vector<uint8_t>   spinner = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY, IMAGE_COMPRESSED_RLE);
+    std::vector<uint8_t>   still   = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, 1), 0, IMAGE_COMPRESSED_RLE);
+    painter_image_handle_t image   = load(spinner);
+    ASSERT_NE(image, nullptr);
+
+    // An image without a delay is drawn once, without holding on to a slot
+    painter_image_handle_t image2 = qp_load_image_mem(still.data());
+    ASSERT_NE(image2, nullptr);
+    EXPECT_EQ(qp_animate(displays[0], 0, 0, image2), INVALID_DEFERRED_TOKEN);
+    qp_close_image(image2);
+
+    for (int n = 0; n < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++n) {
+        ASSERT_NE(animate(n % 2, icon_x(n / 2), icon_y(n / 2), image), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(animate(0, 0, 0, image), INVALID_DEFERRED_TOKEN);
+
+    // Stopped animations aren't drawn again
+    qp_stop_animation(tokens[0]);
+    qp_stop_animation(tokens[1]);
+    reset_stats();
+    tick(ICON_DELAY);
+    EXPECT_EQ(qp_test_display_get_stats(displays[0])->viewports, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS / 2 - 1);
+    EXPECT_EQ(qp_test_display_get_stats(displays[1])->viewports, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS / 2 - 1);
+
+    // Those playing a closed image stop at their next frame
+    qp_close_image(image);
+    images.clear();
+    reset_stats();
+    tick(ICON_DELAY);
+    EXPECT_EQ(qp_test_display_get_stats(displays[0])->viewports, 0);
+
+    image = load(spinner);
+    ASSERT_NE(image, nullptr);
+    tokens.clear();
+    for (int n = 0; n < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++n) {
+        ASSERT_NE(animate(0, icon_x(n % 50), icon_y(n % 50), image), INVALID_DEFERRED_TOKEN);
+    }
+}
+
+TEST_F(PainterAnimation, FrameCosts) {
+    std::vector<uint8_t>   spinner = make_animated_qgf(ICON_SIZE, ICON_SIZE, 2, make_palette(2), make_spinner_frames(ICON_SIZE, ICON_FRAMES), ICON_DELAY, IMAGE_COMPRESSED_RLE);
+    painter_image_handle_t image   = load(spinner);
+    ASSERT_NE(image, nullptr);
+
+    const int ticks = 200;
+    printf("%-10s %-12s %10s %10s %10s %10s\n", "animate", "mode", "icons", "us/frame", "bytes", "converted");
+    for (int icons : {1, 8, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS}) {
+        for (int n = 0; n < icons; ++n) {
+            ASSERT_NE(animate(0, icon_x(n % 50), icon_y(n % 50), image), INVALID_DEFERRED_TOKEN);
+        }
+
+        reset_stats();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) {
+            tick(ICON_DELAY);
+        }
+        double                         us    = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (ticks * icons);
+        const qp_test_display_stats_t *stats = qp_test_display_get_stats(displays[0]);
+        EXPECT_EQ(stats->sessions, ticks);
+        EXPECT_EQ(stats->viewports, ticks * icons);
+        printf("%-10s %-12s %10d %10.2f %10u %10u\n", "animate", ANIMATION_MODE, icons, us, stats->bytes / (ticks * icons), stats->converted / (ticks * icons));
+
+        for (deferred_token token : tokens) {
+            qp_stop_animation(token);
+        }
+        tokens.clear();
+    }
+}
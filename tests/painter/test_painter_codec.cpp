@@ -0,0 +1,301 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "painter_test_helpers.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_draw.h"
+#include "qp_surface_internal.h"
+}
+
+// A 320x240 panel, as driven by an ILI9341
+#define PANEL_WIDTH 320
+#define PANEL_HEIGHT 240
+#define PANEL_SPI_HZ 40000000
+
+using namespace painter_test;
+
+namespace {
+
+// The compression schemes which can be drawn with this configuration
+const std::vector<painter_compression_t> compressions = {
+    IMAGE_UNCOMPRESSED,
+    IMAGE_COMPRESSED_RLE,
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+    IMAGE_COMPRESSED_LZ,
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+};
+
+// Counts the calls made into the driver while decoding
+uint32_t append_pixels_calls;
+uint32_t append_pixel_run_calls;
+
+painter_driver_append_pixels    real_append_pixels;
+painter_driver_append_pixel_run real_append_pixel_run;
+
+bool counting_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    append_pixels_calls++;
+    return real_append_pixels(device, target_buffer, palette, pixel_offset, pixel_count, palette_indices);
+}
+
+bool counting_append_pixel_run(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    append_pixel_run_calls++;
+    return real_append_pixel_run(device, target_buffer, palette, pixel_offset, pixel_count, palette_index);
+}
+
+} // namespace
+
+class PainterCodec : public ::testing::Test {
+   protected:
+    static surface_painter_device_t rgb565_devices[2];
+    static surface_painter_device_t mono1bpp_devices[2];
+    static uint8_t                  rgb565_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+    static uint8_t                  mono1bpp_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 1)];
+    static painter_device_t         rgb565[2];
+    static painter_device_t         mono1bpp[2];
+
+    static void SetUpTestSuite() {
+        for (int i = 0; i < 2; ++i) {
+            rgb565[i]   = qp_make_rgb565_surface_advanced(&rgb565_devices[i], 1, PANEL_WIDTH, PANEL_HEIGHT, rgb565_buffers[i]);
+            mono1bpp[i] = qp_make_mono1bpp_surface_advanced(&mono1bpp_devices[i], 1, PANEL_WIDTH, PANEL_HEIGHT, mono1bpp_buffers[i]);
+        }
+    }
+
+    void SetUp() override {
+        for (int i = 0; i < 2; ++i) {
+            ASSERT_TRUE(qp_init(rgb565[i], QP_ROTATION_0));
+            ASSERT_TRUE(qp_init(mono1bpp[i], QP_ROTATION_0));
+        }
+    }
+
+    // Draws the image on the first device, and the same pixels one at a time on the second
+    void draw_and_compare(painter_device_t *devices, const uint8_t *buffer0, const uint8_t *buffer1, size_t buffer_size, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t bpp, painter_compression_t compression, const std::vector<uint8_t> &indices) {
+        std::vector<qp_pixel_t> palette = make_palette(bpp);
+        std::vector<uint8_t>    qgf     = make_qgf(width, height, bpp, palette, indices, compression);
+        painter_image_handle_t  image   = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+        EXPECT_TRUE(qp_drawimage(devices[0], x, y, image));
+        qp_close_image(image);
+
+        for (uint16_t py = 0; py < height; ++py) {
+            for (uint16_t px = 0; px < width; ++px) {
+                qp_pixel_t entry = palette[indices[py * width + px]];
+                qp_setpixel(devices[1], x + px, y + py, entry.hsv888.h, entry.hsv888.s, entry.hsv888.v);
+            }
+        }
+        EXPECT_EQ(memcmp(buffer0, buffer1, buffer_size), 0) << (int)bpp << "bpp " << width << "x" << height << " " << compression_name(compression);
+    }
+
+    void draw_and_compare_rgb565(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t bpp, painter_compression_t compression, const std::vector<uint8_t> &indices) {
+        draw_and_compare(rgb565, rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0]), x, y, width, height, bpp, compression, indices);
+    }
+
+    void draw_and_compare_mono1bpp(uint16_t x, uint16_t y, uint16_t width, uint16_t height, painter_compression_t compression, const std::vector<uint8_t> &indices) {
+        draw_and_compare(mono1bpp, mono1bpp_buffers[0], mono1bpp_buffers[1], sizeof(mono1bpp_buffers[0]), x, y, width, height, 1, compression, indices);
+    }
+
+    // Swaps in a copy of the device's vtable which counts the calls made to append pixels
+    const painter_driver_vtable_t *count_driver_calls(painter_device_t device, surface_painter_driver_vtable_t *counting_vtable) {
+        painter_driver_t *             driver   = (painter_driver_t *)device;
+        const painter_driver_vtable_t *original = driver->driver_vtable;
+        memcpy(counting_vtable, original, sizeof(*counting_vtable));
+        real_append_pixels                     = original->append_pixels;
+        real_append_pixel_run                  = original->append_pixel_run;
+        counting_vtable->base.append_pixels    = counting_append_pixels;
+        counting_vtable->base.append_pixel_run = real_append_pixel_run ? counting_append_pixel_run : NULL;
+        driver->driver_vtable                  = &counting_vtable->base;
+        append_pixels_calls                    = 0;
+        append_pixel_run_calls                 = 0;
+        return original;
+    }
+};
+
+surface_painter_device_t PainterCodec::rgb565_devices[2];
+surface_painter_device_t PainterCodec::mono1bpp_devices[2];
+uint8_t                  PainterCodec::rgb565_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+uint8_t                  PainterCodec::mono1bpp_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 1)];
+painter_device_t         PainterCodec::rgb565[2];
+painter_device_t         PainterCodec::mono1bpp[2];
+
+TEST_F(PainterCodec, PaletteImagesMatchPerPixelDrawing) {
+    for (uint8_t bpp : {1, 2, 4}) {
+        for (painter_compression_t compression : compressions) {
+            SCOPED_TRACE(testing::Message() << (int)bpp << "bpp " << compression_name(compression));
+            draw_and_compare_rgb565(0, 0, PANEL_WIDTH, PANEL_HEIGHT, bpp, compression, make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, bpp, bpp));
+            draw_and_compare_rgb565(0, 0, PANEL_WIDTH, PANEL_HEIGHT, bpp, compression, make_dithered_indices(PANEL_WIDTH, PANEL_HEIGHT, bpp));
+            // Odd sizes, so that rows don't end on a byte boundary
+            draw_and_compare_rgb565(17, 9, 37, 23, bpp, compression, make_noise_indices(37 * 23, bpp, 42 + bpp));
+            draw_and_compare_rgb565(101, 77, 53, 31, bpp, compression, make_ui_indices(53, 31, bpp, bpp));
+        }
+    }
+}
+
+TEST_F(PainterCodec, MonoRunsFillPartialBytes) {
+    for (painter_compression_t compression : compressions) {
+        // Runs which start and end part way through a byte of the framebuffer
+        draw_and_compare_mono1bpp(3, 5, 77, 19, compression, make_ui_indices(77, 19, 1, 7));
+        std::vector<uint8_t> stripes(61 * 13);
+        for (size_t i = 0; i < stripes.size(); ++i) {
+            stripes[i] = (i / 29) % 2;
+        }
+        draw_and_compare_mono1bpp(5, 40, 61, 13, compression, stripes);
+    }
+}
+
+TEST_F(PainterCodec, RunsAreFilledInOneCall) {
+    for (painter_compression_t compression : compressions) {
+        if (compression == IMAGE_UNCOMPRESSED) {
+            continue;
+        }
+        surface_painter_driver_vtable_t counting_vtable;
+        std::vector<uint8_t>            indices = make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, 4, 1);
+        std::vector<uint8_t>            qgf     = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), indices, compression);
+        painter_image_handle_t          image   = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+
+        const painter_driver_vtable_t *original = count_driver_calls(rgb565[0], &counting_vtable);
+        EXPECT_TRUE(qp_drawimage(rgb565[0], 0, 0, image));
+        ((painter_driver_t *)rgb565[0])->driver_vtable = original;
+        qp_close_image(image);
+
+        uint32_t calls = append_pixels_calls + append_pixel_run_calls;
+        printf("%-10s ui %-9s %10u %10u\n", "calls", compression_name(compression), append_pixels_calls, append_pixel_run_calls);
+        EXPECT_GT(append_pixel_run_calls, 0u);
+        EXPECT_LT(calls * 16, (uint32_t)PANEL_WIDTH * PANEL_HEIGHT);
+    }
+}
+
+/**
+ * Reports the time taken to draw a full-screen palette image onto an RGB565 surface, against decoding it a pixel at a
+ * time through qp_internal_pixel_appender(), and the time the same pixels take to cross the SPI bus.
+ */
+TEST_F(PainterCodec, FullScreenBlitTime) {
+    const int iterations = 20;
+    double    spi_ms     = (double)PANEL_WIDTH * PANEL_HEIGHT * 16 * 1000 / PANEL_SPI_HZ;
+
+    for (bool rle : {false, true}) {
+        std::vector<uint8_t>   indices = rle ? make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, 4, 3) : make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, 4, 3);
+        std::vector<uint8_t>   qgf     = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), indices, rle);
+        painter_image_handle_t image   = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            ASSERT_TRUE(qp_drawimage(rgb565[0], 0, 0, image));
+        }
+        double span_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        // The palette is left converted by the draw above, so only the pixel data needs decoding
+        std::vector<uint8_t> data = pack_pixels(indices, 4);
+        if (rle) {
+            data = compress_rle(data);
+        }
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            qp_memory_stream_t               stream       = qp_make_memory_stream(data.data(), data.size());
+            qp_internal_byte_input_state_t   input_state  = {.device = rgb565[1], .src_stream = &stream.base};
+            qp_internal_byte_input_callback  input        = qp_internal_prepare_input_state(&input_state, rle ? IMAGE_COMPRESSED_RLE : IMAGE_UNCOMPRESSED);
+            qp_internal_pixel_output_state_t output_state = {.device = rgb565[1], .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(rgb565[1])};
+            ASSERT_TRUE(qp_viewport(rgb565[1], 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1));
+            ASSERT_TRUE(qp_internal_decode_palette(rgb565[1], PANEL_WIDTH * PANEL_HEIGHT, 4, input, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state));
+            if (output_state.pixel_write_pos > 0) {
+                ASSERT_TRUE(qp_pixdata(rgb565[1], qp_internal_global_pixdata_buffer, output_state.pixel_write_pos));
+            }
+        }
+        double pixel_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+        qp_close_image(image);
+
+        printf("%-10s %-12s %10.3f %10.3f %10.3f\n", "blit", rle ? "ui rle" : "noise", span_ms, pixel_ms, spi_ms);
+        EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+    }
+}
+
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+TEST_F(PainterCodec, LzMatchesPythonEncoder) {
+    // Generated by compress_bytes_qmk_lz() in lib/python/qmk/painter.py, see lib/python/qmk/tests/test_qmk_painter.py
+    std::vector<uint8_t> ramp;
+    for (int i = 0; i < 20; ++i) {
+        ramp.push_back(i);
+    }
+    std::vector<uint8_t> input = ramp;
+    input.insert(input.end(), 400, 0xAA);
+    input.insert(input.end(), ramp.begin(), ramp.end());
+    for (int i = 0; i < 5; ++i) {
+        input.insert(input.end(), {1, 2, 3, 4});
+    }
+    const std::vector<uint8_t> expected = {
+        0x14, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x10, 0x11, 0x12, 0x13, 0xAA, 0xBF, 0x00, 0xFF, 0xBF, 0x00, 0x0C, 0xD1, 0xA3, 0x81, 0x12, 0x8D, 0x03,
+    };
+    EXPECT_EQ(compress_lz(input), expected);
+
+    qp_memory_stream_t              stream      = qp_make_memory_stream((void *)expected.data(), expected.size());
+    qp_internal_byte_input_state_t  input_state = {.device = rgb565[0], .src_stream = &stream.base};
+    qp_internal_byte_input_callback decode      = qp_internal_prepare_input_state(&input_state, IMAGE_COMPRESSED_LZ);
+    std::vector<uint8_t>            decoded;
+    for (int16_t c = decode(&input_state); c >= 0; c = decode(&input_state)) {
+        decoded.push_back(c);
+    }
+    EXPECT_EQ(decoded, input);
+}
+
+/**
+ * Reports the compressed size of a corpus of full-screen palette images with each codec, and the time taken to draw the
+ * RLE and LZ versions onto an RGB565 surface.
+ */
+TEST_F(PainterCodec, CorpusSizeAndDrawTime) {
+    const int iterations = 20;
+    uint32_t  rle_total  = 0;
+    uint32_t  lz_total   = 0;
+
+    printf("%-10s %-12s %10s %10s %10s %10s %10s\n", "corpus", "image", "raw", "rle", "lz", "rle ms", "lz ms");
+    for (uint8_t bpp : {1, 2, 4}) {
+        struct {
+            const char          *name;
+            std::vector<uint8_t> indices;
+        } corpus[] = {
+            {"ui", make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, bpp, 5)},
+            {"dithered", make_dithered_indices(PANEL_WIDTH, PANEL_HEIGHT, bpp)},
+            {"antialiased", make_antialiased_indices(PANEL_WIDTH, PANEL_HEIGHT, bpp)},
+            {"noise", make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, bpp, 5)},
+        };
+        for (auto &entry : corpus) {
+            std::vector<uint8_t> raw = pack_pixels(entry.indices, bpp);
+            size_t               sizes[3];
+            double               draw_ms[3] = {0};
+            for (painter_compression_t compression : compressions) {
+                sizes[compression] = compress(raw, compression).size();
+                if (compression == IMAGE_UNCOMPRESSED) {
+                    continue;
+                }
+
+                std::vector<uint8_t>   qgf   = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, bpp, make_palette(bpp), entry.indices, compression);
+                painter_image_handle_t image = qp_load_image_mem(qgf.data());
+                ASSERT_NE(image, nullptr);
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < iterations; ++i) {
+                    ASSERT_TRUE(qp_drawimage(rgb565[compression - 1], 0, 0, image));
+                }
+                draw_ms[compression] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+                qp_close_image(image);
+            }
+            EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0) << entry.name << " " << (int)bpp << "bpp";
+
+            char image_name[16];
+            snprintf(image_name, sizeof(image_name), "%s/%d", entry.name, (int)bpp);
+            printf("%-10s %-12s %10zu %10zu %10zu %10.3f %10.3f\n", "corpus", image_name, sizes[IMAGE_UNCOMPRESSED], sizes[IMAGE_COMPRESSED_RLE], sizes[IMAGE_COMPRESSED_LZ], draw_ms[IMAGE_COMPRESSED_RLE], draw_ms[IMAGE_COMPRESSED_LZ]);
+            rle_total += QP_MIN(sizes[IMAGE_UNCOMPRESSED], sizes[IMAGE_COMPRESSED_RLE]);
+            lz_total += QP_MIN(sizes[IMAGE_UNCOMPRESSED], sizes[IMAGE_COMPRESSED_LZ]);
+            EXPECT_LE(sizes[IMAGE_COMPRESSED_LZ], sizes[IMAGE_COMPRESSED_RLE]) << image_name;
+        }
+    }
+    printf("%-10s %-12s %10s %10u %10u\n", "corpus", "total", "", rle_total, lz_total);
+    EXPECT_LT(lz_total * 4, rle_total * 3);
+}
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
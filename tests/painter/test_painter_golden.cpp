@@ -0,0 +1,353 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include "test_common.hpp"
+#include "painter_test_helpers.hpp"
+#include "painter_png.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_test_display.h"
+
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+using namespace painter_test;
+
+// A 96x64 display, drawn at 24bpp so that nothing is lost to the panel format
+#define PANEL_WIDTH 96
+#define PANEL_HEIGHT 64
+#define LINE_HEIGHT 10
+
+// Relative to the root of the repository, which is where the tests are run from
+#define GOLDEN_DIR "tests/painter/golden/"
+#define ACTUAL_DIR ".build/test/"
+
+namespace {
+
+uint8_t          framebuffer[QP_TEST_DISPLAY_FRAMEBUFFER_SIZE(PANEL_WIDTH, PANEL_HEIGHT)];
+painter_device_t display;
+
+// Glyphs showing the bits of their code point, so that every character looks different
+std::vector<Glyph> make_bit_glyphs(void) {
+    std::vector<Glyph> glyphs;
+    for (uint32_t code_point = 0x20; code_point <= 0x7E; ++code_point) {
+        Glyph glyph;
+        glyph.code_point = code_point;
+        glyph.width      = 6;
+        glyph.indices.resize(glyph.width * LINE_HEIGHT);
+        for (uint8_t bit = 0; bit < 7; ++bit) {
+            for (uint8_t x = 1; x < 5; ++x) {
+                glyph.indices[(bit + 1) * glyph.width + x] = (code_point >> bit) & 1 ? 3 : (x == 1 || x == 4 ? 1 : 0);
+            }
+        }
+        glyphs.push_back(glyph);
+    }
+    return glyphs;
+}
+
+// A bar sweeping across, one frame for each position
+std::vector<std::vector<uint8_t>> make_sweep_frames(uint16_t width, uint16_t height, uint8_t frames) {
+    std::vector<std::vector<uint8_t>> out(frames, std::vector<uint8_t>(width * height));
+    for (uint8_t frame = 0; frame < frames; ++frame) {
+        for (uint16_t y = 0; y < height; ++y) {
+            for (uint16_t x = 0; x < width; ++x) {
+                bool bar                  = x / (width / frames) == frame;
+                out[frame][y * width + x] = bar ? 1 + (y * 2 / height) : ((x + y) % 8 == 0 ? 3 : 0);
+            }
+        }
+    }
+    return out;
+}
+
+// A gauge, as might show a value on a keyboard's display: a ring with tick marks, a needle and a hub
+bool draw_dial(uint16_t x, uint16_t y, bool antialiased) {
+    // Inner and outer ends of the tick marks, every 45 degrees starting from the top
+    static const int8_t ticks[8][4] = {{0, -17, 0, -22}, {12, -12, 15, -15}, {17, 0, 22, 0}, {12, 12, 15, 15}, {0, 17, 0, 22}, {-12, 12, -15, 15}, {-17, 0, -22, 0}, {-12, -12, -15, -15}};
+    const uint8_t       fg[3]       = {43, 255, 255};
+    const uint8_t       bg[3]       = {170, 255, 40};
+
+    bool ok = antialiased ? qp_circle_aa(display, x, y, 24, fg[0], fg[1], fg[2], bg[0], bg[1], bg[2], false) : qp_circle(display, x, y, 24, fg[0], fg[1], fg[2], false);
+    for (const int8_t *tick : ticks) {
+        ok = ok && (antialiased ? qp_line_aa(display, x + tick[0], y + tick[1], x + tick[2], y + tick[3], 0, 0, 255, bg[0], bg[1], bg[2]) : qp_line(display, x + tick[0], y + tick[1], x + tick[2], y + tick[3], 0, 0, 255));
+    }
+    ok = ok && (antialiased ? qp_line_aa(display, x, y, x + 14, y - 9, 0, 255, 255, bg[0], bg[1], bg[2]) : qp_line(display, x, y, x + 14, y - 9, 0, 255, 255));
+    ok = ok && (antialiased ? qp_circle_aa(display, x, y, 3, 0, 0, 255, bg[0], bg[1], bg[2], true) : qp_circle(display, x, y, 3, 0, 0, 255, true));
+    return ok;
+}
+
+} // namespace
+
+class PainterGolden : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        display = qp_test_display_make_device(PANEL_WIDTH, PANEL_HEIGHT, framebuffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+    }
+
+    /**
+     * Compares pixels against tests/painter/golden/<name>.png. Setting QP_UPDATE_GOLDEN=1 in the environment rewrites
+     * the golden image instead; otherwise, on a mismatch, what was drawn is written to .build/test/ for comparison.
+     */
+    void expect_golden(const char *name, uint16_t width, uint16_t height, const uint8_t *rgb888) {
+        std::string golden_path = std::string(GOLDEN_DIR) + name + ".png";
+        if (getenv("QP_UPDATE_GOLDEN")) {
+            ASSERT_TRUE(write_file(golden_path, encode_png(width, height, rgb888))) << "could not write " << golden_path;
+            return;
+        }
+
+        std::vector<uint8_t> png, expected;
+        uint16_t             expected_width = 0, expected_height = 0;
+        ASSERT_TRUE(read_file(golden_path, &png)) << "missing " << golden_path << ", run with QP_UPDATE_GOLDEN=1 to create it";
+        ASSERT_TRUE(decode_png(png, &expected_width, &expected_height, &expected)) << "could not decode " << golden_path;
+        ASSERT_EQ(expected_width, width) << name;
+        ASSERT_EQ(expected_height, height) << name;
+
+        uint32_t mismatches = 0, first = 0;
+        for (uint32_t i = 0; i < (uint32_t)width * height; ++i) {
+            if (memcmp(&expected[i * 3], &rgb888[i * 3], 3) != 0) {
+                first = mismatches++ ? first : i;
+            }
+        }
+        if (mismatches > 0) {
+            std::string actual_path = std::string(ACTUAL_DIR) + "painter_golden_" + name + ".png";
+            write_file(actual_path, encode_png(width, height, rgb888));
+            ADD_FAILURE() << name << ": " << mismatches << " pixels differ, the first at (" << first % width << "," << first / width << "), see " << actual_path;
+        }
+    }
+
+    void expect_golden(const char *name) {
+        expect_golden(name, qp_test_display_width(display), qp_test_display_height(display), framebuffer);
+    }
+};
+
+TEST_F(PainterGolden, Primitives) {
+    ASSERT_TRUE(qp_rect(display, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 170, 255, 40, true));
+    ASSERT_TRUE(qp_rect(display, 2, 2, 29, 21, 0, 0, 255, false));
+    ASSERT_TRUE(qp_rect(display, 6, 6, 25, 17, 85, 255, 255, true));
+    ASSERT_TRUE(qp_circle(display, 47, 16, 12, 0, 255, 255, false));
+    ASSERT_TRUE(qp_circle(display, 47, 16, 6, 43, 255, 255, true));
+    ASSERT_TRUE(qp_ellipse(display, 78, 16, 14, 8, 128, 255, 255, false));
+    ASSERT_TRUE(qp_ellipse(display, 78, 16, 9, 4, 213, 255, 255, true));
+    ASSERT_TRUE(qp_line(display, 2, 61, 93, 34, 0, 0, 255));
+    ASSERT_TRUE(qp_line(display, 2, 34, 20, 61, 30, 255, 255));
+    ASSERT_TRUE(qp_line(display, 40, 48, 93, 48, 150, 200, 255));
+    for (uint16_t x = 60; x < 94; x += 3) {
+        ASSERT_TRUE(qp_setpixel(display, x, 58, 0, 255, 255));
+    }
+    expect_golden("primitives");
+}
+
+TEST_F(PainterGolden, AntiAliased) {
+    ASSERT_TRUE(qp_rect(display, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 170, 255, 40, true));
+    ASSERT_TRUE(draw_dial(26, 30, true));
+    ASSERT_TRUE(qp_circle_aa(display, 70, 13, 10, 85, 255, 255, 170, 255, 40, true));
+    ASSERT_TRUE(qp_ellipse_aa(display, 74, 40, 18, 10, 128, 255, 255, 170, 255, 40, false));
+    ASSERT_TRUE(qp_ellipse_aa(display, 74, 40, 8, 4, 213, 255, 255, 170, 255, 40, true));
+    ASSERT_TRUE(qp_line_aa(display, 52, 62, 94, 53, 0, 0, 255, 170, 255, 40));
+    ASSERT_TRUE(qp_line_aa(display, 90, 2, 94, 26, 30, 255, 255, 170, 255, 40));
+    // Hanging off the left and bottom edges
+    ASSERT_TRUE(qp_circle_aa(display, 2, 60, 6, 0, 255, 255, 170, 255, 40, true));
+    expect_golden("antialiased");
+}
+
+TEST_F(PainterGolden, Images) {
+    std::vector<uint8_t> ui        = make_qgf(48, 32, 2, make_palette(2), make_ui_indices(48, 32, 2, 3), false);
+    std::vector<uint8_t> aa        = make_qgf(48, 32, 4, make_palette(4), make_antialiased_indices(48, 32, 4), true);
+    std::vector<uint8_t> dithered  = make_qgf(48, 32, 2, {}, make_dithered_indices(48, 32, 2), true);
+    std::vector<uint8_t> grayscale = make_qgf(48, 32, 4, {}, make_antialiased_indices(48, 32, 4), false);
+
+    painter_image_handle_t images[4] = {qp_load_image_mem(ui.data()), qp_load_image_mem(aa.data()), qp_load_image_mem(dithered.data()), qp_load_image_mem(grayscale.data())};
+    for (painter_image_handle_t image : images) {
+        ASSERT_NE(image, nullptr);
+    }
+    ASSERT_TRUE(qp_drawimage(display, 0, 0, images[0]));
+    ASSERT_TRUE(qp_drawimage(display, 48, 0, images[1]));
+    ASSERT_TRUE(qp_drawimage_recolor(display, 0, 32, images[2], 20, 255, 255, 160, 255, 60));
+    ASSERT_TRUE(qp_drawimage(display, 48, 32, images[3]));
+    for (painter_image_handle_t image : images) {
+        qp_close_image(image);
+    }
+    expect_golden("images");
+}
+
+TEST_F(PainterGolden, Rotated) {
+    std::vector<uint8_t>   ui    = make_qgf(32, 24, 2, make_palette(2), make_ui_indices(32, 24, 2, 7), true);
+    painter_image_handle_t image = qp_load_image_mem(ui.data());
+    ASSERT_NE(image, nullptr);
+
+    ASSERT_TRUE(qp_init(display, QP_ROTATION_90));
+    ASSERT_EQ(qp_test_display_width(display), PANEL_HEIGHT);
+    ASSERT_TRUE(qp_rect(display, 0, 0, 15, 7, 0, 255, 255, true));
+    ASSERT_TRUE(qp_line(display, 0, 0, PANEL_HEIGHT - 1, PANEL_WIDTH - 1, 0, 0, 255));
+    ASSERT_TRUE(qp_circle(display, 40, 70, 10, 85, 255, 255, false));
+    ASSERT_TRUE(qp_drawimage(display, 4, 30, image));
+    qp_close_image(image);
+    expect_golden("rotated");
+}
+
+TEST_F(PainterGolden, Animation) {
+    const uint16_t size = 24, frames = 3, delay = 50;
+
+    std::vector<uint8_t>   qgf   = make_animated_qgf(size, size, 2, make_palette(2), make_sweep_frames(size, size, frames), delay, IMAGE_COMPRESSED_RLE);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    ASSERT_EQ(image->frame_count, frames);
+
+    // Lay each frame out side by side as it's shown, and then the first again once the animation loops
+    std::vector<uint8_t> strip(size * (frames + 1) * size * 3);
+    auto                 capture = [&](uint16_t frame) {
+        for (uint16_t y = 0; y < size; ++y) {
+            memcpy(&strip[(y * size * (frames + 1) + frame * size) * 3], &framebuffer[((y + 4) * PANEL_WIDTH + 4) * 3], size * 3);
+        }
+    };
+
+    deferred_token token = qp_animate(display, 4, 4, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    capture(0);
+    for (uint16_t frame = 1; frame <= frames; ++frame) {
+        advance_time(delay);
+        qp_internal_animation_tick();
+        capture(frame);
+    }
+    qp_stop_animation(token);
+    qp_close_image(image);
+
+    expect_golden("animation", size * (frames + 1), size, strip.data());
+}
+
+TEST_F(PainterGolden, Text) {
+    std::vector<uint8_t>  qff  = make_qff(LINE_HEIGHT, 2, make_bit_glyphs(), true);
+    painter_font_handle_t font = qp_load_font_mem(qff.data());
+    ASSERT_NE(font, nullptr);
+
+    ASSERT_GT(qp_drawtext(display, 0, 0, font, "Hello, QMK!"), 0);
+    ASSERT_GT(qp_drawtext_recolor(display, 0, LINE_HEIGHT, font, "0123456789", 85, 255, 255, 0, 0, 0), 0);
+    ASSERT_GT(qp_drawtext_recolor(display, 6, 2 * LINE_HEIGHT + 2, font, "[layer 2]", 0, 0, 0, 43, 255, 255), 0);
+    ASSERT_GT(qp_drawtext(display, 90, 4 * LINE_HEIGHT, font, "clip"), 0);
+    qp_close_font(font);
+    expect_golden("text");
+}
+
+TEST_F(PainterGolden, TransfersMatchAreaDrawn) {
+    const qp_test_display_stats_t *stats = qp_test_display_get_stats(display);
+    uint32_t                       count = 0;
+
+    // A filled rectangle is one window, with each pixel sent once
+    ASSERT_TRUE(qp_rect(display, 10, 20, 29, 29, 0, 255, 255, true));
+    const qp_test_display_viewport_t *viewports = qp_test_display_get_viewports(display, &count);
+    EXPECT_EQ(stats->viewports, 1);
+    EXPECT_EQ(stats->pixels, 20 * 10);
+    EXPECT_EQ(stats->bytes, QP_TEST_DISPLAY_VIEWPORT_BYTES + 20 * 10 * 3);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(viewports[0].left, 10);
+    EXPECT_EQ(viewports[0].top, 20);
+    EXPECT_EQ(viewports[0].right, 29);
+    EXPECT_EQ(viewports[0].bottom, 29);
+
+    // As is an image, however it's compressed
+    for (bool rle : {false, true}) {
+        std::vector<uint8_t>   qgf   = make_qgf(48, 32, 4, make_palette(4), make_antialiased_indices(48, 32, 4), rle);
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+        qp_test_display_reset_stats(display);
+        ASSERT_TRUE(qp_drawimage(display, 60, 30, image));
+        qp_close_image(image);
+        EXPECT_EQ(stats->viewports, 1);
+        EXPECT_EQ(stats->pixels, 48 * 32);
+        EXPECT_EQ(stats->clipped, (60 + 48 - PANEL_WIDTH) * 32);
+    }
+}
+
+TEST_F(PainterGolden, RunsShareViewports) {
+    const qp_test_display_stats_t *stats = qp_test_display_get_stats(display);
+
+    // A shallow line goes out a row at a time, a steep one a column at a time
+    qp_test_display_reset_stats(display);
+    ASSERT_TRUE(qp_line(display, 0, 0, 19, 3, 0, 255, 255));
+    EXPECT_EQ(stats->viewports, 4);
+    EXPECT_EQ(stats->pixels, 20);
+    qp_test_display_reset_stats(display);
+    ASSERT_TRUE(qp_line(display, 0, 0, 2, 29, 0, 255, 255));
+    EXPECT_EQ(stats->viewports, 3);
+    EXPECT_EQ(stats->pixels, 30);
+
+    // Circles send each pixel once, mostly as runs
+    for (bool filled : {false, true}) {
+        ASSERT_TRUE(qp_rect(display, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 0, 0, 0, true));
+        qp_test_display_reset_stats(display);
+        ASSERT_TRUE(qp_circle(display, 40, 30, 20, 0, 0, 255, filled));
+
+        uint32_t lit = 0;
+        for (uint32_t i = 0; i < sizeof(framebuffer); i += 3) {
+            lit += framebuffer[i] != 0 ? 1 : 0;
+        }
+        EXPECT_EQ(stats->pixels, lit) << (filled ? "filled" : "outline");
+        EXPECT_LT(stats->viewports * 2, lit / (filled ? 20 : 1)) << (filled ? "filled" : "outline");
+    }
+
+    // Anti-aliased lines are a run per row or column too, covering one or two pixels at each step along the line
+    qp_test_display_reset_stats(display);
+    ASSERT_TRUE(qp_line_aa(display, 0, 0, 19, 3, 0, 0, 255, 0, 0, 0));
+    EXPECT_EQ(stats->viewports, 4);
+    EXPECT_LE(stats->pixels, 40);
+}
+
+/**
+ * Reports the time taken on the host by each of the common drawing calls, along with the viewports set and the bytes a
+ * panel would have been sent for each, which don't depend on the host.
+ */
+TEST_F(PainterGolden, DrawCosts) {
+    std::vector<uint8_t>   qgf   = make_qgf(48, 32, 4, make_palette(4), make_antialiased_indices(48, 32, 4), true);
+    std::vector<uint8_t>   qff   = make_qff(LINE_HEIGHT, 2, make_bit_glyphs(), true);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    painter_font_handle_t  font  = qp_load_font_mem(qff.data());
+    ASSERT_NE(image, nullptr);
+    ASSERT_NE(font, nullptr);
+
+    struct Operation {
+        const char *          name;
+        std::function<bool()> draw;
+    };
+    const Operation operations[] = {
+        {"rect 32x32", [] { return qp_rect(display, 8, 8, 39, 39, 0, 255, 255, true); }},
+        {"rect line", [] { return qp_rect(display, 8, 8, 39, 39, 0, 255, 255, false); }},
+        {"circle r20", [] { return qp_circle(display, 40, 30, 20, 0, 255, 255, true); }},
+        {"circle line", [] { return qp_circle(display, 40, 30, 20, 0, 255, 255, false); }},
+        {"circle aa", [] { return qp_circle_aa(display, 40, 30, 20, 0, 255, 255, 0, 0, 0, false); }},
+        {"ellipse", [] { return qp_ellipse(display, 48, 30, 40, 20, 0, 255, 255, false); }},
+        {"ellipse aa", [] { return qp_ellipse_aa(display, 48, 30, 40, 20, 0, 255, 255, 0, 0, 0, false); }},
+        {"line", [] { return qp_line(display, 0, 10, 95, 50, 0, 255, 255); }},
+        {"line aa", [] { return qp_line_aa(display, 0, 10, 95, 50, 0, 255, 255, 0, 0, 0); }},
+        {"dial", [] { return draw_dial(48, 32, false); }},
+        {"dial aa", [] { return draw_dial(48, 32, true); }},
+        {"image 48x32", [&] { return qp_drawimage(display, 8, 8, image); }},
+        {"text 15ch", [&] { return qp_drawtext(display, 0, 0, font, "Layer: Function") > 0; }},
+    };
+
+    const int iterations = 200;
+    printf("%-10s %-12s %10s %10s %10s\n", "draw", "operation", "us", "viewports", "bytes");
+    for (const Operation &operation : operations) {
+        qp_test_display_reset_stats(display);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            ASSERT_TRUE(operation.draw());
+        }
+        double                         us    = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+        const qp_test_display_stats_t *stats = qp_test_display_get_stats(display);
+        printf("%-10s %-12s %10.2f %10u %10u\n", "draw", operation.name, us, stats->viewports / iterations, stats->bytes / iterations);
+    }
+
+    qp_close_image(image);
+    qp_close_font(font);
+}
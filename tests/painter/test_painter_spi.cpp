@@ -0,0 +1,319 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+#include "test_common.hpp"
+#include "painter_test_helpers.hpp"
+#include "painter_panel_model.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_draw.h"
+#include "qp_ili9341.h"
+#include "qp_surface_internal.h"
+#include "spi_mock.h"
+}
+
+using namespace painter_test;
+
+// A 240x320 ILI9341, with the modelled MCU much slower than the host
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 320
+#define PANEL_SPI_HZ 40000000
+#define CPU_SCALE 30
+#define CS_PIN 1
+#define DC_PIN 2
+#define RST_PIN 3
+
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+#    define PIXDATA_MODE "double"
+#else
+#    define PIXDATA_MODE "single"
+#endif
+
+namespace {
+
+PanelModel<PANEL_WIDTH, PANEL_HEIGHT> panel_model;
+surface_painter_device_t              surface_devices[2];
+uint8_t                               surface_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+painter_device_t                      panel;
+painter_device_t                      reference;
+painter_device_t                      source;
+
+void panel_receive(uint8_t byte, bool dc) {
+    panel_model.receive(byte, dc);
+}
+
+} // namespace
+
+class PainterSpi : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        panel     = qp_ili9341_make_spi_device(PANEL_WIDTH, PANEL_HEIGHT, CS_PIN, DC_PIN, RST_PIN, 2, 0);
+        reference = qp_make_rgb565_surface_advanced(&surface_devices[0], 1, PANEL_WIDTH, PANEL_HEIGHT, surface_buffers[0]);
+        source    = qp_make_rgb565_surface_advanced(&surface_devices[1], 1, PANEL_WIDTH, PANEL_HEIGHT, surface_buffers[1]);
+    }
+
+    void SetUp() override {
+        configure(false, 0, 0);
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(reference, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(source, QP_ROTATION_0));
+    }
+
+    void configure(bool dma, uint32_t clock_hz, uint32_t cpu_scale) {
+        spi_mock_config_t config = {};
+        config.clock_hz          = clock_hz;
+        config.cpu_scale         = cpu_scale;
+        config.dma               = dma;
+        config.dc_pin            = DC_PIN;
+        spi_mock_configure(&config, panel_receive);
+        spi_mock_reset_stats();
+    }
+
+    // Draws the same things on the panel and the reference surface
+    void draw_scene(void) {
+        std::vector<uint8_t>   ui    = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, 4, 5), true);
+        std::vector<uint8_t>   noise = make_qgf(77, 53, 2, make_palette(2), make_noise_indices(77 * 53, 2, 9), false);
+        painter_image_handle_t images[2];
+        images[0] = qp_load_image_mem(ui.data());
+        images[1] = qp_load_image_mem(noise.data());
+        ASSERT_NE(images[0], nullptr);
+        ASSERT_NE(images[1], nullptr);
+
+        for (painter_device_t device : {panel, reference}) {
+            EXPECT_TRUE(qp_rect(device, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 0, 255, 255, true));
+            EXPECT_TRUE(qp_drawimage(device, 0, 0, images[0]));
+            EXPECT_TRUE(qp_drawimage(device, 13, 101, images[1]));
+            EXPECT_TRUE(qp_rect(device, 20, 30, 140, 90, 85, 255, 255, false));
+            EXPECT_TRUE(qp_circle(device, 120, 200, 40, 170, 255, 255, true));
+            EXPECT_TRUE(qp_line(device, 3, 311, 236, 7, 43, 255, 255));
+            // Make sure the palette is converted for each device in turn
+            qp_internal_invalidate_palette();
+        }
+        qp_close_image(images[0]);
+        qp_close_image(images[1]);
+
+        // A surface composed off-screen, then sent across in one go. Drawing it clears its dirty region, so it's
+        // composed afresh for each target.
+        for (painter_device_t device : {panel, reference}) {
+            EXPECT_TRUE(qp_rect(source, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 0, 0, 0, true));
+            EXPECT_TRUE(qp_rect(source, 0, 40, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 200, 100, 255, true));
+            EXPECT_TRUE(qp_circle(source, 60, 100, 30, 20, 255, 255, true));
+            EXPECT_TRUE(qp_surface_draw(source, device, 0, 0, true));
+        }
+    }
+
+    void expect_panel_matches_reference(void) {
+        EXPECT_EQ(memcmp(panel_model.gram, surface_buffers[0], sizeof(panel_model.gram)), 0);
+        EXPECT_EQ(spi_mock_get_stats()->corruptions, 0u) << "Pixel data was modified while on the bus";
+        EXPECT_EQ(spi_mock_get_stats()->pin_changes, 0u) << "D/C or CS moved while pixel data was on the bus";
+    }
+
+    // Returns the modelled time taken to draw a full-screen image
+    const spi_mock_stats_t *time_full_screen(bool dma, bool rle) {
+        std::vector<uint8_t>   indices = rle ? make_ui_indices(PANEL_WIDTH, PANEL_HEIGHT, 4, 3) : make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, 4, 3);
+        std::vector<uint8_t>   qgf     = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), indices, rle);
+        painter_image_handle_t image   = qp_load_image_mem(qgf.data());
+        EXPECT_NE(image, nullptr);
+
+        configure(dma, PANEL_SPI_HZ, CPU_SCALE);
+        EXPECT_TRUE(qp_drawimage(panel, 0, 0, image));
+        qp_close_image(image);
+        return spi_mock_get_stats();
+    }
+};
+
+TEST_F(PainterSpi, BlockingTransfersMatchSurface) {
+    TestDriver driver;
+    draw_scene();
+    expect_panel_matches_reference();
+    EXPECT_EQ(spi_mock_get_stats()->waits, 0u);
+}
+
+TEST_F(PainterSpi, DmaTransfersMatchSurface) {
+    TestDriver driver;
+    // Without counting time outside the mock, every transfer is still on the bus when the next is ready
+    configure(true, PANEL_SPI_HZ, 0);
+    draw_scene();
+    expect_panel_matches_reference();
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    EXPECT_GT(spi_mock_get_stats()->waits, 0u) << "Pixel data should have been left on the bus while decoding";
+#else
+    EXPECT_EQ(spi_mock_get_stats()->waits, 0u) << "A single buffer must never be left on the bus";
+#endif
+}
+
+/**
+ * Reports the modelled time taken to draw a full-screen palette image with blocking transfers and with DMA, along
+ * with how much of the bus time was hidden behind decoding.
+ */
+TEST_F(PainterSpi, FullScreenDrawTime) {
+    TestDriver driver;
+    for (bool rle : {false, true}) {
+        for (bool dma : {false, true}) {
+            const spi_mock_stats_t *stats   = time_full_screen(dma, rle);
+            uint64_t                serial  = stats->cpu_ns + stats->busy_ns;
+            uint64_t                overlap = serial - stats->elapsed_ns;
+            printf("%-10s %-8s %-8s %-6s %10.3f %10.3f %10.3f %9.1f%%\n", "draw", PIXDATA_MODE, rle ? "ui rle" : "noise", dma ? "dma" : "block", stats->elapsed_ns / 1e6, stats->cpu_ns / 1e6, stats->busy_ns / 1e6, 100.0 * overlap / stats->busy_ns);
+            EXPECT_GE(stats->bytes, (uint32_t)PANEL_WIDTH * PANEL_HEIGHT * 2);
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+            if (dma) {
+                EXPECT_GT(overlap, 0u) << "Decoding should have carried on while pixel data was sent";
+                continue;
+            }
+#endif
+            EXPECT_EQ(overlap, 0u);
+        }
+    }
+}
+
+#if QUANTUM_PAINTER_YIELD_INTERVAL > 0
+
+#    define OTHER_CS_PIN 4
+
+static bool                   yield_draw_result;
+static bool                   yield_draw_attempted;
+static bool                   yield_bus_released;
+static painter_image_handle_t yield_image;
+static bool                   in_keymap_draw;
+static uint32_t               nested_scans;
+static uint64_t               bus_taken_bytes;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == KC_A && record->event.pressed) {
+        // Whatever the keymap draws while a draw is paused would trample its buffers
+        yield_draw_attempted = true;
+        yield_draw_result    = qp_rect(panel, 0, 0, 9, 9, 0, 0, 255, true);
+
+        // Other devices on the bus, such as a pointing sensor, can still be used
+        yield_bus_released = gpio_read_pin(CS_PIN) && spi_start(OTHER_CS_PIN, false, 0, 2);
+        spi_stop();
+    }
+    if (keycode == KC_C && record->event.pressed) {
+        // Another device takes the bus and keeps it, as the OLED does while flushing in the background
+        EXPECT_TRUE(spi_start(OTHER_CS_PIN, false, 0, 2));
+        bus_taken_bytes = spi_mock_get_stats()->bytes;
+    }
+    if (keycode == KC_B && record->event.pressed) {
+        in_keymap_draw    = true;
+        yield_draw_result = qp_drawimage(panel, 0, 0, yield_image);
+        in_keymap_draw    = false;
+    }
+    return true;
+}
+
+extern "C" void matrix_scan_user(void) {
+    if (in_keymap_draw) {
+        nested_scans++;
+    }
+}
+
+/**
+ * Verifies that a key pressed part way through a long draw is reported before the draw completes, and that drawing
+ * from within the keyboard task is refused while the draw is paused.
+ */
+TEST_F(PainterSpi, KeyboardTaskRunsDuringLongDraw) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    std::vector<uint8_t>   qgf   = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, 4, 11), false);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    configure(true, PANEL_SPI_HZ, 0);
+    yield_draw_attempted = false;
+
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_A));
+    uint32_t start = timer_read32();
+    EXPECT_TRUE(qp_drawimage(panel, 0, 0, image));
+    printf("%-10s %-8s %10u ms\n", "yield", PIXDATA_MODE, (unsigned)timer_elapsed32(start));
+    EXPECT_GT(timer_elapsed32(start), (uint32_t)QUANTUM_PAINTER_YIELD_INTERVAL) << "Draw should outlast the yield interval";
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(yield_draw_attempted);
+    EXPECT_FALSE(yield_draw_result);
+    EXPECT_TRUE(yield_bus_released);
+    // Chip select was released and taken again, and the panel carried on where it left off
+    qp_internal_invalidate_palette();
+    EXPECT_TRUE(qp_drawimage(reference, 0, 0, image));
+    expect_panel_matches_reference();
+    qp_close_image(image);
+
+    key_a.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * Verifies that a long draw made from within the keyboard task runs to completion, rather than running the keyboard
+ * task again from within itself.
+ */
+TEST_F(PainterSpi, DrawFromKeyboardTaskDoesNotYield) {
+    TestDriver driver;
+    auto       key_b = KeymapKey(0, 0, 0, KC_B);
+    set_keymap({key_b});
+
+    std::vector<uint8_t> qgf = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, 4, 12), false);
+    yield_image              = qp_load_image_mem(qgf.data());
+    ASSERT_NE(yield_image, nullptr);
+    configure(true, PANEL_SPI_HZ, 0);
+    nested_scans      = 0;
+    yield_draw_result = false;
+
+    key_b.press();
+    EXPECT_REPORT(driver, (KC_B));
+    uint32_t start = timer_read32();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_GT(timer_elapsed32(start), (uint32_t)QUANTUM_PAINTER_YIELD_INTERVAL) << "Draw should outlast the yield interval";
+    EXPECT_TRUE(yield_draw_result);
+    EXPECT_EQ(nested_scans, 0u);
+    qp_close_image(yield_image);
+
+    key_b.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * Verifies that a draw is abandoned if another device still has the bus when it carries on, rather than sending the
+ * rest of the image with the other device selected and then stopping its transfer.
+ */
+TEST_F(PainterSpi, DrawAbandonedWhenBusIsHeld) {
+    TestDriver driver;
+    auto       key_c = KeymapKey(0, 0, 0, KC_C);
+    set_keymap({key_c});
+
+    std::vector<uint8_t>   qgf   = make_qgf(PANEL_WIDTH, PANEL_HEIGHT, 4, make_palette(4), make_noise_indices(PANEL_WIDTH * PANEL_HEIGHT, 4, 13), false);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    configure(true, PANEL_SPI_HZ, 0);
+    bus_taken_bytes = 0;
+
+    key_c.press();
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_FALSE(qp_drawimage(panel, 0, 0, image));
+    VERIFY_AND_CLEAR(driver);
+    qp_close_image(image);
+
+    EXPECT_GT(bus_taken_bytes, 0u);
+    EXPECT_EQ(spi_mock_get_stats()->bytes, bus_taken_bytes) << "Nothing more should be sent once the bus is lost";
+    EXPECT_TRUE(gpio_read_pin(CS_PIN));
+    EXPECT_FALSE(spi_start(OTHER_CS_PIN, false, 0, 2)) << "The other device's transfer should be left running";
+    spi_stop();
+
+    // The panel can be drawn to again once the bus is free
+    EXPECT_TRUE(qp_rect(panel, 0, 0, 9, 9, 0, 0, 255, true));
+
+    key_c.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+#endif // QUANTUM_PAINTER_YIELD_INTERVAL > 0
@@ -0,0 +1,221 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+#include "gtest/gtest.h"
+#include "painter_panel_model.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_ili9341.h"
+#include "qp_surface_internal.h"
+#include "spi_mock.h"
+}
+
+// A 240x320 ILI9341 showing an RGB565 surface, and a 128x64 monochrome surface mirrored to another
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 320
+#define MONO_WIDTH 128
+#define MONO_HEIGHT 64
+#define CS_PIN 1
+#define DC_PIN 2
+#define RST_PIN 3
+
+// Bytes sent to an ILI9341 to set up each window: CASET, PASET and RAMWR, with their parameters
+#define WINDOW_BYTES 11
+
+using namespace painter_test;
+
+namespace {
+
+PanelModel<PANEL_WIDTH, PANEL_HEIGHT> panel_model;
+surface_painter_device_t              rgb565_device;
+surface_painter_device_t              mono_devices[2];
+uint8_t                               rgb565_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+uint8_t                               mono_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(MONO_WIDTH, MONO_HEIGHT, 1)];
+painter_device_t                      panel;
+painter_device_t                      rgb565;
+painter_device_t                      mono;
+painter_device_t                      mono_target;
+
+// Counts what is streamed into the monochrome target
+surface_painter_driver_vtable_t counting_vtable;
+painter_driver_pixdata_func     real_pixdata;
+painter_driver_viewport_func    real_viewport;
+uint32_t                        mono_pixels;
+uint32_t                        mono_windows;
+
+bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    mono_pixels += native_pixel_count;
+    return real_pixdata(device, pixel_data, native_pixel_count);
+}
+
+bool counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    mono_windows++;
+    return real_viewport(device, left, top, right, bottom);
+}
+
+void panel_receive(uint8_t byte, bool dc) {
+    panel_model.receive(byte, dc);
+}
+
+} // namespace
+
+class PainterSurface : public ::testing::Test {
+   protected:
+    uint32_t random_state = 1;
+
+    static void SetUpTestCase() {
+        panel       = qp_ili9341_make_spi_device(PANEL_WIDTH, PANEL_HEIGHT, CS_PIN, DC_PIN, RST_PIN, 2, 0);
+        rgb565      = qp_make_rgb565_surface_advanced(&rgb565_device, 1, PANEL_WIDTH, PANEL_HEIGHT, rgb565_buffer);
+        mono        = qp_make_mono1bpp_surface_advanced(&mono_devices[0], 1, MONO_WIDTH, MONO_HEIGHT, mono_buffers[0]);
+        mono_target = qp_make_mono1bpp_surface_advanced(&mono_devices[1], 1, MONO_WIDTH, MONO_HEIGHT, mono_buffers[1]);
+
+        painter_driver_t *target_driver = (painter_driver_t *)mono_target;
+        counting_vtable                 = *(surface_painter_driver_vtable_t *)target_driver->driver_vtable;
+        real_pixdata                    = counting_vtable.base.pixdata;
+        real_viewport                   = counting_vtable.base.viewport;
+        counting_vtable.base.pixdata    = counting_pixdata;
+        counting_vtable.base.viewport   = counting_viewport;
+        target_driver->driver_vtable    = &counting_vtable.base;
+    }
+
+    void SetUp() override {
+        spi_mock_config_t config = {};
+        config.dc_pin            = DC_PIN;
+        spi_mock_configure(&config, panel_receive);
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(rgb565, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(mono, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(mono_target, QP_ROTATION_0));
+
+        // Start with everything in step
+        ASSERT_TRUE(qp_surface_draw(rgb565, panel, 0, 0, false));
+        ASSERT_TRUE(qp_surface_draw(mono, mono_target, 0, 0, false));
+        ASSERT_TRUE(qp_flush(mono_target));
+    }
+
+    uint32_t random(void) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state;
+    }
+
+    // Bytes the single dirty rectangle drawn before tiles were tracked would have needed
+    uint32_t bounding_box_bytes(painter_device_t device, uint8_t bpp) {
+        surface_dirty_data_t *dirty = &((surface_painter_device_t *)device)->dirty;
+        if (!dirty->is_dirty) {
+            return 0;
+        }
+        return WINDOW_BYTES + ((dirty->r - dirty->l + 1) * (dirty->b - dirty->t + 1) * bpp + 7) / 8;
+    }
+
+    // Draws the surface to its target, returning the bytes sent
+    uint32_t draw_rgb565(void) {
+        spi_mock_reset_stats();
+        panel_model.windows = 0;
+        EXPECT_TRUE(qp_surface_draw(rgb565, panel, 0, 0, false));
+        return spi_mock_get_stats()->bytes;
+    }
+
+    uint32_t draw_mono(void) {
+        mono_pixels  = 0;
+        mono_windows = 0;
+        EXPECT_TRUE(qp_surface_draw(mono, mono_target, 0, 0, false));
+        EXPECT_TRUE(qp_flush(mono_target));
+        return WINDOW_BYTES * mono_windows + (mono_pixels + 7) / 8;
+    }
+
+    void random_rect(painter_device_t device, uint16_t width, uint16_t height) {
+        uint16_t l = random() % width;
+        uint16_t t = random() % height;
+        uint16_t r = QP_MIN(width - 1, l + random() % 40);
+        uint16_t b = QP_MIN(height - 1, t + random() % 40);
+        EXPECT_TRUE(qp_rect(device, l, t, r, b, random(), 255, random(), random() % 2));
+    }
+
+    // A clock in the top left and a layer indicator in the bottom right, with a battery level along the top
+    void draw_hud(painter_device_t device, uint16_t width, uint16_t height, uint32_t frame) {
+        for (uint8_t digit = 0; digit < 4; ++digit) {
+            uint16_t l = 4 + digit * 10;
+            EXPECT_TRUE(qp_rect(device, l, 4, l + 7, 15, 0, 0, 0, true));
+            EXPECT_TRUE(qp_rect(device, l + (frame + digit) % 4, 4, l + 4 + (frame + digit) % 4, 15, 0, 0, 255, false));
+        }
+        if (frame % 4 == 0) {
+            EXPECT_TRUE(qp_rect(device, width - 36, height - 20, width - 5, height - 5, frame * 8, 255, (frame / 4) % 2 ? 255 : 0, true));
+        }
+        if (frame % 10 == 0) {
+            EXPECT_TRUE(qp_rect(device, width - 40, 4, width - 40 + (frame / 10) % 30, 9, 85, 255, 255, true));
+        }
+    }
+};
+
+TEST_F(PainterSurface, Rgb565DirtyTilesMatchPanel) {
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        for (uint32_t edit = random() % 5; edit > 0; --edit) {
+            random_rect(rgb565, PANEL_WIDTH, PANEL_HEIGHT);
+        }
+        draw_rgb565();
+        ASSERT_EQ(memcmp(panel_model.gram, rgb565_buffer, sizeof(rgb565_buffer)), 0) << "Frame " << frame;
+    }
+}
+
+TEST_F(PainterSurface, Mono1bppDirtyTilesMatchTarget) {
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        for (uint32_t edit = random() % 5; edit > 0; --edit) {
+            random_rect(mono, MONO_WIDTH, MONO_HEIGHT);
+        }
+        draw_mono();
+        ASSERT_EQ(memcmp(mono_buffers[1], mono_buffers[0], sizeof(mono_buffers[0])), 0) << "Frame " << frame;
+    }
+}
+
+TEST_F(PainterSurface, AdjacentTilesCoalesced) {
+    // A 3x2 block of tiles, and a separate tile below it
+    EXPECT_TRUE(qp_rect(rgb565, 20, 20, 60, 40, 0, 255, 255, true));
+    EXPECT_TRUE(qp_setpixel(rgb565, 100, 200, 0, 255, 255));
+    draw_rgb565();
+    EXPECT_EQ(panel_model.windows, 2u);
+    EXPECT_EQ(memcmp(panel_model.gram, rgb565_buffer, sizeof(rgb565_buffer)), 0);
+
+    // Nothing is sent once the panel is up to date
+    EXPECT_EQ(draw_rgb565(), 0u);
+}
+
+TEST_F(PainterSurface, EntireSurfaceIgnoresTiles) {
+    EXPECT_TRUE(qp_setpixel(rgb565, 5, 5, 0, 255, 255));
+    spi_mock_reset_stats();
+    panel_model.windows = 0;
+    EXPECT_TRUE(qp_surface_draw(rgb565, panel, 0, 0, true));
+    EXPECT_EQ(panel_model.windows, 1u);
+    EXPECT_EQ(spi_mock_get_stats()->bytes, (uint32_t)(WINDOW_BYTES + PANEL_WIDTH * PANEL_HEIGHT * 2));
+}
+
+/**
+ * Reports the bytes sent per frame for a typical HUD, against the single dirty rectangle covering everything drawn.
+ */
+TEST_F(PainterSurface, HudBytesPerFrame) {
+    uint32_t tiles_total = 0;
+    uint32_t bbox_total  = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        draw_hud(rgb565, PANEL_WIDTH, PANEL_HEIGHT, frame);
+        bbox_total += bounding_box_bytes(rgb565, 16);
+        tiles_total += draw_rgb565();
+    }
+    printf("%-10s %-8s %10.1f %10.1f\n", "hud", "rgb565", tiles_total / 100.0, bbox_total / 100.0);
+    EXPECT_EQ(memcmp(panel_model.gram, rgb565_buffer, sizeof(rgb565_buffer)), 0);
+    EXPECT_LT(tiles_total * 10, bbox_total) << "Only the areas drawn to should be sent";
+
+    tiles_total = 0;
+    bbox_total  = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        draw_hud(mono, MONO_WIDTH, MONO_HEIGHT, frame);
+        bbox_total += bounding_box_bytes(mono, 1);
+        tiles_total += draw_mono();
+    }
+    printf("%-10s %-8s %10.1f %10.1f\n", "hud", "mono1bpp", tiles_total / 100.0, bbox_total / 100.0);
+    EXPECT_EQ(memcmp(mono_buffers[1], mono_buffers[0], sizeof(mono_buffers[0])), 0);
+    EXPECT_LT(tiles_total * 2, bbox_total);
+}
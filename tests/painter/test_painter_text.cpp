@@ -0,0 +1,337 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "painter_test_helpers.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface_internal.h"
+}
+
+// A 240x64 status display
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 64
+#define LINE_HEIGHT 14
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+#    define TEXT_MODE "cached"
+#else
+#    define TEXT_MODE "uncached"
+#endif
+
+using namespace painter_test;
+
+namespace {
+
+// Arrows and other symbols, listed out of order
+std::vector<Glyph> make_glyphs(uint16_t num_unicode, uint8_t bpp, uint32_t seed) {
+    std::vector<Glyph> glyphs;
+    for (uint32_t i = 0; i < 95 + num_unicode; ++i) {
+        Glyph glyph;
+        glyph.code_point = i < 95 ? 0x20 + i : 0x2190 + (num_unicode - (i - 95)) * 3;
+        glyph.width      = i < 95 ? 4 + i % 5 : 8 + i % 4;
+        glyph.indices.resize(glyph.width * LINE_HEIGHT);
+        for (uint8_t &index : glyph.indices) {
+            seed  = seed * 1103515245 + 12345;
+            index = ((seed >> 16) % 10 < 3) ? (seed >> 20) % (1 << bpp) : 0;
+        }
+        glyphs.push_back(glyph);
+    }
+    return glyphs;
+}
+
+std::string utf8(const std::vector<uint32_t> &code_points) {
+    std::string out;
+    for (uint32_t code_point : code_points) {
+        if (code_point < 0x80) {
+            out += (char)code_point;
+        } else if (code_point < 0x800) {
+            out += (char)(0xC0 | (code_point >> 6));
+            out += (char)(0x80 | (code_point & 0x3F));
+        } else {
+            out += (char)(0xE0 | (code_point >> 12));
+            out += (char)(0x80 | ((code_point >> 6) & 0x3F));
+            out += (char)(0x80 | (code_point & 0x3F));
+        }
+    }
+    return out;
+}
+
+std::vector<uint32_t> ascii(const char *str) {
+    return std::vector<uint32_t>(str, str + strlen(str));
+}
+
+} // namespace
+
+class PainterText : public ::testing::Test {
+   protected:
+    static surface_painter_device_t rgb565_devices[2];
+    static surface_painter_device_t mono1bpp_devices[2];
+    static uint8_t                  rgb565_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+    static uint8_t                  mono1bpp_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 1)];
+    static painter_device_t         rgb565[2];
+    static painter_device_t         mono1bpp[2];
+
+    std::vector<Glyph>            glyphs;
+    std::map<uint32_t, Glyph *>   glyph_map;
+    std::vector<uint8_t>          qff;
+    painter_font_handle_t         font = nullptr;
+
+    static void SetUpTestCase() {
+        for (int i = 0; i < 2; ++i) {
+            rgb565[i]   = qp_make_rgb565_surface_advanced(&rgb565_devices[i], 1, PANEL_WIDTH, PANEL_HEIGHT, rgb565_buffers[i]);
+            mono1bpp[i] = qp_make_mono1bpp_surface_advanced(&mono1bpp_devices[i], 1, PANEL_WIDTH, PANEL_HEIGHT, mono1bpp_buffers[i]);
+        }
+    }
+
+    void SetUp() override {
+        for (int i = 0; i < 2; ++i) {
+            ASSERT_TRUE(qp_init(rgb565[i], QP_ROTATION_0));
+            ASSERT_TRUE(qp_init(mono1bpp[i], QP_ROTATION_0));
+        }
+        load_font(40, 2, true, 1);
+    }
+
+    void TearDown() override {
+        qp_close_font(font);
+    }
+
+    void load_font(uint16_t num_unicode, uint8_t bpp, bool rle, uint32_t seed) {
+        if (font) {
+            qp_close_font(font);
+        }
+        glyphs = make_glyphs(num_unicode, bpp, seed);
+        glyph_map.clear();
+        for (Glyph &glyph : glyphs) {
+            glyph_map[glyph.code_point] = &glyph;
+        }
+        qff  = make_qff(LINE_HEIGHT, bpp, glyphs, rle);
+        font = qp_load_font_mem(qff.data());
+        ASSERT_NE(font, nullptr);
+    }
+
+    // Draws each glyph as a grayscale image, recolored the same way as text
+    void draw_reference(painter_device_t device, uint16_t x, uint16_t y, const std::vector<uint32_t> &code_points, uint8_t bpp, uint8_t hue_fg, uint8_t val_bg) {
+        for (uint32_t code_point : code_points) {
+            const Glyph           *glyph = glyph_map[code_point];
+            std::vector<uint8_t>   qgf   = make_qgf(glyph->width, LINE_HEIGHT, bpp, {}, glyph->indices, false);
+            painter_image_handle_t image = qp_load_image_mem(qgf.data());
+            ASSERT_NE(image, nullptr);
+            EXPECT_TRUE(qp_drawimage_recolor(device, x, y, image, hue_fg, 255, 255, 0, 0, val_bg));
+            qp_close_image(image);
+            x += glyph->width;
+        }
+    }
+
+    void draw_and_compare(painter_device_t *devices, const uint8_t *buffer0, const uint8_t *buffer1, size_t buffer_size, uint8_t bpp, uint8_t hue_fg, uint8_t val_bg) {
+        // Every glyph, a line at a time, then again in a different order
+        std::vector<std::vector<uint32_t>> lines;
+        for (size_t i = 0; i < glyphs.size(); i += 24) {
+            std::vector<uint32_t> line;
+            for (size_t j = i; j < std::min(glyphs.size(), i + 24); ++j) {
+                line.push_back(glyphs[j].code_point);
+            }
+            lines.push_back(line);
+        }
+        for (size_t i = 0; i < lines.size(); ++i) {
+            uint16_t y = (i % 4) * LINE_HEIGHT;
+            EXPECT_GT(qp_drawtext_recolor(devices[0], 0, y, font, utf8(lines[i]).c_str(), hue_fg, 255, 255, 0, 0, val_bg), 0);
+            draw_reference(devices[1], 0, y, lines[i], bpp, hue_fg, val_bg);
+            EXPECT_EQ(memcmp(buffer0, buffer1, buffer_size), 0) << "Line " << i;
+        }
+    }
+};
+
+surface_painter_device_t PainterText::rgb565_devices[2];
+surface_painter_device_t PainterText::mono1bpp_devices[2];
+uint8_t                  PainterText::rgb565_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+uint8_t                  PainterText::mono1bpp_buffers[2][SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 1)];
+painter_device_t         PainterText::rgb565[2];
+painter_device_t         PainterText::mono1bpp[2];
+
+TEST_F(PainterText, TextMatchesGlyphImages) {
+    // Drawn again in each color, so that glyphs already decoded in one color aren't reused in another
+    for (uint8_t hue : {0, 85, 0}) {
+        draw_and_compare(rgb565, rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0]), 2, hue, 0);
+        draw_and_compare(mono1bpp, mono1bpp_buffers[0], mono1bpp_buffers[1], sizeof(mono1bpp_buffers[0]), 2, hue, hue ? 0 : 255);
+    }
+
+    load_font(0, 1, false, 2);
+    draw_and_compare(rgb565, rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0]), 1, 170, 0);
+}
+
+TEST_F(PainterText, ReloadedFontNotDrawnFromOldGlyphs) {
+    std::vector<uint32_t> text = ascii("Layer 1");
+    EXPECT_GT(qp_drawtext_recolor(rgb565[0], 0, 0, font, utf8(text).c_str(), 0, 255, 255, 0, 0, 0), 0);
+
+    // A different font, most likely loaded into the same slot
+    load_font(40, 2, true, 3);
+    EXPECT_GT(qp_drawtext_recolor(rgb565[0], 0, 0, font, utf8(text).c_str(), 0, 255, 255, 0, 0, 0), 0);
+    draw_reference(rgb565[1], 0, 0, text, 2, 0, 0);
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+}
+
+TEST_F(PainterText, MissingGlyphFails) {
+    EXPECT_EQ(qp_drawtext(rgb565[0], 0, 0, font, utf8({'A', 0x2600}).c_str()), 0);
+    EXPECT_EQ(qp_textwidth(font, utf8({0x2600}).c_str()), 0);
+}
+
+TEST_F(PainterText, SpriteMatchesDrawtext) {
+    std::vector<uint32_t> text = ascii("WPM: 123 ");
+    text.push_back(glyphs.back().code_point);
+    std::string str = utf8(text);
+
+    uint8_t               buffer[QP_TEXT_SPRITE_BUFFER_SIZE(PANEL_WIDTH, LINE_HEIGHT, 16)];
+    painter_text_sprite_t sprite;
+    int16_t               width = qp_text_sprite_render(rgb565[0], &sprite, buffer, sizeof(buffer), font, str.c_str(), 43, 255, 255, 0, 0, 0);
+    EXPECT_EQ(width, qp_textwidth(font, str.c_str()));
+    EXPECT_EQ(sprite.height, LINE_HEIGHT);
+    EXPECT_TRUE(qp_text_sprite_draw(rgb565[0], &sprite, 7, 30));
+    EXPECT_EQ(qp_drawtext_recolor(rgb565[1], 7, 30, font, str.c_str(), 43, 255, 255, 0, 0, 0), width);
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+
+    // Glyphs which don't start on a byte boundary
+    EXPECT_EQ(qp_text_sprite_render(mono1bpp[0], &sprite, buffer, sizeof(buffer), font, str.c_str(), 0, 0, 255, 0, 0, 0), width);
+    EXPECT_TRUE(qp_text_sprite_draw(mono1bpp[0], &sprite, 3, 5));
+    EXPECT_EQ(qp_drawtext(mono1bpp[1], 3, 5, font, str.c_str()), width);
+    EXPECT_EQ(memcmp(mono1bpp_buffers[0], mono1bpp_buffers[1], sizeof(mono1bpp_buffers[0])), 0);
+
+    // Rendered for a different pixel format, or into too small a buffer
+    EXPECT_FALSE(qp_text_sprite_draw(rgb565[0], &sprite, 0, 0));
+    EXPECT_EQ(qp_text_sprite_render(rgb565[0], &sprite, buffer, QP_TEXT_SPRITE_BUFFER_SIZE(width, LINE_HEIGHT, 16) - 1, font, str.c_str(), 0, 0, 255, 0, 0, 0), 0);
+}
+
+/**
+ * Reports the time taken to redraw a set of status labels, with qp_drawtext and with pre-rendered sprites, from a font
+ * with a few hundred unicode glyphs.
+ */
+TEST_F(PainterText, StatusLabelsDrawTime) {
+    const int iterations = 200;
+    load_font(300, 1, true, 4);
+
+    std::vector<uint32_t> arrows = {glyphs[95].code_point, glyphs[200].code_point, glyphs.back().code_point};
+    std::vector<std::string> labels = {"Layer: Base", "WPM: 87", "CAPS NUM", utf8(arrows) + " Media", "Battery 74%"};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (size_t label = 0; label < labels.size(); ++label) {
+            ASSERT_GT(qp_drawtext(rgb565[0], 0, (label % 4) * LINE_HEIGHT, font, labels[label].c_str()), 0);
+        }
+    }
+    double text_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::vector<painter_text_sprite_t> sprites(labels.size());
+    std::vector<std::vector<uint8_t>>  buffers(labels.size(), std::vector<uint8_t>(QP_TEXT_SPRITE_BUFFER_SIZE(PANEL_WIDTH, LINE_HEIGHT, 16)));
+    for (size_t label = 0; label < labels.size(); ++label) {
+        ASSERT_GT(qp_text_sprite_render(rgb565[1], &sprites[label], buffers[label].data(), buffers[label].size(), font, labels[label].c_str(), 0, 0, 255, 0, 0, 0), 0);
+    }
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (size_t label = 0; label < labels.size(); ++label) {
+            ASSERT_TRUE(qp_text_sprite_draw(rgb565[1], &sprites[label], 0, (label % 4) * LINE_HEIGHT));
+        }
+    }
+    double sprite_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    printf("%-10s %-10s %10.1f %10.1f\n", "labels", TEXT_MODE, text_us, sprite_us);
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+}
+
+#if QUANTUM_PAINTER_FONT_ATLASES > 0
+TEST_F(PainterText, AtlasMatchesDrawtext) {
+    std::vector<uint32_t> text = ascii("Layer: Base ");
+    text.push_back(glyphs[95].code_point);
+    text.push_back(glyphs.back().code_point);
+    std::string str = utf8(text);
+
+    ASSERT_TRUE(qp_font_atlas_render(rgb565[0], font, 43, 255, 255, 0, 0, 0));
+    ASSERT_TRUE(qp_font_atlas_render(mono1bpp[0], font, 0, 0, 255, 0, 0, 0));
+    EXPECT_GT(qp_font_atlas_bytes_used(), 0);
+
+    int16_t width = qp_textwidth(font, str.c_str());
+    EXPECT_EQ(qp_drawtext_recolor(rgb565[0], 7, 30, font, str.c_str(), 43, 255, 255, 0, 0, 0), width);
+    EXPECT_EQ(qp_drawtext_recolor(rgb565[1], 7, 30, font, str.c_str(), 43, 255, 255, 0, 0, 0), width);
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+
+    // Glyphs which don't start on a byte boundary
+    EXPECT_EQ(qp_drawtext(mono1bpp[0], 3, 5, font, str.c_str()), width);
+    EXPECT_EQ(qp_drawtext(mono1bpp[1], 3, 5, font, str.c_str()), width);
+    EXPECT_EQ(memcmp(mono1bpp_buffers[0], mono1bpp_buffers[1], sizeof(mono1bpp_buffers[0])), 0);
+
+    // Missing glyphs still fail when drawn from an atlas
+    EXPECT_EQ(qp_drawtext(mono1bpp[0], 0, 0, font, utf8({'A', 0x2600}).c_str()), 0);
+}
+
+TEST_F(PainterText, AtlasEvictsLeastRecentlyUsed) {
+    // Two rgb565 atlases fit in the budget, but not alongside a mono one as well
+    ASSERT_TRUE(qp_font_atlas_render(rgb565[0], font, 0, 255, 255, 0, 0, 0));
+    uint32_t rgb565_size = qp_font_atlas_bytes_used();
+    ASSERT_TRUE(qp_font_atlas_render(mono1bpp[0], font, 0, 0, 255, 0, 0, 0));
+    uint32_t mono1bpp_size = qp_font_atlas_bytes_used() - rgb565_size;
+    ASSERT_LE(2 * rgb565_size, QUANTUM_PAINTER_FONT_ATLAS_SIZE);
+    ASSERT_GT(2 * rgb565_size + mono1bpp_size, QUANTUM_PAINTER_FONT_ATLAS_SIZE);
+
+    // Drawing with the first atlas leaves the mono one as the least recently used
+    std::string str = utf8(ascii("WPM: 87"));
+    EXPECT_GT(qp_drawtext_recolor(rgb565[0], 0, 0, font, str.c_str(), 0, 255, 255, 0, 0, 0), 0);
+    ASSERT_TRUE(qp_font_atlas_render(rgb565[0], font, 85, 255, 255, 0, 0, 0));
+    EXPECT_EQ(qp_font_atlas_bytes_used(), 2 * rgb565_size);
+
+    // Both colors are still drawn correctly, as is the evicted one
+    for (uint8_t hue : {0, 85}) {
+        EXPECT_GT(qp_drawtext_recolor(rgb565[0], 0, hue / 8, font, str.c_str(), hue, 255, 255, 0, 0, 0), 0);
+        EXPECT_GT(qp_drawtext_recolor(rgb565[1], 0, hue / 8, font, str.c_str(), hue, 255, 255, 0, 0, 0), 0);
+    }
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+    EXPECT_GT(qp_drawtext(mono1bpp[0], 0, 0, font, str.c_str()), 0);
+    EXPECT_GT(qp_drawtext(mono1bpp[1], 0, 0, font, str.c_str()), 0);
+    EXPECT_EQ(memcmp(mono1bpp_buffers[0], mono1bpp_buffers[1], sizeof(mono1bpp_buffers[0])), 0);
+
+    // Closing the font frees its atlases
+    qp_close_font(font);
+    font = nullptr;
+    EXPECT_EQ(qp_font_atlas_bytes_used(), 0);
+}
+
+TEST_F(PainterText, AtlasTooLargeFails) {
+    load_font(300, 1, true, 4);
+    EXPECT_FALSE(qp_font_atlas_render(rgb565[0], font, 0, 0, 255, 0, 0, 0));
+    EXPECT_EQ(qp_font_atlas_bytes_used(), 0);
+    EXPECT_GT(qp_drawtext(rgb565[0], 0, 0, font, "Layer: Base"), 0);
+}
+
+/**
+ * Reports the time taken to redraw a set of status labels with qp_drawtext, before and after pre-rendering an atlas of
+ * the font.
+ */
+TEST_F(PainterText, AtlasDrawTime) {
+    const int iterations = 200;
+
+    std::vector<uint32_t> arrows = {glyphs[95].code_point, glyphs[110].code_point, glyphs.back().code_point};
+    std::vector<std::string> labels = {"Layer: Base", "WPM: 87", "CAPS NUM", utf8(arrows) + " Media", "Battery 74%"};
+
+    double times[2];
+    for (int atlas = 0; atlas < 2; ++atlas) {
+        if (atlas) {
+            ASSERT_TRUE(qp_font_atlas_render(rgb565[atlas], font, 0, 0, 255, 0, 0, 0));
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (size_t label = 0; label < labels.size(); ++label) {
+                ASSERT_GT(qp_drawtext(rgb565[atlas], 0, (label % 4) * LINE_HEIGHT, font, labels[label].c_str()), 0);
+            }
+        }
+        times[atlas] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+    printf("%-10s %-10s %10.1f %10.1f\n", "labels", "atlas", times[0], times[1]);
+    EXPECT_EQ(memcmp(rgb565_buffers[0], rgb565_buffers[1], sizeof(rgb565_buffers[0])), 0);
+}
+#endif // QUANTUM_PAINTER_FONT_ATLASES > 0
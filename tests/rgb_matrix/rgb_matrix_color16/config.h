@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../rgb_matrix_test_config.h"
+
+#define RGB_MATRIX_LED_COUNT 60
+#define RGB_MATRIX_TEST_GOLDEN_FILE "tests/rgb_matrix/rgb_matrix_color16/golden_hashes.txt"
@@ -0,0 +1,196 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+#include "test_common.hpp"
+#include "../rgb_matrix_test_harness.hpp"
+
+// Number of frames the eye is assumed to average over when judging dithered output
+#define PERCEPTION_WINDOW 8
+// Frames per step of the slow fade used to measure quantisation error
+#define RAMP_FRAMES_PER_STEP 4
+// Number of flushes timed by the benchmark
+#define BENCHMARK_FLUSH_COUNT 4096
+
+using namespace rgb_matrix_test;
+
+class RgbMatrixColor16 : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        init_layout();
+    }
+
+    void SetUp() override {
+        rgb_matrix_color16_init();
+        reset_driver_stats();
+    }
+
+    // Pushes the 16-bit frame through the pipeline and the fake driver, as rgb_task_flush() does.
+    static void flush(uint8_t interval_ms) {
+        rgb_matrix_color16_flush(interval_ms);
+        rgb_matrix_driver.flush();
+    }
+
+    // Ideal 8-bit output for a 16-bit channel value
+    static double ideal(uint16_t value) {
+        return value / 257.0;
+    }
+
+    // Mean absolute error between the output averaged over PERCEPTION_WINDOW frames and the ideal value, for a slow
+    // fade of one channel from 0 up to `top`.
+    static double ramp_error(uint16_t top, uint8_t interval_ms) {
+        rgb_matrix_color16_init();
+
+        double   window[PERCEPTION_WINDOW] = {0};
+        double   target[PERCEPTION_WINDOW] = {0};
+        double   total_error               = 0;
+        uint32_t samples                   = 0;
+        uint32_t frames                    = (uint32_t)top / 16 * RAMP_FRAMES_PER_STEP;
+        for (uint32_t f = 0; f < frames; f++) {
+            uint16_t value = (f / RAMP_FRAMES_PER_STEP) * 16;
+            rgb_matrix_color16_set_color_all(value, 0, 0);
+            flush(interval_ms);
+
+            window[f % PERCEPTION_WINDOW] = last_frame()[0].r;
+            target[f % PERCEPTION_WINDOW] = ideal(value);
+            if (f + 1 >= PERCEPTION_WINDOW) {
+                double out = 0, want = 0;
+                for (int i = 0; i < PERCEPTION_WINDOW; i++) {
+                    out += window[i];
+                    want += target[i];
+                }
+                total_error += fabs(out - want) / PERCEPTION_WINDOW;
+                samples++;
+            }
+        }
+        return total_error / samples;
+    }
+};
+
+TEST_F(RgbMatrixColor16, EightBitColoursPassThroughUnchanged) {
+    TestDriver driver;
+
+    for (int frame = 0; frame < 4; frame++) {
+        for (uint16_t v = 0; v < 256; v++) {
+            rgb_matrix_set_color(0, v, 255 - v, v / 2);
+            flush(RGB_MATRIX_DITHER_MAX_FLUSH_MS);
+            ASSERT_EQ(last_frame()[0].r, v);
+            ASSERT_EQ(last_frame()[0].g, 255 - v);
+            ASSERT_EQ(last_frame()[0].b, v / 2);
+        }
+    }
+}
+
+TEST_F(RgbMatrixColor16, SetColor16RoundTripsWidenedValues) {
+    TestDriver driver;
+
+    rgb_matrix_set_color16(1, 0xFFFF, 0x8080, 0x0101);
+    flush(RGB_MATRIX_DITHER_MAX_FLUSH_MS);
+    EXPECT_EQ(last_frame()[1].r, 0xFF);
+    EXPECT_EQ(last_frame()[1].g, 0x80);
+    EXPECT_EQ(last_frame()[1].b, 0x01);
+}
+
+TEST_F(RgbMatrixColor16, DitheredAverageMatchesLowValue) {
+    TestDriver driver;
+
+    // 0x0480 sits about halfway between the 8-bit levels 4 and 5
+    const uint16_t value = 0x0480;
+    const int      count = 256;
+    uint32_t       sum   = 0;
+    rgb_matrix_color16_set_color_all(value, value, value);
+    for (int i = 0; i < count; i++) {
+        flush(RGB_MATRIX_DITHER_MAX_FLUSH_MS);
+        EXPECT_GE(last_frame()[0].r, 4);
+        EXPECT_LE(last_frame()[0].r, 5);
+        sum += last_frame()[0].r;
+    }
+
+    double dithered = fabs((double)sum / count - ideal(value));
+    double rounded  = fabs(round(ideal(value)) - ideal(value));
+    EXPECT_LT(dithered, 1.0 / 64);
+    EXPECT_LT(dithered, rounded);
+}
+
+TEST_F(RgbMatrixColor16, DitheringReducesRampError) {
+    TestDriver driver;
+
+    double dithered = ramp_error(0x2000, RGB_MATRIX_DITHER_MAX_FLUSH_MS);
+    double rounded  = ramp_error(0x2000, RGB_MATRIX_DITHER_MAX_FLUSH_MS + 1);
+    EXPECT_LT(dithered, rounded / 2);
+}
+
+TEST_F(RgbMatrixColor16, RoundsAtLowFrameRates) {
+    TestDriver driver;
+
+    rgb_matrix_color16_set_color_all(0x0480, 0x0480, 0x0480);
+    for (int i = 0; i < 16; i++) {
+        flush(RGB_MATRIX_DITHER_MAX_FLUSH_MS + 1);
+        EXPECT_EQ(last_frame()[0].r, 4);
+    }
+}
+
+TEST_F(RgbMatrixColor16, BreathingRendersIn16Bit) {
+    TestDriver driver;
+
+    reset_effect(RGB_MATRIX_BREATHING);
+    rgb_matrix_sethsv_noeeprom(0, 0, 64);
+    rgb_matrix_set_speed_noeeprom(16);
+
+    // At low brightness and speed the 8-bit fade holds each level for many frames, the dithered one keeps moving
+    uint8_t  previous = 0;
+    uint32_t changes  = 0;
+    uint8_t  peak     = 0;
+    for (int i = 0; i < 256; i++) {
+        ASSERT_TRUE(render_frame());
+        const rgb_t *frame = last_frame();
+        for (uint8_t led = 1; led < RGB_MATRIX_LED_COUNT; led++) {
+            EXPECT_LE(abs(frame[led].r - frame[0].r), 1);
+        }
+        if (frame[0].r != previous) changes++;
+        if (frame[0].r > peak) peak = frame[0].r;
+        previous = frame[0].r;
+    }
+    EXPECT_GT(changes, 0u);
+    EXPECT_LE(peak, 64);
+}
+
+/*
+ * Reports the quantisation error of a slow fade and the host-side cost of flushing a frame, dithered against rounded.
+ * This is a baseline for comparing changes, not a pass/fail check.
+ */
+TEST_F(RgbMatrixColor16, Benchmark) {
+    TestDriver driver;
+
+    printf("%-10s %10s %10s %10s\n", "mode", "err@0x1000", "err@0x4000", "ns/flush");
+    const uint8_t intervals[]  = {RGB_MATRIX_DITHER_MAX_FLUSH_MS, RGB_MATRIX_DITHER_MAX_FLUSH_MS + 1};
+    const char   *names[]      = {"dithered", "rounded"};
+    for (int m = 0; m < 2; m++) {
+        double low  = ramp_error(0x1000, intervals[m]);
+        double high = ramp_error(0x4000, intervals[m]);
+
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_color16_set_color(i, i * 997, i * 331, i * 67);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCHMARK_FLUSH_COUNT; i++) {
+            rgb_matrix_color16_flush(intervals[m]);
+        }
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        printf("%-10s %10.4f %10.4f %10" PRIu64 "\n", names[m], low, high, ns / BENCHMARK_FLUSH_COUNT);
+    }
+
+    reset_effect(RGB_MATRIX_BREATHING);
+    uint64_t total_ns = 0;
+    for (int i = 0; i < 256; i++) {
+        uint64_t ns = 0;
+        ASSERT_TRUE(render_frame_timed(&ns, nullptr));
+        total_ns += ns;
+    }
+    printf("%-10s %10s %10s %10" PRIu64 " (ns/frame)\n", "BREATHING", "-", "-", total_ns / 256);
+}
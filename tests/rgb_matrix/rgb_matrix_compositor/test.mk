@@ -0,0 +1,10 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+RGB_MATRIX_COMPOSITOR_ENABLE = yes
+
+SRC += tests/rgb_matrix/rgb_matrix_test_harness.cpp
+SRC += tests/rgb_matrix/test_rgb_matrix_effects.cpp
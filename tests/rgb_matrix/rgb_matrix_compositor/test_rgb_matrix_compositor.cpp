@@ -0,0 +1,270 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "test_common.hpp"
+#include "../rgb_matrix_test_harness.hpp"
+
+#define BENCHMARK_FRAME_COUNT 256
+
+// LED indices in the harness layout: the first matrix rows are KEYLIGHT, the last MODIFIER, the rest UNDERGLOW
+#define KEYLIGHT_LED 0
+#define MODIFIER_LED ((MATRIX_ROWS - 1) * MATRIX_COLS)
+#define UNDERGLOW_LED (RGB_MATRIX_LED_COUNT - 1)
+
+using namespace rgb_matrix_test;
+
+static bool  paint_modifiers = false;
+static hsv_t modifier_hsv    = {HSV_GREEN};
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    if (!paint_modifiers) {
+        return false;
+    }
+    // The classic indicator approach: overwrite LEDs after the effect has rendered
+    rgb_t rgb = hsv_to_rgb(modifier_hsv);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        if (HAS_FLAGS(g_led_config.flags[i], LED_FLAG_MODIFIER)) {
+            rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        }
+    }
+    return false;
+}
+
+class RgbMatrixCompositor : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        init_layout();
+    }
+
+    void SetUp() override {
+        TestFixture::SetUp();
+        paint_modifiers = false;
+        for (uint8_t i = 0; i < RGB_MATRIX_COMPOSITOR_LAYERS; i++) {
+            rgb_matrix_compositor_clear_layer(i);
+        }
+        rgb_matrix_compositor_set_indicator_blend(RGB_MATRIX_BLEND_REPLACE, UINT8_MAX);
+    }
+
+    void TearDown() override {
+        for (uint8_t i = 0; i < RGB_MATRIX_COMPOSITOR_LAYERS; i++) {
+            rgb_matrix_compositor_clear_layer(i);
+        }
+        TestFixture::TearDown();
+    }
+
+    static void set_overlay(uint8_t layer, uint8_t mode, uint8_t flags, uint8_t blend, hsv_t hsv, uint8_t alpha = UINT8_MAX) {
+        rgb_matrix_layer_t config = {mode, flags, blend, alpha, hsv, 128};
+        rgb_matrix_compositor_set_layer(layer, &config);
+    }
+
+    static void solid_base(hsv_t hsv) {
+        reset_effect(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(hsv.h, hsv.s, hsv.v);
+    }
+
+    static rgb_t led(uint8_t index) {
+        return last_frame()[index];
+    }
+};
+
+#define EXPECT_RGB(actual, expected)         \
+    do {                                     \
+        rgb_t a_ = (actual), e_ = (expected); \
+        EXPECT_EQ(a_.r, e_.r);               \
+        EXPECT_EQ(a_.g, e_.g);               \
+        EXPECT_EQ(a_.b, e_.b);               \
+    } while (0)
+
+TEST(RgbMatrixCompositorBlend, Channels) {
+    rgb_t below = {200, 100, 0};
+    rgb_t above = {100, 200, 255};
+
+    EXPECT_RGB(rgb_matrix_compositor_blend(below, above, RGB_MATRIX_BLEND_REPLACE, 0), above);
+    EXPECT_RGB(rgb_matrix_compositor_blend(below, above, RGB_MATRIX_BLEND_ADD, 0), (rgb_t{255, 255, 255}));
+    EXPECT_RGB(rgb_matrix_compositor_blend(below, above, RGB_MATRIX_BLEND_MAX, 0), (rgb_t{200, 200, 255}));
+    EXPECT_RGB(rgb_matrix_compositor_blend(below, above, RGB_MATRIX_BLEND_MULTIPLY, 0), (rgb_t{78, 78, 0}));
+    EXPECT_RGB(rgb_matrix_compositor_blend(below, above, RGB_MATRIX_BLEND_ALPHA, 128), (rgb_t{150, 150, 128}));
+}
+
+TEST(RgbMatrixCompositorBlend, IdentityCases) {
+    rgb_t color = {17, 128, 254};
+    rgb_t white = {255, 255, 255};
+    rgb_t black = {0, 0, 0};
+
+    EXPECT_RGB(rgb_matrix_compositor_blend(color, white, RGB_MATRIX_BLEND_MULTIPLY, 0), color);
+    EXPECT_RGB(rgb_matrix_compositor_blend(color, black, RGB_MATRIX_BLEND_ADD, 0), color);
+    EXPECT_RGB(rgb_matrix_compositor_blend(color, black, RGB_MATRIX_BLEND_MAX, 0), color);
+    EXPECT_RGB(rgb_matrix_compositor_blend(color, white, RGB_MATRIX_BLEND_ALPHA, 0), color);
+    EXPECT_RGB(rgb_matrix_compositor_blend(color, black, RGB_MATRIX_BLEND_ALPHA, UINT8_MAX), black);
+}
+
+TEST_F(RgbMatrixCompositor, OverlayRespectsFlagMask) {
+    TestDriver driver;
+    solid_base({HSV_RED});
+    set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_KEYLIGHT, RGB_MATRIX_BLEND_REPLACE, {HSV_BLUE});
+
+    ASSERT_TRUE(render_frame());
+    EXPECT_RGB(led(KEYLIGHT_LED), hsv_to_rgb({HSV_BLUE}));
+    EXPECT_RGB(led(MODIFIER_LED), hsv_to_rgb({HSV_RED}));
+    EXPECT_RGB(led(UNDERGLOW_LED), hsv_to_rgb({HSV_RED}));
+}
+
+TEST_F(RgbMatrixCompositor, BlendModesApplyPerLayer) {
+    TestDriver driver;
+    rgb_t      red  = hsv_to_rgb({HSV_RED});
+    rgb_t      blue = hsv_to_rgb({HSV_BLUE});
+    solid_base({HSV_RED});
+
+    const uint8_t modes[] = {RGB_MATRIX_BLEND_ADD, RGB_MATRIX_BLEND_MULTIPLY, RGB_MATRIX_BLEND_MAX, RGB_MATRIX_BLEND_ALPHA};
+    for (uint8_t blend : modes) {
+        set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_ALL, blend, {HSV_BLUE}, 64);
+        SCOPED_TRACE(testing::Message() << "blend mode " << (int)blend);
+        ASSERT_TRUE(render_frame());
+        EXPECT_RGB(led(KEYLIGHT_LED), rgb_matrix_compositor_blend(red, blue, blend, 64));
+    }
+}
+
+TEST_F(RgbMatrixCompositor, LayersStackInOrder) {
+    TestDriver driver;
+    solid_base({HSV_RED});
+    set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_ALL, RGB_MATRIX_BLEND_ADD, {HSV_BLUE});
+    set_overlay(1, RGB_MATRIX_SOLID_COLOR, LED_FLAG_MODIFIER, RGB_MATRIX_BLEND_MULTIPLY, {HSV_RED});
+
+    ASSERT_TRUE(render_frame());
+    rgb_t sum = rgb_matrix_compositor_blend(hsv_to_rgb({HSV_RED}), hsv_to_rgb({HSV_BLUE}), RGB_MATRIX_BLEND_ADD, 0);
+    EXPECT_RGB(led(KEYLIGHT_LED), sum);
+    EXPECT_RGB(led(MODIFIER_LED), rgb_matrix_compositor_blend(sum, hsv_to_rgb({HSV_RED}), RGB_MATRIX_BLEND_MULTIPLY, 0));
+}
+
+TEST_F(RgbMatrixCompositor, LayerRendersWithItsOwnColourOnly) {
+    TestDriver driver;
+    solid_base({HSV_RED});
+    set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_KEYLIGHT, RGB_MATRIX_BLEND_REPLACE, {HSV_GREEN});
+
+    ASSERT_TRUE(render_frame());
+    hsv_t base = rgb_matrix_get_hsv();
+    EXPECT_EQ(base.h, 0);
+    EXPECT_EQ(base.s, 255);
+    EXPECT_EQ(base.v, 255);
+    EXPECT_EQ(rgb_matrix_get_speed(), 128);
+    EXPECT_RGB(led(KEYLIGHT_LED), hsv_to_rgb({HSV_GREEN}));
+}
+
+TEST_F(RgbMatrixCompositor, DisabledLayerIsSkipped) {
+    TestDriver driver;
+    solid_base({HSV_RED});
+    set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_ALL, RGB_MATRIX_BLEND_REPLACE, {HSV_BLUE});
+    ASSERT_TRUE(render_frame());
+
+    rgb_matrix_compositor_clear_layer(0);
+    ASSERT_TRUE(render_frame());
+    EXPECT_RGB(led(KEYLIGHT_LED), hsv_to_rgb({HSV_RED}));
+}
+
+TEST_F(RgbMatrixCompositor, IndicatorsAreALayer) {
+    TestDriver driver;
+    solid_base({HSV_RED});
+    paint_modifiers = true;
+    modifier_hsv    = {HSV_BLUE};
+    rgb_matrix_compositor_set_indicator_blend(RGB_MATRIX_BLEND_ADD, UINT8_MAX);
+
+    ASSERT_TRUE(render_frame());
+    EXPECT_RGB(led(MODIFIER_LED), rgb_matrix_compositor_blend(hsv_to_rgb({HSV_RED}), hsv_to_rgb({HSV_BLUE}), RGB_MATRIX_BLEND_ADD, 0));
+    // LEDs the indicators did not touch show the layers below
+    EXPECT_RGB(led(KEYLIGHT_LED), hsv_to_rgb({HSV_RED}));
+
+    // Indicator coverage does not persist once the callback stops writing
+    paint_modifiers = false;
+    ASSERT_TRUE(render_frame());
+    EXPECT_RGB(led(MODIFIER_LED), hsv_to_rgb({HSV_RED}));
+}
+
+TEST_F(RgbMatrixCompositor, HeatmapOverlayReceivesKeyHits) {
+    TestDriver driver;
+    solid_base({0, 0, 0});
+    set_overlay(0, RGB_MATRIX_TYPING_HEATMAP, LED_FLAG_KEYLIGHT, RGB_MATRIX_BLEND_ADD, {HSV_RED});
+
+    // The heatmap is cleared when the layer initialises, the harness taps the next key on the fifth frame
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(render_frame());
+    }
+    rgb_t hit = led(KEYLIGHT_LED + 1);
+    EXPECT_GT(hit.r + hit.g + hit.b, 0);
+    EXPECT_RGB(led(UNDERGLOW_LED), (rgb_t{0, 0, 0}));
+}
+
+TEST_F(RgbMatrixCompositor, OverlayMatchesIndicatorApproach) {
+    TestDriver driver;
+    modifier_hsv = {HSV_GREEN};
+
+    reset_effect(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    paint_modifiers = true;
+    std::vector<rgb_t> via_indicators;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(render_frame());
+        via_indicators.insert(via_indicators.end(), last_frame(), last_frame() + RGB_MATRIX_LED_COUNT);
+    }
+
+    reset_effect(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    paint_modifiers = false;
+    set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_MODIFIER, RGB_MATRIX_BLEND_REPLACE, modifier_hsv);
+    std::vector<rgb_t> via_layer;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(render_frame());
+        via_layer.insert(via_layer.end(), last_frame(), last_frame() + RGB_MATRIX_LED_COUNT);
+    }
+
+    ASSERT_EQ(via_indicators.size(), via_layer.size());
+    for (size_t i = 0; i < via_layer.size(); i++) {
+        EXPECT_RGB(via_layer[i], via_indicators[i]);
+    }
+}
+
+/*
+ * Reports the host-side cost of a frame for the indicator callback approach and for equivalent compositor layers.
+ * This is a baseline for comparing optimisations, not a pass/fail check.
+ */
+TEST_F(RgbMatrixCompositor, FrameCost) {
+    TestDriver driver;
+
+    struct scenario_t {
+        const char *name;
+        bool        indicators;
+        uint8_t     overlays;
+    };
+    const scenario_t scenarios[] = {
+        {"base effect only", false, 0},
+        {"base + indicator callback", true, 0},
+        {"base + 1 overlay", false, 1},
+        {"base + 2 overlays", false, 2},
+    };
+
+    printf("%-28s %12s %14s\n", "scenario", "ns/frame", "cycles/frame");
+    for (const auto &scenario : scenarios) {
+        reset_effect(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+        paint_modifiers = scenario.indicators;
+        rgb_matrix_compositor_clear_layer(0);
+        rgb_matrix_compositor_clear_layer(1);
+        if (scenario.overlays > 0) {
+            set_overlay(0, RGB_MATRIX_SOLID_COLOR, LED_FLAG_MODIFIER, RGB_MATRIX_BLEND_REPLACE, {HSV_GREEN});
+        }
+        if (scenario.overlays > 1) {
+            set_overlay(1, RGB_MATRIX_SOLID_REACTIVE_SIMPLE, LED_FLAG_KEYLIGHT, RGB_MATRIX_BLEND_ADD, {HSV_WHITE});
+        }
+
+        uint64_t total_ns     = 0;
+        uint64_t total_cycles = 0;
+        for (int i = 0; i < BENCHMARK_FRAME_COUNT; i++) {
+            uint64_t ns     = 0;
+            uint64_t cycles = 0;
+            ASSERT_TRUE(render_frame_timed(&ns, &cycles));
+            total_ns += ns;
+            total_cycles += cycles;
+        }
+        printf("%-28s %12" PRIu64 " %14" PRIu64 "\n", scenario.name, total_ns / BENCHMARK_FRAME_COUNT, total_cycles / BENCHMARK_FRAME_COUNT);
+    }
+}
@@ -0,0 +1,166 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#include "test_common.hpp"
+#include "../rgb_matrix_test_harness.hpp"
+
+extern "C" {
+#include "action_layer.h"
+#include "action_util.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Length of the idle periods checked for driver writes
+#define IDLE_PERIOD_MS 1000
+// The indicator callback paints this LED while layer 1 is active
+#define INDICATOR_LED 0
+
+using namespace rgb_matrix_test;
+
+bool rgb_matrix_indicators_user(void) {
+    if (layer_state_is(1)) {
+        rgb_matrix_set_color(INDICATOR_LED, 0xFF, 0xFF, 0xFF);
+    }
+    return true;
+}
+
+class RgbMatrixSkipUnchanged : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        init_layout();
+    }
+
+    // Runs the lighting task for `ms` milliseconds of mocked time.
+    static void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+
+    // Selects `mode` and lets it settle, so the next period starts from an already flushed frame.
+    static void settle(uint8_t mode) {
+        reset_effect(mode);
+        run_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+        reset_driver_stats();
+    }
+
+    static uint32_t driver_writes(void) {
+        return driver_stats().set_color_calls + driver_stats().set_color_all_calls + driver_stats().flush_calls;
+    }
+};
+
+TEST_F(RgbMatrixSkipUnchanged, StaticEffectIdleHasNoDriverWrites) {
+    TestDriver driver;
+
+    for (uint8_t mode : {RGB_MATRIX_SOLID_COLOR, RGB_MATRIX_ALPHAS_MODS, RGB_MATRIX_GRADIENT_UP_DOWN, RGB_MATRIX_GRADIENT_LEFT_RIGHT}) {
+        SCOPED_TRACE(rgb_matrix_get_mode_name(mode));
+        settle(mode);
+        run_for(IDLE_PERIOD_MS);
+        EXPECT_EQ(driver_writes(), 0u);
+    }
+}
+
+TEST_F(RgbMatrixSkipUnchanged, DisabledIdleHasNoDriverWrites) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_disable_noeeprom();
+    run_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].r, 0);
+
+    reset_driver_stats();
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_EQ(driver_writes(), 0u);
+}
+
+TEST_F(RgbMatrixSkipUnchanged, ConfigChangeFlushesOnce) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].r, 0xFF);
+
+    rgb_matrix_sethsv_noeeprom(HSV_BLUE);
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_EQ(driver_stats().flush_calls, 1u);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].r, 0);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].b, 0xFF);
+}
+
+TEST_F(RgbMatrixSkipUnchanged, UnchangedFrameIsNotFlushed) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+
+    // Key presses and modifiers may change indicators, so the frame is rendered again but comes out identical
+    rgb_matrix_handle_key_event(0, 0, true);
+    rgb_matrix_handle_key_event(0, 0, false);
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_GT(driver_stats().set_color_calls, 0u);
+    EXPECT_EQ(driver_stats().flush_calls, 0u);
+
+    reset_driver_stats();
+    add_mods(MOD_BIT(KC_LEFT_SHIFT));
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_GT(driver_stats().set_color_calls, 0u);
+    EXPECT_EQ(driver_stats().flush_calls, 0u);
+    clear_mods();
+}
+
+TEST_F(RgbMatrixSkipUnchanged, LayerChangeUpdatesIndicators) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+
+    layer_on(1);
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_EQ(driver_stats().flush_calls, 1u);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].g, 0xFF);
+
+    reset_driver_stats();
+    layer_off(1);
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_EQ(driver_stats().flush_calls, 1u);
+    EXPECT_EQ(last_frame()[INDICATOR_LED].g, 0);
+}
+
+TEST_F(RgbMatrixSkipUnchanged, InvalidateForcesFlush) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_invalidate();
+    run_for(IDLE_PERIOD_MS);
+    EXPECT_EQ(driver_stats().flush_calls, 1u);
+}
+
+TEST_F(RgbMatrixSkipUnchanged, TimeEffectKeepsFlushing) {
+    TestDriver driver;
+
+    settle(RGB_MATRIX_CYCLE_ALL);
+    run_for(IDLE_PERIOD_MS);
+    // Every frame of CYCLE_ALL at this speed differs, so none of them may be dropped
+    EXPECT_GE(driver_stats().flush_calls, IDLE_PERIOD_MS / (RGB_MATRIX_LED_FLUSH_LIMIT + 4));
+}
+
+/*
+ * Reports the host-side cost of an idle second and the driver writes it causes, for a static and an animated effect.
+ * This is a baseline for comparing changes, not a pass/fail check.
+ */
+TEST_F(RgbMatrixSkipUnchanged, IdleCost) {
+    TestDriver driver;
+
+    printf("%-28s %12s %12s %12s\n", "effect", "ns/second", "set_color", "flushes");
+    for (uint8_t mode : {RGB_MATRIX_SOLID_COLOR, RGB_MATRIX_GRADIENT_UP_DOWN, RGB_MATRIX_CYCLE_ALL}) {
+        settle(mode);
+        auto start = std::chrono::steady_clock::now();
+        run_for(1000);
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        printf("%-28s %12" PRIu64 " %12" PRIu32 " %12" PRIu32 "\n", rgb_matrix_get_mode_name(mode), ns, driver_stats().set_color_calls, driver_stats().flush_calls);
+    }
+}
@@ -0,0 +1,193 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_test_harness.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define READ_CYCLES() __rdtsc()
+#else
+#    define READ_CYCLES() 0
+#endif
+
+extern "C" {
+#include "timer.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Upper bound on task iterations per frame: one per LED slice plus starting, flushing and syncing
+#define MAX_TASK_ITERATIONS_PER_FRAME (RGB_MATRIX_LED_COUNT + RGB_MATRIX_LED_FLUSH_LIMIT * 4 + 16)
+// Tap a key every this many frames so reactive and framebuffer effects have input
+#define KEY_TAP_FRAME_INTERVAL 4
+
+led_config_t g_led_config;
+
+namespace {
+
+rgb_t                           working_buffer[RGB_MATRIX_LED_COUNT];
+rgb_t                           flushed_buffer[RGB_MATRIX_LED_COUNT];
+rgb_matrix_test::driver_stats_t stats;
+uint32_t                        frame_count;
+
+void fake_init(void) {
+    memset(working_buffer, 0, sizeof(working_buffer));
+    memset(flushed_buffer, 0, sizeof(flushed_buffer));
+}
+
+void fake_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    stats.set_color_calls++;
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        working_buffer[index] = rgb_t{r, g, b};
+    }
+}
+
+void fake_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    stats.set_color_all_calls++;
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        working_buffer[i] = rgb_t{r, g, b};
+    }
+}
+
+void fake_flush(void) {
+    stats.flush_calls++;
+    memcpy(flushed_buffer, working_buffer, sizeof(flushed_buffer));
+}
+
+void tap_next_key(void) {
+    uint8_t key = (frame_count / KEY_TAP_FRAME_INTERVAL) % (MATRIX_ROWS * MATRIX_COLS);
+    rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, true);
+    rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, false);
+}
+
+} // namespace
+
+extern "C" const rgb_matrix_driver_t rgb_matrix_driver = {fake_init, fake_set_color, fake_set_color_all, fake_flush};
+
+namespace rgb_matrix_test {
+
+void init_layout(void) {
+    // Keep roughly the 224:64 aspect ratio of the LED coordinate space
+    uint8_t cols = (uint8_t)ceil(sqrt(RGB_MATRIX_LED_COUNT * 224.0 / 64.0));
+    uint8_t rows = (RGB_MATRIX_LED_COUNT + cols - 1) / cols;
+
+    memset(&g_led_config, 0, sizeof(g_led_config));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t row             = i / cols;
+        uint8_t col             = i % cols;
+        g_led_config.point[i].x = cols > 1 ? col * 224 / (cols - 1) : 112;
+        g_led_config.point[i].y = rows > 1 ? row * 64 / (rows - 1) : 32;
+        g_led_config.flags[i]   = LED_FLAG_UNDERGLOW;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led                     = row * MATRIX_COLS + col;
+            g_led_config.matrix_co[row][col] = led;
+            g_led_config.flags[led]          = (row == MATRIX_ROWS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+        }
+    }
+}
+
+void reset_effect(uint8_t mode) {
+    // Render one frame with lighting disabled so the next effect always starts with params->init set
+    rgb_matrix_disable_noeeprom();
+    render_frame();
+
+    set_time(0);
+    g_rgb_timer = 0;
+    rgb_matrix_init();
+    srand(1);
+    random16_set_seed(1337);
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+    memset(g_rgb_frame_buffer, 0, sizeof(g_rgb_frame_buffer));
+#endif
+
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(mode);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_set_speed_noeeprom(128);
+    rgb_matrix_set_flags_noeeprom(LED_FLAG_ALL);
+
+    frame_count = 0;
+    reset_driver_stats();
+}
+
+static bool render_frame_impl(uint64_t *ns, uint64_t *cycles) {
+    if (frame_count % KEY_TAP_FRAME_INTERVAL == 0) {
+        tap_next_key();
+    }
+    frame_count++;
+
+    uint64_t total_ns     = 0;
+    uint64_t total_cycles = 0;
+    uint32_t flushes      = stats.flush_calls;
+    for (int i = 0; i < MAX_TASK_ITERATIONS_PER_FRAME; i++) {
+        auto     start_time   = std::chrono::steady_clock::now();
+        uint64_t start_cycles = READ_CYCLES();
+        rgb_matrix_task();
+        total_cycles += READ_CYCLES() - start_cycles;
+        total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+        if (stats.flush_calls != flushes) {
+            if (ns) *ns = total_ns;
+            if (cycles) *cycles = total_cycles;
+            return true;
+        }
+        advance_time(1);
+    }
+    return false;
+}
+
+bool render_frame(void) {
+    return render_frame_impl(nullptr, nullptr);
+}
+
+bool render_frame_timed(uint64_t *ns, uint64_t *cycles) {
+    return render_frame_impl(ns, cycles);
+}
+
+const rgb_t *last_frame(void) {
+    return flushed_buffer;
+}
+
+const driver_stats_t &driver_stats(void) {
+    return stats;
+}
+
+void reset_driver_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+uint32_t hash_frame(uint32_t hash) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(flushed_buffer);
+    for (size_t i = 0; i < sizeof(flushed_buffer); i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool write_ppm(const std::string &path, const std::vector<rgb_t> &frames) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    fprintf(fp, "P6\n%d %zu\n255\n", RGB_MATRIX_LED_COUNT, frames.size() / RGB_MATRIX_LED_COUNT);
+    for (const auto &px : frames) {
+        uint8_t rgb[3] = {px.r, px.g, px.b};
+        fwrite(rgb, 1, sizeof(rgb), fp);
+    }
+    fclose(fp);
+    return true;
+}
+
+} // namespace rgb_matrix_test
@@ -0,0 +1,52 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+/**
+ * Host-side harness for rendering RGB Matrix effects without hardware.
+ *
+ * A fake driver captures everything written through rgb_matrix_set_color() into a working buffer and snapshots it on
+ * every flush. g_led_config is generated at startup as a grid of RGB_MATRIX_LED_COUNT LEDs spread across the standard
+ * 224x64 coordinate space, with the test matrix mapped onto the first LEDs.
+ */
+namespace rgb_matrix_test {
+
+struct driver_stats_t {
+    uint32_t set_color_calls;
+    uint32_t set_color_all_calls;
+    uint32_t flush_calls;
+};
+
+// Fills g_led_config with the synthetic layout.
+void init_layout(void);
+
+// Restores timers, random state, key hit trackers and framebuffers, then selects `mode` so runs are reproducible.
+void reset_effect(uint8_t mode);
+
+// Runs rgb_matrix_task() until the next flush. Keys are tapped periodically so reactive effects have input.
+// Returns false if no flush happened within a bounded number of task iterations.
+bool render_frame(void);
+
+// As render_frame(), but also returns the host time spent inside rgb_matrix_task() for this frame.
+bool render_frame_timed(uint64_t *ns, uint64_t *cycles);
+
+const rgb_t          *last_frame(void);
+const driver_stats_t &driver_stats(void);
+void                  reset_driver_stats(void);
+
+// FNV-1a over the last flushed frame, folded into `hash`.
+uint32_t hash_frame(uint32_t hash);
+
+// Writes `frames` (one row of RGB_MATRIX_LED_COUNT pixels per frame) as a binary PPM.
+bool write_ppm(const std::string &path, const std::vector<rgb_t> &frames);
+
+} // namespace rgb_matrix_test
@@ -0,0 +1,132 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "rgb_matrix_test_harness.hpp"
+
+// Number of frames rendered per effect for the golden comparison
+#define GOLDEN_FRAME_COUNT 64
+// Number of frames rendered per effect for the benchmark
+#define BENCHMARK_FRAME_COUNT 256
+
+using namespace rgb_matrix_test;
+
+namespace {
+
+std::map<std::string, uint32_t> load_golden(void) {
+    std::map<std::string, uint32_t> golden;
+    std::ifstream                   in(RGB_MATRIX_TEST_GOLDEN_FILE);
+    std::string                     name;
+    std::string                     hash;
+    while (in >> name >> hash) {
+        golden[name] = (uint32_t)strtoul(hash.c_str(), nullptr, 16);
+    }
+    return golden;
+}
+
+void store_golden(const std::string &effect, uint32_t hash) {
+    auto golden    = load_golden();
+    golden[effect] = hash;
+
+    FILE *fp = fopen(RGB_MATRIX_TEST_GOLDEN_FILE, "w");
+    ASSERT_NE(fp, nullptr) << "unable to write " << RGB_MATRIX_TEST_GOLDEN_FILE;
+    for (const auto &entry : golden) {
+        fprintf(fp, "%s 0x%08" PRIx32 "\n", entry.first.c_str(), entry.second);
+    }
+    fclose(fp);
+}
+
+} // namespace
+
+class RgbMatrixEffect : public TestFixture, public ::testing::WithParamInterface<uint8_t> {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        init_layout();
+    }
+};
+
+/*
+ * Renders every effect under the mocked timer with periodic key taps and compares a hash of all flushed frames against
+ * the suite's golden file.
+ *
+ * Set RGB_MATRIX_TEST_UPDATE_GOLDEN=1 to rewrite the golden file after an intentional visual change, and
+ * RGB_MATRIX_TEST_DUMP_DIR=<dir> to dump each effect as a PPM image (one row per frame) for inspection.
+ */
+TEST_P(RgbMatrixEffect, MatchesGoldenFrames) {
+    TestDriver  driver;
+    uint8_t     mode = GetParam();
+    std::string name = rgb_matrix_get_mode_name(mode);
+
+    reset_effect(mode);
+
+    std::vector<rgb_t> frames;
+    uint32_t           hash = 2166136261u;
+    for (int i = 0; i < GOLDEN_FRAME_COUNT; i++) {
+        ASSERT_TRUE(render_frame()) << name << " did not flush frame " << i;
+        hash = hash_frame(hash);
+        frames.insert(frames.end(), last_frame(), last_frame() + RGB_MATRIX_LED_COUNT);
+    }
+    EXPECT_EQ(driver_stats().flush_calls, GOLDEN_FRAME_COUNT);
+
+    if (const char *dump_dir = getenv("RGB_MATRIX_TEST_DUMP_DIR")) {
+        std::stringstream path;
+        path << dump_dir << "/" << RGB_MATRIX_LED_COUNT << "_leds_" << name << ".ppm";
+        EXPECT_TRUE(write_ppm(path.str(), frames)) << "unable to write " << path.str();
+    }
+
+    if (getenv("RGB_MATRIX_TEST_UPDATE_GOLDEN")) {
+        store_golden(name, hash);
+        return;
+    }
+
+    auto golden = load_golden();
+    auto entry  = golden.find(name);
+    ASSERT_NE(entry, golden.end()) << "no golden hash for " << name << " in " << RGB_MATRIX_TEST_GOLDEN_FILE;
+    EXPECT_EQ(entry->second, hash) << name << " rendered different frames than recorded in " << RGB_MATRIX_TEST_GOLDEN_FILE;
+}
+
+INSTANTIATE_TEST_CASE_P(AllEffects, RgbMatrixEffect, ::testing::Range<uint8_t>(1, RGB_MATRIX_EFFECT_MAX), [](const ::testing::TestParamInfo<uint8_t> &info) { return std::string(rgb_matrix_get_mode_name(info.param)); });
+
+class RgbMatrixBenchmark : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        init_layout();
+    }
+};
+
+/*
+ * Reports the host-side cost of rendering a frame for every effect. This is a baseline for comparing optimisations,
+ * not a pass/fail check.
+ */
+TEST_F(RgbMatrixBenchmark, FrameCost) {
+    TestDriver driver;
+
+    printf("%-28s %12s %14s %12s\n", "effect", "ns/frame", "cycles/frame", "writes/frame");
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        reset_effect(mode);
+
+        uint64_t total_ns     = 0;
+        uint64_t total_cycles = 0;
+        for (int i = 0; i < BENCHMARK_FRAME_COUNT; i++) {
+            uint64_t ns     = 0;
+            uint64_t cycles = 0;
+            ASSERT_TRUE(render_frame_timed(&ns, &cycles));
+            total_ns += ns;
+            total_cycles += cycles;
+        }
+
+        const auto &stats = driver_stats();
+        printf("%-28s %12" PRIu64 " %14" PRIu64 " %12" PRIu32 "\n", rgb_matrix_get_mode_name(mode), total_ns / BENCHMARK_FRAME_COUNT, total_cycles / BENCHMARK_FRAME_COUNT, (stats.set_color_calls + stats.set_color_all_calls * RGB_MATRIX_LED_COUNT) / BENCHMARK_FRAME_COUNT);
+    }
+}
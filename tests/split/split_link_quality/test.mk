@@ -0,0 +1,12 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+SPLIT_KEYBOARD = yes
+
+SRC += tests/split/split_test_harness.cpp \
+	tests/split/test_split_sync.cpp \
+	tests/split/test_split_link.cpp \
+	tests/split/test_split_scheduler.cpp \
+	tests/split/test_split_link_quality.cpp \
+	serial_loopback.c
@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../split_test_config.h"
+
+#define SPLIT_SYNC_FRAME_ENABLE
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../split_test_config.h"
+
+#define SPLIT_SYNC_FRAME_ENABLE
+
+#define NUM_ENCODERS_LEFT 2
+#define NUM_ENCODERS_RIGHT 2
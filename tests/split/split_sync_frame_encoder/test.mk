@@ -0,0 +1,11 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+SPLIT_KEYBOARD = yes
+ENCODER_ENABLE = yes
+ENCODER_DRIVER = custom
+
+SRC += tests/split/split_test_harness.cpp \
+	tests/split/test_split_sync.cpp \
+	serial_loopback.c
@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_TRANSPORT_MIRROR
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_ACTIVITY_ENABLE
+
+// Bulk data for the sync scheduler benchmark
+#define SPLIT_TRANSACTION_IDS_USER USER_SYNC_BULK, USER_SYNC_STATUS
@@ -0,0 +1,123 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_harness.hpp"
+
+#include <cstring>
+
+extern "C" {
+#include "action_util.h"
+#include "split_util.h"
+}
+
+namespace split_test {
+
+matrix_row_t master_matrix[SPLIT_TEST_HALF_ROWS];
+matrix_row_t slave_matrix[SPLIT_TEST_HALF_ROWS];
+matrix_row_t target_master_matrix[SPLIT_TEST_HALF_ROWS];
+matrix_row_t target_slave_matrix[SPLIT_TEST_HALF_ROWS];
+
+namespace {
+
+split_shared_memory_t captured_shmem;
+target_state_t        captured_state;
+
+#if defined(ENCODER_ENABLE)
+encoder_events_t target_encoder_events;
+bool             in_target;
+
+// The counters restart from zero, which only changes the checksums the master sees
+void load_encoder_events(const encoder_events_t *events) {
+    encoder_events_t pending = *events;
+    uint8_t          index;
+    bool             clockwise;
+    encoder_init();
+    while (encoder_dequeue_event_advanced(&pending, &index, &clockwise)) {
+        encoder_queue_event(index, clockwise);
+    }
+}
+#endif
+
+void target_scan(void) {
+    layer_state_t master_layer_state = layer_state;
+    uint8_t       master_mods        = get_mods();
+    uint8_t       master_weak_mods   = get_weak_mods();
+
+#if defined(ENCODER_ENABLE)
+    encoder_events_t master_encoder_events;
+    encoder_retrieve_events(&master_encoder_events);
+    load_encoder_events(&target_encoder_events);
+    // Applies any drain the master requested, the slave doesn't process its own events
+    in_target = true;
+    encoder_task();
+    in_target = false;
+#endif
+
+    transactions_slave(target_master_matrix, target_slave_matrix);
+
+#if defined(ENCODER_ENABLE)
+    encoder_retrieve_events(&target_encoder_events);
+    load_encoder_events(&master_encoder_events);
+#endif
+
+    captured_state.layer_state = layer_state;
+    captured_state.mods        = get_mods();
+    layer_state                = master_layer_state;
+    set_mods(master_mods);
+    set_weak_mods(master_weak_mods);
+}
+
+void target_capture(void) {
+    memcpy(&captured_shmem, split_shmem, sizeof(captured_shmem));
+}
+
+} // namespace
+
+void reset(void) {
+    serial_loopback_reset();
+    memset(master_matrix, 0, sizeof(master_matrix));
+    memset(slave_matrix, 0, sizeof(slave_matrix));
+    memset(target_master_matrix, 0, sizeof(target_master_matrix));
+    memset(target_slave_matrix, 0, sizeof(target_slave_matrix));
+    memset(&captured_state, 0, sizeof(captured_state));
+#if defined(ENCODER_ENABLE)
+    memset(&target_encoder_events, 0, sizeof(target_encoder_events));
+    encoder_init();
+#endif
+    serial_loopback_run_target(target_scan);
+}
+
+bool scan(void) {
+    bool connected = transport_master_if_connected(master_matrix, slave_matrix);
+    serial_loopback_run_target(target_scan);
+    return connected;
+}
+
+const split_shared_memory_t *target_shmem(void) {
+    serial_loopback_run_target(target_capture);
+    return &captured_shmem;
+}
+
+const target_state_t *target_state(void) {
+    return &captured_state;
+}
+
+#if defined(ENCODER_ENABLE)
+void target_encoder_event(uint8_t index, bool clockwise) {
+    encoder_queue_event_advanced(&target_encoder_events, index, clockwise);
+}
+#endif
+
+} // namespace split_test
+
+#if defined(ENCODER_ENABLE)
+extern "C" {
+// The encoders are driven by the tests
+void encoder_driver_init(void) {}
+void encoder_driver_task(void) {}
+
+bool should_process_encoder(void) {
+    return !split_test::in_target;
+}
+}
+#endif
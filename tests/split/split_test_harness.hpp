@@ -0,0 +1,56 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+#include "action_layer.h"
+#include "matrix.h"
+#include "transactions.h"
+#include "serial_loopback.h"
+#if defined(ENCODER_ENABLE)
+#    include "encoder.h"
+#endif
+}
+
+#define SPLIT_TEST_HALF_ROWS ((MATRIX_ROWS) / 2)
+
+/**
+ * Host-side harness running both halves of a split keyboard over the loopback serial transport.
+ *
+ * The halves share the keyboard state of this process, so the slave's scan is run as the target with the layer and
+ * modifier state it applies captured separately, and the master's restored afterwards. The same goes for the encoder
+ * event queue.
+ */
+namespace split_test {
+
+struct target_state_t {
+    layer_state_t layer_state;
+    uint8_t       mods;
+};
+
+extern matrix_row_t master_matrix[SPLIT_TEST_HALF_ROWS];
+extern matrix_row_t slave_matrix[SPLIT_TEST_HALF_ROWS];
+extern matrix_row_t target_master_matrix[SPLIT_TEST_HALF_ROWS];
+extern matrix_row_t target_slave_matrix[SPLIT_TEST_HALF_ROWS];
+
+// Resets both halves and the link, leaving the slave's shared memory prepared for the first exchange.
+void reset(void);
+
+// Runs the master's side of the transport, then the slave's scan to apply what it received and publish its matrix.
+// The master therefore sees the slave matrix from the slave's previous scan. Returns whether the master considers the
+// slave connected.
+bool scan(void);
+
+// The slave's copy of the shared memory, and the state it applied from it on its last scan.
+const split_shared_memory_t *target_shmem(void);
+const target_state_t        *target_state(void);
+
+#if defined(ENCODER_ENABLE)
+// Queues an event from the slave's encoders, published to the master on the slave's next scan.
+void target_encoder_event(uint8_t index, bool clockwise);
+#endif
+
+} // namespace split_test
@@ -0,0 +1,205 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include "test_common.hpp"
+#include "split_test_harness.hpp"
+
+extern "C" {
+#include "action_util.h"
+#include "split_util.h"
+}
+
+using namespace split_test;
+
+// The default full-duplex USART link: SELECT_SOFT_SERIAL_SPEED 1, and SERIAL_USART_TIMEOUT for dropped transactions
+#define LINK_BAUD 230400
+#define LINK_TURNAROUND_US 25
+#define LINK_TIMEOUT_US 20000
+// Time each scan spends outside of the transport
+#define SCAN_US 200
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+#ifndef SPLIT_CONNECTION_CHECK_TIMEOUT
+#    define SPLIT_CONNECTION_CHECK_TIMEOUT 500
+#endif
+
+#if defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+#    define SYNC_MODE "sched"
+#elif defined(SPLIT_EVENT_PUSH_ENABLE)
+#    define SYNC_MODE "push"
+#elif defined(SPLIT_SYNC_FRAME_ENABLE)
+#    define SYNC_MODE "frame"
+#elif defined(SPLIT_LINK_QUALITY_ENABLE)
+#    define SYNC_MODE "quality"
+#else
+#    define SYNC_MODE "legacy"
+#endif
+
+class SplitLink : public TestFixture {
+   public:
+    void SetUp() override {
+        reset();
+        set_link(0, 0);
+    }
+
+    void set_link(uint32_t bit_error_ppm, uint32_t drop_ppm) {
+        serial_loopback_link_t link = {};
+        link.baud                   = LINK_BAUD;
+        link.turnaround_us          = LINK_TURNAROUND_US;
+        link.timeout_us             = LINK_TIMEOUT_US;
+        link.bit_error_ppm          = bit_error_ppm;
+        link.drop_ppm               = drop_ppm;
+        serial_loopback_set_link(&link, 0x5EED);
+    }
+
+    uint64_t now(void) {
+        return serial_loopback_get_stats()->elapsed_us;
+    }
+
+    bool scan_timed(void) {
+        bool connected = scan();
+        serial_loopback_advance_us(SCAN_US);
+        return connected;
+    }
+
+    // Runs scans until both halves agree on everything being synced, returning the time it took
+    uint64_t scan_until_synced(uint64_t limit_us) {
+        uint64_t start = now();
+        while (now() - start < limit_us) {
+            scan_timed();
+            if (is_transport_connected() && synced()) {
+                return now() - start;
+            }
+        }
+        return UINT64_MAX;
+    }
+
+    bool synced(void) {
+        return target_state()->layer_state == layer_state && target_state()->mods == get_mods() && memcmp(target_master_matrix, master_matrix, sizeof(master_matrix)) == 0 && memcmp(slave_matrix, target_slave_matrix, sizeof(slave_matrix)) == 0;
+    }
+
+    // Changes a slave key just after its scan, returning the time until the master sees it
+    uint64_t slave_key_latency(void) {
+        target_slave_matrix[0] ^= 1;
+        uint64_t start = now();
+        while (now() - start < 1000000) {
+            scan_timed();
+            if ((slave_matrix[0] & 1) == (target_slave_matrix[0] & 1)) {
+                return now() - start;
+            }
+        }
+        return UINT64_MAX;
+    }
+
+    void report_latency(const char *scenario, uint32_t bit_error_ppm) {
+        const uint32_t presses = 200;
+        uint64_t       total   = 0;
+        uint64_t       worst   = 0;
+
+        set_link(bit_error_ppm, 0);
+        for (uint32_t i = 0; i < presses; ++i) {
+            uint64_t latency = slave_key_latency();
+            ASSERT_NE(latency, UINT64_MAX) << "Key change never reached the master";
+            total += latency;
+            worst = latency > worst ? latency : worst;
+        }
+        printf("%-8s %-8s %-10s %10" PRIu64 " %10" PRIu64 "\n", "latency", SYNC_MODE, scenario, total / presses, worst);
+    }
+};
+
+/**
+ * Reports the mean and worst time from a slave key changing until the master's matrix has it, on a clean and a noisy
+ * link.
+ */
+TEST_F(SplitLink, MatrixToMasterLatency) {
+    TestDriver driver;
+
+    report_latency("clean", 0);
+    EXPECT_EQ(serial_loopback_get_stats()->failures, 0u);
+
+    report_latency("noisy", 200);
+    EXPECT_GT(serial_loopback_get_stats()->failures + serial_loopback_get_stats()->corruptions, 0u) << "Error injection had no effect";
+}
+
+/**
+ * Reports the transactions per second, scans per second and link utilisation over a second of scanning.
+ */
+TEST_F(SplitLink, TransactionsPerSecond) {
+    TestDriver driver;
+    uint32_t   scans = 0;
+
+    while (now() < 1000000) {
+        if (scans % 16 == 0) {
+            target_slave_matrix[1] ^= 2;
+            layer_move((scans / 16) & 3);
+        }
+        ASSERT_TRUE(scan_timed());
+        ++scans;
+    }
+
+    const serial_loopback_stats_t *stats = serial_loopback_get_stats();
+    double                         secs  = stats->elapsed_us / 1e6;
+    printf("%-8s %-8s %12.0f %12.0f %9.1f%%\n", "rate", SYNC_MODE, stats->transactions / secs, scans / secs, 100.0 * stats->bytes * 10 / LINK_BAUD / secs);
+    EXPECT_EQ(stats->failures, 0u);
+
+    layer_clear();
+}
+
+/**
+ * Verifies that the halves resynchronise once a disconnected link comes back, reporting the time it took along with
+ * the time the master took to notice the disconnection.
+ */
+TEST_F(SplitLink, RecoveryAfterDisconnect) {
+    TestDriver driver;
+
+    EXPECT_NE(scan_until_synced(100000), UINT64_MAX);
+
+    // Each scan retries before failing, so it takes a while before the master gives up on the slave
+    set_link(0, 1000000);
+    uint64_t start = now();
+    while (is_transport_connected() && now() - start < 10000000) {
+        scan_timed();
+    }
+    uint64_t detect = now() - start;
+    EXPECT_FALSE(is_transport_connected());
+
+    set_link(0, 0);
+    layer_move(3);
+    add_mods(MOD_BIT(KC_LEFT_CTRL));
+    target_slave_matrix[1] = 0b100;
+    uint64_t recovery = scan_until_synced(2000000);
+    printf("%-8s %-8s %-10s %10" PRIu64 " %10" PRIu64 "\n", "recovery", SYNC_MODE, "disconnect", recovery, detect);
+    EXPECT_LE(recovery, (uint64_t)(SPLIT_CONNECTION_CHECK_TIMEOUT + 10) * 1000) << "Halves did not resynchronise";
+
+    clear_mods();
+    layer_clear();
+}
+
+/**
+ * Verifies that the halves resynchronise after a burst of bit errors on a link without checksums, reporting the time
+ * it took.
+ */
+TEST_F(SplitLink, RecoveryAfterBitErrors) {
+    TestDriver driver;
+
+    set_link(500, 0);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        layer_move((i / 8) & 3);
+        master_matrix[0]       = i & 4;
+        target_slave_matrix[0] = (i / 3) & 1;
+        scan_timed();
+    }
+    const serial_loopback_stats_t *stats = serial_loopback_get_stats();
+    EXPECT_GT(stats->corruptions, 0u) << "Error injection had no effect";
+
+    set_link(0, 0);
+    uint64_t recovery = scan_until_synced(2000000);
+    printf("%-8s %-8s %-10s %10" PRIu64 " %10" PRIu32 " %10" PRIu32 "\n", "recovery", SYNC_MODE, "bit errors", recovery, stats->failures, stats->corruptions);
+    EXPECT_LE(recovery, (uint64_t)(SPLIT_CONNECTION_CHECK_TIMEOUT + FORCED_SYNC_THROTTLE_MS) * 1000) << "Halves did not resynchronise";
+
+    layer_clear();
+}
@@ -0,0 +1,146 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include "test_common.hpp"
+#include "split_test_harness.hpp"
+
+extern "C" {
+#include "split_util.h"
+}
+
+using namespace split_test;
+
+#define LINK_BAUD 230400
+#define LINK_TURNAROUND_US 25
+#define LINK_TIMEOUT_US 20000
+#define SCAN_US 200
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+
+class SplitLinkQuality : public TestFixture {
+   public:
+    void SetUp() override {
+        reset();
+        set_link(0);
+    }
+
+    // Settles the connection and running error rate left behind by earlier tests
+    void settle(void) {
+        for (uint32_t i = 0; i < 10000 && (!is_transport_connected() || split_link_get_stats()->error_rate > 0); ++i) {
+            scan_timed();
+        }
+        split_link_reset_stats();
+    }
+
+    void set_link(uint32_t drop_ppm) {
+        serial_loopback_link_t link = {};
+        link.baud                   = LINK_BAUD;
+        link.turnaround_us          = LINK_TURNAROUND_US;
+        link.timeout_us             = LINK_TIMEOUT_US;
+        link.drop_ppm               = drop_ppm;
+        serial_loopback_set_link(&link, 0x5EED);
+    }
+
+    uint64_t now(void) {
+        return serial_loopback_get_stats()->elapsed_us;
+    }
+
+    bool scan_timed(void) {
+        bool connected = scan();
+        serial_loopback_advance_us(SCAN_US);
+        return connected;
+    }
+
+    const split_link_transaction_stats_t *transaction(int8_t id) {
+        return &split_link_get_stats()->transactions[id];
+    }
+};
+
+/**
+ * Verifies that a failed scan only waits out the timeouts of its retries, without stalling in between, and reports
+ * the time taken to notice the slave being disconnected.
+ */
+TEST_F(SplitLinkQuality, FailedScanDoesNotStall) {
+    TestDriver driver;
+    settle();
+
+    set_link(1000000);
+    uint64_t start = now();
+    EXPECT_TRUE(scan_timed());
+    EXPECT_LE(now() - start, (uint64_t)(SPLIT_LINK_RETRIES + 2) * LINK_TIMEOUT_US);
+
+    while (is_transport_connected() && now() - start < 10000000) {
+        scan_timed();
+    }
+    printf("%-8s %-10s %10" PRIu64 "\n", "quality", "detect", now() - start);
+    EXPECT_FALSE(is_transport_connected());
+    EXPECT_GT(split_link_get_stats()->retries, 0u);
+}
+
+/**
+ * Verifies that failures are counted against the transaction that failed.
+ */
+TEST_F(SplitLinkQuality, CountsFailuresPerTransaction) {
+    TestDriver driver;
+    settle();
+
+    EXPECT_TRUE(scan_timed());
+    EXPECT_EQ(transaction(GET_SLAVE_MATRIX_CHECKSUM)->attempts, 1u);
+    EXPECT_EQ(transaction(GET_SLAVE_MATRIX_CHECKSUM)->failures, 0u);
+
+    set_link(1000000);
+    for (int i = 0; i < 3; ++i) {
+        scan_timed();
+    }
+    EXPECT_EQ(transaction(GET_SLAVE_MATRIX_CHECKSUM)->attempts, 1u + 3 * (1 + SPLIT_LINK_RETRIES));
+    EXPECT_EQ(transaction(GET_SLAVE_MATRIX_CHECKSUM)->failures, 3u * (1 + SPLIT_LINK_RETRIES));
+    EXPECT_GE(transaction(GET_SLAVE_MATRIX_CHECKSUM)->worst_ms, LINK_TIMEOUT_US / 1000);
+    EXPECT_GT(split_link_get_stats()->error_rate, 0u);
+}
+
+/**
+ * Verifies that optional sync is skipped while the link is dropping transactions, that the slave matrix keeps
+ * reaching the master, and that optional sync resumes once the link recovers.
+ */
+TEST_F(SplitLinkQuality, DegradedLinkKeepsMatrixSync) {
+    TestDriver driver;
+    uint32_t   changes = 0;
+    uint32_t   seen    = 0;
+    settle();
+
+    set_link(200000);
+    while (!split_link_is_degraded()) {
+        scan_timed();
+    }
+    split_link_reset_stats();
+    uint64_t start = now();
+    for (uint32_t i = 0; i < 1000; ++i) {
+        if (i % 20 == 0) {
+            target_slave_matrix[0] ^= 1;
+            ++changes;
+        }
+        scan_timed();
+        if (i % 20 == 19 && (slave_matrix[0] & 1) == (target_slave_matrix[0] & 1)) {
+            ++seen;
+        }
+    }
+    printf("%-8s %-10s %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 "\n", "quality", "degraded", seen, changes, (uint32_t)split_link_get_stats()->skipped, (uint32_t)transaction(PUT_ACTIVITY)->attempts);
+    // Activity is resent at least every FORCED_SYNC_THROTTLE_MS when it isn't being skipped
+    uint64_t forced = (now() - start) / 1000 / FORCED_SYNC_THROTTLE_MS;
+    EXPECT_TRUE(split_link_is_degraded());
+    EXPECT_LT(transaction(PUT_ACTIVITY)->attempts * 10u, forced) << "Optional sync should be skipped while degraded";
+    EXPECT_GT(split_link_get_stats()->skipped, 0u);
+    EXPECT_GE(seen, changes * 9 / 10) << "Slave matrix should keep up on a degraded link";
+
+    set_link(0);
+    uint16_t attempts = transaction(PUT_ACTIVITY)->attempts;
+    for (uint32_t i = 0; i < 1000 && transaction(PUT_ACTIVITY)->attempts == attempts; ++i) {
+        scan_timed();
+    }
+    EXPECT_FALSE(split_link_is_degraded());
+    EXPECT_GT(transaction(PUT_ACTIVITY)->attempts, attempts) << "Optional sync should resume once the link recovers";
+}
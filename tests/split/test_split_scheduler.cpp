@@ -0,0 +1,150 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include "test_common.hpp"
+#include "split_test_harness.hpp"
+
+extern "C" {
+#include "split_util.h"
+}
+
+using namespace split_test;
+
+#define LINK_BAUD 230400
+#define LINK_TURNAROUND_US 25
+#define LINK_TIMEOUT_US 20000
+#define SCAN_US 200
+
+#if defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+#    define SYNC_MODE "sched"
+#elif defined(SPLIT_EVENT_PUSH_ENABLE)
+#    define SYNC_MODE "push"
+#elif defined(SPLIT_SYNC_FRAME_ENABLE)
+#    define SYNC_MODE "frame"
+#elif defined(SPLIT_LINK_QUALITY_ENABLE)
+#    define SYNC_MODE "quality"
+#else
+#    define SYNC_MODE "legacy"
+#endif
+
+static uint32_t bulk_received;
+static uint8_t  bulk_data[RPC_M2S_BUFFER_SIZE];
+
+static void bulk_slave_callback(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    bulk_received++;
+    memcpy(bulk_data, in_data, in_buflen < sizeof(bulk_data) ? in_buflen : sizeof(bulk_data));
+}
+
+class SplitScheduler : public TestFixture {
+   public:
+    void SetUp() override {
+        reset();
+        serial_loopback_link_t link = {};
+        link.baud                   = LINK_BAUD;
+        link.turnaround_us          = LINK_TURNAROUND_US;
+        link.timeout_us             = LINK_TIMEOUT_US;
+        serial_loopback_set_link(&link, 0x5EED);
+        transaction_register_rpc(USER_SYNC_BULK, bulk_slave_callback);
+        bulk_received = 0;
+    }
+
+    uint64_t now(void) {
+        return serial_loopback_get_stats()->elapsed_us;
+    }
+
+    // Hands a display's worth of data to the transport, as a keymap would after drawing
+    void send_bulk(uint8_t fill) {
+        uint8_t data[RPC_M2S_BUFFER_SIZE];
+        memset(data, fill, sizeof(data));
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+        transaction_rpc_queue(USER_SYNC_BULK, sizeof(data), data);
+#else
+        transaction_rpc_send(USER_SYNC_BULK, sizeof(data), data);
+#endif
+    }
+
+    bool scan_with_bulk(void) {
+        bool connected = scan();
+        send_bulk(now() & 0xFF);
+        serial_loopback_advance_us(SCAN_US);
+        return connected;
+    }
+};
+
+/**
+ * Reports the mean and worst time from a slave key changing until the master's matrix has it, while bulk data is
+ * handed to the transport after every scan, along with how many bulk calls reach the slave each second.
+ */
+TEST_F(SplitScheduler, MatrixLatencyWithBulkSync) {
+    TestDriver     driver;
+    const uint32_t presses = 200;
+    uint64_t       total   = 0;
+    uint64_t       worst   = 0;
+
+    scan_with_bulk();
+    uint64_t start = now();
+    bulk_received  = 0;
+    for (uint32_t i = 0; i < presses; ++i) {
+        target_slave_matrix[0] ^= 1;
+        uint64_t pressed = now();
+        while ((slave_matrix[0] & 1) != (target_slave_matrix[0] & 1)) {
+            ASSERT_TRUE(scan_with_bulk());
+            ASSERT_LT(now() - pressed, 1000000u) << "Key change never reached the master";
+        }
+        total += now() - pressed;
+        worst = now() - pressed > worst ? now() - pressed : worst;
+    }
+    double secs = (now() - start) / 1e6;
+    printf("%-8s %-8s %-10s %10" PRIu64 " %10" PRIu64 " %10.0f\n", "latency", SYNC_MODE, "bulk", total / presses, worst, bulk_received / secs);
+    EXPECT_GT(bulk_received, 0u);
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    // Bulk sync only ever adds the transaction which crosses the budget to a scan
+    uint32_t worst_scan_bytes = SPLIT_SYNC_SCAN_BUDGET + 2 + RPC_M2S_BUFFER_SIZE;
+    EXPECT_LE(worst, 2 * (SCAN_US + (uint64_t)worst_scan_bytes * 10 * 1000000 / LINK_BAUD + 8 * LINK_TURNAROUND_US));
+#endif
+}
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+
+/**
+ * Verifies that a queued call reaches the slave intact, spread over more than one scan, and that no scan sends more
+ * than the budget plus the transaction which crossed it.
+ */
+TEST_F(SplitScheduler, QueuedRpcIsChunkedWithinBudget) {
+    TestDriver driver;
+    uint8_t    data[RPC_M2S_BUFFER_SIZE];
+    uint32_t   scans = 0;
+
+    // Let anything queued by earlier tests go through
+    for (int i = 0; i < 20; ++i) {
+        scan();
+        serial_loopback_advance_us(1000);
+    }
+    bulk_received = 0;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = i * 7;
+    }
+    ASSERT_TRUE(transaction_rpc_queue(USER_SYNC_BULK, sizeof(data), data));
+    EXPECT_FALSE(transaction_rpc_queue(USER_SYNC_STATUS, sizeof(data), data)) << "Only one call may be queued";
+
+    while (bulk_received == 0 && scans < 100) {
+        uint32_t bytes = serial_loopback_get_stats()->bytes;
+        ASSERT_TRUE(scan());
+        serial_loopback_advance_us(SCAN_US);
+        EXPECT_LE(serial_loopback_get_stats()->bytes - bytes, SPLIT_SYNC_SCAN_BUDGET + 2 + RPC_M2S_BUFFER_SIZE);
+        ++scans;
+    }
+    EXPECT_EQ(bulk_received, 1u);
+    EXPECT_GT(scans, 1u) << "Queued call should have been spread over several scans";
+    EXPECT_EQ(memcmp(bulk_data, data, sizeof(data)), 0);
+    EXPECT_TRUE(transaction_rpc_queue(USER_SYNC_STATUS, sizeof(data), data)) << "Queue should be free once sent";
+    for (int i = 0; i < 20; ++i) {
+        scan();
+        serial_loopback_advance_us(1000);
+    }
+}
+
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
@@ -0,0 +1,152 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include "test_common.hpp"
+#include "split_test_harness.hpp"
+
+extern "C" {
+#include "action_util.h"
+
+void advance_time(uint32_t ms);
+}
+
+using namespace split_test;
+
+// Link model used for the reported time: a USART at 921600 baud sends a 10-bit byte in ~11us, and each round trip
+// turns the link around twice, after the transaction ID handshake and after the master to slave data
+#define LINK_US_PER_BYTE 11
+#define LINK_US_PER_TRANSACTION 50
+
+#if defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+#    define SYNC_MODE "sched"
+#elif defined(SPLIT_EVENT_PUSH_ENABLE)
+#    define SYNC_MODE "push"
+#elif defined(SPLIT_SYNC_FRAME_ENABLE)
+#    define SYNC_MODE "frame"
+#elif defined(SPLIT_LINK_QUALITY_ENABLE)
+#    define SYNC_MODE "quality"
+#else
+#    define SYNC_MODE "legacy"
+#endif
+
+class SplitSync : public TestFixture {
+   public:
+    void SetUp() override {
+        reset();
+    }
+
+    // One scan of each half, a millisecond apart
+    bool scan(void) {
+        bool okay = split_test::scan();
+        advance_time(1);
+        return okay;
+    }
+
+    void report(const char *scenario, uint32_t scans) {
+        const serial_loopback_stats_t *stats = serial_loopback_get_stats();
+        uint32_t                       us    = stats->transactions * LINK_US_PER_TRANSACTION + stats->bytes * LINK_US_PER_BYTE;
+        printf("%-8s %-8s %-8s %10.2f %10.2f %10.1f\n", "split", SYNC_MODE, scenario, (double)stats->transactions / scans, (double)stats->bytes / scans, (double)us / scans);
+    }
+};
+
+TEST_F(SplitSync, SlaveMatrixReachesMaster) {
+    TestDriver driver;
+    target_slave_matrix[0] = 0b101;
+    target_slave_matrix[1] = 0b010;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_matrix[0], 0b101u);
+    EXPECT_EQ(slave_matrix[1], 0b010u);
+
+    target_slave_matrix[0] = 0;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_matrix[0], 0u);
+    EXPECT_EQ(slave_matrix[1], 0b010u);
+}
+
+TEST_F(SplitSync, MasterStateReachesSlave) {
+    TestDriver driver;
+    layer_move(2);
+    add_mods(MOD_BIT(KC_LEFT_SHIFT));
+    master_matrix[1] = 0b1000;
+    EXPECT_TRUE(scan());
+
+    EXPECT_EQ(target_state()->layer_state, (layer_state_t)1 << 2);
+    EXPECT_EQ(target_state()->mods, MOD_BIT(KC_LEFT_SHIFT));
+    EXPECT_EQ(target_master_matrix[1], 0b1000u);
+    EXPECT_EQ(target_shmem()->layers.layer_state, (layer_state_t)1 << 2);
+
+    clear_mods();
+    layer_clear();
+}
+
+#if defined(ENCODER_ENABLE)
+static int encoder_updates[NUM_ENCODERS][2];
+
+extern "C" bool encoder_update_user(uint8_t index, bool clockwise) {
+    encoder_updates[index][clockwise]++;
+    return false;
+}
+
+TEST_F(SplitSync, SlaveEncoderEventsReachMasterOnce) {
+    TestDriver driver;
+    memset(encoder_updates, 0, sizeof(encoder_updates));
+
+    target_encoder_event(0, true);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(scan());
+        encoder_task();
+    }
+    target_encoder_event(1, false);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(scan());
+        encoder_task();
+    }
+
+    EXPECT_EQ(encoder_updates[0][true], 1);
+    EXPECT_EQ(encoder_updates[0][false], 0);
+    EXPECT_EQ(encoder_updates[1][true], 0);
+    EXPECT_EQ(encoder_updates[1][false], 1);
+}
+#endif
+
+/**
+ * Reports the round trips, bytes and modelled link time per scan, both while idle and while keys change on every
+ * scan.
+ */
+TEST_F(SplitSync, LinkUtilisation) {
+    TestDriver     driver;
+    const uint32_t scans = 1000;
+
+    // Let the initial forced syncs settle
+    scan();
+    serial_loopback_reset_stats();
+    for (uint32_t i = 0; i < scans; ++i) {
+        ASSERT_TRUE(scan());
+    }
+    report("idle", scans);
+#if defined(SPLIT_EVENT_PUSH_ENABLE)
+    EXPECT_LT(serial_loopback_get_stats()->transactions, scans / 4) << "Idle scans should only poll for keepalive";
+#elif defined(SPLIT_SYNC_FRAME_ENABLE)
+    EXPECT_EQ(serial_loopback_get_stats()->transactions, scans) << "Idle scans should take a single round trip";
+#endif
+
+    serial_loopback_reset_stats();
+    for (uint32_t i = 0; i < scans; ++i) {
+        target_slave_matrix[0] = i & 1;
+        master_matrix[0]       = (i >> 1) & 1;
+        layer_move(i & 3);
+        ASSERT_TRUE(scan());
+        EXPECT_EQ(slave_matrix[0], i == 0 ? 0 : (i - 1) & 1);
+    }
+    report("active", scans);
+#ifdef SPLIT_SYNC_FRAME_ENABLE
+    EXPECT_EQ(serial_loopback_get_stats()->transactions, scans) << "Active scans should take a single round trip";
+#endif
+
+    layer_clear();
+}